@@ -5,6 +5,19 @@
 #include <ctime>
 #include <sstream>
 #include <algorithm>
+#include <chrono>
+
+namespace
+{
+    auto constexpr DrainInterval = std::chrono::milliseconds(20);
+}
+
+void LoggingCallBack::newLogMessages(std::vector<LogMessage> const& messages)
+{
+    for (auto const& message : messages) {
+        newLogMessage(message.priority, message.message);
+    }
+}
 
 LoggingService& LoggingService::getInstance()
 {
@@ -12,30 +25,129 @@ LoggingService& LoggingService::getInstance()
     return instance;
 }
 
+LoggingService::LoggingService(size_t capacity)
+    : _queue(capacity)
+{
+    _drainThread = std::thread([this] { runDrainThread(); });
+}
+
+LoggingService::~LoggingService()
+{
+    {
+        std::lock_guard lock(_mutex);
+        _shutdown = true;
+    }
+    _drainCondition.notify_one();
+    _drainThread.join();
+}
+
 void LoggingService::log(Priority priority, std::string const& message)
 {
-    std::lock_guard<std::mutex> lock(_mutex);
+    if (priority < _minPriority.load(std::memory_order_relaxed)) {
+        return;
+    }
+    if (!_queue.tryPush(Entry{priority, std::time(nullptr), message})) {
+        _numDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void LoggingService::setMinPriority(Priority value)
+{
+    _minPriority = value;
+}
 
-    auto t = std::time(nullptr);
-    auto tm = *std::localtime(&t);
+Priority LoggingService::getMinPriority() const
+{
+    return _minPriority;
+}
 
-    std::stringstream stream;
-    stream << std::put_time(&tm, "%Y-%m-%d %H-%M-%S") << ": " << message;
+uint64_t LoggingService::getNumDroppedMessages() const
+{
+    return _numDroppedMessages;
+}
 
-    auto enrichedMessage = stream.str();
-    for (auto const& callback : _callbacks) {
-        callback->newLogMessage(priority, enrichedMessage);
-    }
+void LoggingService::flush()
+{
+    auto numPushed = _queue.getNumPushed();
+    std::unique_lock lock(_mutex);
+    _numRequestedForDelivery = std::max(_numRequestedForDelivery, numPushed);
+    _drainCondition.notify_one();
+    _flushCondition.wait(lock, [&] { return _numDelivered >= numPushed; });
 }
 
 void LoggingService::registerCallBack(LoggingCallBack* callback)
 {
+    std::lock_guard lock(_callbackMutex);
     _callbacks.emplace_back(callback);
 }
 
 void LoggingService::unregisterCallBack(LoggingCallBack* callback)
 {
+    std::lock_guard lock(_callbackMutex);
     auto end = std::remove_if(_callbacks.begin(), _callbacks.end(), [&](auto const& callback_) { return callback_ == callback; });
 
     _callbacks.erase(end, _callbacks.end());
 }
+
+void LoggingService::runDrainThread()
+{
+    std::vector<LogMessage> messages;
+    size_t numPopped = 0;
+    while (true) {
+        size_t numRequested;
+        bool shutdown;
+        {
+            std::unique_lock lock(_mutex);
+            _drainCondition.wait_for(lock, DrainInterval, [&] { return _shutdown || _numRequestedForDelivery > _numDelivered; });
+            numRequested = _numRequestedForDelivery;
+            shutdown = _shutdown;
+        }
+        if (shutdown) {
+            numRequested = std::max(numRequested, _queue.getNumPushed());
+        }
+
+        //slots claimed by producers may not be written yet, hence requested messages are awaited by polling
+        while (true) {
+            messages.clear();
+            Entry entry;
+            while (_queue.tryPop(entry)) {
+                auto tm = *std::localtime(&entry.time);
+                std::stringstream stream;
+                stream << std::put_time(&tm, "%Y-%m-%d %H-%M-%S") << ": " << entry.message;
+                messages.emplace_back(LogMessage{entry.priority, stream.str()});
+                ++numPopped;
+            }
+            auto numDroppedMessages = _numDroppedMessages.load();
+            if (numDroppedMessages > _numReportedDroppedMessages) {
+                std::stringstream stream;
+                stream << numDroppedMessages - _numReportedDroppedMessages << " log message(s) dropped due to a full logging queue";
+                messages.emplace_back(LogMessage{Priority::Important, stream.str()});
+                _numReportedDroppedMessages = numDroppedMessages;
+            }
+            if (!messages.empty()) {
+                deliver(messages);
+            }
+            if (numPopped >= numRequested) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+
+        {
+            std::lock_guard lock(_mutex);
+            _numDelivered = numPopped;
+        }
+        _flushCondition.notify_all();
+        if (shutdown) {
+            break;
+        }
+    }
+}
+
+void LoggingService::deliver(std::vector<LogMessage> const& messages)
+{
+    std::lock_guard lock(_callbackMutex);
+    for (auto const& callback : _callbacks) {
+        callback->newLogMessages(messages);
+    }
+}
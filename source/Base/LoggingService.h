@@ -1,8 +1,14 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
-#include <mutex>
+
+#include "MpscQueue.h"
 
 enum class Priority
 {
@@ -10,28 +16,80 @@ enum class Priority
     Important,
 };
 
+struct LogMessage
+{
+    Priority priority;
+    std::string message;
+};
+
+//callbacks are invoked on the logging thread
 class LoggingCallBack
 {
 public:
     virtual void newLogMessage(Priority priority, std::string const& message) = 0;
+
+    //receives all messages delivered at once, sinks with expensive writes may override it to process them in one go
+    virtual void newLogMessages(std::vector<LogMessage> const& messages);
 };
 
+//log() only enqueues the message into a bounded lock-free queue, a background thread drains the queue in batches
+//and forwards them to the callbacks; if the queue is full the message is dropped and the number of dropped messages
+//is reported with the next batch
 class LoggingService
 {
 public:
     static LoggingService& getInstance();
 
+    LoggingService(size_t capacity = 1 << 14);  //capacity must be a power of 2
+    ~LoggingService();
+
+    LoggingService(LoggingService const&) = delete;
+    void operator=(LoggingService const&) = delete;
+
     void log(Priority priority, std::string const& message);
 
+    //messages below the minimum priority are discarded before they are enqueued
+    void setMinPriority(Priority value);
+    Priority getMinPriority() const;
+
+    uint64_t getNumDroppedMessages() const;
+
+    //blocks until all messages logged before are delivered to the callbacks, must not be called from a callback
+    void flush();
+
+    //after unregisterCallBack returns, the callback is not invoked anymore
     void registerCallBack(LoggingCallBack* callback);
     void unregisterCallBack(LoggingCallBack* callback);
 
 private:
+    struct Entry
+    {
+        Priority priority;
+        std::time_t time;
+        std::string message;
+    };
+
+    void runDrainThread();
+    void deliver(std::vector<LogMessage> const& messages);
+
+    MpscQueue<Entry> _queue;
+    std::atomic<Priority> _minPriority = Priority::Unimportant;
+    std::atomic<uint64_t> _numDroppedMessages = 0;
+    uint64_t _numReportedDroppedMessages = 0;
+
+    std::mutex _callbackMutex;
     std::vector<LoggingCallBack*> _callbacks;
+
     std::mutex _mutex;
+    std::condition_variable _drainCondition;
+    std::condition_variable _flushCondition;
+    size_t _numDelivered = 0;
+    size_t _numRequestedForDelivery = 0;
+    bool _shutdown = false;
+    std::thread _drainThread;
 };
 
 inline void log(Priority priority, std::string const& message)
 {
     LoggingService::getInstance().log(priority, message);
-}
\ No newline at end of file
+}
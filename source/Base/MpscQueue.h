@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "Exceptions.h"
+
+//bounded lock-free queue for multiple producers and a single consumer:
+//every slot carries a sequence number which tells whether it is free for the producer of a certain position or filled
+//for the consumer, producers claim positions by a CAS on the enqueue counter, hence tryPush never blocks
+template <typename T>
+class MpscQueue
+{
+public:
+    //capacity must be a power of 2
+    MpscQueue(size_t capacity)
+        : _mask(capacity - 1)
+        , _slots(new Slot[capacity])
+    {
+        if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+            throw BugReportException("MpscQueue capacity must be a power of 2");
+        }
+        for (size_t i = 0; i < capacity; ++i) {
+            _slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(MpscQueue const&) = delete;
+    void operator=(MpscQueue const&) = delete;
+
+    size_t getCapacity() const { return _mask + 1; }
+
+    //number of positions claimed by producers so far, every value pushed before this call is at a lower position
+    size_t getNumPushed() const { return _enqueuePos.load(std::memory_order_relaxed); }
+
+    //returns false if the queue is full
+    bool tryPush(T&& value)
+    {
+        auto pos = _enqueuePos.load(std::memory_order_relaxed);
+        while (true) {
+            auto& slot = _slots[pos & _mask];
+            auto sequence = slot.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.value = std::move(value);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    //must only be called from the consumer thread, returns false if the queue is empty
+    bool tryPop(T& value)
+    {
+        auto& slot = _slots[_dequeuePos & _mask];
+        if (slot.sequence.load(std::memory_order_acquire) != _dequeuePos + 1) {
+            return false;
+        }
+        value = std::move(slot.value);
+        slot.sequence.store(_dequeuePos + _mask + 1, std::memory_order_release);
+        ++_dequeuePos;
+        return true;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    size_t const _mask;
+    std::unique_ptr<Slot[]> _slots;
+    alignas(64) std::atomic<size_t> _enqueuePos = 0;
+    alignas(64) size_t _dequeuePos = 0;
+};
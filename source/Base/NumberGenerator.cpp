@@ -4,23 +4,28 @@
 
 #include "NumberGenerator.h"
 
+#include "Philox.h"
+
 namespace
 {
     double const RandMax = 4294967296.0;
+
+    struct CounterStream
+    {
+        uint64_t seedGeneration = ~static_cast<uint64_t>(0);
+        uint32_t seed = 0;
+        uint64_t streamId = 0;
+        uint64_t counter = 0;
+    };
+    thread_local CounterStream counterStream;
 }
 
 NumberGenerator::NumberGenerator()
 {
     _threadId = static_cast<uint64_t>(1) << 48;
-    _arrayOfRandomNumbers.reserve(1323781);
     _runningNumber = 0;
-    std::random_device rd;   //Will be used to obtain a seed for the random number engine
-    std::mt19937 gen(rd());  //Standard mersenne_twister_engine seeded with rd()
-    std::uniform_int_distribution<> distrib(0);
-
-    for (uint32_t i = 0; i < 1323781; ++i) {
-        _arrayOfRandomNumbers.emplace_back(distrib(gen));
-    }
+    std::random_device rd;
+    _seed = rd();
 }
 
 NumberGenerator::~NumberGenerator()
@@ -35,23 +40,23 @@ NumberGenerator& NumberGenerator::getInstance()
 
 uint32_t NumberGenerator::getRandomInt()
 {
-	return getNumberFromArray();
+	return getNextRandomNumber();
 }
 
 uint32_t NumberGenerator::getRandomInt(uint32_t range)
 {
-	return getNumberFromArray() % range;
+	return getNextRandomNumber() % range;
 }
 
 uint32_t NumberGenerator::getRandomInt(uint32_t min, uint32_t max)
 {
     auto delta = max - min + 1;
-    return min + (getNumberFromArray() % delta);
+    return min + (getNextRandomNumber() % delta);
 }
 
 uint32_t NumberGenerator::getLargeRandomInt(uint32_t range)
 {
-	return getNumberFromArray() % (range + 1);
+	return getNextRandomNumber() % (range + 1);
 }
 
 double NumberGenerator::getRandomReal(double min, double max)
@@ -66,16 +71,34 @@ float NumberGenerator::getRandomFloat(float min, float max)
 
 double NumberGenerator::getRandomReal()
 {
-    return static_cast<double>(getNumberFromArray()) / RandMax;
+    return static_cast<double>(getNextRandomNumber()) / RandMax;
 }
 
 uint64_t NumberGenerator::getId()
 {
-	return _threadId | ++_runningNumber;
+	return _threadId | (_runningNumber.fetch_add(1, std::memory_order_relaxed) + 1);
 }
 
-uint32_t NumberGenerator::getNumberFromArray()
+void NumberGenerator::setSeed(uint32_t seed)
 {
-	_index = (_index + 1) % _arrayOfRandomNumbers.size();
-	return _arrayOfRandomNumbers[_index];
+    _seed.store(seed, std::memory_order_relaxed);
+    _runningNumber.store(0, std::memory_order_relaxed);
+    _seedGeneration.fetch_add(1, std::memory_order_release);
+}
+
+void NumberGenerator::setStreamId(uint64_t streamId)
+{
+    counterStream.streamId = streamId;
+    counterStream.seedGeneration = ~static_cast<uint64_t>(0);
+}
+
+uint32_t NumberGenerator::getNextRandomNumber()
+{
+    auto seedGeneration = _seedGeneration.load(std::memory_order_acquire);
+    if (counterStream.seedGeneration != seedGeneration) {
+        counterStream.seedGeneration = seedGeneration;
+        counterStream.seed = _seed.load(std::memory_order_relaxed);
+        counterStream.counter = 0;
+    }
+    return Philox::generate(counterStream.counter++, counterStream.streamId, counterStream.seed).values[0];
 }
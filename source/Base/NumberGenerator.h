@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 #include "Definitions.h"
 
 class NumberGenerator
@@ -16,20 +18,30 @@ public:
 
 	uint64_t getId();
 
+    //makes the sequence of random numbers and ids reproducible
+    void setSeed(uint32_t seed);
+
+    //selects the random number stream of the calling thread and restarts it, the default stream is 0; threads drawing
+    //concurrently select distinct stream ids derived from their work (e.g. the index of a work item) so that the numbers
+    //do not depend on the scheduling
+    void setStreamId(uint64_t streamId);
+
 public:
     NumberGenerator(NumberGenerator const&) = delete;
     void operator=(NumberGenerator const&) = delete;
 
 	uint32_t getLargeRandomInt(uint32_t range);
-    uint32_t getNumberFromArray();
+    uint32_t getNextRandomNumber();
 
 private:
     NumberGenerator();
     ~NumberGenerator();
 
-	int _index = 0;
-	std::vector<uint32_t> _arrayOfRandomNumbers;
-	uint64_t _runningNumber = 0;
+    //each thread draws from its own counter stream: the n-th random number of stream s is Philox(n, s, seed), hence
+    //drawing only increments a thread-local counter; the seed is copied into the stream when it is (re)started
+    std::atomic<uint32_t> _seed = 0;
+    std::atomic<uint64_t> _seedGeneration = 0;
+    std::atomic<uint64_t> _runningNumber = 0;
 	uint64_t _threadId = 0;
 };
 
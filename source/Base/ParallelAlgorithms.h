@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+#include "ThreadPool.h"
+
+//parallel loops on the engine thread pool, small ranges are processed on the calling thread
+class ParallelAlgorithms
+{
+public:
+    //function(index) is called exactly once for each index in [begin, end), grainSize is the minimum number of indices per task
+    template <typename Function>
+    static void parallelFor(int begin, int end, Function const& function, int grainSize = 1)
+    {
+        auto size = end - begin;
+        if (size <= 0) {
+            return;
+        }
+        auto chunkSize = getChunkSize(size, grainSize);
+        if (chunkSize >= size || ThreadPool::getInstance().getNumThreads() <= 1) {
+            for (int index = begin; index < end; ++index) {
+                function(index);
+            }
+            return;
+        }
+
+        TaskGroup group;
+        for (int chunkBegin = begin; chunkBegin < end; chunkBegin += chunkSize) {
+            auto chunkEnd = std::min(end, chunkBegin + chunkSize);
+            group.run([&function, chunkBegin, chunkEnd] {
+                for (int index = chunkBegin; index < chunkEnd; ++index) {
+                    function(index);
+                }
+            });
+        }
+        group.wait();
+    }
+
+    //the range is divided into chunks independently of the number of threads and the partial results are combined in
+    //ascending order, hence the result is deterministic also for non-associative operations such as floating point sums
+    template <typename T, typename Function, typename Combine>
+    static T parallelReduce(int begin, int end, T const& identity, Function const& function, Combine const& combine, int grainSize = 1)
+    {
+        auto size = end - begin;
+        if (size <= 0) {
+            return identity;
+        }
+        auto chunkSize = getChunkSize(size, grainSize);
+        auto numChunks = (size + chunkSize - 1) / chunkSize;
+
+        std::vector<T> partialResults(numChunks, identity);
+        parallelFor(0, numChunks, [&](int chunk) {
+            auto chunkBegin = begin + chunk * chunkSize;
+            auto chunkEnd = std::min(end, chunkBegin + chunkSize);
+            auto& partialResult = partialResults[chunk];
+            for (int index = chunkBegin; index < chunkEnd; ++index) {
+                partialResult = combine(partialResult, function(index));
+            }
+        });
+
+        auto result = identity;
+        for (auto const& partialResult : partialResults) {
+            result = combine(result, partialResult);
+        }
+        return result;
+    }
+
+    //sorts chunks in parallel and merges them pairwise in parallel rounds, not stable
+    template <typename Iterator, typename Compare>
+    static void parallelSort(Iterator begin, Iterator end, Compare const& compare)
+    {
+        auto size = static_cast<int>(std::distance(begin, end));
+        auto numThreads = ThreadPool::getInstance().getNumThreads();
+        if (size < MinSizeForParallelSort || numThreads <= 1) {
+            std::sort(begin, end, compare);
+            return;
+        }
+
+        int numChunks = 1;
+        while (numChunks < numThreads * 2 && size / (numChunks * 2) >= MinSizeForParallelSort / 2) {
+            numChunks *= 2;
+        }
+        std::vector<Iterator> bounds;
+        for (int chunk = 0; chunk <= numChunks; ++chunk) {
+            bounds.emplace_back(begin + static_cast<int>(static_cast<int64_t>(size) * chunk / numChunks));
+        }
+
+        parallelFor(0, numChunks, [&](int chunk) { std::sort(bounds[chunk], bounds[chunk + 1], compare); });
+        for (int width = 1; width < numChunks; width *= 2) {
+            parallelFor(0, numChunks / (width * 2), [&](int pair) {
+                auto first = pair * width * 2;
+                std::inplace_merge(bounds[first], bounds[first + width], bounds[first + width * 2], compare);
+            });
+        }
+    }
+
+    template <typename Iterator>
+    static void parallelSort(Iterator begin, Iterator end)
+    {
+        parallelSort(begin, end, std::less<>());
+    }
+
+private:
+    static int getChunkSize(int size, int grainSize)
+    {
+        return std::max({1, grainSize, (size + MaxNumChunks - 1) / MaxNumChunks});
+    }
+
+    static auto constexpr MaxNumChunks = 256;
+    static auto constexpr MinSizeForParallelSort = 16384;
+};
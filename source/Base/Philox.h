@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(__CUDACC__)
+#define PHILOX_FUNCTION __host__ __device__ __inline__
+#else
+#define PHILOX_FUNCTION inline
+#endif
+
+//counter-based random number generator Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3"):
+//the output only depends on the counter and the key, hence draws need no shared state and are identical on host and device
+class Philox
+{
+public:
+    struct Block
+    {
+        uint32_t values[4];
+    };
+
+    static PHILOX_FUNCTION Block generate(uint64_t counterLow, uint64_t counterHigh, uint64_t key)
+    {
+        uint32_t counter[4] = {
+            static_cast<uint32_t>(counterLow),
+            static_cast<uint32_t>(counterLow >> 32),
+            static_cast<uint32_t>(counterHigh),
+            static_cast<uint32_t>(counterHigh >> 32)};
+        uint32_t key0 = static_cast<uint32_t>(key);
+        uint32_t key1 = static_cast<uint32_t>(key >> 32);
+
+        for (int round = 0; round < 10; ++round) {
+            uint64_t product0 = static_cast<uint64_t>(Multiplier0) * counter[0];
+            uint64_t product1 = static_cast<uint64_t>(Multiplier1) * counter[2];
+            uint32_t newCounter[4] = {
+                static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key0,
+                static_cast<uint32_t>(product1),
+                static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key1,
+                static_cast<uint32_t>(product0)};
+            for (int i = 0; i < 4; ++i) {
+                counter[i] = newCounter[i];
+            }
+            key0 += Weyl0;
+            key1 += Weyl1;
+        }
+        return {{counter[0], counter[1], counter[2], counter[3]}};
+    }
+
+    //random number for an entity at a certain time step, callSite distinguishes independent draws for the same entity
+    static PHILOX_FUNCTION uint32_t generate(uint32_t seed, uint64_t timestep, uint64_t entityId, uint32_t callSite)
+    {
+        auto key = (static_cast<uint64_t>(callSite) << 32) | seed;
+        return generate(entityId, timestep, key).values[0];
+    }
+
+    //in [0, 1)
+    static PHILOX_FUNCTION float generateFloat(uint32_t seed, uint64_t timestep, uint64_t entityId, uint32_t callSite)
+    {
+        return static_cast<float>(generate(seed, timestep, entityId, callSite) >> 8) * (1.0f / 16777216.0f);
+    }
+
+private:
+    static constexpr uint32_t Multiplier0 = 0xD2511F53;
+    static constexpr uint32_t Multiplier1 = 0xCD9E8D57;
+    static constexpr uint32_t Weyl0 = 0x9E3779B9;
+    static constexpr uint32_t Weyl1 = 0xBB67AE85;
+};
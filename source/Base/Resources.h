@@ -9,6 +9,9 @@ namespace Const
     auto const LogFilename = "log.txt";
     auto const AutosaveFile = BasePath + "autosave.sim";
     auto const SettingsFilename = BasePath + "settings.json";
+    auto const SimulationCacheDirectory = BasePath + "simulation cache";
+    auto const SimulationCacheMaxBytes = 1024ull * 1024 * 1024;
+    auto const SimulationCatalogFilename = BasePath + "simulation catalog.bin";
 
     auto const SimulationFragmentShader = BasePath + "shader.fs";
     auto const SimulationVertexShader = BasePath + "shader.vs";
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+
+#include "Exceptions.h"
+
+//fixed-capacity FIFO with O(1) add/popFront whose content can always be read as one contiguous array:
+//every element is stored twice (at i and i + capacity), hence data() points to size() consecutive elements
+template <typename T>
+class RingBuffer
+{
+public:
+    RingBuffer(size_t capacity = 0)
+        : _capacity(capacity)
+        , _data(capacity * 2)
+    {}
+
+    void add(T const& value)
+    {
+        if (_capacity == 0) {
+            return;
+        }
+        size_t pos;
+        if (_size == _capacity) {
+            pos = _start;
+            _start = (_start + 1) % _capacity;
+            ++_numRemoved;
+        } else {
+            pos = (_start + _size) % _capacity;
+            ++_size;
+        }
+        _data[pos] = value;
+        _data[pos + _capacity] = value;
+    }
+
+    void popFront()
+    {
+        if (_size == 0) {
+            throw BugReportException("RingBuffer::popFront on empty buffer");
+        }
+        _start = (_start + 1) % _capacity;
+        --_size;
+        ++_numRemoved;
+    }
+
+    void clear()
+    {
+        _numRemoved += _size;
+        _start = 0;
+        _size = 0;
+    }
+
+    size_t size() const { return _size; }
+    size_t capacity() const { return _capacity; }
+    bool empty() const { return _size == 0; }
+    bool full() const { return _capacity > 0 && _size == _capacity; }
+
+    //number of elements dropped at the front since construction, i.e. front() is the (numRemoved() + 1)-th added element
+    size_t numRemoved() const { return _numRemoved; }
+
+    //oldest element first
+    T const* data() const { return _data.data() + _start; }
+    T const* begin() const { return data(); }
+    T const* end() const { return data() + _size; }
+
+    T const& front() const { return *data(); }
+    T const& back() const { return data()[_size - 1]; }
+    T const& at(size_t index) const
+    {
+        if (index >= _size) {
+            throw BugReportException("RingBuffer::at out of range");
+        }
+        return data()[index];
+    }
+    T const& operator[](size_t index) const { return data()[index]; }
+
+private:
+    size_t _capacity = 0;
+    size_t _start = 0;
+    size_t _size = 0;
+    size_t _numRemoved = 0;
+    std::vector<T> _data;
+};
@@ -0,0 +1,204 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+    thread_local ThreadPool const* currentPool = nullptr;
+    thread_local int currentWorkerIndex = -1;
+}
+
+ThreadPool& ThreadPool::getInstance()
+{
+    static ThreadPool instance;
+    return instance;
+}
+
+ThreadPool::ThreadPool(int numThreads)
+{
+    start(numThreads);
+}
+
+ThreadPool::~ThreadPool()
+{
+    stop();
+}
+
+int ThreadPool::getNumThreads() const
+{
+    return static_cast<int>(_workers.size());
+}
+
+void ThreadPool::setNumThreads(int value)
+{
+    stop();
+    start(value);
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    auto queueIndex = currentPool == this ? currentWorkerIndex : static_cast<int>(_nextQueueIndex++ % _queues.size());
+    {
+        auto& queue = *_queues.at(queueIndex);
+        std::lock_guard lock(queue.mutex);
+        queue.tasks.emplace_back(std::move(task));
+    }
+    {
+        std::lock_guard lock(_mutex);
+        ++_numPendingTasks;
+    }
+    _condition.notify_one();
+}
+
+bool ThreadPool::tryRunPendingTask()
+{
+    std::function<void()> task;
+    if (!tryPopTask(currentPool == this ? currentWorkerIndex : -1, task)) {
+        return false;
+    }
+    task();
+    return true;
+}
+
+void ThreadPool::start(int numThreads)
+{
+    if (numThreads <= 0) {
+        numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    _shutdown = false;
+    _queues.clear();
+    for (int i = 0; i < numThreads; ++i) {
+        _queues.emplace_back(std::make_unique<WorkerQueue>());
+    }
+    for (int i = 0; i < numThreads; ++i) {
+        _workers.emplace_back([this, i] { runWorker(i); });
+    }
+}
+
+void ThreadPool::stop()
+{
+    {
+        std::lock_guard lock(_mutex);
+        _shutdown = true;
+    }
+    _condition.notify_all();
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+    _workers.clear();
+}
+
+void ThreadPool::runWorker(int workerIndex)
+{
+    currentPool = this;
+    currentWorkerIndex = workerIndex;
+
+    std::function<void()> task;
+    while (true) {
+        if (tryPopTask(workerIndex, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock lock(_mutex);
+        _condition.wait(lock, [&] { return _shutdown || _numPendingTasks > 0; });
+        if (_shutdown && 0 == _numPendingTasks) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::tryPopTask(int workerIndex, std::function<void()>& task)
+{
+    if (workerIndex >= 0) {
+        auto& queue = *_queues[workerIndex];
+        std::lock_guard lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            --_numPendingTasks;
+            return true;
+        }
+    }
+
+    auto numQueues = static_cast<int>(_queues.size());
+    auto startIndex = workerIndex >= 0 ? workerIndex + 1 : static_cast<int>(_nextQueueIndex % numQueues);
+    for (int i = 0; i < numQueues; ++i) {
+        auto& queue = *_queues[(startIndex + i) % numQueues];
+        std::lock_guard lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            --_numPendingTasks;
+            return true;
+        }
+    }
+    return false;
+}
+
+TaskGroup::TaskGroup(ThreadPool& pool)
+    : _pool(pool)
+{}
+
+TaskGroup::~TaskGroup()
+{
+    try {
+        wait();
+    } catch (...) {
+    }
+}
+
+void TaskGroup::run(std::function<void()> task)
+{
+    ++_numUnfinishedTasks;
+    _pool.submit([this, task = std::move(task)] {
+        if (!_canceled) {
+            try {
+                task();
+            } catch (...) {
+                std::lock_guard lock(_mutex);
+                if (!_exception) {
+                    _exception = std::current_exception();
+                }
+                _canceled = true;
+            }
+        }
+
+        //notify while holding the lock since the group may be destroyed as soon as the waiting thread continues
+        std::lock_guard lock(_mutex);
+        if (0 == --_numUnfinishedTasks) {
+            _condition.notify_all();
+        }
+    });
+}
+
+void TaskGroup::wait()
+{
+    while (_numUnfinishedTasks > 0) {
+        if (_pool.tryRunPendingTask()) {
+            continue;
+        }
+        std::unique_lock lock(_mutex);
+        _condition.wait_for(lock, std::chrono::milliseconds(1), [&] { return 0 == _numUnfinishedTasks; });
+    }
+
+    std::exception_ptr exception;
+    {
+        std::lock_guard lock(_mutex);
+        std::swap(exception, _exception);
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+void TaskGroup::cancel()
+{
+    _canceled = true;
+}
+
+bool TaskGroup::isCanceled() const
+{
+    return _canceled;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//work-stealing thread pool: every worker has its own task queue, tasks submitted from a worker are pushed to its queue
+//and taken from the back (LIFO), idle workers and waiting threads steal from the front of the other queues
+class ThreadPool
+{
+public:
+    static ThreadPool& getInstance();
+
+    ThreadPool(int numThreads = 0);  //0 = hardware concurrency
+    ~ThreadPool();
+
+    ThreadPool(ThreadPool const&) = delete;
+    void operator=(ThreadPool const&) = delete;
+
+    int getNumThreads() const;
+
+    //pending tasks are finished before the workers are replaced, must not be called while other threads may submit
+    //tasks (e.g. at program start before the pool users are created) and not from a task
+    void setNumThreads(int value);
+
+    //task must not throw, use TaskGroup for error propagation
+    void submit(std::function<void()> task);
+
+    //executes one pending task on the calling thread if available
+    bool tryRunPendingTask();
+
+private:
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void start(int numThreads);
+    void stop();
+    void runWorker(int workerIndex);
+    bool tryPopTask(int workerIndex, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<WorkerQueue>> _queues;
+    std::vector<std::thread> _workers;
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::atomic<int> _numPendingTasks = 0;
+    std::atomic<uint32_t> _nextQueueIndex = 0;
+    bool _shutdown = false;
+};
+
+//set of tasks whose completion can be awaited:
+//an exception thrown by a task cancels the group and is rethrown by wait()
+class TaskGroup
+{
+public:
+    TaskGroup(ThreadPool& pool = ThreadPool::getInstance());
+    ~TaskGroup();
+
+    TaskGroup(TaskGroup const&) = delete;
+    void operator=(TaskGroup const&) = delete;
+
+    void run(std::function<void()> task);
+
+    //executes pending tasks while waiting, hence it can also be called from a task (nested parallelism)
+    void wait();
+
+    //tasks which have not started yet are skipped, running tasks can poll isCanceled()
+    void cancel();
+    bool isCanceled() const;
+
+private:
+    ThreadPool& _pool;
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::atomic<int> _numUnfinishedTasks = 0;
+    std::atomic<bool> _canceled = false;
+    std::exception_ptr _exception;
+};
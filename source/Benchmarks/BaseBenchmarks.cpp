@@ -0,0 +1,130 @@
+#include <atomic>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "Base/LoggingService.h"
+#include "Base/NumberGenerator.h"
+#include "Base/ParallelAlgorithms.h"
+#include "Base/Philox.h"
+#include "Base/ThreadPool.h"
+
+//parallelFor over a memory-bound loop for 1, 2, 4, ... threads
+static void BM_parallelForScaling(benchmark::State& state)
+{
+    ThreadPool::getInstance().setNumThreads(toInt(state.range(0)));
+    std::vector<float> values(1 << 22, 1.0f);
+    for (auto _ : state) {
+        ParallelAlgorithms::parallelFor(
+            0, toInt(values.size()), [&](int index) { values[index] = values[index] * 1.0001f + 0.5f; }, 4096);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+    ThreadPool::getInstance().setNumThreads(0);
+}
+BENCHMARK(BM_parallelForScaling)->RangeMultiplier(2)->Range(1, 16)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_taskGroupOverhead(benchmark::State& state)
+{
+    std::atomic<int> counter = 0;
+    for (auto _ : state) {
+        TaskGroup group;
+        for (int i = 0; i < 1000; ++i) {
+            group.run([&] { counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+        group.wait();
+    }
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+BENCHMARK(BM_taskGroupOverhead)->UseRealTime();
+
+static void BM_philox(benchmark::State& state)
+{
+    uint64_t entityId = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Philox::generate(1, 2, ++entityId, 3));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_philox);
+
+//keyed draws from several threads without shared state, cf. BM_numberGenerator
+static void BM_philox_threads(benchmark::State& state)
+{
+    uint64_t entityId = static_cast<uint64_t>(state.thread_index()) << 40;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Philox::generate(1, 2, ++entityId, 3));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_philox_threads)->ThreadRange(1, 8);
+
+static void BM_numberGenerator(benchmark::State& state)
+{
+    auto& numberGen = NumberGenerator::getInstance();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(numberGen.getRandomInt());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_numberGenerator)->ThreadRange(1, 8);
+
+static void BM_mersenneTwister(benchmark::State& state)
+{
+    std::mt19937 randomEngine(0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(randomEngine());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_mersenneTwister);
+
+namespace
+{
+    class NullLoggingCallBack : public LoggingCallBack
+    {
+    public:
+        void newLogMessage(Priority priority, std::string const& message) override { benchmark::DoNotOptimize(message); }
+    };
+}
+
+//latency of log() on the producer side, the queue is flushed outside of the measurement before it runs full
+static void BM_log(benchmark::State& state)
+{
+    auto constexpr Capacity = 1 << 14;
+    static LoggingService service(Capacity);
+    static NullLoggingCallBack callback;
+    static uint64_t numDroppedMessagesBefore = 0;
+    if (state.thread_index() == 0) {
+        service.registerCallBack(&callback);
+        numDroppedMessagesBefore = service.getNumDroppedMessages();
+    }
+    int numMessages = 0;
+    for (auto _ : state) {
+        service.log(Priority::Unimportant, "benchmark message");
+        if (++numMessages == Capacity / 16 / state.threads()) {
+            state.PauseTiming();
+            service.flush();
+            numMessages = 0;
+            state.ResumeTiming();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        service.flush();
+        state.counters["dropped"] = static_cast<double>(service.getNumDroppedMessages() - numDroppedMessagesBefore);
+        service.unregisterCallBack(&callback);
+    }
+}
+BENCHMARK(BM_log)->ThreadRange(1, 8);
+
+static void BM_log_filtered(benchmark::State& state)
+{
+    LoggingService service(1 << 10);
+    service.setMinPriority(Priority::Important);
+    for (auto _ : state) {
+        service.log(Priority::Unimportant, "benchmark message");
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_log_filtered);
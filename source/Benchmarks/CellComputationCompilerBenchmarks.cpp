@@ -0,0 +1,79 @@
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "EngineInterface/CellComputationCompiler.h"
+
+namespace
+{
+    //programs of 12 lines, the comment in the first line makes each program distinct
+    std::vector<std::string> createSourceCodes(int number, int firstIndex)
+    {
+        std::vector<std::string> const lines = {
+            "mov [1], 3",
+            "add i, j",
+            "if SCANNER_OUT = SCANNER_OUT::FINISHED",
+            "mov SCANNER_OUT, SCANNER_OUT::SUCCESS",
+            "else",
+            "xor (2), [[0x10]]",
+            "endif",
+            "mul k, (3)",
+            "if CONSTR_IN_OPTION = CONSTR_IN::CONSTRUCT",
+            "sub [i], 5",
+            "endif",
+            "mov CONSTR_IN, CONSTR_IN::DO_NOTHING"};
+        std::mt19937 randomEngine(firstIndex);
+        std::vector<std::string> result;
+        for (int i = 0; i < number; ++i) {
+            std::string code = "# program " + std::to_string(firstIndex + i) + "\n";
+            for (auto const& line : lines) {
+                code += line + "\n";
+            }
+            result.emplace_back(code);
+        }
+        return result;
+    }
+}
+
+static void BM_compileSourceCode_uncached(benchmark::State& state)
+{
+    auto symbols = SymbolMapHelper::getDefaultSymbolMap();
+    SimulationParameters parameters;
+    auto codes = createSourceCodes(1 << 16, 0);
+    int index = 0;
+    for (auto _ : state) {
+        if (index == toInt(codes.size())) {
+            state.PauseTiming();
+            codes = createSourceCodes(1 << 16, index);
+            index = 0;
+            state.ResumeTiming();
+        }
+        benchmark::DoNotOptimize(CellComputationCompiler::compileSourceCode(codes[index++], symbols, parameters));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_compileSourceCode_uncached);
+
+static void BM_compileSourceCode_cached(benchmark::State& state)
+{
+    auto symbols = SymbolMapHelper::getDefaultSymbolMap();
+    SimulationParameters parameters;
+    auto code = createSourceCodes(1, 0).front();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CellComputationCompiler::compileSourceCode(code, symbols, parameters));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_compileSourceCode_cached);
+
+static void BM_decompileSourceCode(benchmark::State& state)
+{
+    auto symbols = SymbolMapHelper::getDefaultSymbolMap();
+    SimulationParameters parameters;
+    auto compilation = CellComputationCompiler::compileSourceCode(createSourceCodes(1, 0).front(), symbols, parameters).compilation;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CellComputationCompiler::decompileSourceCode(compilation, symbols, parameters));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_decompileSourceCode);
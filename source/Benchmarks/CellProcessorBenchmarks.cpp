@@ -0,0 +1,91 @@
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "Base/Definitions.h"
+#include "EngineGpuKernels/CellArrays.cuh"
+#include "EngineGpuKernels/HostCellProcessor.cuh"
+
+#include "SyntheticWorld.h"
+
+//host physics path of the GPU engine for the structure-of-arrays layout (HostCellArrays) and the array-of-structures
+//layout (HostCellRecords)
+namespace
+{
+    template <typename CellStorage>
+    void initRandomCells(CellStorage& cells, int2 const& worldSize)
+    {
+        std::mt19937 randomEngine(0);
+        std::uniform_real_distribution<float> xDistribution(0.0f, toFloat(worldSize.x));
+        std::uniform_real_distribution<float> yDistribution(0.0f, toFloat(worldSize.y));
+        std::uniform_real_distribution<float> velDistribution(-0.5f, 0.5f);
+        for (int index = 0; index < cells.getNumCells(); ++index) {
+            auto cell = cells.getHandle(index);
+            cell.absPos() = {xDistribution(randomEngine), yDistribution(randomEngine)};
+            cell.vel() = {velDistribution(randomEngine), velDistribution(randomEngine)};
+            cell.temp1() = {0, 0};
+            cell.temp2() = {0, 0};
+            cell.barrier() = false;
+            cell.numConnections() = 0;
+        }
+    }
+}
+
+//collisions and verlet steps of one time step
+template <typename CellStorage>
+static void BM_cellPhysics(benchmark::State& state)
+{
+    auto numCells = SyntheticWorld::getScaled(state.range(0));
+    auto size = SyntheticWorld::getWorldSize(numCells);
+    int2 worldSize{size, size};
+    CellStorage cells(numCells);
+    initRandomCells(cells, worldSize);
+    HostCellProcessor<CellStorage> processor(worldSize, SimulationParameters());
+    for (auto _ : state) {
+        processor.collisions(cells);
+        processor.verletUpdatePositions(cells);
+        processor.verletUpdateVelocities(cells);
+    }
+    state.SetItemsProcessed(state.iterations() * numCells);
+}
+BENCHMARK_TEMPLATE(BM_cellPhysics, HostCellArrays)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_cellPhysics, HostCellRecords)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+//streaming pass over the hot data only, where the layouts differ the most
+template <typename CellStorage>
+static void BM_cellPositionUpdate(benchmark::State& state)
+{
+    auto numCells = SyntheticWorld::getScaled(state.range(0));
+    auto size = SyntheticWorld::getWorldSize(numCells);
+    int2 worldSize{size, size};
+    CellStorage cells(numCells);
+    initRandomCells(cells, worldSize);
+    HostCellProcessor<CellStorage> processor(worldSize, SimulationParameters());
+    for (auto _ : state) {
+        processor.verletUpdatePositions(cells);
+    }
+    state.SetItemsProcessed(state.iterations() * numCells);
+}
+BENCHMARK_TEMPLATE(BM_cellPositionUpdate, HostCellArrays)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_cellPositionUpdate, HostCellRecords)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+//pairwise collisions with per-thread force accumulation for 1, 2, 4, ... threads, cf. BM_cellPhysics for the
+//serial collisions
+static void BM_pairwiseCollisionsScaling(benchmark::State& state)
+{
+    auto numCells = SyntheticWorld::getScaled(state.range(0));
+    auto numThreads = toInt(state.range(1));
+    auto size = SyntheticWorld::getWorldSize(numCells);
+    int2 worldSize{size, size};
+    HostCellArrays cells(numCells);
+    initRandomCells(cells, worldSize);
+    HostCellProcessor<HostCellArrays> processor(worldSize, SimulationParameters());
+    for (auto _ : state) {
+        processor.collisions(cells, numThreads);
+    }
+    state.SetItemsProcessed(state.iterations() * numCells);
+}
+BENCHMARK(BM_pairwiseCollisionsScaling)
+    ->ArgsProduct({{1000000}, {1, 2, 4, 8, 16}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include "EngineInterface/ClusterHasher.h"
+
+#include "SyntheticWorld.h"
+
+//structural hashes as used by the replicator detection of the pattern analysis, the synthetic clusters are copies of
+//one template and therefore fall into one class
+namespace
+{
+    auto constexpr ClusterSize = 3;
+
+    DeserializedSimulation createClusters(int numClusters)
+    {
+        return SyntheticWorld::create(SyntheticWorld::Parameters()
+                                          .numCells(numClusters * ClusterSize * ClusterSize)
+                                          .clusterSize(ClusterSize)
+                                          .particlesPerCell(0)
+                                          .tokensPerCell(0));
+    }
+}
+
+static void BM_clusterHashes(benchmark::State& state)
+{
+    auto simulation = createClusters(SyntheticWorld::getScaled(state.range(0)));
+    auto const& clusters = simulation.content.clusters;
+    for (auto _ : state) {
+        auto hashes = ClusterHasher::calcHashes(clusters);
+        benchmark::DoNotOptimize(hashes);
+    }
+    state.SetItemsProcessed(state.iterations() * clusters.size());
+}
+BENCHMARK(BM_clusterHashes)->Arg(100000)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+//single-threaded reference for BM_clusterHashes
+static void BM_clusterHashes_serial(benchmark::State& state)
+{
+    auto simulation = createClusters(SyntheticWorld::getScaled(state.range(0)));
+    auto const& clusters = simulation.content.clusters;
+    for (auto _ : state) {
+        for (auto const& cluster : clusters) {
+            benchmark::DoNotOptimize(ClusterHasher::calcHash(cluster));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * clusters.size());
+}
+BENCHMARK(BM_clusterHashes_serial)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+//structures with hashes as used by the pattern analysis, computed once per cluster
+static void BM_clusterStructures(benchmark::State& state)
+{
+    auto simulation = createClusters(SyntheticWorld::getScaled(state.range(0)));
+    auto const& clusters = simulation.content.clusters;
+    for (auto _ : state) {
+        auto structures = ClusterHasher::calcStructures(clusters);
+        benchmark::DoNotOptimize(structures);
+    }
+    state.SetItemsProcessed(state.iterations() * clusters.size());
+}
+BENCHMARK(BM_clusterStructures)->Arg(100000)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+//exact comparison of clusters with equal hashes against the structure of the class representant, the structures are
+//precomputed as in the pattern analysis
+static void BM_clusterEquivalence(benchmark::State& state)
+{
+    auto simulation = createClusters(SyntheticWorld::getScaled(state.range(0)));
+    auto const& clusters = simulation.content.clusters;
+    auto structures = ClusterHasher::calcStructures(clusters);
+    for (auto _ : state) {
+        for (auto const& structure : structures) {
+            benchmark::DoNotOptimize(ClusterHasher::isEquivalent(structures.front(), structure));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * clusters.size());
+}
+BENCHMARK(BM_clusterEquivalence)->Arg(100000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+
+#include "EngineImpl/AccessDataTOCache.h"
+#include "EngineImpl/DataConverter.h"
+
+#include "SyntheticWorld.h"
+
+namespace
+{
+    _AccessDataTOCache::ArraySizes getArraySizes(ClusteredDataDescription const& content, SimulationParameters const& parameters)
+    {
+        _AccessDataTOCache::ArraySizes result{0, toInt(content.particles.size()), 0, parameters.tokenMemorySize};
+        for (auto const& cluster : content.clusters) {
+            result.cellArraySize += toInt(cluster.cells.size());
+            for (auto const& cell : cluster.cells) {
+                result.tokenArraySize += toInt(cell.tokens.size());
+            }
+        }
+        return result;
+    }
+}
+
+static void BM_convertDescriptionToAccessTO(benchmark::State& state)
+{
+    auto simulation = SyntheticWorld::create(SyntheticWorld::Parameters().numCells(SyntheticWorld::getScaled(state.range(0))));
+    auto arraySizes = getArraySizes(simulation.content, simulation.settings.simulationParameters);
+    _AccessDataTOCache dataTOCache(simulation.settings.gpuSettings);
+    DataConverter converter(simulation.settings.simulationParameters);
+    for (auto _ : state) {
+        auto dataTO = dataTOCache.getDataTO(arraySizes);
+        converter.convertClusteredDataDescriptionToAccessTO(dataTO, simulation.content);
+        dataTOCache.releaseDataTO(dataTO);
+    }
+    state.SetItemsProcessed(state.iterations() * arraySizes.cellArraySize);
+}
+BENCHMARK(BM_convertDescriptionToAccessTO)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void BM_convertAccessTOToDataDescription(benchmark::State& state)
+{
+    auto simulation = SyntheticWorld::create(SyntheticWorld::Parameters().numCells(SyntheticWorld::getScaled(state.range(0))));
+    auto arraySizes = getArraySizes(simulation.content, simulation.settings.simulationParameters);
+    _AccessDataTOCache dataTOCache(simulation.settings.gpuSettings);
+    DataConverter converter(simulation.settings.simulationParameters);
+    auto dataTO = dataTOCache.getDataTO(arraySizes);
+    converter.convertClusteredDataDescriptionToAccessTO(dataTO, simulation.content);
+    for (auto _ : state) {
+        auto description = converter.convertAccessTOtoDataDescription(dataTO, DataConverter::SortTokens::Yes);
+        benchmark::DoNotOptimize(description);
+    }
+    state.SetItemsProcessed(state.iterations() * arraySizes.cellArraySize);
+    dataTOCache.releaseDataTO(dataTO);
+}
+BENCHMARK(BM_convertAccessTOToDataDescription)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void BM_convertAccessTOToClusteredDataDescription(benchmark::State& state)
+{
+    auto simulation = SyntheticWorld::create(SyntheticWorld::Parameters().numCells(SyntheticWorld::getScaled(state.range(0))));
+    auto arraySizes = getArraySizes(simulation.content, simulation.settings.simulationParameters);
+    _AccessDataTOCache dataTOCache(simulation.settings.gpuSettings);
+    DataConverter converter(simulation.settings.simulationParameters);
+    auto dataTO = dataTOCache.getDataTO(arraySizes);
+    converter.convertClusteredDataDescriptionToAccessTO(dataTO, simulation.content);
+    for (auto _ : state) {
+        auto description = converter.convertAccessTOtoClusteredDataDescription(dataTO, DataConverter::SortTokens::Yes);
+        benchmark::DoNotOptimize(description);
+    }
+    state.SetItemsProcessed(state.iterations() * arraySizes.cellArraySize);
+    dataTOCache.releaseDataTO(dataTO);
+}
+BENCHMARK(BM_convertAccessTOToClusteredDataDescription)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+//round trip of token-heavy worlds for different token memory sizes, the access TOs hold tokenMemorySize bytes per token
+static void BM_convertTokensWithMemorySize(benchmark::State& state)
+{
+    auto simulation = SyntheticWorld::create(
+        SyntheticWorld::Parameters().numCells(SyntheticWorld::getScaled(100000)).tokensPerCell(1.0f));
+    auto& parameters = simulation.settings.simulationParameters;
+    parameters.tokenMemorySize = toInt(state.range(0));
+    for (auto& cluster : simulation.content.clusters) {
+        for (auto& cell : cluster.cells) {
+            for (auto& token : cell.tokens) {
+                token.data.resize(parameters.tokenMemorySize, 0);
+            }
+        }
+    }
+    auto arraySizes = getArraySizes(simulation.content, parameters);
+    _AccessDataTOCache dataTOCache(simulation.settings.gpuSettings);
+    DataConverter converter(parameters);
+    for (auto _ : state) {
+        auto dataTO = dataTOCache.getDataTO(arraySizes);
+        converter.convertClusteredDataDescriptionToAccessTO(dataTO, simulation.content);
+        auto description = converter.convertAccessTOtoClusteredDataDescription(dataTO);
+        benchmark::DoNotOptimize(description);
+        dataTOCache.releaseDataTO(dataTO);
+    }
+    state.SetItemsProcessed(state.iterations() * arraySizes.tokenArraySize);
+    state.counters["tokenMemoryBytes"] = static_cast<double>(arraySizes.tokenArraySize) * parameters.tokenMemorySize;
+}
+BENCHMARK(BM_convertTokensWithMemorySize)->Arg(32)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
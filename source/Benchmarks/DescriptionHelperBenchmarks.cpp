@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include "EngineInterface/DescriptionHelper.h"
+
+#include "SyntheticWorld.h"
+
+static void BM_createRect(benchmark::State& state)
+{
+    auto size = toInt(state.range(0));
+    for (auto _ : state) {
+        auto data = DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(size).height(size));
+        benchmark::DoNotOptimize(data);
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_createRect)->Arg(30)->Arg(100)->Unit(benchmark::kMillisecond);
+
+static void BM_reconnectCells(benchmark::State& state)
+{
+    auto simulation = SyntheticWorld::create(SyntheticWorld::Parameters().numCells(SyntheticWorld::getScaled(state.range(0))));
+    DataDescription data(simulation.content);
+    for (auto _ : state) {
+        DescriptionHelper::reconnectCells(data, 1.1f);
+    }
+    state.SetItemsProcessed(state.iterations() * data.cells.size());
+}
+BENCHMARK(BM_reconnectCells)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void BM_gridMultiply(benchmark::State& state)
+{
+    auto simulation = SyntheticWorld::create(SyntheticWorld::Parameters().numCells(1000));
+    DataDescription data(simulation.content);
+    auto number = toInt(state.range(0));
+    for (auto _ : state) {
+        auto result = DescriptionHelper::gridMultiply(
+            data, DescriptionHelper::GridMultiplyParameters().horizontalNumber(number).verticalNumber(number).horizontalAngleInc(5.0f));
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * data.cells.size() * number * number);
+}
+BENCHMARK(BM_gridMultiply)->Arg(3)->Arg(10)->Unit(benchmark::kMillisecond);
+
+static void BM_randomMultiply(benchmark::State& state)
+{
+    auto simulation = SyntheticWorld::create(SyntheticWorld::Parameters().numCells(100).particlesPerCell(0));
+    DataDescription data(simulation.content);
+    auto number = toInt(state.range(0));
+    for (auto _ : state) {
+        bool overlappingCheckSuccessful;
+        auto result = DescriptionHelper::randomMultiply(
+            data,
+            DescriptionHelper::RandomMultiplyParameters().number(number).overlappingCheck(true),
+            {2000, 2000},
+            DataDescription(),
+            overlappingCheckSuccessful);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * number);
+}
+BENCHMARK(BM_randomMultiply)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+static void BM_correctConnections(benchmark::State& state)
+{
+    auto simulation = SyntheticWorld::create(SyntheticWorld::Parameters().numCells(SyntheticWorld::getScaled(state.range(0))));
+    IntVector2D worldSize{simulation.settings.generalSettings.worldSizeX, simulation.settings.generalSettings.worldSizeY};
+    for (auto _ : state) {
+        DescriptionHelper::correctConnections(simulation.content, worldSize);
+    }
+    state.SetItemsProcessed(state.iterations() * SyntheticWorld::getNumCells(simulation.content));
+}
+BENCHMARK(BM_correctConnections)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void BM_duplicate(benchmark::State& state)
+{
+    auto simulation = SyntheticWorld::create(SyntheticWorld::Parameters().numCells(SyntheticWorld::getScaled(state.range(0))));
+    IntVector2D worldSize{simulation.settings.generalSettings.worldSizeX, simulation.settings.generalSettings.worldSizeY};
+    for (auto _ : state) {
+        auto content = simulation.content;
+        DescriptionHelper::duplicate(content, worldSize, {worldSize.x * 2, worldSize.y * 2});
+        benchmark::DoNotOptimize(content);
+    }
+    state.SetItemsProcessed(state.iterations() * SyntheticWorld::getNumCells(simulation.content) * 4);
+}
+BENCHMARK(BM_duplicate)->Arg(10000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,417 @@
+#include <atomic>
+#include <cmath>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "Base/Definitions.h"
+#include "EngineGpuKernels/FlowFieldGrid.cuh"
+#include "EngineGpuKernels/HostCellList.cuh"
+#include "EngineGpuKernels/HostNeighborList.cuh"
+#include "EngineGpuKernels/HostParticleMap.cuh"
+#include "EngineInterface/SimulationParameters.h"
+
+#include "SyntheticWorld.h"
+
+//host counterparts of the spatial data structures of the GPU engine, the world area grows with the number of entities
+//as in SyntheticWorld
+namespace
+{
+    int2 getWorldSize(int numEntities)
+    {
+        auto size = SyntheticWorld::getWorldSize(numEntities);
+        return {size, size};
+    }
+
+    //areaPerEntity = 1 corresponds to packed clusters, the synthetic worlds have 10 units per entity
+    int2 getWorldSize(int numEntities, int areaPerEntity)
+    {
+        auto size = std::max(10, toInt(std::ceil(std::sqrt(toFloat(numEntities) * toFloat(areaPerEntity)))));
+        return {size, size};
+    }
+
+    std::vector<float2> createPositions(int numEntities, int2 const& worldSize)
+    {
+        std::mt19937 randomEngine(0);
+        std::uniform_real_distribution<float> xDistribution(0.0f, toFloat(worldSize.x));
+        std::uniform_real_distribution<float> yDistribution(0.0f, toFloat(worldSize.y));
+        std::vector<float2> result(numEntities);
+        for (auto& pos : result) {
+            pos = {xDistribution(randomEngine), yDistribution(randomEngine)};
+        }
+        return result;
+    }
+
+    std::vector<uint64_t> createIds(int numEntities)
+    {
+        std::vector<uint64_t> result(numEntities);
+        for (int i = 0; i < numEntities; ++i) {
+            result[i] = i + 1;
+        }
+        return result;
+    }
+
+    //replica of the former CellMap as reference for the cell list: two slots per unit square of the world, further
+    //entities in the same unit square overwrite the second slot and are lost for queries
+    class TwoSlotCellMap
+    {
+    public:
+        TwoSlotCellMap(int2 const& worldSize)
+            : _worldSize(worldSize)
+            , _map(static_cast<size_t>(worldSize.x) * worldSize.y * 2)
+        {
+            for (auto& slot : _map) {
+                slot = -1;
+            }
+        }
+
+        void build(std::vector<float2> const& positions)
+        {
+            //only the slots of the previous build are cleared
+            for (auto const& mapEntry : _mapEntries) {
+                _map[mapEntry] = -1;
+                _map[mapEntry + 1] = -1;
+            }
+            auto numEntities = toInt(positions.size());
+            _mapEntries.resize(numEntities);
+            for (int index = 0; index < numEntities; ++index) {
+                auto mapEntry = getMapEntry({toInt(std::floor(positions[index].x)), toInt(std::floor(positions[index].y))});
+                auto expected = -1;
+                if (!_map[mapEntry].compare_exchange_strong(expected, index)) {
+                    _map[mapEntry + 1].exchange(index);
+                }
+                _mapEntries[index] = mapEntry;
+            }
+        }
+
+        //entities in the 3x3 unit squares around pos
+        void get(std::vector<int>& result, float2 const& pos) const
+        {
+            result.clear();
+            int2 posInt{toInt(std::floor(pos.x)), toInt(std::floor(pos.y))};
+            for (int dx = -1; dx <= 1; ++dx) {
+                for (int dy = -1; dy <= 1; ++dy) {
+                    auto mapEntry = getMapEntry({posInt.x + dx, posInt.y + dy});
+                    for (int slot = 0; slot < 2; ++slot) {
+                        auto index = _map[mapEntry + slot].load(std::memory_order_relaxed);
+                        if (index == -1) {
+                            break;
+                        }
+                        result.emplace_back(index);
+                    }
+                }
+            }
+        }
+
+        size_t getMemorySize() const { return sizeof(void*) * _map.size() + sizeof(int) * _mapEntries.size(); }
+
+    private:
+        int getMapEntry(int2 pos) const
+        {
+            pos = {((pos.x % _worldSize.x) + _worldSize.x) % _worldSize.x, ((pos.y % _worldSize.y) + _worldSize.y) % _worldSize.y};
+            return (pos.x + pos.y * _worldSize.x) * 2;
+        }
+
+        int2 _worldSize;
+        std::vector<std::atomic<int>> _map;
+        std::vector<int> _mapEntries;
+    };
+
+    FlowFieldSettings createFlowFieldSettings(int2 const& worldSize)
+    {
+        FlowFieldSettings result;
+        result.active = true;
+        result.numCenters = 2;
+        result.centers[0].posX = toFloat(worldSize.x) / 3;
+        result.centers[0].posY = toFloat(worldSize.y) / 3;
+        result.centers[0].radius = toFloat(worldSize.x) / 4;
+        result.centers[0].strength = 0.05f;
+        result.centers[1].posX = toFloat(worldSize.x) * 2 / 3;
+        result.centers[1].posY = toFloat(worldSize.y) * 2 / 3;
+        result.centers[1].radius = toFloat(worldSize.x) / 4;
+        result.centers[1].strength = 0.02f;
+        result.centers[1].orientation = Orientation::CounterClockwise;
+        return result;
+    }
+}
+
+static void BM_cellListBuild(benchmark::State& state)
+{
+    auto numEntities = SyntheticWorld::getScaled(state.range(0));
+    auto worldSize = getWorldSize(numEntities);
+    auto positions = createPositions(numEntities, worldSize);
+    HostCellList cellList(worldSize);
+    for (auto _ : state) {
+        cellList.build(positions);
+    }
+    state.SetItemsProcessed(state.iterations() * numEntities);
+}
+BENCHMARK(BM_cellListBuild)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_cellListQuery(benchmark::State& state)
+{
+    auto numEntities = SyntheticWorld::getScaled(state.range(0));
+    auto worldSize = getWorldSize(numEntities);
+    auto positions = createPositions(numEntities, worldSize);
+    HostCellList cellList(worldSize);
+    cellList.build(positions);
+    std::vector<int> result;
+    size_t index = 0;
+    for (auto _ : state) {
+        cellList.get(result, positions[index], 1.6f);
+        index = (index + 1) % positions.size();
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_cellListQuery)->Arg(100000);
+
+static void BM_cellListUnitSquareQuery(benchmark::State& state)
+{
+    auto numEntities = SyntheticWorld::getScaled(state.range(0));
+    auto worldSize = getWorldSize(numEntities);
+    auto positions = createPositions(numEntities, worldSize);
+    HostCellList cellList(worldSize);
+    cellList.build(positions);
+    std::vector<int> result;
+    size_t index = 0;
+    for (auto _ : state) {
+        cellList.get(result, positions[index]);
+        index = (index + 1) % positions.size();
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["bytes"] = static_cast<double>(cellList.getMemorySize());
+}
+BENCHMARK(BM_cellListUnitSquareQuery)->Arg(100000)->Arg(1000000);
+
+//reference for BM_cellListBuild
+static void BM_twoSlotCellMapBuild(benchmark::State& state)
+{
+    auto numEntities = SyntheticWorld::getScaled(state.range(0));
+    auto worldSize = getWorldSize(numEntities);
+    auto positions = createPositions(numEntities, worldSize);
+    TwoSlotCellMap cellMap(worldSize);
+    for (auto _ : state) {
+        cellMap.build(positions);
+    }
+    state.SetItemsProcessed(state.iterations() * numEntities);
+}
+BENCHMARK(BM_twoSlotCellMapBuild)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+//reference for BM_cellListUnitSquareQuery
+static void BM_twoSlotCellMapQuery(benchmark::State& state)
+{
+    auto numEntities = SyntheticWorld::getScaled(state.range(0));
+    auto worldSize = getWorldSize(numEntities);
+    auto positions = createPositions(numEntities, worldSize);
+    TwoSlotCellMap cellMap(worldSize);
+    cellMap.build(positions);
+    std::vector<int> result;
+    size_t index = 0;
+    for (auto _ : state) {
+        cellMap.get(result, positions[index]);
+        index = (index + 1) % positions.size();
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["bytes"] = static_cast<double>(cellMap.getMemorySize());
+}
+BENCHMARK(BM_twoSlotCellMapQuery)->Arg(100000)->Arg(1000000);
+
+static void BM_neighborListRebuild(benchmark::State& state)
+{
+    auto numEntities = SyntheticWorld::getScaled(state.range(0));
+    auto worldSize = getWorldSize(numEntities);
+    auto positions = createPositions(numEntities, worldSize);
+    auto ids = createIds(numEntities);
+    HostNeighborList neighborList(worldSize, 1.6f);
+    for (auto _ : state) {
+        neighborList.rebuild(positions, ids);
+    }
+    state.SetItemsProcessed(state.iterations() * numEntities);
+    state.counters["neighbors"] = neighborList.getNumNeighbors();
+}
+BENCHMARK(BM_neighborListRebuild)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//neighbor queries of all entities in one substep with the area per entity as second argument (1: dense, 100: sparse)
+static void BM_neighborQueries_cellList(benchmark::State& state)
+{
+    auto numEntities = SyntheticWorld::getScaled(state.range(0));
+    auto worldSize = getWorldSize(numEntities, toInt(state.range(1)));
+    auto positions = createPositions(numEntities, worldSize);
+    HostCellList cellList(worldSize);
+    cellList.build(positions);
+    auto const cutoff = SimulationParameters().cellMaxCollisionDistance;
+    for (auto _ : state) {
+        int numNeighbors = 0;
+        for (int index = 0; index < numEntities; ++index) {
+            cellList.executeForEach(positions[index], cutoff, [&](int otherIndex) { numNeighbors += otherIndex != index ? 1 : 0; });
+        }
+        benchmark::DoNotOptimize(numNeighbors);
+    }
+    state.SetItemsProcessed(state.iterations() * numEntities);
+}
+BENCHMARK(BM_neighborQueries_cellList)->Args({100000, 1})->Args({100000, 10})->Args({100000, 100})->Unit(benchmark::kMillisecond);
+
+//same queries as BM_neighborQueries_cellList from a neighbor list which is reused since no entity moves
+static void BM_neighborQueries_neighborList(benchmark::State& state)
+{
+    auto numEntities = SyntheticWorld::getScaled(state.range(0));
+    auto worldSize = getWorldSize(numEntities, toInt(state.range(1)));
+    auto positions = createPositions(numEntities, worldSize);
+    auto const cutoff = SimulationParameters().cellMaxCollisionDistance;
+    auto ids = createIds(numEntities);
+    HostNeighborList neighborList(worldSize, cutoff);
+    neighborList.rebuild(positions, ids);
+    for (auto _ : state) {
+        neighborList.update(positions, ids);
+        int numNeighbors = 0;
+        for (int index = 0; index < numEntities; ++index) {
+            neighborList.executeForEach(index, cutoff, positions, [&](int) { ++numNeighbors; });
+        }
+        benchmark::DoNotOptimize(numNeighbors);
+    }
+    state.SetItemsProcessed(state.iterations() * numEntities);
+    state.counters["neighbors"] = neighborList.getNumNeighbors();
+    state.counters["bytes"] = static_cast<double>(neighborList.getMemorySize());
+}
+BENCHMARK(BM_neighborQueries_neighborList)->Args({100000, 1})->Args({100000, 10})->Args({100000, 100})->Unit(benchmark::kMillisecond);
+
+//same queries as BM_neighborQueries_neighborList in a world where cells die and are born: in each step the given number
+//of entities per mille is removed (the last entity takes the index of a removed one as by the compaction of the cell
+//pointers) and as many are added, the entities move slowly such that the list is rebuilt from time to time
+static void BM_neighborQueries_neighborListChurn(benchmark::State& state)
+{
+    auto numEntities = SyntheticWorld::getScaled(state.range(0));
+    auto numChangesPerStep = std::max(1, numEntities * toInt(state.range(1)) / 1000);
+    auto worldSize = getWorldSize(numEntities);
+    auto positions = createPositions(numEntities, worldSize);
+    auto ids = createIds(numEntities);
+    auto nextId = ids.back() + 1;
+    auto const cutoff = SimulationParameters().cellMaxCollisionDistance;
+    std::mt19937 randomEngine(0);
+    std::uniform_int_distribution<int> indexDistribution(0, numEntities - 1);
+    std::uniform_real_distribution<float> xDistribution(0.0f, toFloat(worldSize.x));
+    std::uniform_real_distribution<float> yDistribution(0.0f, toFloat(worldSize.y));
+
+    HostNeighborList neighborList(worldSize, cutoff);
+    int numRebuilds = 0;
+    for (auto _ : state) {
+        for (int i = 0; i < numChangesPerStep; ++i) {
+            auto index = indexDistribution(randomEngine);
+            positions[index] = positions.back();
+            ids[index] = ids.back();
+            positions.back() = {xDistribution(randomEngine), yDistribution(randomEngine)};
+            ids.back() = nextId++;
+        }
+        for (auto& pos : positions) {
+            pos.x = std::fmod(pos.x + 0.01f, toFloat(worldSize.x));
+        }
+        if (neighborList.update(positions, ids)) {
+            ++numRebuilds;
+        }
+        int numNeighbors = 0;
+        for (int index = 0; index < numEntities; ++index) {
+            neighborList.executeForEach(index, cutoff, positions, [&](int) { ++numNeighbors; });
+        }
+        benchmark::DoNotOptimize(numNeighbors);
+    }
+    state.SetItemsProcessed(state.iterations() * numEntities);
+    state.counters["rebuilds"] = benchmark::Counter(numRebuilds, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_neighborQueries_neighborListChurn)->Args({100000, 1})->Args({100000, 10})->Args({100000, 50})->Unit(benchmark::kMillisecond);
+
+static void BM_particleCollision(benchmark::State& state)
+{
+    auto numParticles = SyntheticWorld::getScaled(state.range(0));
+    auto worldSize = getWorldSize(numParticles / 10);
+    auto positions = createPositions(numParticles, worldSize);
+    std::vector<HostParticle> inputParticles(numParticles);
+    for (int index = 0; index < numParticles; ++index) {
+        inputParticles[index] = {static_cast<uint64_t>(index + 1), positions[index], {0.1f, 0.1f}, 1.0f};
+    }
+    std::vector<HostAbsorbingCell> inputCells;
+    for (int index = 0; index < numParticles / 100; ++index) {
+        inputCells.emplace_back(HostAbsorbingCell{static_cast<uint64_t>(numParticles + index + 1), positions[index * 100], 100.0f, false});
+    }
+    HostParticleMap particleMap(worldSize, SimulationParameters().particleMergeDistance);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto particles = inputParticles;
+        auto cells = inputCells;
+        state.ResumeTiming();
+        particleMap.collision(particles, cells);
+    }
+    state.SetItemsProcessed(state.iterations() * numParticles);
+}
+BENCHMARK(BM_particleCollision)->Arg(1000000)->Arg(10000000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//particles concentrated in few unit squares, e.g. the radiation around large energy sources: the bins are processed
+//in the order of the sorted buckets, hence the work per bin is linear in its size
+static void BM_particleCollision_denseBins(benchmark::State& state)
+{
+    auto numParticles = SyntheticWorld::getScaled(state.range(0));
+    auto particlesPerBin = toInt(state.range(1));
+    auto worldSize = getWorldSize(numParticles / particlesPerBin, 1);
+    auto positions = createPositions(numParticles, worldSize);
+    std::vector<HostParticle> inputParticles(numParticles);
+    for (int index = 0; index < numParticles; ++index) {
+        inputParticles[index] = {static_cast<uint64_t>(numParticles - index), positions[index], {0.1f, 0.1f}, 1.0f};
+    }
+    std::vector<HostAbsorbingCell> cells;
+    HostParticleMap particleMap(worldSize, SimulationParameters().particleMergeDistance);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto particles = inputParticles;
+        state.ResumeTiming();
+        particleMap.collision(particles, cells);
+    }
+    state.SetItemsProcessed(state.iterations() * numParticles);
+}
+BENCHMARK(BM_particleCollision_denseBins)->Args({1000000, 100})->Args({1000000, 1000})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//flow field velocities of all cells from the analytic field, reference for BM_flowFieldGrid
+static void BM_flowFieldAnalytic(benchmark::State& state)
+{
+    auto numCells = SyntheticWorld::getScaled(state.range(0));
+    auto worldSize = getWorldSize(numCells);
+    auto positions = createPositions(numCells, worldSize);
+    auto settings = createFlowFieldSettings(worldSize);
+    for (auto _ : state) {
+        for (auto const& pos : positions) {
+            benchmark::DoNotOptimize(FlowFieldGrid::calcVelocity(settings, worldSize, pos));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numCells);
+}
+BENCHMARK(BM_flowFieldAnalytic)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+//flow field velocities of all cells interpolated from the cached grid
+static void BM_flowFieldGrid(benchmark::State& state)
+{
+    auto numCells = SyntheticWorld::getScaled(state.range(0));
+    auto worldSize = getWorldSize(numCells);
+    auto positions = createPositions(numCells, worldSize);
+    HostFlowFieldGrid grid(worldSize, FlowFieldSettings().gridSpacing);
+    grid.build(createFlowFieldSettings(worldSize));
+    for (auto _ : state) {
+        for (auto const& pos : positions) {
+            benchmark::DoNotOptimize(grid.getVelocity(pos));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numCells);
+}
+BENCHMARK(BM_flowFieldGrid)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+//rebuild of the cached grid after a settings change
+static void BM_flowFieldGridBuild(benchmark::State& state)
+{
+    auto worldSize = getWorldSize(SyntheticWorld::getScaled(state.range(0)));
+    HostFlowFieldGrid grid(worldSize, FlowFieldSettings().gridSpacing);
+    auto settings = createFlowFieldSettings(worldSize);
+    for (auto _ : state) {
+        grid.build(settings);
+    }
+}
+BENCHMARK(BM_flowFieldGridBuild)->Arg(1000000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,54 @@
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "EngineInterface/ImageToPatternConverter.h"
+
+namespace
+{
+    //dark RGBA image with colored discs covering about 10 percent of the area
+    std::vector<unsigned char> createImage(int size)
+    {
+        std::vector<unsigned char> result(static_cast<size_t>(size) * size * 4, 0);
+        std::mt19937 randomEngine(0);
+        std::uniform_int_distribution<int> posDistribution(0, size - 1);
+        std::uniform_int_distribution<int> channelDistribution(0, 255);
+        auto radius = std::max(2, size / 64);
+        auto numDiscs = size * size / (radius * radius * 3) / 10;
+        for (int disc = 0; disc < numDiscs; ++disc) {
+            auto centerX = posDistribution(randomEngine);
+            auto centerY = posDistribution(randomEngine);
+            unsigned char color[3] = {
+                static_cast<unsigned char>(channelDistribution(randomEngine)),
+                static_cast<unsigned char>(channelDistribution(randomEngine)),
+                static_cast<unsigned char>(channelDistribution(randomEngine))};
+            for (int y = std::max(0, centerY - radius); y < std::min(size, centerY + radius); ++y) {
+                for (int x = std::max(0, centerX - radius); x < std::min(size, centerX + radius); ++x) {
+                    if ((x - centerX) * (x - centerX) + (y - centerY) * (y - centerY) < radius * radius) {
+                        auto pixel = &result[(static_cast<size_t>(y) * size + x) * 4];
+                        pixel[0] = color[0];
+                        pixel[1] = color[1];
+                        pixel[2] = color[2];
+                        pixel[3] = 255;
+                    }
+                }
+            }
+        }
+        return result;
+    }
+}
+
+static void BM_convertImageToPattern(benchmark::State& state)
+{
+    auto size = toInt(state.range(0));
+    auto image = createImage(size);
+    size_t numCells = 0;
+    for (auto _ : state) {
+        auto data = ImageToPatternConverter::convert(image.data(), size, size, 4, 6);
+        numCells = data.cells.size();
+        benchmark::DoNotOptimize(data);
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+    state.counters["cells"] = static_cast<double>(numCells);
+}
+BENCHMARK(BM_convertImageToPattern)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,33 @@
+#include <iostream>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "SyntheticWorld.h"
+
+//besides the Google Benchmark options (e.g. --benchmark_filter=<regex>, --benchmark_out=<file> and
+//--benchmark_out_format=json for regression tracking) the option --world_scale=<factor> is accepted
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+
+    std::string const worldScaleOption = "--world_scale=";
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind(worldScaleOption, 0) == 0) {
+            try {
+                SyntheticWorld::setScale(std::stod(arg.substr(worldScaleOption.size())));
+            } catch (std::exception const&) {
+                std::cerr << "Invalid world scale: " << arg << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
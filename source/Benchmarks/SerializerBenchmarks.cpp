@@ -0,0 +1,70 @@
+#include <filesystem>
+
+#include <benchmark/benchmark.h>
+
+#include "EngineInterface/Serializer.h"
+
+#include "SyntheticWorld.h"
+
+namespace
+{
+    std::string getTempFilename()
+    {
+        return (std::filesystem::temp_directory_path() / "alien_benchmark.sim").string();
+    }
+
+    void removeTempFiles()
+    {
+        std::filesystem::path path = getTempFilename();
+        for (auto const& extension : {".sim", ".settings.json", ".symbols.json"}) {
+            std::filesystem::remove(path.replace_extension(extension));
+        }
+    }
+}
+
+static void BM_serializeSimulationToFiles(benchmark::State& state)
+{
+    auto simulation = SyntheticWorld::create(SyntheticWorld::Parameters().numCells(SyntheticWorld::getScaled(state.range(0))));
+    auto filename = getTempFilename();
+    for (auto _ : state) {
+        if (!Serializer::serializeSimulationToFiles(filename, simulation)) {
+            state.SkipWithError("serialization failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * SyntheticWorld::getNumCells(simulation.content));
+    state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(filename));
+    removeTempFiles();
+}
+BENCHMARK(BM_serializeSimulationToFiles)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void BM_deserializeSimulationFromFiles(benchmark::State& state)
+{
+    auto simulation = SyntheticWorld::create(SyntheticWorld::Parameters().numCells(SyntheticWorld::getScaled(state.range(0))));
+    auto filename = getTempFilename();
+    Serializer::serializeSimulationToFiles(filename, simulation);
+    for (auto _ : state) {
+        DeserializedSimulation deserializedSimulation;
+        if (!Serializer::deserializeSimulationFromFiles(deserializedSimulation, filename)) {
+            state.SkipWithError("deserialization failed");
+            break;
+        }
+        benchmark::DoNotOptimize(deserializedSimulation);
+    }
+    state.SetItemsProcessed(state.iterations() * SyntheticWorld::getNumCells(simulation.content));
+    state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(filename));
+    removeTempFiles();
+}
+BENCHMARK(BM_deserializeSimulationFromFiles)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void BM_serializeSimulationToStrings(benchmark::State& state)
+{
+    auto simulation = SyntheticWorld::create(SyntheticWorld::Parameters().numCells(SyntheticWorld::getScaled(state.range(0))));
+    for (auto _ : state) {
+        std::string content, timestepAndSettings, symbolMap;
+        Serializer::serializeSimulationToStrings(content, timestepAndSettings, symbolMap, simulation);
+        benchmark::DoNotOptimize(content);
+    }
+    state.SetItemsProcessed(state.iterations() * SyntheticWorld::getNumCells(simulation.content));
+}
+BENCHMARK(BM_serializeSimulationToStrings)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
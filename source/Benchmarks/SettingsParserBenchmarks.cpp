@@ -0,0 +1,38 @@
+#include <sstream>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <benchmark/benchmark.h>
+
+#include "EngineInterface/Settings.h"
+#include "EngineInterface/SettingsParser.h"
+
+static void BM_encodeSettings(benchmark::State& state)
+{
+    Settings settings;
+    settings.generalSettings.worldSizeX = 1000;
+    settings.generalSettings.worldSizeY = 1000;
+    for (auto _ : state) {
+        auto tree = SettingsParser::encode(42, settings);
+        std::stringstream stream;
+        boost::property_tree::json_parser::write_json(stream, tree);
+        benchmark::DoNotOptimize(stream);
+    }
+}
+BENCHMARK(BM_encodeSettings);
+
+static void BM_decodeSettings(benchmark::State& state)
+{
+    Settings settings;
+    settings.generalSettings.worldSizeX = 1000;
+    settings.generalSettings.worldSizeY = 1000;
+    std::stringstream encodedStream;
+    boost::property_tree::json_parser::write_json(encodedStream, SettingsParser::encode(42, settings));
+    auto encoded = encodedStream.str();
+    for (auto _ : state) {
+        std::stringstream stream(encoded);
+        boost::property_tree::ptree tree;
+        boost::property_tree::json_parser::read_json(stream, tree);
+        benchmark::DoNotOptimize(SettingsParser::decodeTimestepAndSettings(tree));
+    }
+}
+BENCHMARK(BM_decodeSettings);
@@ -0,0 +1,107 @@
+#include <filesystem>
+
+#include <benchmark/benchmark.h>
+
+#include "EngineInterface/DecimatedPlotSeries.h"
+#include "EngineInterface/MonitorData.h"
+#include "EngineInterface/StatisticsExporter.h"
+#include "EngineInterface/StatisticsHistory.h"
+
+namespace
+{
+    MonitorData createMonitorData(uint64_t timestep)
+    {
+        MonitorData result;
+        result.timestep = timestep;
+        for (int i = 0; i < 7; ++i) {
+            result.numCellsByColor[i] = toInt(1000 + (timestep * (i + 1)) % 317);
+        }
+        result.numConnections = toInt(3000 + timestep % 1000);
+        result.numParticles = toInt(500 + timestep % 200);
+        result.numTokens = toInt(100 + timestep % 50);
+        return result;
+    }
+
+    StatisticsTable createTable(int numRows)
+    {
+        StatisticsTable result;
+        for (int row = 0; row < numRows; ++row) {
+            result.add(row * 10, toStatisticsSample(createMonitorData(row * 10)));
+        }
+        return result;
+    }
+
+    std::string getTempFilename(std::string const& extension)
+    {
+        return (std::filesystem::temp_directory_path() / ("alien_benchmark" + extension)).string();
+    }
+}
+
+static void BM_longtermStatisticsAdd(benchmark::State& state)
+{
+    LongtermStatistics statistics;
+    uint64_t timestep = 0;
+    for (auto _ : state) {
+        statistics.add(createMonitorData(++timestep));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_longtermStatisticsAdd);
+
+static void BM_liveStatisticsAdd(benchmark::State& state)
+{
+    LiveStatistics statistics;
+    uint64_t timestep = 0;
+    for (auto _ : state) {
+        statistics.add(createMonitorData(++timestep), 1.0f / 60);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_liveStatisticsAdd);
+
+//per-frame cost of the plot data for a sliding series with one new sample per frame
+static void BM_decimatedPlotSeriesUpdate(benchmark::State& state)
+{
+    auto capacity = static_cast<size_t>(state.range(0));
+    RingBuffer<float> xs(capacity);
+    RingBuffer<float> ys(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+        xs.add(toFloat(i));
+        ys.add(toFloat((i * 7919) % 1000));
+    }
+    DecimatedPlotSeries series;
+    auto sampleNumber = capacity;
+    for (auto _ : state) {
+        xs.add(toFloat(sampleNumber));
+        ys.add(toFloat((sampleNumber * 7919) % 1000));
+        ++sampleNumber;
+        series.update(xs, ys, 1000);
+        benchmark::DoNotOptimize(series.getYs());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_decimatedPlotSeriesUpdate)->Arg(10000)->Arg(1000000);
+
+static void BM_exportStatisticsCsv(benchmark::State& state)
+{
+    auto table = createTable(toInt(state.range(0)));
+    auto filename = getTempFilename(".csv");
+    for (auto _ : state) {
+        StatisticsExporter::writeCsv(filename, table);
+    }
+    state.SetItemsProcessed(state.iterations() * table.getNumRows());
+    std::filesystem::remove(filename);
+}
+BENCHMARK(BM_exportStatisticsCsv)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void BM_exportStatisticsColumnar(benchmark::State& state)
+{
+    auto table = createTable(toInt(state.range(0)));
+    auto filename = getTempFilename(StatisticsExporter::ColumnarFileExtension);
+    for (auto _ : state) {
+        StatisticsExporter::writeColumnar(filename, table);
+    }
+    state.SetItemsProcessed(state.iterations() * table.getNumRows());
+    std::filesystem::remove(filename);
+}
+BENCHMARK(BM_exportStatisticsColumnar)->Arg(100000)->Unit(benchmark::kMillisecond);
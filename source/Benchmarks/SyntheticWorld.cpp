@@ -0,0 +1,126 @@
+#include "SyntheticWorld.h"
+
+#include <cmath>
+#include <random>
+#include <unordered_map>
+
+#include "Base/NumberGenerator.h"
+#include "EngineGpuKernels/AccessTOs.cuh"
+#include "EngineInterface/DescriptionHelper.h"
+#include "EngineInterface/SymbolMap.h"
+
+namespace
+{
+    auto constexpr AreaPerCell = 10.0f;
+    auto constexpr MinWorldSize = 100;
+}
+
+double SyntheticWorld::_scale = 1.0;
+
+DeserializedSimulation SyntheticWorld::create(Parameters const& parameters)
+{
+    NumberGenerator::getInstance().setSeed(parameters._seed);
+    std::mt19937 randomEngine(parameters._seed);
+
+    DeserializedSimulation result;
+    result.timestep = 0;
+    result.symbolMap = SymbolMapHelper::getDefaultSymbolMap();
+
+    auto worldSize = getWorldSize(parameters._numCells);
+    auto& generalSettings = result.settings.generalSettings;
+    generalSettings.worldSizeX = worldSize;
+    generalSettings.worldSizeY = worldSize;
+    generalSettings.useSeed = true;
+    generalSettings.seed = parameters._seed;
+    auto const& simulationParameters = result.settings.simulationParameters;
+
+    //all clusters are copies of one template with new ids, the clusters are placed on a grid
+    auto clusterTemplate = DescriptionHelper::createRect(
+        DescriptionHelper::CreateRectParameters().width(parameters._clusterSize).height(parameters._clusterSize));
+    auto numCellsPerCluster = toInt(clusterTemplate.cells.size());
+    auto numClusters = (parameters._numCells + numCellsPerCluster - 1) / numCellsPerCluster;
+    auto clusterDistance = toFloat(parameters._clusterSize) * 2;
+    auto numClustersPerRow = std::max(1, toInt(toFloat(worldSize) / clusterDistance));
+
+    std::uniform_int_distribution<int> byteDistribution(0, 255);
+    std::uniform_real_distribution<float> unitDistribution(0.0f, 1.0f);
+    auto createBytes = [&](int size) {
+        std::string result(size, 0);
+        for (auto& byte : result) {
+            byte = static_cast<char>(byteDistribution(randomEngine));
+        }
+        return result;
+    };
+
+    std::unordered_map<uint64_t, uint64_t> newIdByTemplateId;
+    for (int clusterIndex = 0; clusterIndex < numClusters; ++clusterIndex) {
+        RealVector2D offset{
+            toFloat(clusterIndex % numClustersPerRow) * clusterDistance + clusterDistance / 2,
+            toFloat(clusterIndex / numClustersPerRow) * clusterDistance + clusterDistance / 2};
+        for (auto const& cell : clusterTemplate.cells) {
+            newIdByTemplateId[cell.id] = NumberGenerator::getInstance().getId();
+        }
+
+        ClusterDescription cluster;
+        cluster.setId(NumberGenerator::getInstance().getId());
+        cluster.cells.reserve(numCellsPerCluster);
+        for (int cellIndex = 0; cellIndex < numCellsPerCluster; ++cellIndex) {
+            auto cell = clusterTemplate.cells[cellIndex];
+            cell.id = newIdByTemplateId.at(cell.id);
+            for (auto& connection : cell.connections) {
+                connection.cellId = newIdByTemplateId.at(connection.cellId);
+            }
+            cell.pos = cell.pos + offset;
+            cell.vel = {0, 0};
+            cell.tokenBlocked = false;
+            cell.tokenBranchNumber = cellIndex % simulationParameters.cellMaxTokenBranchNumber;
+            cell.cellFunctionInvocations = 0;
+            cell.age = 0;
+            cell.cellFeature = CellFeatureDescription()
+                                   .setType(Enums::CellFunction_Computation)
+                                   .setConstData(createBytes(MAX_CELL_STATIC_BYTES))
+                                   .setVolatileData(createBytes(MAX_CELL_MUTABLE_BYTES));
+            if (unitDistribution(randomEngine) < parameters._tokensPerCell) {
+                cell.addToken(TokenDescription().setEnergy(60).setData(createBytes(simulationParameters.tokenMemorySize)));
+            }
+            cluster.cells.emplace_back(cell);
+        }
+        result.content.addCluster(cluster);
+    }
+
+    std::uniform_real_distribution<float> posDistribution(0.0f, toFloat(worldSize));
+    std::uniform_real_distribution<float> velDistribution(-0.5f, 0.5f);
+    auto numParticles = toInt(toFloat(parameters._numCells) * parameters._particlesPerCell);
+    for (int i = 0; i < numParticles; ++i) {
+        result.content.addParticle(ParticleDescription()
+                                       .setId(NumberGenerator::getInstance().getId())
+                                       .setPos({posDistribution(randomEngine), posDistribution(randomEngine)})
+                                       .setVel({velDistribution(randomEngine), velDistribution(randomEngine)})
+                                       .setEnergy(10.0));
+    }
+    return result;
+}
+
+int SyntheticWorld::getNumCells(ClusteredDataDescription const& content)
+{
+    int result = 0;
+    for (auto const& cluster : content.clusters) {
+        result += toInt(cluster.cells.size());
+    }
+    return result;
+}
+
+int SyntheticWorld::getWorldSize(int numEntities)
+{
+    return std::max(MinWorldSize, toInt(std::ceil(std::sqrt(toFloat(numEntities) * AreaPerCell))));
+}
+
+void SyntheticWorld::setScale(double value)
+{
+    _scale = value;
+}
+
+int SyntheticWorld::getScaled(int64_t number)
+{
+    return std::max(1, toInt(static_cast<double>(number) * _scale));
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Base/Definitions.h"
+#include "EngineInterface/Serializer.h"
+
+//reproducible simulations for benchmarks: square clusters of connected cells carrying tokens and cell function data,
+//and free particles in a world whose area grows with the number of cells
+class SyntheticWorld
+{
+public:
+    struct Parameters
+    {
+        MEMBER_DECLARATION(Parameters, int, numCells, 10000);  //rounded up to full clusters
+        MEMBER_DECLARATION(Parameters, int, clusterSize, 10);  //width and height of a cluster in cells
+        MEMBER_DECLARATION(Parameters, float, particlesPerCell, 0.2f);
+        MEMBER_DECLARATION(Parameters, float, tokensPerCell, 0.1f);
+        MEMBER_DECLARATION(Parameters, uint32_t, seed, 0);
+    };
+    static DeserializedSimulation create(Parameters const& parameters);
+
+    static int getNumCells(ClusteredDataDescription const& content);
+
+    //width and height of a square world for the given number of entities with the density of the synthetic worlds
+    static int getWorldSize(int numEntities);
+
+    //factor for all entity numbers requested by the benchmarks, set by the command line option --world_scale=<factor>
+    static void setScale(double value);
+    static int getScaled(int64_t number);
+
+private:
+    static double _scale;
+};
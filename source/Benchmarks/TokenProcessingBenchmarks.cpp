@@ -0,0 +1,239 @@
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "Base/Definitions.h"
+#include "Base/ParallelAlgorithms.h"
+#include "EngineGpuKernels/ConstructionPriority.cuh"
+#include "EngineGpuKernels/HostConstructionReservations.cuh"
+#include "EngineInterface/Enums.h"
+#include "EngineInterface/SimulationParameters.h"
+
+#include "SyntheticWorld.h"
+
+//token processing of replicator colonies on the host: the batches of TokenFunctionBins and the construction rounds of
+//HostConstructionReservations against their predecessors; the warp divergence avoided by the batches on the GPU is not
+//reproduced on the host, only the dispatch per token
+namespace
+{
+    //cell functions under tokens in a replicator colony: mostly computation and constructor cells
+    std::vector<Enums::CellFunction> createCellFunctionTypes(int numTokens)
+    {
+        std::discrete_distribution<int> distribution({50, 0, 5, 5, 25, 5, 10});
+        std::mt19937 randomEngine(0);
+        std::vector<Enums::CellFunction> result(numTokens);
+        for (auto& cellFunctionType : result) {
+            cellFunctionType = distribution(randomEngine);
+        }
+        return result;
+    }
+
+    //stand-in for the cell functions with different work on the token memory
+    template <Enums::CellFunction cellFunctionType>
+    void executeCellFunction(unsigned char* memory, int memorySize)
+    {
+        if constexpr (Enums::CellFunction_Computation == cellFunctionType) {
+            for (int i = 1; i < memorySize; ++i) {
+                memory[i] = static_cast<unsigned char>(memory[i] ^ (memory[i - 1] + 1));
+            }
+        } else if constexpr (Enums::CellFunction_Constructor == cellFunctionType) {
+            for (int i = 0; i < 16; ++i) {
+                memory[i] = static_cast<unsigned char>(memory[i] + memory[i + 16]);
+            }
+        } else {
+            memory[0] = static_cast<unsigned char>(memory[0] + cellFunctionType);
+        }
+    }
+
+    void executeCellFunction(Enums::CellFunction cellFunctionType, unsigned char* memory, int memorySize)
+    {
+        switch (cellFunctionType) {
+        case Enums::CellFunction_Computation:
+            return executeCellFunction<Enums::CellFunction_Computation>(memory, memorySize);
+        case Enums::CellFunction_NeuralNet:
+            return executeCellFunction<Enums::CellFunction_NeuralNet>(memory, memorySize);
+        case Enums::CellFunction_Scanner:
+            return executeCellFunction<Enums::CellFunction_Scanner>(memory, memorySize);
+        case Enums::CellFunction_Digestion:
+            return executeCellFunction<Enums::CellFunction_Digestion>(memory, memorySize);
+        case Enums::CellFunction_Constructor:
+            return executeCellFunction<Enums::CellFunction_Constructor>(memory, memorySize);
+        case Enums::CellFunction_Sensor:
+            return executeCellFunction<Enums::CellFunction_Sensor>(memory, memorySize);
+        case Enums::CellFunction_Muscle:
+            return executeCellFunction<Enums::CellFunction_Muscle>(memory, memorySize);
+        }
+    }
+
+    template <int cellFunctionType = 0>
+    void executeBin(int cellFunction, std::vector<int> const& tokenIndices, unsigned char* memory, int memorySize)
+    {
+        if constexpr (cellFunctionType < Enums::CellFunction_Count) {
+            if (cellFunction != cellFunctionType) {
+                return executeBin<cellFunctionType + 1>(cellFunction, tokenIndices, memory, memorySize);
+            }
+            for (auto const& index : tokenIndices) {
+                executeCellFunction<cellFunctionType>(&memory[static_cast<size_t>(index) * memorySize], memorySize);
+            }
+        }
+    }
+
+    //request of a constructor in a colony on a ring: it modifies its own cell and the neighboring cells
+    HostConstructionRequest createRingRequest(int index, int numConstructors)
+    {
+        return HostConstructionRequest{
+            calcConstructionPriority(index + 1), {(index + numConstructors - 1) % numConstructors, index, (index + 1) % numConstructors}};
+    }
+}
+
+//tokens in the order of the token array, the cell function is dispatched per token
+static void BM_replicatorTokens_unbinned(benchmark::State& state)
+{
+    auto numTokens = SyntheticWorld::getScaled(state.range(0));
+    auto memorySize = SimulationParameters().tokenMemorySize;
+    auto cellFunctionTypes = createCellFunctionTypes(numTokens);
+    std::vector<unsigned char> memory(static_cast<size_t>(numTokens) * memorySize, 1);
+    for (auto _ : state) {
+        for (int index = 0; index < numTokens; ++index) {
+            executeCellFunction(cellFunctionTypes[index], &memory[static_cast<size_t>(index) * memorySize], memorySize);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * numTokens);
+}
+BENCHMARK(BM_replicatorTokens_unbinned)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+//same tokens as BM_replicatorTokens_unbinned: counted, scattered into bins per cell function as in TokenFunctionBins and
+//executed as one batch per cell function; binning is included in the measurement
+static void BM_replicatorTokens_binned(benchmark::State& state)
+{
+    auto numTokens = SyntheticWorld::getScaled(state.range(0));
+    auto memorySize = SimulationParameters().tokenMemorySize;
+    auto cellFunctionTypes = createCellFunctionTypes(numTokens);
+    std::vector<unsigned char> memory(static_cast<size_t>(numTokens) * memorySize, 1);
+    std::vector<std::vector<int>> bins(Enums::CellFunction_Count);
+    for (auto _ : state) {
+        std::vector<int> binCounts(Enums::CellFunction_Count, 0);
+        for (auto const& cellFunctionType : cellFunctionTypes) {
+            ++binCounts[cellFunctionType];
+        }
+        for (int i = 0; i < Enums::CellFunction_Count; ++i) {
+            bins[i].clear();
+            bins[i].reserve(binCounts[i]);
+        }
+        for (int index = 0; index < numTokens; ++index) {
+            bins[cellFunctionTypes[index]].emplace_back(index);
+        }
+        for (int i = 0; i < Enums::CellFunction_Count; ++i) {
+            executeBin(i, bins[i], memory.data(), memorySize);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * numTokens);
+    for (int i = 0; i < Enums::CellFunction_Count; ++i) {
+        state.counters["bin" + std::to_string(i)] = static_cast<double>(bins[i].size());
+    }
+}
+BENCHMARK(BM_replicatorTokens_binned)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+//all constructions of a colony on a ring in reservation rounds, adjacent constructions conflict
+static void BM_constructionRounds(benchmark::State& state)
+{
+    auto numConstructors = SyntheticWorld::getScaled(state.range(0));
+    HostConstructionReservations reservations;
+    std::vector<int> cellValues(numConstructors, 0);
+    int numRounds = 0;
+    for (auto _ : state) {
+        numRounds = reservations.executeConstructions(
+            numConstructors,
+            [&](int index) { return createRingRequest(index, numConstructors); },
+            [&](int index) {
+                for (auto const& cellIndex : createRingRequest(index, numConstructors).cellIndices) {
+                    ++cellValues[cellIndex];
+                }
+            });
+    }
+    state.SetItemsProcessed(state.iterations() * numConstructors);
+    state.counters["rounds"] = numRounds;
+}
+BENCHMARK(BM_constructionRounds)->Arg(10000)->Arg(100000)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+//reference for BM_constructionRounds with the former scheme: each construction try-locks the cells of its site and
+//fails on contention, failed constructions are retried in the next time step (pass); the locks are held until all
+//constructions of a pass have tried to lock as the GPU threads run concurrently
+static void BM_constructionLocking(benchmark::State& state)
+{
+    auto numConstructors = SyntheticWorld::getScaled(state.range(0));
+    auto locks = std::make_unique<std::atomic<int>[]>(numConstructors);
+    for (int i = 0; i < numConstructors; ++i) {
+        locks[i] = 0;
+    }
+    std::vector<int> cellValues(numConstructors, 0);
+    int numPasses = 0;
+    for (auto _ : state) {
+        std::vector<int> pendingIndices(numConstructors);
+        for (int i = 0; i < numConstructors; ++i) {
+            pendingIndices[i] = i;
+        }
+        std::vector<HostConstructionRequest> requests;
+        std::vector<char> locked;
+        numPasses = 0;
+        while (!pendingIndices.empty()) {
+            auto numPending = toInt(pendingIndices.size());
+            requests.resize(numPending);
+            locked.assign(numPending, 0);
+            ParallelAlgorithms::parallelFor(
+                0,
+                numPending,
+                [&](int index) {
+                    auto& request = requests[index];
+                    request = createRingRequest(pendingIndices[index], numConstructors);
+                    auto numLocked = 0;
+                    for (auto const& cellIndex : request.cellIndices) {
+                        auto expected = 0;
+                        if (!locks[cellIndex].compare_exchange_strong(expected, 1)) {
+                            break;
+                        }
+                        ++numLocked;
+                    }
+                    if (numLocked == toInt(request.cellIndices.size())) {
+                        locked[index] = 1;
+                        return;
+                    }
+                    for (int i = 0; i < numLocked; ++i) {
+                        locks[request.cellIndices[i]] = 0;
+                    }
+                },
+                1024);
+            ParallelAlgorithms::parallelFor(
+                0,
+                numPending,
+                [&](int index) {
+                    if (!locked[index]) {
+                        return;
+                    }
+                    for (auto const& cellIndex : requests[index].cellIndices) {
+                        ++cellValues[cellIndex];
+                        locks[cellIndex] = 0;
+                    }
+                },
+                1024);
+
+            int numRemaining = 0;
+            for (int index = 0; index < numPending; ++index) {
+                if (!locked[index]) {
+                    pendingIndices[numRemaining++] = pendingIndices[index];
+                }
+            }
+            pendingIndices.resize(numRemaining);
+            ++numPasses;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numConstructors);
+    state.counters["rounds"] = numPasses;
+}
+BENCHMARK(BM_constructionLocking)->Arg(10000)->Arg(100000)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -5,6 +5,7 @@
 
 #define MAX_STRING_BYTES 50000000
 #define MAX_TOKEN_MEM_SIZE 256
+#define MIN_TOKEN_MEM_STRIDE 128  //fixed input/output addresses of cell functions (neural nets up to 126) must always be backed by memory
 #define MAX_CELL_BONDS 6
 #define MAX_CELL_STATIC_BYTES 48
 #define MAX_CELL_MUTABLE_BYTES 16
@@ -12,7 +13,7 @@
 struct TokenAccessTO
 {
 	float energy;
-	char memory[MAX_TOKEN_MEM_SIZE];
+	int memoryIndex;  //tokenMemorySize bytes in DataAccessTO::tokenMemory
 	int cellIndex;
 
 	//only for temporary use
@@ -90,6 +91,8 @@ struct DataAccessTO
 	TokenAccessTO* tokens = nullptr;
     int* numStringBytes = nullptr;
     char* stringBytes = nullptr;
+    int* numTokenMemoryBytes = nullptr;
+    char* tokenMemory = nullptr;
 
 	bool operator==(DataAccessTO const& other) const
 	{
@@ -100,7 +103,9 @@ struct DataAccessTO
 			&& numTokens == other.numTokens
 			&& tokens == other.tokens
             && numStringBytes == other.numStringBytes
-            && stringBytes == other.stringBytes;
+            && stringBytes == other.stringBytes
+            && numTokenMemoryBytes == other.numTokenMemoryBytes
+            && tokenMemory == other.tokenMemory;
 	}
 };
 
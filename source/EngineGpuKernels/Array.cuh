@@ -207,6 +207,11 @@ public:
         *_numOrigEntries = 0;
     }
     __device__ __inline__ int getSize() const { return *_size; }
+    __device__ __inline__ void reset() const
+    {
+        *_numEntries = 0;
+        *_numOrigEntries = 0;
+    }
     __device__ __inline__ int saveNumEntries() const { return *_numOrigEntries = *_numEntries; }
     __device__ __inline__ int getNumEntries() const { return *_numEntries; }
     __device__ __inline__ int getNumOrigEntries() const { return *_numOrigEntries; }
@@ -6,6 +6,7 @@
 #include <device_launch_parameters.h>
 #include <cuda/helper_cuda.h>
 
+#include "Base/Philox.h"
 #include "EngineInterface/GpuSettings.h"
 
 #include "Array.cuh"
@@ -40,56 +41,79 @@ struct PartitionData
     __inline__ __device__ int numElements() const { return endIndex - startIndex + 1; }
 };
 
+//distinguishes independent random draws for the same entity in the same time step
+namespace RandomCallSite
+{
+    enum Type : uint32_t
+    {
+        CellMutationPreselection,
+        CellMutation,
+        CellMutationAddress,
+        CellMutationValue,
+        CellMaxForceDecay,
+        CellInvocationDecay,
+        Radiation,
+        RadiationVelX,
+        RadiationVelY,
+        RadiationEnergy,
+        DigestionVelX,
+        DigestionVelY,
+        TokenMutation,
+        TokenMutationAddress,
+        TokenMutationValue,
+        RandomCellMaxConnections,
+        RandomCellBranchNumber,
+        RandomCellFunction,
+        RandomCellStaticData,
+        RandomCellMutableData,
+    };
+}
+
+//counter-based random numbers: a draw only depends on seed, time step, entity and call site, hence it needs no shared
+//state and is independent of the thread scheduling and the number of threads
 class CudaNumberGenerator
 {
 private:
-    unsigned int* _currentIndex;
-    int* _array;
-    int _size;
-
     unsigned long long int* _currentId;
 
+    uint32_t _seed = 0;
+    uint64_t _timestep = 0;
+
 public:
-    void init(int size)
+    void init(uint32_t seed)
     {
-        _size = size;
+        _seed = seed;
 
-        CudaMemoryManager::getInstance().acquireMemory<unsigned int>(1, _currentIndex);
-        CudaMemoryManager::getInstance().acquireMemory<int>(size, _array);
         CudaMemoryManager::getInstance().acquireMemory<unsigned long long int>(1, _currentId);
 
-        CHECK_FOR_CUDA_ERROR(cudaMemset(_currentIndex, 0, sizeof(unsigned int)));
         unsigned long long int hostCurrentId = 1;
         CHECK_FOR_CUDA_ERROR(cudaMemcpy(_currentId, &hostCurrentId, sizeof(_currentId), cudaMemcpyHostToDevice));
-
-        std::vector<int> randomNumbers(size);
-        for (int i = 0; i < size; ++i) {
-            randomNumbers[i] = rand();
-        }
-        CHECK_FOR_CUDA_ERROR(cudaMemcpy(_array, randomNumbers.data(), sizeof(int) * size, cudaMemcpyHostToDevice));
     }
 
-
-    __device__ __inline__ int random(int maxVal)
+    //in [0, 1)
+    __device__ __inline__ float random(uint64_t entityId, RandomCallSite::Type callSite)
     {
-        int number = getRandomNumber();
-        return number % (maxVal + 1);
+        return Philox::generateFloat(_seed, _timestep, entityId, callSite);
     }
 
-    __device__ __inline__ float random(float maxVal)
+    //in [0, maxVal], drawIndex distinguishes several draws at the same call site, e.g. in a loop
+    __device__ __inline__ int random(int maxVal, uint64_t entityId, RandomCallSite::Type callSite, uint32_t drawIndex = 0)
     {
-        int number = getRandomNumber();
-        return maxVal * static_cast<float>(number) / RAND_MAX;
+        return Philox::generate(_seed, _timestep, entityId, callSite | (drawIndex << 8)) % (maxVal + 1);
     }
 
-    __device__ __inline__ float random()
-    {
-        int number = getRandomNumber();
-        return static_cast<float>(number) / RAND_MAX;
-    }
+    void setTimestep(uint64_t timestep) { _timestep = timestep; }
 
     __device__ __inline__ unsigned long long int createNewId_kernel() { return atomicAdd(_currentId, 1); }
 
+    //id derived from the ids of the entities the new entity originates from, unlike createNewId_kernel it does not
+    //depend on the order in which the threads create entities
+    __device__ __inline__ uint64_t createDerivedId(uint64_t parentId, uint64_t otherId)
+    {
+        auto block = Philox::generate(parentId, _timestep, otherId ^ _seed);
+        return (static_cast<uint64_t>(block.values[1]) << 32) | block.values[0];
+    }
+
     __device__ __inline__ void adaptMaxId(unsigned long long int id)
     {
         atomicMax(_currentId, id + 1);
@@ -97,17 +121,8 @@ public:
 
     void free()
     {
-        CudaMemoryManager::getInstance().freeMemory(_currentIndex);
-        CudaMemoryManager::getInstance().freeMemory(_array);
         CudaMemoryManager::getInstance().freeMemory(_currentId);
     }
-
-private:
-    __device__ __inline__ int getRandomNumber()
-    {
-        int index = atomicInc(_currentIndex, _size - 1);
-        return _array[index];
-    }
 };
 
 __device__ __inline__ PartitionData calcPartition(int numEntities, int division, int numDivisions)
@@ -130,6 +145,38 @@ __device__ __inline__ PartitionData calcAllThreadsPartition(int numEntities)
         numEntities, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
 }
 
+//exclusive prefix sum of values written to result (with numValues + 1 elements), needs to be executed by a single block
+__device__ __inline__ void exclusiveScan_block(int const* values, int* result, int numValues)
+{
+    __shared__ int threadSums[1024];
+    auto const partition = calcPartition(numValues, threadIdx.x, blockDim.x);
+
+    int sum = 0;
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        sum += values[index];
+    }
+    threadSums[threadIdx.x] = sum;
+    __syncthreads();
+
+    if (0 == threadIdx.x) {
+        int offset = 0;
+        for (int i = 0; i < blockDim.x; ++i) {
+            auto threadSum = threadSums[i];
+            threadSums[i] = offset;
+            offset += threadSum;
+        }
+        result[numValues] = offset;
+    }
+    __syncthreads();
+
+    auto offset = threadSums[threadIdx.x];
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        result[index] = offset;
+        offset += values[index];
+    }
+    __syncthreads();
+}
+
 __host__ __device__ __inline__ int2 toInt2(float2 const& p)
 {
     return {static_cast<int>(p.x), static_cast<int>(p.y)};
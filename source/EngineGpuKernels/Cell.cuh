@@ -59,6 +59,9 @@ struct Cell
     float2 temp1;
     float2 temp2;
     float2 temp3;
+    unsigned long long constructionPriority;  //see ConstructionReservations
+    int constructionTokenIndex;
+    int neighborListIndex;  //see NeighborList, -1 = not contained
 
     //cluster data
     int clusterIndex;
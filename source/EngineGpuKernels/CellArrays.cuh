@@ -0,0 +1,279 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <cuda_runtime.h>
+
+#include "AccessTOs.cuh"
+
+//connection referencing the other cell by index instead of pointer so that it is valid in every layout
+struct CellIndexConnection
+{
+    int cellIndex;
+    float distance;
+    float angleFromPrevious;
+};
+
+//structure-of-arrays layout of the cell data: hot physics data, connections, cell function data and cold data
+//are kept in separate arrays such that a physics pass only touches the cache lines it actually needs
+struct CellArrays
+{
+    int numCells = 0;
+
+    //hot physics data
+    float2* absPos = nullptr;
+    float2* vel = nullptr;
+    float2* temp1 = nullptr;
+    float2* temp2 = nullptr;
+    float* energy = nullptr;
+    int* locked = nullptr;
+    bool* barrier = nullptr;
+
+    //connections
+    int* maxConnections = nullptr;
+    int* numConnections = nullptr;
+    CellIndexConnection* connections = nullptr;  //MAX_CELL_BONDS entries per cell
+
+    //cell function data
+    int* cellFunctionType = nullptr;
+    unsigned char* numStaticBytes = nullptr;
+    char* staticData = nullptr;  //MAX_CELL_STATIC_BYTES entries per cell
+    unsigned char* numMutableBytes = nullptr;
+    char* mutableData = nullptr;  //MAX_CELL_MUTABLE_BYTES entries per cell
+    int* cellFunctionInvocations = nullptr;
+
+    //cold data
+    uint64_t* id = nullptr;
+    int* branchNumber = nullptr;
+    bool* tokenBlocked = nullptr;
+    int* age = nullptr;
+    int* selected = nullptr;
+    CellMetadataAccessTO* metadata = nullptr;
+};
+
+//accessor for one cell in CellArrays, processor code should only use this type instead of the arrays
+class CellHandle
+{
+public:
+    __host__ __device__ __inline__ CellHandle(CellArrays const& arrays, int index)
+        : _arrays(&arrays)
+        , _index(index)
+    {}
+
+    __host__ __device__ __inline__ int getIndex() const { return _index; }
+
+    __host__ __device__ __inline__ float2& absPos() const { return _arrays->absPos[_index]; }
+    __host__ __device__ __inline__ float2& vel() const { return _arrays->vel[_index]; }
+    __host__ __device__ __inline__ float2& temp1() const { return _arrays->temp1[_index]; }
+    __host__ __device__ __inline__ float2& temp2() const { return _arrays->temp2[_index]; }
+    __host__ __device__ __inline__ float& energy() const { return _arrays->energy[_index]; }
+    __host__ __device__ __inline__ int& locked() const { return _arrays->locked[_index]; }
+    __host__ __device__ __inline__ bool& barrier() const { return _arrays->barrier[_index]; }
+
+    __host__ __device__ __inline__ int& maxConnections() const { return _arrays->maxConnections[_index]; }
+    __host__ __device__ __inline__ int& numConnections() const { return _arrays->numConnections[_index]; }
+    __host__ __device__ __inline__ CellIndexConnection& connection(int i) const
+    {
+        return _arrays->connections[_index * MAX_CELL_BONDS + i];
+    }
+
+    __host__ __device__ __inline__ int& cellFunctionType() const { return _arrays->cellFunctionType[_index]; }
+    __host__ __device__ __inline__ unsigned char& numStaticBytes() const { return _arrays->numStaticBytes[_index]; }
+    __host__ __device__ __inline__ char* staticData() const { return &_arrays->staticData[_index * MAX_CELL_STATIC_BYTES]; }
+    __host__ __device__ __inline__ unsigned char& numMutableBytes() const { return _arrays->numMutableBytes[_index]; }
+    __host__ __device__ __inline__ char* mutableData() const { return &_arrays->mutableData[_index * MAX_CELL_MUTABLE_BYTES]; }
+
+    __host__ __device__ __inline__ uint64_t& id() const { return _arrays->id[_index]; }
+    __host__ __device__ __inline__ int& branchNumber() const { return _arrays->branchNumber[_index]; }
+    __host__ __device__ __inline__ int& age() const { return _arrays->age[_index]; }
+    __host__ __device__ __inline__ CellMetadataAccessTO& metadata() const { return _arrays->metadata[_index]; }
+
+private:
+    CellArrays const* _arrays;
+    int _index;
+};
+
+//array-of-structures counterpart with the field order of Cell, used as reference for the layout comparison
+struct CellRecord
+{
+    uint64_t id;
+    float2 absPos;
+    float2 vel;
+
+    int branchNumber;
+    bool tokenBlocked;
+    int maxConnections;
+    int numConnections;
+    CellIndexConnection connections[MAX_CELL_BONDS];
+    unsigned char numStaticBytes;
+    char staticData[MAX_CELL_STATIC_BYTES];
+    unsigned char numMutableBytes;
+    char mutableData[MAX_CELL_MUTABLE_BYTES];
+    int cellFunctionInvocations;
+    CellMetadataAccessTO metadata;
+    float energy;
+    int cellFunctionType;
+    bool barrier;
+    int age;
+
+    int selected;
+
+    int locked;
+    int tag;
+    float2 temp1;
+    float2 temp2;
+    float2 temp3;
+
+    int clusterIndex;
+    int clusterBoundaries;
+    float2 clusterPos;
+    float2 clusterVel;
+    float clusterAngularMomentum;
+    float clusterAngularMass;
+    int numCellsInCluster;
+};
+
+class CellRecordHandle
+{
+public:
+    __host__ __device__ __inline__ CellRecordHandle(CellRecord* records, int index)
+        : _record(&records[index])
+        , _index(index)
+    {}
+
+    __host__ __device__ __inline__ int getIndex() const { return _index; }
+
+    __host__ __device__ __inline__ float2& absPos() const { return _record->absPos; }
+    __host__ __device__ __inline__ float2& vel() const { return _record->vel; }
+    __host__ __device__ __inline__ float2& temp1() const { return _record->temp1; }
+    __host__ __device__ __inline__ float2& temp2() const { return _record->temp2; }
+    __host__ __device__ __inline__ float& energy() const { return _record->energy; }
+    __host__ __device__ __inline__ int& locked() const { return _record->locked; }
+    __host__ __device__ __inline__ bool& barrier() const { return _record->barrier; }
+
+    __host__ __device__ __inline__ int& maxConnections() const { return _record->maxConnections; }
+    __host__ __device__ __inline__ int& numConnections() const { return _record->numConnections; }
+    __host__ __device__ __inline__ CellIndexConnection& connection(int i) const { return _record->connections[i]; }
+
+    __host__ __device__ __inline__ int& cellFunctionType() const { return _record->cellFunctionType; }
+    __host__ __device__ __inline__ unsigned char& numStaticBytes() const { return _record->numStaticBytes; }
+    __host__ __device__ __inline__ char* staticData() const { return _record->staticData; }
+    __host__ __device__ __inline__ unsigned char& numMutableBytes() const { return _record->numMutableBytes; }
+    __host__ __device__ __inline__ char* mutableData() const { return _record->mutableData; }
+
+    __host__ __device__ __inline__ uint64_t& id() const { return _record->id; }
+    __host__ __device__ __inline__ int& branchNumber() const { return _record->branchNumber; }
+    __host__ __device__ __inline__ int& age() const { return _record->age; }
+    __host__ __device__ __inline__ CellMetadataAccessTO& metadata() const { return _record->metadata; }
+
+private:
+    CellRecord* _record;
+    int _index;
+};
+
+//host storage for both layouts
+class HostCellArrays
+{
+public:
+    using Handle = CellHandle;
+
+    HostCellArrays(int numCells)
+    {
+        _absPos.resize(numCells);
+        _vel.resize(numCells);
+        _temp1.resize(numCells);
+        _temp2.resize(numCells);
+        _energy.resize(numCells);
+        _locked.resize(numCells);
+        _barrier = std::make_unique<bool[]>(numCells);
+        _maxConnections.resize(numCells);
+        _numConnections.resize(numCells);
+        _connections.resize(numCells * MAX_CELL_BONDS);
+        _cellFunctionType.resize(numCells);
+        _numStaticBytes.resize(numCells);
+        _staticData.resize(numCells * MAX_CELL_STATIC_BYTES);
+        _numMutableBytes.resize(numCells);
+        _mutableData.resize(numCells * MAX_CELL_MUTABLE_BYTES);
+        _cellFunctionInvocations.resize(numCells);
+        _id.resize(numCells);
+        _branchNumber.resize(numCells);
+        _tokenBlocked = std::make_unique<bool[]>(numCells);
+        _age.resize(numCells);
+        _selected.resize(numCells);
+        _metadata.resize(numCells);
+
+        _arrays.numCells = numCells;
+        _arrays.absPos = _absPos.data();
+        _arrays.vel = _vel.data();
+        _arrays.temp1 = _temp1.data();
+        _arrays.temp2 = _temp2.data();
+        _arrays.energy = _energy.data();
+        _arrays.locked = _locked.data();
+        _arrays.barrier = _barrier.get();
+        _arrays.maxConnections = _maxConnections.data();
+        _arrays.numConnections = _numConnections.data();
+        _arrays.connections = _connections.data();
+        _arrays.cellFunctionType = _cellFunctionType.data();
+        _arrays.numStaticBytes = _numStaticBytes.data();
+        _arrays.staticData = _staticData.data();
+        _arrays.numMutableBytes = _numMutableBytes.data();
+        _arrays.mutableData = _mutableData.data();
+        _arrays.cellFunctionInvocations = _cellFunctionInvocations.data();
+        _arrays.id = _id.data();
+        _arrays.branchNumber = _branchNumber.data();
+        _arrays.tokenBlocked = _tokenBlocked.get();
+        _arrays.age = _age.data();
+        _arrays.selected = _selected.data();
+        _arrays.metadata = _metadata.data();
+    }
+    HostCellArrays(HostCellArrays const&) = delete;
+    HostCellArrays& operator=(HostCellArrays const&) = delete;
+
+    int getNumCells() const { return _arrays.numCells; }
+    CellHandle getHandle(int index) { return CellHandle(_arrays, index); }
+    CellArrays const& getArrays() const { return _arrays; }
+
+private:
+    CellArrays _arrays;
+
+    std::vector<float2> _absPos;
+    std::vector<float2> _vel;
+    std::vector<float2> _temp1;
+    std::vector<float2> _temp2;
+    std::vector<float> _energy;
+    std::vector<int> _locked;
+    std::unique_ptr<bool[]> _barrier;
+    std::vector<int> _maxConnections;
+    std::vector<int> _numConnections;
+    std::vector<CellIndexConnection> _connections;
+    std::vector<int> _cellFunctionType;
+    std::vector<unsigned char> _numStaticBytes;
+    std::vector<char> _staticData;
+    std::vector<unsigned char> _numMutableBytes;
+    std::vector<char> _mutableData;
+    std::vector<int> _cellFunctionInvocations;
+    std::vector<uint64_t> _id;
+    std::vector<int> _branchNumber;
+    std::unique_ptr<bool[]> _tokenBlocked;
+    std::vector<int> _age;
+    std::vector<int> _selected;
+    std::vector<CellMetadataAccessTO> _metadata;
+};
+
+class HostCellRecords
+{
+public:
+    using Handle = CellRecordHandle;
+
+    HostCellRecords(int numCells)
+        : _records(numCells)
+    {}
+
+    int getNumCells() const { return static_cast<int>(_records.size()); }
+    CellRecordHandle getHandle(int index) { return CellRecordHandle(_records.data(), index); }
+
+private:
+    std::vector<CellRecord> _records;
+};
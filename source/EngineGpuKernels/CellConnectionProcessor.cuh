@@ -15,8 +15,12 @@ public:
     __inline__ __device__ static void scheduleDelCell(SimulationData& data, Cell* cell, int cellIndex);
     __inline__ __device__ static void scheduleDelCellAndConnections(SimulationData& data, Cell* cell, int cellIndex);
 
-    __inline__ __device__ static void processConnectionsOperations(SimulationData& data);
-    __inline__ __device__ static void processDelCellOperations(SimulationData& data);
+    //lock-free processing of the scheduled operations in three passes (each pass executed by all threads):
+    //operations are split into per-cell entries which are sorted into segments by StructuralOperationBuckets in between,
+    //then each segment owner applies deletions and grants connections and finally establishes connections granted by both cells
+    __inline__ __device__ static void splitOperations(SimulationData& data);
+    __inline__ __device__ static void applyDeletionsAndGrantConnections(SimulationData& data);
+    __inline__ __device__ static void applyConnectionsAndCellDeletions(SimulationData& data);
 
     __inline__ __device__ static void addConnections(
         SimulationData& data,
@@ -30,7 +34,34 @@ public:
     __inline__ __device__ static void delConnectionOneWay(Cell* cell1, Cell* cell2);
 
 private:
-    __inline__ __device__ static void addConnectionsIntern(SimulationData& data, Cell* cell1, Cell* cell2, bool addTokens);
+    //cell access by index in the cell array for StructuralOperationSegments
+    class CellAccess
+    {
+    public:
+        __inline__ __device__ CellAccess(SimulationData& data)
+            : _data(&data)
+            , _cells(data.entities.cells.getArray())
+        {}
+
+        __inline__ __device__ int getIndex(Cell* cell) const { return static_cast<int>(cell - _cells); }
+
+        __inline__ __device__ int getNumConnections(int cellIndex) const { return _cells[cellIndex].numConnections; }
+        __inline__ __device__ int getMaxConnections(int cellIndex) const { return _cells[cellIndex].maxConnections; }
+        __inline__ __device__ int getConnectedCellIndex(int cellIndex, int i) const { return getIndex(_cells[cellIndex].connections[i].cell); }
+        __inline__ __device__ bool isConnected(int cellIndex, int otherCellIndex) const;
+
+        __inline__ __device__ void delConnectionOneWay(int cellIndex, int otherCellIndex);
+        __inline__ __device__ void delConnectionsOneWay(int cellIndex);
+        __inline__ __device__ void addConnectionOneWay(int cellIndex, int otherCellIndex, int operationIndex);
+        __inline__ __device__ void delCell(int cellIndex, int operationIndex);
+
+    private:
+        SimulationData* _data;
+        Cell* _cells;
+    };
+
+    __inline__ __device__ static void scheduleOperation(SimulationData& data, StructuralOperation const& operation);
+
     __inline__ __device__ static void addConnectionIntern(
         SimulationData& data,
         Cell* cell1,
@@ -39,11 +70,6 @@ private:
         float desiredDistance,
         float desiredAngleOnCell1 = 0,
         int angleAlignment = 0);
-
-    __inline__ __device__ static void delConnectionsIntern(Cell* cell);
-    __inline__ __device__ static void delConnectionIntern(Cell* cell1, Cell* cell2);
-
-    __inline__ __device__ static void delCell(SimulationData& data, Cell* cell, int cellIndex);
 };
 
 /************************************************************************/
@@ -57,7 +83,7 @@ CellConnectionProcessor::scheduleAddConnections(SimulationData& data, Cell* cell
     operation.data.addConnectionOperation.cell = cell1;
     operation.data.addConnectionOperation.otherCell = cell2;
     operation.data.addConnectionOperation.addTokens = addTokens;
-    data.structuralOperations.tryAddEntry(operation);
+    scheduleOperation(data, operation);
 }
 
 
@@ -66,7 +92,7 @@ __inline__ __device__ void CellConnectionProcessor::scheduleDelConnections(Simul
     StructuralOperation operation;
     operation.type = StructuralOperation::Type::DelConnections;
     operation.data.delConnectionsOperation.cell = cell;
-    data.structuralOperations.tryAddEntry(operation);
+    scheduleOperation(data, operation);
 }
 
 __inline__ __device__ void
@@ -76,7 +102,7 @@ CellConnectionProcessor::scheduleDelConnection(SimulationData& data, Cell* cell1
     operation.type = StructuralOperation::Type::DelConnection;
     operation.data.delConnectionOperation.cell1 = cell1;
     operation.data.delConnectionOperation.cell2 = cell2;
-    data.structuralOperations.tryAddEntry(operation);
+    scheduleOperation(data, operation);
 }
 
 __inline__ __device__ void CellConnectionProcessor::scheduleDelCell(SimulationData& data, Cell* cell, int cellIndex)
@@ -85,7 +111,7 @@ __inline__ __device__ void CellConnectionProcessor::scheduleDelCell(SimulationDa
     operation.type = StructuralOperation::Type::DelCell;
     operation.data.delCellOperation.cell = cell;
     operation.data.delCellOperation.cellIndex = cellIndex;
-    data.structuralOperations.tryAddEntry(operation);
+    scheduleOperation(data, operation);
 }
 
 __inline__ __device__ void
@@ -95,48 +121,74 @@ CellConnectionProcessor::scheduleDelCellAndConnections(SimulationData& data, Cel
     operation.type = StructuralOperation::Type::DelCellAndConnections;
     operation.data.delCellAndConnectionOperation.cell = cell;
     operation.data.delCellAndConnectionOperation.cellIndex = cellIndex;
-    data.structuralOperations.tryAddEntry(operation);
+    scheduleOperation(data, operation);
 }
 
-__inline__ __device__ void CellConnectionProcessor::processConnectionsOperations(SimulationData& data)
+__inline__ __device__ void CellConnectionProcessor::splitOperations(SimulationData& data)
 {
+    CellAccess cells(data);
     auto partition = calcAllThreadsPartition(data.structuralOperations.getNumOrigEntries());
 
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
         auto const& operation = data.structuralOperations.at(index);
-        if (StructuralOperation::Type::DelConnection == operation.type) {
-            delConnectionIntern(operation.data.delConnectionOperation.cell1, operation.data.delConnectionOperation.cell2);
-        }
-        if (StructuralOperation::Type::DelConnections == operation.type) {
-            delConnectionsIntern(operation.data.delConnectionsOperation.cell);
-        }
-        if (StructuralOperation::Type::DelCellAndConnections == operation.type) {
-            delConnectionsIntern(operation.data.delConnectionsOperation.cell);
-
-            scheduleDelCell(
-                data,
-                operation.data.delCellAndConnectionOperation.cell,
-                operation.data.delCellAndConnectionOperation.cellIndex);
+        Cell* cell = nullptr;
+        Cell* otherCell = nullptr;
+        switch (operation.type) {
+        case StructuralOperation::Type::AddConnections:
+            cell = operation.data.addConnectionOperation.cell;
+            otherCell = operation.data.addConnectionOperation.otherCell;
+            break;
+        case StructuralOperation::Type::DelConnection:
+            cell = operation.data.delConnectionOperation.cell1;
+            otherCell = operation.data.delConnectionOperation.cell2;
+            break;
+        case StructuralOperation::Type::DelConnections:
+            cell = operation.data.delConnectionsOperation.cell;
+            break;
+        case StructuralOperation::Type::DelCell:
+            cell = operation.data.delCellOperation.cell;
+            break;
+        case StructuralOperation::Type::DelCellAndConnections:
+            cell = operation.data.delCellAndConnectionOperation.cell;
+            break;
         }
-        if (StructuralOperation::Type::AddConnections == operation.type) {
-            addConnectionsIntern(
-                data,
-                operation.data.addConnectionOperation.cell,
-                operation.data.addConnectionOperation.otherCell,
-                operation.data.addConnectionOperation.addTokens);
+        auto cellIndex = cells.getIndex(cell);
+        auto otherCellIndex = otherCell ? cells.getIndex(otherCell) : -1;
+
+        auto numEntries = StructuralOperationSegments::getNumEntries(cells, operation.type, cellIndex);
+        auto entries = data.structuralOperationBuckets.tryReserveEntries(numEntries);
+        if (!entries) {
+            data.structuralOperationBuckets.reportDroppedOperation();
+            continue;
         }
+        StructuralOperationSegments::createEntries(cells, operation.type, cellIndex, otherCellIndex, index, entries);
     }
 }
 
-__inline__ __device__ void CellConnectionProcessor::processDelCellOperations(SimulationData& data)
+__inline__ __device__ void CellConnectionProcessor::applyDeletionsAndGrantConnections(SimulationData& data)
 {
-    auto partition = calcAllThreadsPartition(data.structuralOperations.getNumEntries());
+    CellAccess cells(data);
+    auto& buckets = data.structuralOperationBuckets;
+    auto partition = calcAllThreadsPartition(buckets.getNumBuckets());
+
+    for (int bucket = partition.startIndex; bucket <= partition.endIndex; ++bucket) {
+        auto segment = buckets.getSegment(bucket);
+        auto segmentSize = buckets.getSegmentSize(bucket);
+        StructuralOperationSegments::sortSegment(segment, segmentSize);
+        StructuralOperationSegments::applyDeletionsAndGrantConnections(cells, segment, segmentSize, buckets.getGrants());
+    }
+}
 
-    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
-        auto const& operation = data.structuralOperations.at(index);
-        if (StructuralOperation::Type::DelCell == operation.type) {
-            delCell(data, operation.data.delCellOperation.cell, operation.data.delCellOperation.cellIndex);
-        }
+__inline__ __device__ void CellConnectionProcessor::applyConnectionsAndCellDeletions(SimulationData& data)
+{
+    CellAccess cells(data);
+    auto& buckets = data.structuralOperationBuckets;
+    auto partition = calcAllThreadsPartition(buckets.getNumBuckets());
+
+    for (int bucket = partition.startIndex; bucket <= partition.endIndex; ++bucket) {
+        StructuralOperationSegments::applyConnectionsAndCellDeletions(
+            cells, buckets.getSegment(bucket), buckets.getSegmentSize(bucket), buckets.getGrants());
+        buckets.clearSegment(bucket);
     }
 }
 
@@ -162,55 +214,10 @@ CellConnectionProcessor::delConnections(Cell* cell1, Cell* cell2)
     delConnectionOneWay(cell2, cell1);
 }
 
-__inline__ __device__ void
-CellConnectionProcessor::addConnectionsIntern(SimulationData& data, Cell* cell1, Cell* cell2, bool addTokens)
+__inline__ __device__ void CellConnectionProcessor::scheduleOperation(SimulationData& data, StructuralOperation const& operation)
 {
-    SystemDoubleLock lock;
-    lock.init(&cell1->locked, &cell2->locked);
-    if (lock.tryLock()) {
-
-        bool alreadyConnected = false;
-        for (int i = 0; i < cell1->numConnections; ++i) {
-            if (cell1->connections[i].cell == cell2) {
-                alreadyConnected = true;
-                break;
-            }
-        }
-
-        if (!alreadyConnected && cell1->numConnections < cell1->maxConnections
-            && cell2->numConnections < cell2->maxConnections) {
-            auto posDelta = cell2->absPos - cell1->absPos;
-            data.cellMap.correctDirection(posDelta);
-            addConnectionIntern(data, cell1, cell2, posDelta, Math::length(posDelta));
-            addConnectionIntern(data, cell2, cell1, posDelta * (-1), Math::length(posDelta));
-
-/*
-            //align connections
-            addConnectionIntern(data, cell1, cell2, posDelta, 1, 0, 6);
-            addConnectionIntern(data, cell2, cell1, posDelta * (-1), 1, 0, 6);
-*/
-
-            if (addTokens) {
-                EntityFactory factory;
-                factory.init(&data);
-
-                auto cellMinEnergy =
-                    SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellMinEnergy, data, cell1->absPos);
-                auto newTokenEnergy = cudaSimulationParameters.tokenMinEnergy * 1.5f;
-                if (cell1->energy > cellMinEnergy + newTokenEnergy) {
-                    auto token = factory.createToken(cell1, cell2);
-                    token->energy = newTokenEnergy;
-                    cell1->energy -= newTokenEnergy;
-                }
-                if (cell2->energy > cellMinEnergy + newTokenEnergy) {
-                    auto token = factory.createToken(cell2, cell1);
-                    token->energy = newTokenEnergy;
-                    cell2->energy -= newTokenEnergy;
-                }
-            }
-        }
-
-        lock.releaseLock();
+    if (!data.structuralOperations.tryAddEntry(operation)) {
+        data.structuralOperationBuckets.reportDroppedOperation();
     }
 }
 
@@ -312,35 +319,6 @@ __inline__ __device__ void CellConnectionProcessor::addConnectionIntern(
 
 }
 
-__inline__ __device__ void CellConnectionProcessor::delConnectionsIntern(Cell* cell)
-{
-    for (int i = cell->numConnections - 1; i >= 0; --i) {
-        auto connectedCell = cell->connections[0].cell;
-        SystemDoubleLock lock;
-        lock.init(&cell->locked, &connectedCell->locked);
-        if (lock.tryLock()) {
-
-            if (cell->numConnections > 0) {
-                delConnectionOneWay(cell, connectedCell);
-                delConnectionOneWay(connectedCell, cell);
-            }
-
-            lock.releaseLock();
-        }
-    }
-}
-
-__inline__ __device__ void CellConnectionProcessor::delConnectionIntern(Cell* cell1, Cell* cell2)
-{
-    SystemDoubleLock lock;
-    lock.init(&cell1->locked, &cell2->locked);
-    if (lock.tryLock()) {
-        delConnectionOneWay(cell1, cell2);
-        delConnectionOneWay(cell2, cell1);
-        lock.releaseLock();
-    }
-}
-
 __inline__ __device__ void CellConnectionProcessor::delConnectionOneWay(Cell* cell1, Cell* cell2)
 {
     for (int i = 0; i < cell1->numConnections; ++i) {
@@ -362,19 +340,64 @@ __inline__ __device__ void CellConnectionProcessor::delConnectionOneWay(Cell* ce
     }
 }
 
-__inline__ __device__ void CellConnectionProcessor::delCell(SimulationData& data, Cell* cell, int cellIndex)
+__inline__ __device__ bool CellConnectionProcessor::CellAccess::isConnected(int cellIndex, int otherCellIndex) const
 {
-    if (cell->tryLock()) {
+    auto const& cell = _cells[cellIndex];
+    for (int i = 0; i < cell.numConnections; ++i) {
+        if (cell.connections[i].cell == &_cells[otherCellIndex]) {
+            return true;
+        }
+    }
+    return false;
+}
 
-        if (0 == cell->numConnections && cell->energy != 0 /* && _data->entities.cellPointers.at(cellIndex) == cell*/) {
-            EntityFactory factory;
-            factory.init(&data);
-            factory.createParticle(cell->energy, cell->absPos, cell->vel, {cell->metadata.color});
-            cell->setDeleted();
+__inline__ __device__ void CellConnectionProcessor::CellAccess::delConnectionOneWay(int cellIndex, int otherCellIndex)
+{
+    CellConnectionProcessor::delConnectionOneWay(&_cells[cellIndex], &_cells[otherCellIndex]);
+}
 
-            data.entities.cellPointers.at(cellIndex) = nullptr;
+__inline__ __device__ void CellConnectionProcessor::CellAccess::delConnectionsOneWay(int cellIndex)
+{
+    _cells[cellIndex].numConnections = 0;
+}
+
+__inline__ __device__ void CellConnectionProcessor::CellAccess::addConnectionOneWay(int cellIndex, int otherCellIndex, int operationIndex)
+{
+    auto const& operation = _data->structuralOperations.at(operationIndex).data.addConnectionOperation;
+    auto cell = &_cells[cellIndex];
+    auto otherCell = &_cells[otherCellIndex];
+
+    auto posDelta = otherCell->absPos - cell->absPos;
+    _data->cellMap.correctDirection(posDelta);
+    addConnectionIntern(*_data, cell, otherCell, posDelta, Math::length(posDelta));
+
+    if (operation.addTokens) {
+        EntityFactory factory;
+        factory.init(_data);
+
+        auto cellMinEnergy =
+            SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellMinEnergy, *_data, operation.cell->absPos);
+        auto newTokenEnergy = cudaSimulationParameters.tokenMinEnergy * 1.5f;
+        if (cell->energy > cellMinEnergy + newTokenEnergy) {
+            auto token = factory.createToken(cell, otherCell);
+            token->energy = newTokenEnergy;
+            cell->energy -= newTokenEnergy;
         }
+    }
+}
 
-        cell->releaseLock();
+__inline__ __device__ void CellConnectionProcessor::CellAccess::delCell(int cellIndex, int operationIndex)
+{
+    auto const& operation = _data->structuralOperations.at(operationIndex);
+    auto cellPointerIndex = StructuralOperation::Type::DelCell == operation.type ? operation.data.delCellOperation.cellIndex
+                                                                                 : operation.data.delCellAndConnectionOperation.cellIndex;
+    auto cell = &_cells[cellIndex];
+    if (0 == cell->numConnections && cell->energy != 0) {
+        EntityFactory factory;
+        factory.init(_data);
+        factory.createParticle(cell->energy, cell->absPos, cell->vel, {cell->metadata.color});
+        cell->setDeleted();
+
+        _data->entities.cellPointers.at(cellPointerIndex) = nullptr;
     }
 }
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#include <cuda_runtime.h>
+
+//assigns the unit squares of the world to the buckets of a cell list: the number of buckets is proportional to the
+//number of entities instead of the world size, unit squares sharing a bucket are distinguished by their position index
+class CellListLayout
+{
+public:
+    __host__ __device__ __inline__ void init(int2 const& worldSize, int maxEntries)
+    {
+        _worldSize = worldSize;
+        _numBuckets = 1;
+        while (_numBuckets < maxEntries) {
+            _numBuckets *= 2;
+        }
+    }
+
+    __host__ __device__ __inline__ int getNumBuckets() const { return _numBuckets; }
+
+    __host__ __device__ __inline__ int getPosIndex(float2 const& pos) const
+    {
+        int2 posInt{static_cast<int>(floorf(pos.x)), static_cast<int>(floorf(pos.y))};
+        return getPosIndex(posInt);
+    }
+
+    __host__ __device__ __inline__ int getPosIndex(int2 posInt) const
+    {
+        posInt = {((posInt.x % _worldSize.x) + _worldSize.x) % _worldSize.x, ((posInt.y % _worldSize.y) + _worldSize.y) % _worldSize.y};
+        return posInt.x + posInt.y * _worldSize.x;
+    }
+
+    __host__ __device__ __inline__ int getBucket(int posIndex) const
+    {
+        auto hash = static_cast<uint32_t>(posIndex) * 0x9e3779b1u;
+        hash ^= hash >> 16;
+        return static_cast<int>(hash & static_cast<uint32_t>(_numBuckets - 1));
+    }
+
+private:
+    int2 _worldSize;
+    int _numBuckets;
+};
+
+//read access to the bucket ranges of a built cell list, shared by the device maps and their host counterparts
+template <typename Entry>
+class CellListBuckets
+{
+public:
+    __host__ __device__ __inline__ CellListBuckets(CellListLayout const& layout, int const* bucketStarts, int const* sortedPosIndices, Entry const* sortedEntries)
+        : _layout(layout)
+        , _bucketStarts(bucketStarts)
+        , _sortedPosIndices(sortedPosIndices)
+        , _sortedEntries(sortedEntries)
+    {}
+
+    //calls func for all entries in the unit square
+    template <typename Func>
+    __host__ __device__ __inline__ void executeForEachInUnitSquare(int posIndex, Func const& func) const
+    {
+        auto bucket = _layout.getBucket(posIndex);
+        for (int index = _bucketStarts[bucket]; index < _bucketStarts[bucket + 1]; ++index) {
+            if (_sortedPosIndices[index] == posIndex) {
+                func(_sortedEntries[index]);
+            }
+        }
+    }
+
+    //sorted index after the last entry of the bucket of the unit square
+    __host__ __device__ __inline__ int getBucketEnd(int posIndex) const { return _bucketStarts[_layout.getBucket(posIndex) + 1]; }
+
+    __host__ __device__ __inline__ int getSortedPosIndex(int sortedIndex) const { return _sortedPosIndices[sortedIndex]; }
+    __host__ __device__ __inline__ Entry const& getSortedEntry(int sortedIndex) const { return _sortedEntries[sortedIndex]; }
+
+    //calls func for all entries in the (2 * radius + 1) x (2 * radius + 1) unit squares around pos
+    template <typename Func>
+    __host__ __device__ __inline__ void executeForEachInUnitSquares(float2 const& pos, int radius, Func const& func) const
+    {
+        int2 posInt{static_cast<int>(floorf(pos.x)), static_cast<int>(floorf(pos.y))};
+        for (int dx = -radius; dx <= radius; ++dx) {
+            for (int dy = -radius; dy <= radius; ++dy) {
+                executeForEachInUnitSquare(_layout.getPosIndex(int2{posInt.x + dx, posInt.y + dy}), func);
+            }
+        }
+    }
+
+private:
+    CellListLayout _layout;
+    int const* _bucketStarts;
+    int const* _sortedPosIndices;
+    Entry const* _sortedEntries;
+};
@@ -16,12 +16,19 @@ class CellProcessor
 public:
     __inline__ __device__ void init(SimulationData& data);
     __inline__ __device__ void clearTag(SimulationData& data);
-    __inline__ __device__ void updateMap(SimulationData& data);
+    __inline__ __device__ void updateMap(SimulationData& data);  //cell map is complete after prepareMapRanges and sortMap
+    __inline__ __device__ void prepareMapRanges(SimulationData& data);  //single block
+    __inline__ __device__ void sortMap(SimulationData& data);
+    __inline__ __device__ void prepareNeighborListCheck(SimulationData& data);  //single thread, prerequisite: complete cell map
+    __inline__ __device__ void checkNeighborList(SimulationData& data);
+    __inline__ __device__ void countNeighbors(SimulationData& data);
+    __inline__ __device__ void prepareNeighborListRanges(SimulationData& data);  //single block
+    __inline__ __device__ void fillNeighborList(SimulationData& data);
     __inline__ __device__ void clearDensityMap(SimulationData& data);
     __inline__ __device__ void fillDensityMap(SimulationData& data);
     __inline__ __device__ void applyMutation(SimulationData& data);
 
-    __inline__ __device__ void collisions(SimulationData& data);    //prerequisite: clearTag
+    __inline__ __device__ void collisions(SimulationData& data);    //prerequisite: clearTag, atomic-free: each thread only writes to its own cells
     __inline__ __device__ void checkForces(SimulationData& data);
     __inline__ __device__ void updateVelocities(SimulationData& data);    //prerequisite: tag from collisions
 
@@ -37,6 +44,16 @@ public:
     __inline__ __device__ void decay(SimulationData& data);
 
 private:
+    //covers the collision distance and the search radius of DigestionProcessor
+    __inline__ __device__ static float calcNeighborListCutoff();
+
+    //force on cell from the collision as seen by cell, posDelta and velDelta point from the other cell to cell
+    __inline__ __device__ float2 calcCollisionForce(Cell* cell, float2 const& posDelta, float2 const& velDelta, float distance, bool isApproaching);
+
+    //angle forces of the i-th connection acting on the connected cell (force1) and on the previous connected cell (force2)
+    __inline__ __device__ bool
+    calcAngleForces(SimulationData& data, Cell* cell, int i, float cellBindingForce, float2& force1, float2& force2);
+
     SimulationData* _data;
     PartitionData _partition;
 };
@@ -71,9 +88,47 @@ __inline__ __device__ void CellProcessor::clearTag(SimulationData& data)
 
 __inline__ __device__ void CellProcessor::updateMap(SimulationData& data)
 {
-    auto const partition = calcPartition(data.entities.cellPointers.getNumEntries(), blockIdx.x, gridDim.x);
-    Cell** cellPointers = &data.entities.cellPointers.at(partition.startIndex);
-    data.cellMap.set_block(partition.numElements(), cellPointers);
+    auto& cells = data.entities.cellPointers;
+    data.cellMap.set_system(cells.getNumEntries(), cells.getArray());
+}
+
+__inline__ __device__ void CellProcessor::prepareMapRanges(SimulationData& data)
+{
+    data.cellMap.prepareRanges_block();
+}
+
+__inline__ __device__ void CellProcessor::sortMap(SimulationData& data)
+{
+    auto& cells = data.entities.cellPointers;
+    data.cellMap.sort_system(cells.getNumEntries(), cells.getArray());
+}
+
+__inline__ __device__ void CellProcessor::prepareNeighborListCheck(SimulationData& data)
+{
+    data.neighborList.prepareCheck(calcNeighborListCutoff());
+}
+
+__inline__ __device__ void CellProcessor::checkNeighborList(SimulationData& data)
+{
+    auto& cells = data.entities.cellPointers;
+    data.neighborList.check_system(cells.getNumEntries(), cells.getArray(), data.cellMap);
+}
+
+__inline__ __device__ void CellProcessor::countNeighbors(SimulationData& data)
+{
+    auto& cells = data.entities.cellPointers;
+    data.neighborList.count_system(cells.getNumEntries(), cells.getArray(), data.cellMap, calcNeighborListCutoff());
+}
+
+__inline__ __device__ void CellProcessor::prepareNeighborListRanges(SimulationData& data)
+{
+    data.neighborList.prepareRanges_block(data.entities.cellPointers.getNumEntries(), calcNeighborListCutoff());
+}
+
+__inline__ __device__ void CellProcessor::fillNeighborList(SimulationData& data)
+{
+    auto& cells = data.entities.cellPointers;
+    data.neighborList.fill_system(cells.getNumEntries(), cells.getArray(), data.cellMap, calcNeighborListCutoff());
 }
 
 __inline__ __device__ void CellProcessor::clearDensityMap(SimulationData& data)
@@ -98,17 +153,19 @@ __inline__ __device__ void CellProcessor::applyMutation(SimulationData& data)
             continue;
         }
         auto mutationRate = SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellMutationRate, data, cell->absPos);
-        if (data.numberGen2.random() < 0.001f && data.numberGen1.random() < mutationRate * 1000) {
-            auto address = data.numberGen1.random(MAX_CELL_STATIC_BYTES + 2);
+        if (data.numberGen2.random(cell->id, RandomCallSite::CellMutationPreselection) < 0.001f
+            && data.numberGen1.random(cell->id, RandomCallSite::CellMutation) < mutationRate * 1000) {
+            auto address = data.numberGen1.random(MAX_CELL_STATIC_BYTES + 2, cell->id, RandomCallSite::CellMutationAddress);
             if (address < MAX_CELL_STATIC_BYTES) {
-                cell->staticData[address] = data.numberGen1.random(255);
+                cell->staticData[address] = data.numberGen1.random(255, cell->id, RandomCallSite::CellMutationValue);
             } else if (address == MAX_CELL_STATIC_BYTES) {
 //                cell->metadata.color = data.numberGen1.random(6);
             } else if (address == MAX_CELL_STATIC_BYTES + 1) {
-                cell->cellFunctionType = data.numberGen1.random(Enums::CellFunction_Count - 1);
+                cell->cellFunctionType = data.numberGen1.random(Enums::CellFunction_Count - 1, cell->id, RandomCallSite::CellMutationValue);
                 cell->initMemorySizes();
             } else {
-                cell->branchNumber = data.numberGen1.random(cudaSimulationParameters.cellMaxTokenBranchNumber);
+                cell->branchNumber =
+                    data.numberGen1.random(cudaSimulationParameters.cellMaxTokenBranchNumber, cell->id, RandomCallSite::CellMutationValue);
             }
         }
 
@@ -129,25 +186,17 @@ __inline__ __device__ void CellProcessor::collisions(SimulationData& data)
     auto& cells = data.entities.cellPointers;
     _partition = calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
 
-    Cell* otherCells[18];
-    int numOtherCells;
     for (int index = _partition.startIndex; index <= _partition.endIndex; ++index) {
         auto& cell = cells.at(index);
-        data.cellMap.get(otherCells, numOtherCells, cell->absPos);
-        for (int i = 0; i < numOtherCells; ++i) {
-            Cell* otherCell = otherCells[i];
-
-            if (!otherCell || otherCell == cell) {
-                continue;
-            }
-
+        float2 force{0, 0};
+        data.neighborList.executeForEach(cell, cudaSimulationParameters.cellMaxCollisionDistance, data.cellMap, [&](Cell* otherCell) {
             auto posDelta = cell->absPos - otherCell->absPos;
             data.cellMap.correctDirection(posDelta);
 
             auto distance = Math::length(posDelta);
             if (distance >= cudaSimulationParameters.cellMaxCollisionDistance
                 /*|| distance <= cudaSimulationParameters.cellMinDistance*/) {
-                continue;
+                return;
             }
 
             if (distance < cudaSimulationParameters.cellMinDistance && cell->numConnections > 1 && !cell->barrier) {
@@ -166,25 +215,10 @@ __inline__ __device__ void CellProcessor::collisions(SimulationData& data)
             if (!alreadyConnected) {
                 auto velDelta = cell->vel - otherCell->vel;
                 auto isApproaching = Math::dot(posDelta, velDelta) < 0;
-                auto barrierFactor = cell->barrier ? 2 : 1;
 
-                if (Math::length(cell->vel) > 0.5f && isApproaching) {  //&& cell->numConnections == 0 
-                    auto distanceSquared = distance * distance + 0.25;
-                    auto force = posDelta * Math::dot(velDelta, posDelta) / (-2 * distanceSquared) * barrierFactor;
-                    atomicAdd(&cell->temp1.x, force.x);
-                    atomicAdd(&cell->temp1.y, force.y);
-                    atomicAdd(&otherCell->temp1.x, -force.x);
-                    atomicAdd(&otherCell->temp1.y, -force.y);
-                }
-                else {
-                    auto force = Math::normalized(posDelta)
-                        * (cudaSimulationParameters.cellMaxCollisionDistance - Math::length(posDelta))
-                        * cudaSimulationParameters.cellRepulsionStrength * barrierFactor;  ///12, 32
-                    atomicAdd(&cell->temp1.x, force.x);
-                    atomicAdd(&cell->temp1.y, force.y);
-                    atomicAdd(&otherCell->temp1.x, -force.x);
-                    atomicAdd(&otherCell->temp1.y, -force.y);
-                }
+                //the pair is visited from both sides: gather the reaction of the other side instead of scattering to it
+                force = force + calcCollisionForce(cell, posDelta, velDelta, distance, isApproaching)
+                    - calcCollisionForce(otherCell, posDelta * (-1), velDelta * (-1), distance, isApproaching);
 
                 if (cell->numConnections < cell->maxConnections && otherCell->numConnections < otherCell->maxConnections
                     && Math::length(velDelta)
@@ -232,7 +266,26 @@ __inline__ __device__ void CellProcessor::collisions(SimulationData& data)
                 }
             }
 */
-        }
+        });
+        cell->temp1 = cell->temp1 + force;
+    }
+}
+
+__inline__ __device__ float CellProcessor::calcNeighborListCutoff()
+{
+    return max(cudaSimulationParameters.cellMaxCollisionDistance, 1.6f);
+}
+
+__inline__ __device__ float2
+CellProcessor::calcCollisionForce(Cell* cell, float2 const& posDelta, float2 const& velDelta, float distance, bool isApproaching)
+{
+    auto barrierFactor = cell->barrier ? 2 : 1;
+    if (Math::length(cell->vel) > 0.5f && isApproaching) {  //&& cell->numConnections == 0
+        auto distanceSquared = distance * distance + 0.25;
+        return posDelta * Math::dot(velDelta, posDelta) / (-2 * distanceSquared) * barrierFactor;
+    } else {
+        return Math::normalized(posDelta) * (cudaSimulationParameters.cellMaxCollisionDistance - Math::length(posDelta))
+            * cudaSimulationParameters.cellRepulsionStrength * barrierFactor;  ///12, 32
     }
 }
 
@@ -249,7 +302,7 @@ __inline__ __device__ void CellProcessor::checkForces(SimulationData& data)
         }
 
         if (Math::length(cell->temp1) > SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellMaxForce, data, cell->absPos)) {
-            if (data.numberGen1.random() < cudaSimulationParameters.cellMaxForceDecayProb) {
+            if (data.numberGen1.random(cell->id, RandomCallSite::CellMaxForceDecay) < cudaSimulationParameters.cellMaxForceDecayProb) {
                 CellConnectionProcessor::scheduleDelCellAndConnections(data, cell, index);
             }
         }
@@ -283,76 +336,102 @@ __inline__ __device__ void CellProcessor::calcConnectionForces(SimulationData& d
     auto& cells = data.entities.cellPointers;
     auto const partition = calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
 
+    //atomic-free: angle forces caused by the connected cells are gathered instead of scattered by them
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
         auto& cell = cells.at(index);
-        if (0 == cell->numConnections || cell->barrier) {
+        if (0 == cell->numConnections) {
             continue;
         }
         float2 force{0, 0};
-        float2 prevDisplacement = cell->connections[cell->numConnections - 1].cell->absPos - cell->absPos;
-        data.cellMap.correctDirection(prevDisplacement);
-
-        auto cellBindingForce = SpotCalculator::calcParameter(
-            &SimulationParametersSpotValues::cellBindingForce, data, cell->absPos);
-        for (int i = 0; i < cell->numConnections; ++i) {
-            auto connectedCell = cell->connections[i].cell;
-
-            auto displacement = connectedCell->absPos - cell->absPos;
-            data.cellMap.correctDirection(displacement);
-
-            auto actualDistance = Math::length(displacement);
-            auto bondDistance = cell->connections[i].distance;
-            auto deviation = actualDistance - bondDistance;
-            force = force + Math::normalized(displacement) * deviation / 2 * cellBindingForce;
-
-            if (cell->numConnections >= 2) {
+        float2 force1;
+        float2 force2;
+        if (!cell->barrier) {
+            auto cellBindingForce = SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellBindingForce, data, cell->absPos);
+            for (int i = 0; i < cell->numConnections; ++i) {
+                auto displacement = cell->connections[i].cell->absPos - cell->absPos;
+                data.cellMap.correctDirection(displacement);
 
-                auto lastIndex = (i + cell->numConnections - 1) % cell->numConnections;
-                auto lastConnectedCell = cell->connections[lastIndex].cell;
+                auto actualDistance = Math::length(displacement);
+                auto bondDistance = cell->connections[i].distance;
+                auto deviation = actualDistance - bondDistance;
+                force = force + Math::normalized(displacement) * deviation / 2 * cellBindingForce;
 
-                //check if there is a triangular connection
-                bool triangularConnection = false;
-                for (int j = 0; j < connectedCell->numConnections; ++j) {
-                    if (connectedCell->connections[j].cell == lastConnectedCell) {
-                        triangularConnection = true;
-                        break;
-                    }
+                if (calcAngleForces(data, cell, i, cellBindingForce, force1, force2)) {
+                    force = force - (force1 + force2);
                 }
+            }
+        }
 
-                //angle forces in case of no triangular connections
-                if (!triangularConnection) {
-                    auto angle = Math::angleOfVector(displacement);
-                    auto prevAngle = Math::angleOfVector(prevDisplacement);
-                    auto actualAngleFromPrevious = Math::subtractAngle(angle, prevAngle);
-                    auto referenceAngleFromPrevious = cell->connections[i].angleFromPrevious;
-
-                    auto angleDeviation = abs(referenceAngleFromPrevious - actualAngleFromPrevious) / 2000 * cellBindingForce;
-
-                    auto force1 = Math::normalized(displacement) / max(Math::length(displacement), cudaSimulationParameters.cellMinDistance) * angleDeviation;
-                    Math::rotateQuarterClockwise(force1);
-
-                    auto force2 = Math::normalized(prevDisplacement) / max(Math::length(prevDisplacement), cudaSimulationParameters.cellMinDistance) * angleDeviation;
-                    Math::rotateQuarterCounterClockwise(force2);
-
-                    if (abs(referenceAngleFromPrevious - actualAngleFromPrevious) < 180) {
-                        if (referenceAngleFromPrevious < actualAngleFromPrevious) {
-                            force1 = force1 * (-1);
-                            force2 = force2 * (-1);
-                        }
-                        atomicAdd(&connectedCell->temp1.x, force1.x);
-                        atomicAdd(&connectedCell->temp1.y, force1.y);
-                        atomicAdd(&cell->connections[lastIndex].cell->temp1.x, force2.x);
-                        atomicAdd(&cell->connections[lastIndex].cell->temp1.y, force2.y);
-                        force = force - (force1 + force2);
-                    }
+        for (int i = 0; i < cell->numConnections; ++i) {
+            auto connectedCell = cell->connections[i].cell;
+            auto numConnectedCellConnections = connectedCell->numConnections;
+            if (connectedCell->barrier || numConnectedCellConnections < 2) {
+                continue;
+            }
+            int indexInConnectedCell = 0;
+            for (; indexInConnectedCell < numConnectedCellConnections; ++indexInConnectedCell) {
+                if (connectedCell->connections[indexInConnectedCell].cell == cell) {
+                    break;
                 }
             }
+            if (indexInConnectedCell == numConnectedCellConnections) {
+                continue;
+            }
+            auto cellBindingForce = SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellBindingForce, data, connectedCell->absPos);
+            if (calcAngleForces(data, connectedCell, indexInConnectedCell, cellBindingForce, force1, force2)) {
+                force = force + force1;
+            }
+            if (calcAngleForces(data, connectedCell, (indexInConnectedCell + 1) % numConnectedCellConnections, cellBindingForce, force1, force2)) {
+                force = force + force2;
+            }
+        }
+        cell->temp1 = cell->temp1 + force;
+    }
+}
 
-            prevDisplacement = displacement;
+__inline__ __device__ bool
+CellProcessor::calcAngleForces(SimulationData& data, Cell* cell, int i, float cellBindingForce, float2& force1, float2& force2)
+{
+    auto numConnections = cell->numConnections;
+    if (numConnections < 2) {
+        return false;
+    }
+    auto lastIndex = (i + numConnections - 1) % numConnections;
+    auto connectedCell = cell->connections[i].cell;
+    auto lastConnectedCell = cell->connections[lastIndex].cell;
+
+    //no angle forces in case of a triangular connection
+    for (int j = 0; j < connectedCell->numConnections; ++j) {
+        if (connectedCell->connections[j].cell == lastConnectedCell) {
+            return false;
         }
-        atomicAdd(&cell->temp1.x, force.x);
-        atomicAdd(&cell->temp1.y, force.y);
     }
+
+    auto displacement = connectedCell->absPos - cell->absPos;
+    data.cellMap.correctDirection(displacement);
+    auto prevDisplacement = lastConnectedCell->absPos - cell->absPos;
+    data.cellMap.correctDirection(prevDisplacement);
+
+    auto angle = Math::angleOfVector(displacement);
+    auto prevAngle = Math::angleOfVector(prevDisplacement);
+    auto actualAngleFromPrevious = Math::subtractAngle(angle, prevAngle);
+    auto referenceAngleFromPrevious = cell->connections[i].angleFromPrevious;
+    if (abs(referenceAngleFromPrevious - actualAngleFromPrevious) >= 180) {
+        return false;
+    }
+    auto angleDeviation = abs(referenceAngleFromPrevious - actualAngleFromPrevious) / 2000 * cellBindingForce;
+
+    force1 = Math::normalized(displacement) / max(Math::length(displacement), cudaSimulationParameters.cellMinDistance) * angleDeviation;
+    Math::rotateQuarterClockwise(force1);
+
+    force2 = Math::normalized(prevDisplacement) / max(Math::length(prevDisplacement), cudaSimulationParameters.cellMinDistance) * angleDeviation;
+    Math::rotateQuarterCounterClockwise(force2);
+
+    if (referenceAngleFromPrevious < actualAngleFromPrevious) {
+        force1 = force1 * (-1);
+        force2 = force2 * (-1);
+    }
+    return true;
 }
 
 __inline__ __device__ void CellProcessor::checkConnections(SimulationData& data)
@@ -474,7 +553,7 @@ __inline__ __device__ void CellProcessor::radiation(SimulationData& data)
         calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
         auto& cell = cells.at(index);
-        if (data.numberGen1.random() < cudaSimulationParameters.radiationProb && !cell->barrier) {
+        if (data.numberGen1.random(cell->id, RandomCallSite::Radiation) < cudaSimulationParameters.radiationProb && !cell->barrier) {
             auto radiationFactor =
                 SpotCalculator::calcParameter(&SimulationParametersSpotValues::radiationFactor, data, cell->absPos);
             if (radiationFactor > 0) {
@@ -482,8 +561,8 @@ __inline__ __device__ void CellProcessor::radiation(SimulationData& data)
                 auto& pos = cell->absPos;
                 float2 particleVel = (cell->vel * cudaSimulationParameters.radiationVelocityMultiplier)
                     + float2{
-                        (data.numberGen1.random() - 0.5f) * cudaSimulationParameters.radiationVelocityPerturbation,
-                        (data.numberGen1.random() - 0.5f) * cudaSimulationParameters.radiationVelocityPerturbation};
+                        (data.numberGen1.random(cell->id, RandomCallSite::RadiationVelX) - 0.5f) * cudaSimulationParameters.radiationVelocityPerturbation,
+                        (data.numberGen1.random(cell->id, RandomCallSite::RadiationVelY) - 0.5f) * cudaSimulationParameters.radiationVelocityPerturbation};
                 float2 particlePos = pos + Math::normalized(particleVel) * 1.5f;
                 data.cellMap.correctPosition(particlePos);
 
@@ -491,7 +570,7 @@ __inline__ __device__ void CellProcessor::radiation(SimulationData& data)
                 particlePos = particlePos - particleVel;  //because particle will still be moved in current time step
                 float radiationEnergy = powf(cellEnergy, cudaSimulationParameters.radiationExponent) * radiationFactor;
                 radiationEnergy = radiationEnergy / cudaSimulationParameters.radiationProb;
-                radiationEnergy = 2 * radiationEnergy * data.numberGen1.random();
+                radiationEnergy = 2 * radiationEnergy * data.numberGen1.random(cell->id, RandomCallSite::RadiationEnergy);
                 if (cellEnergy > 1) {
                     if (radiationEnergy > cellEnergy - 1) {
                         radiationEnergy = cellEnergy - 1;
@@ -526,7 +605,7 @@ __inline__ __device__ void CellProcessor::decay(SimulationData& data)
             if (cell->cellFunctionInvocations > cellFunctionMinInvocations) {
                 auto cellFunctionInvocationDecayProb =
                     SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellFunctionInvocationDecayProb, data, cell->absPos);
-                if (_data->numberGen1.random() < cellFunctionInvocationDecayProb) {
+                if (_data->numberGen1.random(cell->id, RandomCallSite::CellInvocationDecay) < cellFunctionInvocationDecayProb) {
                     destroyDueToInvocations = true;
                 }
             }
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+#include <cuda_runtime.h>
+
+//priority of a construction derived from the id of the constructing cell by a bijective mixing function:
+//cells of a colony have consecutive ids and ordering neighboring constructions by the raw ids would grant only one
+//construction per chain of conflicts in each round
+__host__ __device__ __inline__ uint64_t calcConstructionPriority(uint64_t cellId)
+{
+    cellId ^= cellId >> 30;
+    cellId *= 0xbf58476d1ce4e5b9ull;
+    cellId ^= cellId >> 27;
+    cellId *= 0x94d049bb133111ebull;
+    cellId ^= cellId >> 31;
+    return cellId;
+}
+
+//claim rules for the cells of construction sites, shared by ConstructionReservations and HostConstructionReservations:
+//the claim of a cell is won by the smallest priority and then by the smallest token index
+namespace ConstructionClaim
+{
+    auto constexpr NotClaimed = 0xffffffffffffffffull;
+    auto constexpr NoTokenIndex = 0x7fffffff;
+
+    //only the claimants with the winning priority compete by their token index
+    __host__ __device__ __inline__ bool isTieCandidate(uint64_t claimedPriority, uint64_t priority)
+    {
+        return claimedPriority == priority;
+    }
+
+    __host__ __device__ __inline__ bool isClaimedBy(uint64_t claimedPriority, int claimedTokenIndex, uint64_t priority, int tokenIndex)
+    {
+        return claimedPriority == priority && claimedTokenIndex == tokenIndex;
+    }
+}
@@ -5,12 +5,39 @@
 #include "Math.cuh"
 #include "QuantityConverter.cuh"
 #include "CellConnectionProcessor.cuh"
+#include "ConstructionPriority.cuh"
+#include "ConstructionReservations.cuh"
 #include "SimulationResult.cuh"
+#include "TokenFunctionBins.cuh"
 
+//constructions are scheduled by the tokens in the constructor bin and then executed in rounds until no construction is
+//pending, each round needs the kernels claimCells => resolveClaimTies => grantConstructions => releaseCells => executeGrantedConstructions
+//a fixed number of rounds is executed by the whole grid, the remaining rounds are executed by a single block in
+//executeRemainingRounds_block so that the host does not need to check for pending constructions
 class ConstructionProcessor
 {
 public:
-    __inline__ __device__ static void process(Token* token, SimulationData& data, SimulationResult& result);
+    enum class Scope
+    {
+        System,
+        Block
+    };
+
+    __inline__ __device__ static void scheduleConstruction(Token* token, int tokenIndex, SimulationData& data);
+
+    template <Scope scope = Scope::System>
+    __inline__ __device__ static void claimCells(SimulationData& data);
+    template <Scope scope = Scope::System>
+    __inline__ __device__ static void resolveClaimTies(SimulationData& data);
+    template <Scope scope = Scope::System>
+    __inline__ __device__ static void grantConstructions(SimulationData& data);
+    template <Scope scope = Scope::System>
+    __inline__ __device__ static void releaseCells(SimulationData& data);
+    template <Scope scope = Scope::System>
+    __inline__ __device__ static void executeGrantedConstructions(SimulationData& data, SimulationResult& result);
+
+    //loops until no construction is pending, does nothing if all constructions are already executed
+    __inline__ __device__ static void executeRemainingRounds_block(SimulationData& data, SimulationResult& result);
 
 private:
     struct ConstructionData
@@ -31,7 +58,23 @@ private:
     };
     __inline__ __device__ static void readConstructionData(Token* token, ConstructionData& data);
 
+    template <Scope scope, typename Func>
+    __inline__ __device__ static void executeForEachPendingConstruction(SimulationData& data, Func const& func);
+
+    //all cells which may be modified by the construction
+    template <typename Func>
+    __inline__ __device__ static void executeForEachCellOfConstructionSite(Token* token, SimulationData& data, Func const& func);
+
+    __inline__ __device__ static unsigned long long getPriority(Token* token);
+
+    __inline__ __device__ static void process(Token* token, SimulationData& data, SimulationResult& result);
+
     __inline__ __device__ static Cell* getFirstCellOfConstructionSite(Token* token);
+    __inline__ __device__ static float2 calcPosDeltaOfNewCell(
+        SimulationData& data,
+        Cell* cell,
+        Cell* firstConstructedCell,
+        ConstructionData const& constructionData);
     __inline__ __device__ static void startNewConstruction(
         Token* token,
         SimulationData& data,
@@ -95,7 +138,7 @@ private:
 /************************************************************************/
 /* Implementation                                                       */
 /************************************************************************/
-__inline__ __device__ void ConstructionProcessor::process(Token* token, SimulationData& data, SimulationResult& result)
+__inline__ __device__ void ConstructionProcessor::scheduleConstruction(Token* token, int tokenIndex, SimulationData& data)
 {
     //    mutateToken(token, data);
 
@@ -106,17 +149,139 @@ __inline__ __device__ void ConstructionProcessor::process(Token* token, Simulati
         token->memory[Enums::Constr_Output] = Enums::ConstrOut_Success;
         return;
     }
+    data.constructionReservations.setPending(tokenIndex);
+}
+
+template <ConstructionProcessor::Scope scope>
+__inline__ __device__ void ConstructionProcessor::claimCells(SimulationData& data)
+{
+    executeForEachPendingConstruction<scope>(data, [&](Token* token, int tokenIndex) {
+        auto priority = getPriority(token);
+        executeForEachCellOfConstructionSite(token, data, [&](Cell* cell) { ConstructionReservations::claim(cell, priority); });
+    });
+}
 
-    Cell* firstCellOfConstructionSite = getFirstCellOfConstructionSite(token);
+template <ConstructionProcessor::Scope scope>
+__inline__ __device__ void ConstructionProcessor::resolveClaimTies(SimulationData& data)
+{
+    executeForEachPendingConstruction<scope>(data, [&](Token* token, int tokenIndex) {
+        auto priority = getPriority(token);
+        executeForEachCellOfConstructionSite(
+            token, data, [&](Cell* cell) { ConstructionReservations::resolveTie(cell, priority, tokenIndex); });
+    });
+}
 
-    if (firstCellOfConstructionSite) {
-        if (!firstCellOfConstructionSite->tryLock()) {
-            token->memory[Enums::Constr_Output] = Enums::ConstrOut_ErrorLock;
+template <ConstructionProcessor::Scope scope>
+__inline__ __device__ void ConstructionProcessor::grantConstructions(SimulationData& data)
+{
+    executeForEachPendingConstruction<scope>(data, [&](Token* token, int tokenIndex) {
+        auto priority = getPriority(token);
+        auto granted = true;
+        executeForEachCellOfConstructionSite(token, data, [&](Cell* cell) {
+            if (!ConstructionReservations::isClaimedBy(cell, priority, tokenIndex)) {
+                granted = false;
+            }
+        });
+        if (granted) {
+            data.constructionReservations.grant(tokenIndex);
+        }
+    });
+}
+
+template <ConstructionProcessor::Scope scope>
+__inline__ __device__ void ConstructionProcessor::releaseCells(SimulationData& data)
+{
+    executeForEachPendingConstruction<scope>(data, [&](Token* token, int tokenIndex) {
+        executeForEachCellOfConstructionSite(token, data, [&](Cell* cell) { ConstructionReservations::release(cell); });
+    });
+}
+
+template <ConstructionProcessor::Scope scope>
+__inline__ __device__ void ConstructionProcessor::executeGrantedConstructions(SimulationData& data, SimulationResult& result)
+{
+    //granted constructions modify disjoint sets of cells => no locks needed
+    executeForEachPendingConstruction<scope>(data, [&](Token* token, int tokenIndex) {
+        if (data.constructionReservations.isGranted(tokenIndex)) {
+            process(token, data, result);
+            data.constructionReservations.finish(tokenIndex);
+        }
+    });
+}
+
+__inline__ __device__ void ConstructionProcessor::executeRemainingRounds_block(SimulationData& data, SimulationResult& result)
+{
+    //__syncthreads makes the results of each step visible to the whole block
+    while (true) {
+        auto numPending = data.constructionReservations.getNumPending();
+        __syncthreads();
+        if (0 == numPending) {
             return;
         }
+        claimCells<Scope::Block>(data);
+        __syncthreads();
+        resolveClaimTies<Scope::Block>(data);
+        __syncthreads();
+        grantConstructions<Scope::Block>(data);
+        __syncthreads();
+        releaseCells<Scope::Block>(data);
+        __syncthreads();
+        executeGrantedConstructions<Scope::Block>(data, result);
+        __syncthreads();
+    }
+}
+
+template <ConstructionProcessor::Scope scope, typename Func>
+__inline__ __device__ void ConstructionProcessor::executeForEachPendingConstruction(SimulationData& data, Func const& func)
+{
+    auto& tokens = data.entities.tokenPointers;
+    auto executeIfPending = [&](int tokenIndex) {
+        if (data.constructionReservations.isPending(tokenIndex)) {
+            func(tokens.at(tokenIndex), tokenIndex);
+        }
+    };
+    if (Scope::System == scope) {
+        data.tokenFunctionBins.executeForEachInBin_system(Enums::CellFunction_Constructor, executeIfPending);
+    } else {
+        data.tokenFunctionBins.executeForEachInBin_block(Enums::CellFunction_Constructor, executeIfPending);
+    }
+}
+
+template <typename Func>
+__inline__ __device__ void ConstructionProcessor::executeForEachCellOfConstructionSite(Token* token, SimulationData& data, Func const& func)
+{
+    auto const& cell = token->cell;
+    func(cell);
+    for (int i = 0; i < cell->numConnections; ++i) {
+        func(cell->connections[i].cell);
+    }
+
+    //cells which may be connected to the new cell when continuing a construction
+    if (auto firstConstructedCell = getFirstCellOfConstructionSite(token)) {
+        ConstructionData constructionData;
+        readConstructionData(token, constructionData);
+        auto posOfNewCell = cell->absPos + calcPosDeltaOfNewCell(data, cell, firstConstructedCell, constructionData);
+
+        Cell* otherCells[18];
+        int numOtherCells;
+        data.cellMap.get(otherCells, 18, numOtherCells, posOfNewCell, cudaSimulationParameters.cellFunctionConstructorOffspringCellDistance);
+        for (int i = 0; i < numOtherCells; ++i) {
+            func(otherCells[i]);
+        }
+    }
+}
 
+__inline__ __device__ unsigned long long ConstructionProcessor::getPriority(Token* token)
+{
+    return calcConstructionPriority(token->cell->id);
+}
+
+__inline__ __device__ void ConstructionProcessor::process(Token* token, SimulationData& data, SimulationResult& result)
+{
+    ConstructionData constructionData;
+    readConstructionData(token, constructionData);
+
+    if (auto firstCellOfConstructionSite = getFirstCellOfConstructionSite(token)) {
         continueConstruction(token, data, result, constructionData, firstCellOfConstructionSite);
-        firstCellOfConstructionSite->releaseLock();
     } else {
         startNewConstruction(token, data, result, constructionData);
     }
@@ -166,6 +331,19 @@ __inline__ __device__ Cell* ConstructionProcessor::getFirstCellOfConstructionSit
     return result;
 }
 
+__inline__ __device__ float2 ConstructionProcessor::calcPosDeltaOfNewCell(
+    SimulationData& data,
+    Cell* cell,
+    Cell* firstConstructedCell,
+    ConstructionData const& constructionData)
+{
+    auto posDelta = firstConstructedCell->absPos - cell->absPos;
+    data.cellMap.correctDirection(posDelta);
+
+    auto desiredDistance = QuantityConverter::convertDataToDistance(constructionData.distance);
+    return Math::normalized(posDelta) * (cudaSimulationParameters.cellFunctionConstructorOffspringCellDistance - desiredDistance);
+}
+
 __inline__ __device__ void ConstructionProcessor::startNewConstruction(
     Token* token,
     SimulationData& data,
@@ -200,12 +378,6 @@ __inline__ __device__ void ConstructionProcessor::startNewConstruction(
     Cell* newCell;
     constructCell(data, token, posOfNewCell, energyForNewEntities.cell, constructionData, newCell);
 
-    if (!newCell->tryLock()) {
-        token->memory[Enums::Constr_Output] = Enums::ConstrOut_ErrorLock;
-        return;
-    }
-
-
     if (!constructionData.isFinishConstruction || !constructionData.isSeparateConstruction) {
         CellConnectionProcessor::addConnections(
             data,
@@ -223,8 +395,6 @@ __inline__ __device__ void ConstructionProcessor::startNewConstruction(
         newCell->maxConnections = newCell->numConnections;
     }
 
-    newCell->releaseLock();
-
     token->memory[Enums::Constr_Output] = Enums::ConstrOut_Success;
     token->memory[Enums::Constr_InOutAngle] = 0;
     result.incCreatedCell();
@@ -238,12 +408,8 @@ __inline__ __device__ void ConstructionProcessor::continueConstruction(
     Cell* firstConstructedCell)
 {
     auto cell = token->cell;
-    auto posDelta = firstConstructedCell->absPos - cell->absPos;
-    data.cellMap.correctDirection(posDelta);
-
     auto desiredDistance = QuantityConverter::convertDataToDistance(constructionData.distance);
-    posDelta =
-        Math::normalized(posDelta) * (cudaSimulationParameters.cellFunctionConstructorOffspringCellDistance - desiredDistance);
+    auto posDelta = calcPosDeltaOfNewCell(data, cell, firstConstructedCell, constructionData);
 
     if (Math::length(posDelta) <= cudaSimulationParameters.cellMinDistance
         || cudaSimulationParameters.cellFunctionConstructorOffspringCellDistance - desiredDistance < 0) {
@@ -267,13 +433,6 @@ __inline__ __device__ void ConstructionProcessor::continueConstruction(
     constructCell(data, token, posOfNewCell, energyForNewEntities.cell, constructionData, newCell);
     firstConstructedCell->tokenBlocked = false;
 
-    if (!newCell->tryLock()) {
-        cell->energy +=
-            energyForNewEntities.token;  //token could not be constructed anymore => transfer energy back to cell
-        token->memory[Enums::Constr_Output] = Enums::ConstrOut_ErrorLock;
-        return;
-    }
-
     if (constructionData.isConstructToken) {
         constructToken(data, newCell, token, cell, energyForNewEntities.token, constructionData.isDuplicateTokenMemory);
     }
@@ -354,15 +513,11 @@ __inline__ __device__ void ConstructionProcessor::continueConstruction(
         if (Math::dot(posDelta, otherPosDelta) < 0.1) {
             continue;
         }
-        if (otherCell->tryLock()) {
-            if (isConnectable(newCell->numConnections, newCell->maxConnections, adaptMaxConnections)
-                && isConnectable(otherCell->numConnections, otherCell->maxConnections, adaptMaxConnections)) {
+        if (isConnectable(newCell->numConnections, newCell->maxConnections, adaptMaxConnections)
+            && isConnectable(otherCell->numConnections, otherCell->maxConnections, adaptMaxConnections)) {
 
-                auto distance = constructionData.uniformDist ? desiredDistance : Math::length(otherPosDelta);
-                CellConnectionProcessor::addConnections(
-                    data, newCell, otherCell, 0, 0, distance, constructionData.angleAlignment);
-            }
-            otherCell->releaseLock();
+            auto distance = constructionData.uniformDist ? desiredDistance : Math::length(otherPosDelta);
+            CellConnectionProcessor::addConnections(data, newCell, otherCell, 0, 0, distance, constructionData.angleAlignment);
         }
     }
 
@@ -371,8 +526,6 @@ __inline__ __device__ void ConstructionProcessor::continueConstruction(
         newCell->maxConnections = newCell->numConnections;
     }
 
-    newCell->releaseLock();
-
     token->memory[Enums::Constr_Output] = Enums::ConstrOut_Success;
     result.incCreatedCell();
 }
@@ -402,16 +555,16 @@ __inline__ __device__ void ConstructionProcessor::constructCell(
     auto offset = result->numStaticBytes + 1;
     result->numMutableBytes =
         static_cast<unsigned char>(
-            token->memory[(Enums::Constr_InCellFunctionData + offset) % MAX_TOKEN_MEM_SIZE])
+            token->memory[(Enums::Constr_InCellFunctionData + offset) % data.tokenMemoryStride])
         % (MAX_CELL_MUTABLE_BYTES + 1);
     result->metadata.color = constructionData.metaData;
 
     for (int i = 0; i < result->numStaticBytes; ++i) {
-        result->staticData[i] = token->memory[(Enums::Constr_InCellFunctionData + i + 1) % MAX_TOKEN_MEM_SIZE];
+        result->staticData[i] = token->memory[(Enums::Constr_InCellFunctionData + i + 1) % data.tokenMemoryStride];
     }
     for (int i = 0; i <= result->numMutableBytes; ++i) {
         result->mutableData[i] =
-            token->memory[(Enums::Constr_InCellFunctionData + offset + i + 1) % MAX_TOKEN_MEM_SIZE];
+            token->memory[(Enums::Constr_InCellFunctionData + offset + i + 1) % data.tokenMemoryStride];
     }
 }
 
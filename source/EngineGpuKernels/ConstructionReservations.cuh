@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Base.cuh"
+#include "Cell.cuh"
+#include "ConstructionPriority.cuh"
+#include "CudaMemoryManager.cuh"
+
+//conflict resolution for constructions without locks, executed in rounds:
+//each pending construction claims all cells it may modify (see ConstructionClaim for the rules), constructions holding
+//the claims of all their cells are granted and executed, the others are retried in the next round
+//=> the construction with the smallest priority is always granted and a construction never fails due to contention
+class ConstructionReservations
+{
+public:
+    __host__ __inline__ void init()
+    {
+        CudaMemoryManager::getInstance().acquireMemory<int>(1, _numPending);
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_numPending, 0, sizeof(int)));
+        resize(1);
+    }
+
+    __host__ __inline__ void resize(int maxTokens)
+    {
+        CudaMemoryManager::getInstance().freeMemory(_states);
+        CudaMemoryManager::getInstance().acquireMemory<int>(maxTokens, _states);
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_states, 0, sizeof(int) * maxTokens));
+    }
+
+    __host__ __inline__ void free()
+    {
+        CudaMemoryManager::getInstance().freeMemory(_numPending);
+        CudaMemoryManager::getInstance().freeMemory(_states);
+    }
+
+    __device__ __inline__ void reset() { *_numPending = 0; }
+
+    __device__ __inline__ int getNumPending() const { return alienAtomicRead(_numPending); }
+
+    //all tokens are in state none outside of the construction rounds
+    __device__ __inline__ void setPending(int tokenIndex)
+    {
+        _states[tokenIndex] = State_Pending;
+        atomicAdd(_numPending, 1);
+    }
+
+    __device__ __inline__ bool isPending(int tokenIndex) const { return _states[tokenIndex] != State_None; }
+    __device__ __inline__ bool isGranted(int tokenIndex) const { return _states[tokenIndex] == State_Granted; }
+    __device__ __inline__ void grant(int tokenIndex) { _states[tokenIndex] = State_Granted; }
+    __device__ __inline__ void finish(int tokenIndex)
+    {
+        _states[tokenIndex] = State_None;
+        atomicSub(_numPending, 1);
+    }
+
+    //claims need to be resolved in separate kernels: claim => resolveTie => isClaimedBy => release
+    __device__ __inline__ static void claim(Cell* cell, unsigned long long priority) { atomicMin(&cell->constructionPriority, priority); }
+
+    __device__ __inline__ static void resolveTie(Cell* cell, unsigned long long priority, int tokenIndex)
+    {
+        if (ConstructionClaim::isTieCandidate(cell->constructionPriority, priority)) {
+            atomicMin(&cell->constructionTokenIndex, tokenIndex);
+        }
+    }
+
+    __device__ __inline__ static bool isClaimedBy(Cell* cell, unsigned long long priority, int tokenIndex)
+    {
+        return ConstructionClaim::isClaimedBy(cell->constructionPriority, cell->constructionTokenIndex, priority, tokenIndex);
+    }
+
+    __device__ __inline__ static void release(Cell* cell)
+    {
+        cell->constructionPriority = ConstructionClaim::NotClaimed;
+        cell->constructionTokenIndex = ConstructionClaim::NoTokenIndex;
+    }
+
+private:
+    enum State_
+    {
+        State_None,
+        State_Pending,
+        State_Granted
+    };
+
+    int* _numPending = nullptr;
+    int* _states = nullptr;
+};
@@ -16,11 +16,13 @@ public:
         CudaMemoryManager::getInstance().acquireMemory<int>(1, _numTokens);
         CudaMemoryManager::getInstance().acquireMemory<int>(1, _numParticles);
         CudaMemoryManager::getInstance().acquireMemory<double>(1, _internalEnergy);
+        CudaMemoryManager::getInstance().acquireMemory<int>(1, _numDroppedStructuralOperations);
 
         CHECK_FOR_CUDA_ERROR(cudaMemset(_numCellsByColor, 0, sizeof(NumCellsByColor)));
         CHECK_FOR_CUDA_ERROR(cudaMemset(_numConnections, 0, sizeof(int)));
         CHECK_FOR_CUDA_ERROR(cudaMemset(_numTokens, 0, sizeof(int)));
         CHECK_FOR_CUDA_ERROR(cudaMemset(_numParticles, 0, sizeof(int)));
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_numDroppedStructuralOperations, 0, sizeof(int)));
 
         double zero = 0.0;
         CHECK_FOR_CUDA_ERROR(cudaMemcpy(_internalEnergy, &zero, sizeof(double), cudaMemcpyHostToDevice));
@@ -34,6 +36,7 @@ public:
         CudaMemoryManager::getInstance().freeMemory(_numTokens);
         CudaMemoryManager::getInstance().freeMemory(_numParticles);
         CudaMemoryManager::getInstance().freeMemory(_internalEnergy);
+        CudaMemoryManager::getInstance().freeMemory(_numDroppedStructuralOperations);
     }
 
     using NumCellsByColor = int[7];
@@ -45,6 +48,7 @@ public:
         int numParticles = 0;
         int numTokens = 0;
         double totalInternalEnergy = 0.0;
+        int numDroppedStructuralOperations = 0;
     };
     __host__ MonitorData getMonitorData(uint64_t timeStep)
     {
@@ -54,6 +58,8 @@ public:
         CHECK_FOR_CUDA_ERROR(cudaMemcpy(&result.numParticles, _numParticles, sizeof(int), cudaMemcpyDeviceToHost));
         CHECK_FOR_CUDA_ERROR(cudaMemcpy(&result.numTokens, _numTokens, sizeof(int), cudaMemcpyDeviceToHost));
         CHECK_FOR_CUDA_ERROR(cudaMemcpy(&result.totalInternalEnergy, _internalEnergy, sizeof(double), cudaMemcpyDeviceToHost));
+        CHECK_FOR_CUDA_ERROR(
+            cudaMemcpy(&result.numDroppedStructuralOperations, _numDroppedStructuralOperations, sizeof(int), cudaMemcpyDeviceToHost));
         result.timeStep = timeStep;
         return result;
     }
@@ -73,6 +79,7 @@ public:
     __inline__ __device__ void incNumConnections(int numConnections) { atomicAdd(_numConnections, numConnections); }
     __inline__ __device__ void setNumParticles(int value) { *_numParticles = value; }
     __inline__ __device__ void setNumTokens(int value) { *_numTokens = value; }
+    __inline__ __device__ void setNumDroppedStructuralOperations(int value) { *_numDroppedStructuralOperations = value; }
     __inline__ __device__ void halveNumConnections() { *_numConnections /= 2; }
 
 
@@ -89,5 +96,6 @@ private:
     int* _numTokens;
     int* _numParticles;
     double* _internalEnergy;
+    int* _numDroppedStructuralOperations;
 };
 
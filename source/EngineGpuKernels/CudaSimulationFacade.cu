@@ -131,7 +131,7 @@ _CudaSimulationFacade::_CudaSimulationFacade(uint64_t timestep, Settings const&
     _cudaAccessTO = std::make_shared<DataAccessTO>();
     _cudaMonitorData = std::make_shared<CudaMonitorData>();
 
-    _cudaSimulationData->init({settings.generalSettings.worldSizeX, settings.generalSettings.worldSizeY});
+    _cudaSimulationData->init(settings);
     _cudaRenderingData->init();
     _cudaMonitorData->init();
     _cudaSimulationResult->init();
@@ -148,9 +148,12 @@ _CudaSimulationFacade::_CudaSimulationFacade(uint64_t timestep, Settings const&
     CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaAccessTO->numParticles);
     CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaAccessTO->numTokens);
     CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaAccessTO->numStringBytes);
+    CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaAccessTO->numTokenMemoryBytes);
 
     //default array sizes for empty simulation (will be resized later if not sufficient)
     resizeArrays({100000, 100000, 10000});
+
+    _simulationKernels->updateFlowFieldGrid(_settings.gpuSettings, *_cudaSimulationData);
 }
 
 _CudaSimulationFacade::~_CudaSimulationFacade()
@@ -165,10 +168,12 @@ _CudaSimulationFacade::~_CudaSimulationFacade()
     CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->particles);
     CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->tokens);
     CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->stringBytes);
+    CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->tokenMemory);
     CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->numCells);
     CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->numParticles);
     CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->numTokens);
     CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->numStringBytes);
+    CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->numTokenMemoryBytes);
 
     log(Priority::Important, "close simulation");
 }
@@ -185,6 +190,7 @@ void* _CudaSimulationFacade::registerImageResource(GLuint image)
 
 void _CudaSimulationFacade::calcTimestep()
 {
+    _cudaSimulationData->setTimestep(_currentTimestep.load());
     _simulationKernels->calcTimestep(_settings, *_cudaSimulationData, *_cudaSimulationResult);
     syncAndCheck();
 
@@ -427,6 +433,10 @@ MonitorData _CudaSimulationFacade::getMonitorData()
     result.numSuccessfulAttacks = processStatistics.sucessfulAttacks;
     result.numFailedAttacks = processStatistics.failedAttacks;
     result.numMuscleActivities = processStatistics.muscleActivities;
+    result.numDroppedStructuralOperations = monitorData.numDroppedStructuralOperations;
+    result.numStructuralOperationQueueResizes = _numStructuralOperationQueueResizes;
+    _cudaSimulationData->tokenFunctionBins.getBinSizes_host(result.numTokensByCellFunction);
+    _simulationKernels->getCellFunctionBatchTimes(result.cellFunctionBatchTimes);
 
     auto deltaTime = static_cast<int64_t>(result.timestep) - static_cast<int64_t>(_timestepOfLastMonitorData);
     auto divisor = deltaTime > 0 ? deltaTime : 1;
@@ -457,8 +467,19 @@ void _CudaSimulationFacade::setCurrentTimestep(uint64_t timestep)
 
 void _CudaSimulationFacade::setSimulationParameters(SimulationParameters const& parameters)
 {
+    auto tokenMemorySizeChanged = parameters.tokenMemorySize != _settings.simulationParameters.tokenMemorySize;
     _settings.simulationParameters = parameters;
     CHECK_FOR_CUDA_ERROR(cudaMemcpyToSymbol(cudaSimulationParameters, &parameters, sizeof(SimulationParameters), 0, cudaMemcpyHostToDevice));
+
+    if (_cudaSimulationData) {
+        auto tokenMemoryStride = calcTokenMemoryStride(parameters.tokenMemorySize);
+        if (tokenMemoryStride != _cudaSimulationData->tokenMemoryStride) {
+            changeTokenMemoryStride(tokenMemoryStride);
+        }
+        if (tokenMemorySizeChanged) {
+            acquireTokenMemoryTO();
+        }
+    }
 }
 
 void _CudaSimulationFacade::setSimulationParametersSpots(SimulationParametersSpots const& spots)
@@ -473,7 +494,17 @@ void _CudaSimulationFacade::setFlowFieldSettings(FlowFieldSettings const& settin
     CHECK_FOR_CUDA_ERROR(
         cudaMemcpyToSymbol(cudaFlowFieldSettings, &settings, sizeof(FlowFieldSettings), 0, cudaMemcpyHostToDevice));
 
+    auto lastSettings = _settings.flowFieldSettings;
     _settings.flowFieldSettings = settings;
+
+    //the cached velocity grid is only regenerated on changes, the kernel runs asynchronously to the caller and
+    //is ordered before the next time step
+    if (_cudaSimulationData && settings != lastSettings) {
+        if (settings.gridSpacing != lastSettings.gridSpacing) {
+            _cudaSimulationData->resizeFlowFieldGrid(settings.gridSpacing);
+        }
+        _simulationKernels->updateFlowFieldGrid(_settings.gpuSettings, *_cudaSimulationData);
+    }
 }
 
 
@@ -503,11 +534,13 @@ void _CudaSimulationFacade::copyDataTOtoDevice(DataAccessTO const& dataTO)
     copyToDevice(_cudaAccessTO->numParticles, dataTO.numParticles);
     copyToDevice(_cudaAccessTO->numTokens, dataTO.numTokens);
     copyToDevice(_cudaAccessTO->numStringBytes, dataTO.numStringBytes);
+    copyToDevice(_cudaAccessTO->numTokenMemoryBytes, dataTO.numTokenMemoryBytes);
 
     copyToDevice(_cudaAccessTO->cells, dataTO.cells, *dataTO.numCells);
     copyToDevice(_cudaAccessTO->particles, dataTO.particles, *dataTO.numParticles);
     copyToDevice(_cudaAccessTO->tokens, dataTO.tokens, *dataTO.numTokens);
     copyToDevice(_cudaAccessTO->stringBytes, dataTO.stringBytes, *dataTO.numStringBytes);
+    copyToDevice(_cudaAccessTO->tokenMemory, dataTO.tokenMemory, *dataTO.numTokenMemoryBytes);
 }
 
 void _CudaSimulationFacade::copyDataTOtoHost(DataAccessTO const& dataTO)
@@ -516,20 +549,48 @@ void _CudaSimulationFacade::copyDataTOtoHost(DataAccessTO const& dataTO)
     copyToHost(dataTO.numParticles, _cudaAccessTO->numParticles);
     copyToHost(dataTO.numTokens, _cudaAccessTO->numTokens);
     copyToHost(dataTO.numStringBytes, _cudaAccessTO->numStringBytes);
+    copyToHost(dataTO.numTokenMemoryBytes, _cudaAccessTO->numTokenMemoryBytes);
 
     copyToHost(dataTO.cells, _cudaAccessTO->cells, *dataTO.numCells);
     copyToHost(dataTO.particles, _cudaAccessTO->particles, *dataTO.numParticles);
     copyToHost(dataTO.tokens, _cudaAccessTO->tokens, *dataTO.numTokens);
     copyToHost(dataTO.stringBytes, _cudaAccessTO->stringBytes, *dataTO.numStringBytes);
+    copyToHost(dataTO.tokenMemory, _cudaAccessTO->tokenMemory, *dataTO.numTokenMemoryBytes);
 }
 
 void _CudaSimulationFacade::automaticResizeArrays()
 {
+    //operations are dropped as long as the queue is too small, hence it is checked after every time step
+    resizeStructuralOperationsIfNecessary();
+
     //make check after every 10th time step
     if (_currentTimestep.load() % 10 == 0) {
         if (_cudaSimulationResult->isArrayResizeNeeded()) {
             resizeArrays({0, 0, 0});
         }
+        resizeNeighborListIfNecessary();
+    }
+}
+
+void _CudaSimulationFacade::resizeStructuralOperationsIfNecessary()
+{
+    auto numDroppedStructuralOperations = _cudaSimulationData->structuralOperationBuckets.getNumDroppedOperations_host();
+    if (numDroppedStructuralOperations > _numDroppedStructuralOperations) {
+        log(Priority::Important, "resize structural operation queue");
+
+        _numDroppedStructuralOperations = numDroppedStructuralOperations;
+        ++_numStructuralOperationQueueResizes;
+        _cudaSimulationData->resizeStructuralOperations(_cudaSimulationData->structuralOperationBuckets.getMaxOperations() * 2);
+    }
+}
+
+void _CudaSimulationFacade::resizeNeighborListIfNecessary()
+{
+    auto numRequiredNeighbors = _cudaSimulationData->neighborList.getNumRequiredNeighbors_host();
+    if (numRequiredNeighbors > _cudaSimulationData->neighborList.getMaxNeighbors()) {
+        log(Priority::Important, "resize neighbor list");
+
+        _cudaSimulationData->neighborList.resizeNeighbors(numRequiredNeighbors * 2);
     }
 }
 
@@ -562,6 +623,7 @@ void _CudaSimulationFacade::resizeArrays(ArraySizes const& additionals)
     CudaMemoryManager::getInstance().acquireMemory<ParticleAccessTO>(cellArraySize, _cudaAccessTO->particles);
     CudaMemoryManager::getInstance().acquireMemory<TokenAccessTO>(tokenArraySize, _cudaAccessTO->tokens);
     CudaMemoryManager::getInstance().acquireMemory<char>(MAX_STRING_BYTES, _cudaAccessTO->stringBytes);
+    acquireTokenMemoryTO();
 
     CHECK_FOR_CUDA_ERROR(cudaGetLastError());
 
@@ -572,3 +634,27 @@ void _CudaSimulationFacade::resizeArrays(ArraySizes const& additionals)
         auto const memorySizeAfter = CudaMemoryManager::getInstance().getSizeOfAcquiredMemory();
     log(Priority::Important, std::to_string(memorySizeAfter / (1024 * 1024)) + " MB GPU memory acquired");
 }
+
+void _CudaSimulationFacade::acquireTokenMemoryTO()
+{
+    //the access TOs transfer tokenMemorySize bytes per token
+    CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->tokenMemory);
+    CudaMemoryManager::getInstance().acquireMemory<char>(
+        _cudaSimulationData->entities.tokens.getSize_host() * _settings.simulationParameters.tokenMemorySize, _cudaAccessTO->tokenMemory);
+}
+
+void _CudaSimulationFacade::changeTokenMemoryStride(int newTokenMemoryStride)
+{
+    log(Priority::Important, "change token memory stride to " + std::to_string(newTokenMemoryStride) + " bytes");
+
+    _cudaSimulationData->resizeTokenMemoryForCleanup(newTokenMemoryStride);
+    _garbageCollectorKernels->copyTokenMemory(_settings.gpuSettings, *_cudaSimulationData, newTokenMemoryStride);
+    syncAndCheck();
+
+    _cudaSimulationData->tokenMemoryStride = newTokenMemoryStride;
+    auto& entities = _cudaSimulationData->entities;
+    entities.tokenMemory.resize(_cudaSimulationData->entitiesForCleanup.tokenMemory.getSize_host());
+
+    _garbageCollectorKernels->swapTokenMemory(_settings.gpuSettings, *_cudaSimulationData);
+    syncAndCheck();
+}
@@ -78,9 +78,15 @@ private:
     void copyDataTOtoHost(DataAccessTO const& dataTO);
     void automaticResizeArrays();
     void resizeArrays(ArraySizes const& additionals);
+    void resizeStructuralOperationsIfNecessary();
+    void resizeNeighborListIfNecessary();
+    void acquireTokenMemoryTO();
+    void changeTokenMemoryStride(int newTokenMemoryStride);
 
     std::atomic<uint64_t> _currentTimestep;
     uint64_t _timestepOfLastMonitorData = 0llu;
+    int _numDroppedStructuralOperations = 0;
+    int _numStructuralOperationQueueResizes = 0;
     Settings _settings;
 
     std::shared_ptr<SimulationData> _cudaSimulationData;
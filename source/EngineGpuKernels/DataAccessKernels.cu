@@ -260,8 +260,9 @@ __global__ void cudaGetTokenData(SimulationData data, DataAccessTO dataTO)
         auto& tokenTO = dataTO.tokens[tokenTOIndex];
 
         tokenTO.energy = token->energy;
+        tokenTO.memoryIndex = atomicAdd(dataTO.numTokenMemoryBytes, cudaSimulationParameters.tokenMemorySize);
         for (int i = 0; i < cudaSimulationParameters.tokenMemorySize; ++i) {
-            tokenTO.memory[i] = token->memory[i];
+            dataTO.tokenMemory[tokenTO.memoryIndex + i] = token->memory[i];
         }
         tokenTO.cellIndex = token->cell->tag;
         tokenTO.sequenceNumber = tokenIndex;
@@ -311,7 +312,7 @@ __global__ void cudaCreateDataFromTO(SimulationData data, DataAccessTO dataTO, b
 
     auto tokenPartition = calcPartition(*dataTO.numTokens, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
     for (int index = tokenPartition.startIndex; index <= tokenPartition.endIndex; ++index) {
-        factory.createTokenFromTO(dataTO.tokens[index], cellTargetArray);
+        factory.createTokenFromTO(dataTO.tokens[index], dataTO, cellTargetArray);
     }
 }
 
@@ -341,6 +342,7 @@ __global__ void cudaClearDataTO(DataAccessTO dataTO)
     *dataTO.numParticles = 0;
     *dataTO.numTokens = 0;
     *dataTO.numStringBytes = 0;
+    *dataTO.numTokenMemoryBytes = 0;
 }
 
 __global__ void cudaClearData(SimulationData data)
@@ -351,6 +353,7 @@ __global__ void cudaClearData(SimulationData data)
     data.entities.cells.reset();
     data.entities.tokens.reset();
     data.entities.particles.reset();
+    data.entities.tokenMemory.reset();
     data.entities.stringBytes.reset();
 }
 
@@ -34,7 +34,7 @@ __inline__ __device__ void DigestionProcessor::process(Token* token, SimulationD
 
         Cell* otherCells[18];
         int numOtherCells;
-        data.cellMap.get(otherCells, 18, numOtherCells, cell->absPos, 1.6f);
+        data.neighborList.get(otherCells, 18, numOtherCells, cell, 1.6f, data.cellMap);
         for (int i = 0; i < numOtherCells; ++i) {
             Cell* otherCell = otherCells[i];
             if (otherCell->tryLock()) {
@@ -133,10 +133,11 @@ __inline__ __device__ void DigestionProcessor::process(Token* token, SimulationD
         if (cellFunctionWeaponEnergyCost > 0) {
             auto const cellEnergy = cell->energy;
             auto& pos = cell->absPos;
+            //keyed by the token since several tokens can digest on the same cell in a time step
             float2 particleVel = (cell->vel * cudaSimulationParameters.radiationVelocityMultiplier)
                 + float2{
-                    (data.numberGen1.random() - 0.5f) * cudaSimulationParameters.radiationVelocityPerturbation,
-                    (data.numberGen1.random() - 0.5f) * cudaSimulationParameters.radiationVelocityPerturbation};
+                    (data.numberGen1.random(token->id, RandomCallSite::DigestionVelX) - 0.5f) * cudaSimulationParameters.radiationVelocityPerturbation,
+                    (data.numberGen1.random(token->id, RandomCallSite::DigestionVelY) - 0.5f) * cudaSimulationParameters.radiationVelocityPerturbation};
             float2 particlePos = pos + Math::normalized(particleVel) * 1.5f;
             data.cellMap.correctPosition(particlePos);
 
@@ -48,7 +48,7 @@ __global__ void cudaChangeCell(SimulationData data, DataAccessTO changeDataTO)
                 entityFactory.changeCellFromTO(cellTO, changeDataTO, cell);
 
                 for (int i = 0; i < *changeDataTO.numTokens; ++i) {
-                    entityFactory.createTokenFromTO(changeDataTO.tokens[i], cell);
+                    entityFactory.createTokenFromTO(changeDataTO.tokens[i], changeDataTO, cell);
                 }
             }
         }
@@ -405,16 +405,6 @@ __global__ void cudaScheduleDisconnectSelectionFromRemainings(SimulationData dat
     }
 }
 
-__global__ void cudaPrepareConnectionChanges(SimulationData data)
-{
-    data.structuralOperations.saveNumEntries();
-}
-
-__global__ void cudaProcessConnectionChanges(SimulationData data)
-{
-    CellConnectionProcessor::processConnectionsOperations(data);
-}
-
 __global__ void cudaExistsSelection(PointSelectionData pointData, SimulationData data, int* result)
 {
     auto const cellBlock = calcAllThreadsPartition(data.entities.cellPointers.getNumEntries());
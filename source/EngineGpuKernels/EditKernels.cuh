@@ -35,8 +35,6 @@ __global__ void cudaMakeSticky(SimulationData data, bool includeClusters);
 __global__ void cudaRemoveStickiness(SimulationData data, bool includeClusters);
 __global__ void cudaSetBarrier(SimulationData data, bool value, bool includeClusters);
 __global__ void cudaScheduleDisconnectSelectionFromRemainings(SimulationData data, int* result);
-__global__ void cudaPrepareConnectionChanges(SimulationData data);
-__global__ void cudaProcessConnectionChanges(SimulationData data);
 __global__ void cudaExistsSelection(PointSelectionData pointData, SimulationData data, int* result);
 __global__ void cudaSetSelection(float2 pos, float radius, SimulationData data);
 __global__ void cudaSetSelection(AreaSelectionData selectionData, SimulationData data);
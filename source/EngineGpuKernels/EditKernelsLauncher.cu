@@ -2,6 +2,8 @@
 
 #include "DataAccessKernels.cuh"
 #include "EditKernels.cuh"
+#include "SimulationKernels.cuh"
+#include "SimulationKernelsLauncher.cuh"
 #include "GarbageCollectorKernelsLauncher.cuh"
 
 _EditKernelsLauncher::_EditKernelsLauncher()
@@ -86,10 +88,9 @@ void _EditKernelsLauncher::shallowUpdateSelectedEntities(
 
             setValueToDevice(_cudaUpdateResult, 0);
             KERNEL_CALL(cudaScheduleDisconnectSelectionFromRemainings, data, _cudaUpdateResult);
-            KERNEL_CALL_1_1(cudaPrepareConnectionChanges, data);
-            KERNEL_CALL(cudaProcessConnectionChanges, data);
+            _SimulationKernelsLauncher::processStructuralOperations(gpuSettings, data);
             cudaDeviceSynchronize();
-        } while (1 == copyToHost(_cudaUpdateResult) && --counter > 0);  //due to locking not all affecting connections may be removed at first => repeat
+        } while (1 == copyToHost(_cudaUpdateResult) && --counter > 0);  //operations may have been dropped on queue overflow => repeat
     }
 
     if (updateData.posDeltaX != 0 || updateData.posDeltaY != 0 || updateData.velDeltaX != 0 || updateData.velDeltaY != 0) {
@@ -119,9 +120,10 @@ void _EditKernelsLauncher::shallowUpdateSelectedEntities(
 
             setValueToDevice(_cudaUpdateResult, 0);
             KERNEL_CALL(cudaUpdateMapForConnection, data);
+            KERNEL_CALL_1_BLOCK(cudaPrepareCellMapRanges, data);
+            KERNEL_CALL(cudaSortCellMap, data);
             KERNEL_CALL(cudaScheduleConnectSelection, data, false, _cudaUpdateResult);
-            KERNEL_CALL_1_1(cudaPrepareConnectionChanges, data);
-            KERNEL_CALL(cudaProcessConnectionChanges, data);
+            _SimulationKernelsLauncher::processStructuralOperations(gpuSettings, data);
 
             KERNEL_CALL(cudaCleanupCellMap, data);
             cudaDeviceSynchronize();
@@ -184,10 +186,9 @@ void _EditKernelsLauncher::reconnectSelectedEntities(GpuSettings const& gpuSetti
 
         setValueToDevice(_cudaUpdateResult, 0);
         KERNEL_CALL(cudaScheduleDisconnectSelectionFromRemainings, data, _cudaUpdateResult);
-        KERNEL_CALL_1_1(cudaPrepareConnectionChanges, data);
-        KERNEL_CALL(cudaProcessConnectionChanges, data);
+        _SimulationKernelsLauncher::processStructuralOperations(gpuSettings, data);
         cudaDeviceSynchronize();
-    } while (1 == copyToHost(_cudaUpdateResult) && --counter > 0);  //due to locking not all affecting connections may be removed at first => repeat
+    } while (1 == copyToHost(_cudaUpdateResult) && --counter > 0);  //operations may have been dropped on queue overflow => repeat
 
         cudaDeviceSynchronize();
 
@@ -197,9 +198,10 @@ void _EditKernelsLauncher::reconnectSelectedEntities(GpuSettings const& gpuSetti
 
         setValueToDevice(_cudaUpdateResult, 0);
         KERNEL_CALL(cudaUpdateMapForConnection, data);
+        KERNEL_CALL_1_BLOCK(cudaPrepareCellMapRanges, data);
+        KERNEL_CALL(cudaSortCellMap, data);
         KERNEL_CALL(cudaScheduleConnectSelection, data, false, _cudaUpdateResult);
-        KERNEL_CALL_1_1(cudaPrepareConnectionChanges, data);
-        KERNEL_CALL(cudaProcessConnectionChanges, data);
+        _SimulationKernelsLauncher::processStructuralOperations(gpuSettings, data);
 
         KERNEL_CALL(cudaCleanupCellMap, data);
         cudaDeviceSynchronize();
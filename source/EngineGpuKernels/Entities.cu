@@ -12,6 +12,7 @@ void Entities::init()
     tokens.init();
     particles.init();
     particlePointers.init();
+    tokenMemory.init();
     stringBytes.init();
     stringBytes.resize(MAX_STRING_BYTES);
 }
@@ -24,5 +25,6 @@ void Entities::free()
     tokens.free();
     particles.free();
     particlePointers.free();
+    tokenMemory.free();
     stringBytes.free();
 }
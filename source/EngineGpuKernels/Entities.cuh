@@ -16,6 +16,7 @@ struct Entities
     Array<Token> tokens;
     Array<Particle> particles;
 
+    Array<char> tokenMemory;  //SimulationData::tokenMemoryStride bytes per token
     RawMemory stringBytes;
 
     void init();
@@ -19,7 +19,7 @@ public:
     __inline__ __device__ Particle* createParticleFromTO(ParticleAccessTO const& particleTO, bool createIds);
     __inline__ __device__ Cell* createCellFromTO(int targetIndex, CellAccessTO const& cellTO, Cell* cellArray, DataAccessTO* simulationTO, bool createIds);
     __inline__ __device__ void changeCellFromTO(CellAccessTO const& cellTO, DataAccessTO const& dataTO, Cell* cell);
-    __inline__ __device__ Token* createTokenFromTO(TokenAccessTO const& tokenTO, Cell* cellArray);
+    __inline__ __device__ Token* createTokenFromTO(TokenAccessTO const& tokenTO, DataAccessTO const& dataTO, Cell* cellArray);
     __inline__ __device__ void changeParticleFromTO(ParticleAccessTO const& particleTO, Particle* particle);
     __inline__ __device__ Particle* createParticle(float energy, float2 const& pos, float2 const& vel, ParticleMetadata const& metadata);
     __inline__ __device__ Cell* createRandomCell(float energy, float2 const& pos, float2 const& vel);
@@ -30,6 +30,7 @@ public:
 private:
     __inline__ __device__ void
     copyString(int& targetLen, char*& targetString, int sourceLen, int sourceStringIndex, char* stringBytes);
+    __inline__ __device__ Token* createTokenWithMemory();
 
     BaseMap _map;
     SimulationData* _data;
@@ -122,6 +123,8 @@ EntityFactory::createCellFromTO(int targetIndex, CellAccessTO const& cellTO, Cel
     cell->selected = 0;
     cell->locked = 0;
     cell->temp3 = {0, 0};
+    ConstructionReservations::release(cell);
+    cell->neighborListIndex = -1;
 
     return cell;
 }
@@ -185,18 +188,21 @@ __inline__ __device__ void EntityFactory::changeCellFromTO(
         dataTO.stringBytes);
 }
 
-__inline__ __device__ Token* EntityFactory::createTokenFromTO(TokenAccessTO const& tokenTO, Cell* cellArray)
+__inline__ __device__ Token* EntityFactory::createTokenFromTO(TokenAccessTO const& tokenTO, DataAccessTO const& dataTO, Cell* cellArray)
 {
-    Token** tokenPointer = _data->entities.tokenPointers.getNewElement();
-    Token* token = _data->entities.tokens.getNewElement();
-    *tokenPointer = token;
+    Token* token = createTokenWithMemory();
 
     token->energy = tokenTO.energy;
-    for (int i = 0; i < cudaSimulationParameters.tokenMemorySize; ++i) {
-        token->memory[i] = tokenTO.memory[i];
+    auto tokenMemorySize = min(cudaSimulationParameters.tokenMemorySize, _data->tokenMemoryStride);
+    for (int i = 0; i < tokenMemorySize; ++i) {
+        token->memory[i] = dataTO.tokenMemory[tokenTO.memoryIndex + i];
+    }
+    for (int i = tokenMemorySize; i < _data->tokenMemoryStride; ++i) {
+        token->memory[i] = 0;
     }
     token->cell = cellArray + tokenTO.cellIndex;
     token->sourceCell = token->cell;
+    token->id = _data->numberGen1.createDerivedId(token->cell->id, tokenTO.memoryIndex);
     return token;
 }
 
@@ -245,13 +251,16 @@ __inline__ __device__ Cell* EntityFactory::createRandomCell(float energy, float2
     cell->absPos = pos;
     cell->vel = vel;
     cell->energy = energy;
-    cell->maxConnections = _data->numberGen1.random(MAX_CELL_BONDS);
-    cell->branchNumber = _data->numberGen1.random(cudaSimulationParameters.cellMaxTokenBranchNumber - 1);
+    cell->maxConnections = _data->numberGen1.random(MAX_CELL_BONDS, cell->id, RandomCallSite::RandomCellMaxConnections);
+    cell->branchNumber = _data->numberGen1.random(
+        cudaSimulationParameters.cellMaxTokenBranchNumber - 1, cell->id, RandomCallSite::RandomCellBranchNumber);
     cell->numConnections = 0;
     cell->tokenBlocked = false;
     cell->locked = 0;
     cell->selected = 0;
     cell->temp3 = {0, 0};
+    ConstructionReservations::release(cell);
+    cell->neighborListIndex = -1;
     cell->metadata.color = 0;
     cell->metadata.nameLen = 0;
     cell->metadata.descriptionLen = 0;
@@ -259,13 +268,13 @@ __inline__ __device__ Cell* EntityFactory::createRandomCell(float energy, float2
     cell->barrier = false;
     cell->age = 0;
 
-    cell->cellFunctionType = _data->numberGen1.random(Enums::CellFunction_Count - 1);
+    cell->cellFunctionType = _data->numberGen1.random(Enums::CellFunction_Count - 1, cell->id, RandomCallSite::RandomCellFunction);
     cell->initMemorySizes();
     for (int i = 0; i < MAX_CELL_STATIC_BYTES; ++i) {
-        cell->staticData[i] = _data->numberGen1.random(255);
+        cell->staticData[i] = _data->numberGen1.random(255, cell->id, RandomCallSite::RandomCellStaticData, i);
     }
     for (int i = 0; i < MAX_CELL_MUTABLE_BYTES; ++i) {
-        cell->mutableData[i] = _data->numberGen1.random(255);
+        cell->mutableData[i] = _data->numberGen1.random(255, cell->id, RandomCallSite::RandomCellMutableData, i);
     }
     cell->cellFunctionInvocations = 0;
     return cell;
@@ -281,6 +290,8 @@ __inline__ __device__ Cell* EntityFactory::createCell()
     result->selected = 0;
     result->locked = 0;
     result->temp3 = {0, 0};
+    ConstructionReservations::release(result);
+    result->neighborListIndex = -1;
     result->metadata.color = 0;
     result->metadata.nameLen = 0;
     result->metadata.descriptionLen = 0;
@@ -292,28 +303,41 @@ __inline__ __device__ Cell* EntityFactory::createCell()
 
 __inline__ __device__ Token* EntityFactory::duplicateToken(Cell* targetCell, Token* sourceToken)
 {
-    Token* token = _data->entities.tokens.getNewElement();
-    Token** tokenPointer = _data->entities.tokenPointers.getNewElement();
-    *tokenPointer = token;
+    Token* token = createTokenWithMemory();
 
+    auto memory = token->memory;
     *token = *sourceToken;
+    token->memory = memory;
+    for (int i = 0; i < _data->tokenMemoryStride; ++i) {
+        token->memory[i] = sourceToken->memory[i];
+    }
     token->memory[0] = targetCell->branchNumber;
     token->sourceCell = token->cell;
     token->cell = targetCell;
+    token->id = _data->numberGen1.createDerivedId(sourceToken->id, targetCell->id);
     return token;
 }
 
 __inline__ __device__ Token* EntityFactory::createToken(Cell* cell, Cell* sourceCell)
 {
-    Token* token = _data->entities.tokens.getNewSubarray(1);
-    Token** tokenPointer = _data->entities.tokenPointers.getNewElement();
-    *tokenPointer = token;
+    Token* token = createTokenWithMemory();
 
     token->cell = cell;
     token->sourceCell = sourceCell;
+    token->id = _data->numberGen1.createDerivedId(cell->id, sourceCell->id);
     token->memory[0] = cell->branchNumber;
-    for (int i = 1; i < MAX_TOKEN_MEM_SIZE; ++i) {
+    for (int i = 1; i < _data->tokenMemoryStride; ++i) {
         token->memory[i] = 0;
     }
     return token;
 }
+
+__inline__ __device__ Token* EntityFactory::createTokenWithMemory()
+{
+    Token* token = _data->entities.tokens.getNewElement();
+    Token** tokenPointer = _data->entities.tokenPointers.getNewElement();
+    *tokenPointer = token;
+
+    token->memory = _data->entities.tokenMemory.getNewSubarray(_data->tokenMemoryStride);
+    return token;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include <cuda_runtime.h>
+
+#include "EngineInterface/FlowFieldSettings.h"
+
+//velocity field of the flow centers cached at the nodes of a regular grid covering the world
+//the nodes are evenly spaced such that the grid wraps around the world boundaries like the world itself
+class FlowFieldGrid
+{
+public:
+    __host__ __device__ __inline__ void init(int2 const& worldSize, int gridSpacing)
+    {
+        _worldSize = worldSize;
+        gridSpacing = gridSpacing < 1 ? 1 : gridSpacing;
+        _gridSize = {(worldSize.x + gridSpacing - 1) / gridSpacing, (worldSize.y + gridSpacing - 1) / gridSpacing};
+        _nodeDistance = {
+            static_cast<float>(worldSize.x) / static_cast<float>(_gridSize.x),
+            static_cast<float>(worldSize.y) / static_cast<float>(_gridSize.y)};
+    }
+
+    __host__ __device__ __inline__ int getNumNodes() const { return _gridSize.x * _gridSize.y; }
+    __host__ __device__ __inline__ float2* getVelocities() const { return _velocities; }
+    __host__ __device__ __inline__ void setVelocities(float2* velocities) { _velocities = velocities; }
+
+    __host__ __device__ __inline__ float2 getNodePos(int nodeIndex) const
+    {
+        return {
+            static_cast<float>(nodeIndex % _gridSize.x) * _nodeDistance.x, static_cast<float>(nodeIndex / _gridSize.x) * _nodeDistance.y};
+    }
+
+    __host__ __device__ __inline__ void calcNodeVelocity(FlowFieldSettings const& settings, int nodeIndex) const
+    {
+        _velocities[nodeIndex] = calcVelocity(settings, _worldSize, getNodePos(nodeIndex));
+    }
+
+    //bilinear interpolation of the surrounding nodes
+    __host__ __device__ __inline__ float2 getVelocity(float2 const& pos) const
+    {
+        auto gridPosX = pos.x / _nodeDistance.x;
+        auto gridPosY = pos.y / _nodeDistance.y;
+        auto floorX = floorf(gridPosX);
+        auto floorY = floorf(gridPosY);
+        auto fracX = gridPosX - floorX;
+        auto fracY = gridPosY - floorY;
+
+        auto x0 = ((static_cast<int>(floorX) % _gridSize.x) + _gridSize.x) % _gridSize.x;
+        auto y0 = ((static_cast<int>(floorY) % _gridSize.y) + _gridSize.y) % _gridSize.y;
+        auto x1 = x0 + 1 < _gridSize.x ? x0 + 1 : 0;
+        auto y1 = y0 + 1 < _gridSize.y ? y0 + 1 : 0;
+
+        auto const& v00 = _velocities[x0 + y0 * _gridSize.x];
+        auto const& v10 = _velocities[x1 + y0 * _gridSize.x];
+        auto const& v01 = _velocities[x0 + y1 * _gridSize.x];
+        auto const& v11 = _velocities[x1 + y1 * _gridSize.x];
+        return {
+            (v00.x * (1.0f - fracX) + v10.x * fracX) * (1.0f - fracY) + (v01.x * (1.0f - fracX) + v11.x * fracX) * fracY,
+            (v00.y * (1.0f - fracX) + v10.y * fracX) * (1.0f - fracY) + (v01.y * (1.0f - fracX) + v11.y * fracX) * fracY};
+    }
+
+    //analytic field: rotated gradient of a height function which is the sum of a square root profile for each center
+    __host__ __device__ __inline__ static float2 calcVelocity(FlowFieldSettings const& settings, int2 const& worldSize, float2 const& pos)
+    {
+        auto baseValue = calcHeight(settings, worldSize, pos);
+        auto downValue = calcHeight(settings, worldSize, {pos.x, pos.y + 1});
+        auto rightValue = calcHeight(settings, worldSize, {pos.x + 1, pos.y});
+        return {baseValue - downValue, rightValue - baseValue};
+    }
+
+private:
+    __host__ __device__ __inline__ static float calcHeight(FlowFieldSettings const& settings, int2 const& worldSize, float2 const& pos)
+    {
+        float result = 0;
+        for (int i = 0; i < settings.numCenters; ++i) {
+            auto const& radialFlow = settings.centers[i];
+            float2 delta{
+                remainderf(pos.x - radialFlow.posX, static_cast<float>(worldSize.x)),
+                remainderf(pos.y - radialFlow.posY, static_cast<float>(worldSize.y))};
+            auto dist = sqrtf(delta.x * delta.x + delta.y * delta.y);
+            if (dist > radialFlow.radius) {
+                dist = radialFlow.radius;
+            }
+            if (Orientation::Clockwise == radialFlow.orientation) {
+                result += sqrtf(dist) * radialFlow.strength;
+            } else {
+                result -= sqrtf(dist) * radialFlow.strength;
+            }
+        }
+        return result;
+    }
+
+    int2 _worldSize;
+    int2 _gridSize;
+    float2 _nodeDistance;
+    float2* _velocities = nullptr;
+};
+
+//host-executable counterpart owning the node velocities
+class HostFlowFieldGrid
+{
+public:
+    HostFlowFieldGrid(int2 const& worldSize, int gridSpacing)
+    {
+        _grid.init(worldSize, gridSpacing);
+        _velocities.resize(_grid.getNumNodes());
+        _grid.setVelocities(_velocities.data());
+    }
+
+    void build(FlowFieldSettings const& settings)
+    {
+        for (int nodeIndex = 0; nodeIndex < _grid.getNumNodes(); ++nodeIndex) {
+            _grid.calcNodeVelocity(settings, nodeIndex);
+        }
+    }
+
+    float2 getVelocity(float2 const& pos) const { return _grid.getVelocity(pos); }
+
+private:
+    FlowFieldGrid _grid;
+    std::vector<float2> _velocities;
+};
@@ -4,37 +4,14 @@
 
 #include "ConstantMemory.cuh"
 
-namespace
+__global__ void cudaUpdateFlowFieldGrid(SimulationData data)
 {
-    __device__ float getHeight(float2 const& pos, BaseMap const& mapInfo)
-    {
-        float result = 0;
-        for (int i = 0; i < cudaFlowFieldSettings.numCenters; ++i) {
-            auto& radialFlow = cudaFlowFieldSettings.centers[i];
-            auto dist = mapInfo.getDistance(pos, float2{radialFlow.posX, radialFlow.posY});
-            if (dist > radialFlow.radius) {
-                dist = radialFlow.radius;
-            }
-            if (Orientation::Clockwise == radialFlow.orientation) {
-                result += sqrtf(dist) * radialFlow.strength;
-            } else {
-                result -= sqrtf(dist) * radialFlow.strength;
-            }
-        }
-        return result;
-    }
+    auto& grid = data.flowFieldGrid;
+    auto partition = calcPartition(grid.getNumNodes(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
 
-    __device__ float2 calcVelocity(float2 const& pos, BaseMap const& mapInfo)
-    {
-        auto baseValue = getHeight(pos, mapInfo);
-        auto downValue = getHeight(pos + float2{0, 1}, mapInfo);
-        auto rightValue = getHeight(pos + float2{1, 0}, mapInfo);
-        float2 result{rightValue - baseValue, downValue - baseValue};
-        Math::rotateQuarterClockwise(result);
-        return result;
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        grid.calcNodeVelocity(cudaFlowFieldSettings, index);
     }
-
-
 }
 
 __global__ void cudaApplyFlowFieldSettings(SimulationData data)
@@ -47,6 +24,6 @@ __global__ void cudaApplyFlowFieldSettings(SimulationData data)
         if (cell->barrier) {
             continue;
         }
-        cell->vel = cell->vel + calcVelocity(cell->absPos, data.cellMap);
+        cell->vel = cell->vel + data.flowFieldGrid.getVelocity(cell->absPos);
     }
 }
@@ -4,4 +4,5 @@
 #include "Map.cuh"
 #include "SimulationData.cuh"
 
-__global__ void cudaApplyFlowFieldSettings(SimulationData data);
\ No newline at end of file
+__global__ void cudaUpdateFlowFieldGrid(SimulationData data);
+__global__ void cudaApplyFlowFieldSettings(SimulationData data);
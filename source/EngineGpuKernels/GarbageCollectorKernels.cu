@@ -12,6 +12,7 @@ __global__ void cudaPrepareArraysForCleanup(SimulationData data)
     data.entitiesForCleanup.particles.reset();
     data.entitiesForCleanup.cells.reset();
     data.entitiesForCleanup.tokens.reset();
+    data.entitiesForCleanup.tokenMemory.reset();
     data.entitiesForCleanup.stringBytes.reset();
 }
 
@@ -80,6 +81,28 @@ __global__ void cudaCleanupTokens(Array<Token*> tokenPointers, Array<Token> newT
     }
 }
 
+__global__ void cudaCleanupTokenMemory(Array<Token*> tokenPointers, Array<char> tokenMemory, int oldStride, int newStride)
+{
+    auto partition = calcPartition(tokenPointers.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+
+    if (partition.numElements() > 0) {
+        char* newMemory = tokenMemory.getNewSubarray(partition.numElements() * newStride);
+
+        auto numBytesToCopy = min(oldStride, newStride);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto& token = tokenPointers.at(index);
+            for (int i = 0; i < numBytesToCopy; ++i) {
+                newMemory[i] = token->memory[i];
+            }
+            for (int i = numBytesToCopy; i < newStride; ++i) {
+                newMemory[i] = 0;
+            }
+            token->memory = newMemory;
+            newMemory += newStride;
+        }
+    }
+}
+
 namespace
 {
     __device__ void copyString(char*& string, int numBytes, RawMemory& stringBytes)
@@ -128,7 +151,14 @@ __global__ void cudaSwapArrays(SimulationData data)
     data.entities.cells.swapContent(data.entitiesForCleanup.cells);
     data.entities.tokens.swapContent(data.entitiesForCleanup.tokens);
     data.entities.particles.swapContent(data.entitiesForCleanup.particles);
+    data.entities.tokenMemory.swapContent(data.entitiesForCleanup.tokenMemory);
     data.entities.stringBytes.swapContent(data.entitiesForCleanup.stringBytes);
+    data.neighborList.invalidate();
+}
+
+__global__ void cudaSwapTokenMemory(SimulationData data)
+{
+    data.entities.tokenMemory.swapContent(data.entitiesForCleanup.tokenMemory);
 }
 
 
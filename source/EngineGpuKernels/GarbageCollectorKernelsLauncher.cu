@@ -29,6 +29,7 @@ void _GarbageCollectorKernelsLauncher::cleanupAfterTimestep(GpuSettings const& g
         KERNEL_CALL(cudaCleanupCellsStep1, data.entities.cellPointers, data.entitiesForCleanup.cells);
         KERNEL_CALL(cudaCleanupCellsStep2, data.entities.tokenPointers, data.entitiesForCleanup.cells);
         KERNEL_CALL(cudaCleanupTokens, data.entities.tokenPointers, data.entitiesForCleanup.tokens);
+        KERNEL_CALL(cudaCleanupTokenMemory, data.entities.tokenPointers, data.entitiesForCleanup.tokenMemory, data.tokenMemoryStride, data.tokenMemoryStride);
         KERNEL_CALL_1_1(cudaSwapArrays, data);
     }
 }
@@ -62,6 +63,7 @@ void _GarbageCollectorKernelsLauncher::copyArrays(GpuSettings const& gpuSettings
     KERNEL_CALL(cudaCleanupCellsStep1, data.entitiesForCleanup.cellPointers, data.entitiesForCleanup.cells);
     KERNEL_CALL(cudaCleanupCellsStep2, data.entitiesForCleanup.tokenPointers, data.entitiesForCleanup.cells);
     KERNEL_CALL(cudaCleanupTokens, data.entitiesForCleanup.tokenPointers, data.entitiesForCleanup.tokens);
+    KERNEL_CALL(cudaCleanupTokenMemory, data.entitiesForCleanup.tokenPointers, data.entitiesForCleanup.tokenMemory, data.tokenMemoryStride, data.tokenMemoryStride);
     KERNEL_CALL(cudaCleanupStringBytes, data.entitiesForCleanup.cellPointers, data.entitiesForCleanup.stringBytes);
 }
 
@@ -70,3 +72,14 @@ void _GarbageCollectorKernelsLauncher::swapArrays(GpuSettings const& gpuSettings
     KERNEL_CALL_1_1(cudaSwapPointerArrays, data);
     KERNEL_CALL_1_1(cudaSwapArrays, data);
 }
+
+void _GarbageCollectorKernelsLauncher::copyTokenMemory(GpuSettings const& gpuSettings, SimulationData const& data, int newTokenMemoryStride)
+{
+    KERNEL_CALL_1_1(cudaPrepareArraysForCleanup, data);
+    KERNEL_CALL(cudaCleanupTokenMemory, data.entities.tokenPointers, data.entitiesForCleanup.tokenMemory, data.tokenMemoryStride, newTokenMemoryStride);
+}
+
+void _GarbageCollectorKernelsLauncher::swapTokenMemory(GpuSettings const& gpuSettings, SimulationData const& data)
+{
+    KERNEL_CALL_1_1(cudaSwapTokenMemory, data);
+}
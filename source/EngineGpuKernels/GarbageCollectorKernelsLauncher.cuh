@@ -18,6 +18,10 @@ public:
     void copyArrays(GpuSettings const& gpuSettings, SimulationData const& simulationData);
     void swapArrays(GpuSettings const& gpuSettings, SimulationData const& simulationData);
 
+    //copies token memory to entitiesForCleanup with new stride, must be followed by swapTokenMemory
+    void copyTokenMemory(GpuSettings const& gpuSettings, SimulationData const& simulationData, int newTokenMemoryStride);
+    void swapTokenMemory(GpuSettings const& gpuSettings, SimulationData const& simulationData);
+
 private:
     //gpu memory
     bool* _cudaBool;
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include "CellListLayout.cuh"
+
+//host-executable counterpart of CellMap with the same bucket layout and queries (CellListBuckets), entities are referred
+//by their index
+class HostCellList
+{
+public:
+    HostCellList(int2 const& worldSize)
+        : _worldSize(worldSize)
+    {}
+
+    void build(std::vector<float2> const& positions)
+    {
+        auto numEntities = static_cast<int>(positions.size());
+        _layout.init(_worldSize, numEntities);
+        auto numBuckets = _layout.getNumBuckets();
+
+        //counting sort of the entities by bucket
+        _bucketStarts.assign(numBuckets + 1, 0);
+        std::vector<int> posIndices(numEntities);
+        for (int index = 0; index < numEntities; ++index) {
+            posIndices[index] = _layout.getPosIndex(positions[index]);
+            ++_bucketStarts[_layout.getBucket(posIndices[index]) + 1];
+        }
+        for (int i = 0; i < numBuckets; ++i) {
+            _bucketStarts[i + 1] += _bucketStarts[i];
+        }
+        std::vector<int> bucketFillLevels(_bucketStarts.begin(), _bucketStarts.end() - 1);
+        _sortedPosIndices.resize(numEntities);
+        _sortedEntries.resize(numEntities);
+        for (int index = 0; index < numEntities; ++index) {
+            auto sortedIndex = bucketFillLevels[_layout.getBucket(posIndices[index])]++;
+            _sortedPosIndices[sortedIndex] = posIndices[index];
+            _sortedEntries[sortedIndex] = {index, positions[index]};
+        }
+    }
+
+    //entities in the 3x3 unit squares around pos
+    void get(std::vector<int>& result, float2 const& pos) const
+    {
+        result.clear();
+        getBuckets().executeForEachInUnitSquares(pos, 1, [&](Entry const& entry) { result.emplace_back(entry.index); });
+    }
+
+    void get(std::vector<int>& result, float2 const& pos, float radius) const
+    {
+        result.clear();
+        getBuckets().executeForEachInUnitSquares(pos, static_cast<int>(std::ceil(radius)), [&](Entry const& entry) {
+            if (std::sqrt((entry.pos.x - pos.x) * (entry.pos.x - pos.x) + (entry.pos.y - pos.y) * (entry.pos.y - pos.y)) <= radius) {
+                result.emplace_back(entry.index);
+            }
+        });
+    }
+
+    //calls func for all entities within radius around pos, distances are corrected by the world boundaries as in CellMap
+    template <typename Func>
+    void executeForEach(float2 const& pos, float radius, Func const& func) const
+    {
+        getBuckets().executeForEachInUnitSquares(pos, static_cast<int>(std::ceil(radius)), [&](Entry const& entry) {
+            if (getDistance(entry.pos, pos) <= radius) {
+                func(entry.index);
+            }
+        });
+    }
+
+    float getDistance(float2 const& p, float2 const& q) const
+    {
+        auto dx = std::remainder(p.x - q.x, static_cast<float>(_worldSize.x));
+        auto dy = std::remainder(p.y - q.y, static_cast<float>(_worldSize.y));
+        return std::sqrt(dx * dx + dy * dy);
+    }
+
+    //returns -1 if the unit square is empty
+    int getFirst(float2 const& pos) const
+    {
+        auto result = -1;
+        getBuckets().executeForEachInUnitSquare(_layout.getPosIndex(pos), [&](Entry const& entry) {
+            if (result == -1) {
+                result = entry.index;
+            }
+        });
+        return result;
+    }
+
+    //same accounting as CellMap: bucket counts and starts, per-entity scratch data and sorted entries
+    size_t getMemorySize() const
+    {
+        return sizeof(int) * (2 * _bucketStarts.size() - 1) + (sizeof(int) * 3 + sizeof(void*)) * _sortedEntries.size();
+    }
+
+private:
+    //corresponds to the cell pointer of CellMap
+    struct Entry
+    {
+        int index;
+        float2 pos;
+    };
+
+    CellListBuckets<Entry> getBuckets() const { return {_layout, _bucketStarts.data(), _sortedPosIndices.data(), _sortedEntries.data()}; }
+
+    int2 _worldSize;
+    CellListLayout _layout;
+    std::vector<int> _bucketStarts;
+    std::vector<int> _sortedPosIndices;
+    std::vector<Entry> _sortedEntries;
+};
@@ -0,0 +1,319 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "EngineInterface/SimulationParameters.h"
+
+#include "CellArrays.cuh"
+
+//host-executable counterpart of CellProcessor::collisions and the verlet steps of CellProcessor for any cell storage
+//(HostCellArrays or HostCellRecords); scheduling of structural operations and spot parameters are not covered
+template <typename CellStorage>
+class HostCellProcessor
+{
+public:
+    HostCellProcessor(int2 const& worldSize, SimulationParameters const& parameters);
+
+    void collisions(CellStorage& cells);  //forces are accumulated in temp1
+
+    //same forces as collisions: each pair is visited once (half stencil) and the forces are accumulated per thread
+    //without atomics and reduced afterwards
+    void collisions(CellStorage& cells, int numThreads);
+
+    void verletUpdatePositions(CellStorage& cells);
+    void verletUpdateVelocities(CellStorage& cells);
+
+private:
+    using Handle = typename CellStorage::Handle;
+
+    void buildGrid(CellStorage& cells);
+    int getBinIndex(float2 const& pos) const;
+    void correctPosition(float2& pos) const;
+    void correctDirection(float2& disp) const;
+    void collide(Handle const& cell, Handle const& otherCell);
+    bool calcPairForce(Handle const& cell, Handle const& otherCell, float2& force) const;  //force on cell incl. reaction
+    float2 calcCollisionForce(Handle const& cell, float2 const& posDelta, float2 const& velDelta, float distance, bool isApproaching) const;
+    template <typename Func>
+    void executeForEachNeighborBin(int binIndex, Func const& func) const;
+
+    int2 _worldSize;
+    SimulationParameters _parameters;
+
+    //cell indices sorted by bin (bin size >= cellMaxCollisionDistance)
+    int2 _gridSize;
+    float _binSize;
+    std::vector<int> _binStarts;
+    std::vector<int> _sortedCellIndices;
+    std::vector<int> _binIndices;
+    std::vector<std::vector<float2>> _threadForces;
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+template <typename CellStorage>
+HostCellProcessor<CellStorage>::HostCellProcessor(int2 const& worldSize, SimulationParameters const& parameters)
+    : _worldSize(worldSize)
+    , _parameters(parameters)
+{
+    _binSize = std::max(1.0f, std::ceil(parameters.cellMaxCollisionDistance));
+    _gridSize = {
+        std::max(1, static_cast<int>(static_cast<float>(worldSize.x) / _binSize)),
+        std::max(1, static_cast<int>(static_cast<float>(worldSize.y) / _binSize))};
+}
+
+template <typename CellStorage>
+void HostCellProcessor<CellStorage>::collisions(CellStorage& cells)
+{
+    buildGrid(cells);
+
+    for (int index = 0; index < cells.getNumCells(); ++index) {
+        auto cell = cells.getHandle(index);
+        executeForEachNeighborBin(_binIndices[index], [&](int scanBinIndex) {
+            for (int i = _binStarts[scanBinIndex]; i < _binStarts[scanBinIndex + 1]; ++i) {
+                auto otherIndex = _sortedCellIndices[i];
+                if (otherIndex != index) {
+                    collide(cell, cells.getHandle(otherIndex));
+                }
+            }
+        });
+    }
+}
+
+template <typename CellStorage>
+void HostCellProcessor<CellStorage>::collisions(CellStorage& cells, int numThreads)
+{
+    buildGrid(cells);
+
+    auto numCells = cells.getNumCells();
+    auto numBins = _gridSize.x * _gridSize.y;
+    numThreads = std::max(1, numThreads);
+    _threadForces.resize(numThreads);
+
+    auto accumulateForces = [&](int threadIndex) {
+        auto& forces = _threadForces[threadIndex];
+        forces.assign(numCells, float2{0, 0});
+        for (int binIndex = numBins * threadIndex / numThreads; binIndex < numBins * (threadIndex + 1) / numThreads; ++binIndex) {
+            for (int i = _binStarts[binIndex]; i < _binStarts[binIndex + 1]; ++i) {
+                auto index = _sortedCellIndices[i];
+                auto cell = cells.getHandle(index);
+                executeForEachNeighborBin(binIndex, [&](int scanBinIndex) {
+                    for (int j = _binStarts[scanBinIndex]; j < _binStarts[scanBinIndex + 1]; ++j) {
+                        auto otherIndex = _sortedCellIndices[j];
+                        float2 force;
+                        if (otherIndex > index && calcPairForce(cell, cells.getHandle(otherIndex), force)) {
+                            forces[index].x += force.x;
+                            forces[index].y += force.y;
+                            forces[otherIndex].x -= force.x;
+                            forces[otherIndex].y -= force.y;
+                        }
+                    }
+                });
+            }
+        }
+    };
+    auto reduceForces = [&](int threadIndex) {
+        for (int index = numCells * threadIndex / numThreads; index < numCells * (threadIndex + 1) / numThreads; ++index) {
+            auto& temp1 = cells.getHandle(index).temp1();
+            for (auto const& forces : _threadForces) {
+                temp1.x += forces[index].x;
+                temp1.y += forces[index].y;
+            }
+        }
+    };
+
+    for (auto const& pass : {std::function<void(int)>(accumulateForces), std::function<void(int)>(reduceForces)}) {
+        std::vector<std::thread> threads;
+        for (int threadIndex = 1; threadIndex < numThreads; ++threadIndex) {
+            threads.emplace_back(pass, threadIndex);
+        }
+        pass(0);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+}
+
+template <typename CellStorage>
+void HostCellProcessor<CellStorage>::verletUpdatePositions(CellStorage& cells)
+{
+    auto timestepSize = _parameters.timestepSize;
+    for (int index = 0; index < cells.getNumCells(); ++index) {
+        auto cell = cells.getHandle(index);
+        if (cell.barrier()) {
+            continue;
+        }
+        auto& absPos = cell.absPos();
+        auto& vel = cell.vel();
+        auto& temp1 = cell.temp1();
+        absPos.x += vel.x * timestepSize + temp1.x * timestepSize * timestepSize / 2;
+        absPos.y += vel.y * timestepSize + temp1.y * timestepSize * timestepSize / 2;
+        correctPosition(absPos);
+        cell.temp2() = temp1;  //forces
+        temp1 = {0, 0};
+    }
+}
+
+template <typename CellStorage>
+void HostCellProcessor<CellStorage>::verletUpdateVelocities(CellStorage& cells)
+{
+    auto timestepSize = _parameters.timestepSize;
+    for (int index = 0; index < cells.getNumCells(); ++index) {
+        auto cell = cells.getHandle(index);
+        auto& vel = cell.vel();
+        if (cell.barrier()) {
+            vel = {0, 0};
+        } else {
+            vel.x += (cell.temp1().x + cell.temp2().x) / 2 * timestepSize;
+            vel.y += (cell.temp1().y + cell.temp2().y) / 2 * timestepSize;
+        }
+    }
+}
+
+template <typename CellStorage>
+void HostCellProcessor<CellStorage>::buildGrid(CellStorage& cells)
+{
+    auto numBins = _gridSize.x * _gridSize.y;
+    auto numCells = cells.getNumCells();
+
+    //counting sort of the cell indices by bin
+    _binStarts.assign(numBins + 1, 0);
+    _binIndices.resize(numCells);
+    for (int index = 0; index < numCells; ++index) {
+        _binIndices[index] = getBinIndex(cells.getHandle(index).absPos());
+        ++_binStarts[_binIndices[index] + 1];
+    }
+    for (int i = 0; i < numBins; ++i) {
+        _binStarts[i + 1] += _binStarts[i];
+    }
+    _sortedCellIndices.resize(numCells);
+    std::vector<int> binFillLevels(_binStarts.begin(), _binStarts.end() - 1);
+    for (int index = 0; index < numCells; ++index) {
+        _sortedCellIndices[binFillLevels[_binIndices[index]]++] = index;
+    }
+}
+
+template <typename CellStorage>
+int HostCellProcessor<CellStorage>::getBinIndex(float2 const& pos) const
+{
+    auto x = std::min(_gridSize.x - 1, std::max(0, static_cast<int>(pos.x / _binSize)));
+    auto y = std::min(_gridSize.y - 1, std::max(0, static_cast<int>(pos.y / _binSize)));
+    return x + y * _gridSize.x;
+}
+
+template <typename CellStorage>
+void HostCellProcessor<CellStorage>::correctPosition(float2& pos) const
+{
+    auto intPartX = static_cast<int>(std::floor(pos.x));
+    auto intPartY = static_cast<int>(std::floor(pos.y));
+    float2 fracPart{pos.x - intPartX, pos.y - intPartY};
+    intPartX = ((intPartX % _worldSize.x) + _worldSize.x) % _worldSize.x;
+    intPartY = ((intPartY % _worldSize.y) + _worldSize.y) % _worldSize.y;
+    pos = {static_cast<float>(intPartX) + fracPart.x, static_cast<float>(intPartY) + fracPart.y};
+}
+
+template <typename CellStorage>
+void HostCellProcessor<CellStorage>::correctDirection(float2& disp) const
+{
+    disp.x = std::remainder(disp.x, static_cast<float>(_worldSize.x));
+    disp.y = std::remainder(disp.y, static_cast<float>(_worldSize.y));
+}
+
+template <typename CellStorage>
+template <typename Func>
+void HostCellProcessor<CellStorage>::executeForEachNeighborBin(int binIndex, Func const& func) const
+{
+    int2 bin{binIndex % _gridSize.x, binIndex / _gridSize.x};
+    int scannedBins[9];
+    int numScannedBins = 0;
+    for (int dx = -1; dx <= 1; ++dx) {
+        for (int dy = -1; dy <= 1; ++dy) {
+            int2 scanBin{(bin.x + dx + _gridSize.x) % _gridSize.x, (bin.y + dy + _gridSize.y) % _gridSize.y};
+            auto scanBinIndex = scanBin.x + scanBin.y * _gridSize.x;
+
+            //small worlds may wrap to the same bin several times
+            if (std::find(scannedBins, scannedBins + numScannedBins, scanBinIndex) != scannedBins + numScannedBins) {
+                continue;
+            }
+            scannedBins[numScannedBins++] = scanBinIndex;
+            func(scanBinIndex);
+        }
+    }
+}
+
+template <typename CellStorage>
+void HostCellProcessor<CellStorage>::collide(Handle const& cell, Handle const& otherCell)
+{
+    float2 posDelta{cell.absPos().x - otherCell.absPos().x, cell.absPos().y - otherCell.absPos().y};
+    correctDirection(posDelta);
+
+    auto distance = std::sqrt(posDelta.x * posDelta.x + posDelta.y * posDelta.y);
+    if (distance >= _parameters.cellMaxCollisionDistance) {
+        return;
+    }
+
+    for (int i = 0; i < cell.numConnections(); ++i) {
+        if (cell.connection(i).cellIndex == otherCell.getIndex()) {
+            return;
+        }
+    }
+
+    float2 velDelta{cell.vel().x - otherCell.vel().x, cell.vel().y - otherCell.vel().y};
+    auto isApproaching = posDelta.x * velDelta.x + posDelta.y * velDelta.y < 0;
+    auto force = calcCollisionForce(cell, posDelta, velDelta, distance, isApproaching);
+    cell.temp1().x += force.x;
+    cell.temp1().y += force.y;
+    otherCell.temp1().x -= force.x;
+    otherCell.temp1().y -= force.y;
+}
+
+template <typename CellStorage>
+bool HostCellProcessor<CellStorage>::calcPairForce(Handle const& cell, Handle const& otherCell, float2& force) const
+{
+    float2 posDelta{cell.absPos().x - otherCell.absPos().x, cell.absPos().y - otherCell.absPos().y};
+    correctDirection(posDelta);
+
+    auto distance = std::sqrt(posDelta.x * posDelta.x + posDelta.y * posDelta.y);
+    if (distance >= _parameters.cellMaxCollisionDistance) {
+        return false;
+    }
+
+    for (int i = 0; i < cell.numConnections(); ++i) {
+        if (cell.connection(i).cellIndex == otherCell.getIndex()) {
+            return false;
+        }
+    }
+
+    float2 velDelta{cell.vel().x - otherCell.vel().x, cell.vel().y - otherCell.vel().y};
+    auto isApproaching = posDelta.x * velDelta.x + posDelta.y * velDelta.y < 0;
+    auto action = calcCollisionForce(cell, posDelta, velDelta, distance, isApproaching);
+    auto reaction = calcCollisionForce(otherCell, float2{-posDelta.x, -posDelta.y}, float2{-velDelta.x, -velDelta.y}, distance, isApproaching);
+    force = {action.x - reaction.x, action.y - reaction.y};
+    return true;
+}
+
+template <typename CellStorage>
+float2 HostCellProcessor<CellStorage>::calcCollisionForce(
+    Handle const& cell,
+    float2 const& posDelta,
+    float2 const& velDelta,
+    float distance,
+    bool isApproaching) const
+{
+    auto const& vel = cell.vel();
+    auto barrierFactor = cell.barrier() ? 2.0f : 1.0f;
+    if (std::sqrt(vel.x * vel.x + vel.y * vel.y) > 0.5f && isApproaching) {
+        auto distanceSquared = distance * distance + 0.25f;
+        auto factor = (posDelta.x * velDelta.x + posDelta.y * velDelta.y) / (-2 * distanceSquared) * barrierFactor;
+        return {posDelta.x * factor, posDelta.y * factor};
+    }
+    auto factor = distance > 0
+        ? (_parameters.cellMaxCollisionDistance - distance) * _parameters.cellRepulsionStrength * barrierFactor / distance
+        : 0.0f;
+    return {posDelta.x * factor, posDelta.y * factor};
+}
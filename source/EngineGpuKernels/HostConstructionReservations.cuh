@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Base/ParallelAlgorithms.h"
+
+#include "ConstructionPriority.cuh"
+
+struct HostConstructionRequest
+{
+    uint64_t priority = 0;  //see calcConstructionPriority
+    std::vector<int> cellIndices;  //all cells which may be modified by the construction
+};
+
+//host-executable counterpart of ConstructionReservations and the construction rounds of ConstructionProcessor with the
+//same claim rules (ConstructionClaim), request indices take the role of the token indices
+class HostConstructionReservations
+{
+public:
+    //getRequest(requestIndex) is evaluated for each pending request at the beginning of a round since executed
+    //constructions change the construction sites, execute(requestIndex) is called in parallel for the granted requests
+    //returns the number of rounds
+    template <typename GetRequestFunc, typename ExecuteFunc>
+    int executeConstructions(int numRequests, GetRequestFunc const& getRequest, ExecuteFunc const& execute)
+    {
+        std::vector<int> pendingIndices(numRequests);
+        for (int i = 0; i < numRequests; ++i) {
+            pendingIndices[i] = i;
+        }
+
+        int result = 0;
+        std::vector<HostConstructionRequest> requests;
+        std::vector<char> granted;
+        while (!pendingIndices.empty()) {
+            auto numPending = static_cast<int>(pendingIndices.size());
+            requests.resize(numPending);
+            ParallelAlgorithms::parallelFor(
+                0, numPending, [&](int index) { requests[index] = getRequest(pendingIndices[index]); }, GrainSize);
+            ensureCapacity(requests);
+
+            ParallelAlgorithms::parallelFor(
+                0,
+                numPending,
+                [&](int index) {
+                    for (auto const& cellIndex : requests[index].cellIndices) {
+                        atomicMin(_priorities[cellIndex], requests[index].priority);
+                    }
+                },
+                GrainSize);
+            ParallelAlgorithms::parallelFor(
+                0,
+                numPending,
+                [&](int index) {
+                    for (auto const& cellIndex : requests[index].cellIndices) {
+                        if (ConstructionClaim::isTieCandidate(_priorities[cellIndex].load(), requests[index].priority)) {
+                            atomicMin(_requestIndices[cellIndex], pendingIndices[index]);
+                        }
+                    }
+                },
+                GrainSize);
+            granted.assign(numPending, 1);
+            ParallelAlgorithms::parallelFor(
+                0,
+                numPending,
+                [&](int index) {
+                    for (auto const& cellIndex : requests[index].cellIndices) {
+                        if (!ConstructionClaim::isClaimedBy(
+                                _priorities[cellIndex].load(), _requestIndices[cellIndex].load(), requests[index].priority, pendingIndices[index])) {
+                            granted[index] = 0;
+                        }
+                    }
+                },
+                GrainSize);
+            ParallelAlgorithms::parallelFor(
+                0,
+                numPending,
+                [&](int index) {
+                    for (auto const& cellIndex : requests[index].cellIndices) {
+                        _priorities[cellIndex] = ConstructionClaim::NotClaimed;
+                        _requestIndices[cellIndex] = ConstructionClaim::NoTokenIndex;
+                    }
+                },
+                GrainSize);
+            ParallelAlgorithms::parallelFor(
+                0,
+                numPending,
+                [&](int index) {
+                    if (granted[index]) {
+                        execute(pendingIndices[index]);
+                    }
+                },
+                GrainSize);
+
+            int numRemaining = 0;
+            for (int index = 0; index < numPending; ++index) {
+                if (!granted[index]) {
+                    pendingIndices[numRemaining++] = pendingIndices[index];
+                }
+            }
+            pendingIndices.resize(numRemaining);
+            ++result;
+        }
+        return result;
+    }
+
+private:
+    static auto constexpr GrainSize = 1024;
+
+    template <typename T>
+    static void atomicMin(std::atomic<T>& target, T value)
+    {
+        auto origValue = target.load();
+        while (value < origValue && !target.compare_exchange_weak(origValue, value)) {
+        }
+    }
+
+    void ensureCapacity(std::vector<HostConstructionRequest> const& requests)
+    {
+        int numCells = 0;
+        for (auto const& request : requests) {
+            for (auto const& cellIndex : request.cellIndices) {
+                numCells = std::max(numCells, cellIndex + 1);
+            }
+        }
+        if (numCells <= _numCells) {
+            return;
+        }
+        _numCells = std::max(numCells, _numCells * 2);
+        _priorities = std::make_unique<std::atomic<uint64_t>[]>(_numCells);
+        _requestIndices = std::make_unique<std::atomic<int>[]>(_numCells);
+        for (int i = 0; i < _numCells; ++i) {
+            _priorities[i] = ConstructionClaim::NotClaimed;
+            _requestIndices[i] = ConstructionClaim::NoTokenIndex;
+        }
+    }
+
+    int _numCells = 0;
+    std::unique_ptr<std::atomic<uint64_t>[]> _priorities;
+    std::unique_ptr<std::atomic<int>[]> _requestIndices;
+};
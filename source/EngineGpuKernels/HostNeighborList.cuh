@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Base/ParallelAlgorithms.h"
+
+#include "HostCellList.cuh"
+#include "NeighborListLayout.cuh"
+
+//host-executable counterpart of NeighborList with the same CSR layout and rebuild rule (NeighborListLayout), entities
+//are referred by their index and identified across updates by their id
+class HostNeighborList
+{
+public:
+    HostNeighborList(int2 const& worldSize, float cutoff)
+        : _worldSize(worldSize)
+        , _cellList(worldSize)
+        , _cutoff(cutoff)
+        , _newEntityBlockStamps(NeighborListLayout::getNumNewEntityBlocks(worldSize), 0)
+    {}
+
+    //rebuilds the list if a listed entity is outdated, returns true if the list has been rebuilt
+    //as in NeighborList entities removed since the last build are skipped and entities added since the last build are
+    //looked up in the cell list, by themselves and by the listed entities around them
+    bool update(std::vector<float2> const& positions, std::vector<uint64_t> const& ids)
+    {
+        if (_neighborStarts.empty()) {
+            rebuild(positions, ids);
+            return true;
+        }
+        auto numEntities = static_cast<int>(positions.size());
+        _listIndices.resize(numEntities);
+        _entityIndices.assign(_refPositions.size(), -1);
+        _hasNewEntities = false;
+        ++_updateNumber;
+        for (int index = 0; index < numEntities; ++index) {
+            auto findResult = _listIndexById.find(ids[index]);
+            if (findResult == _listIndexById.end()) {
+                _listIndices[index] = -1;
+                NeighborListLayout::executeForEachBlockAroundNewEntity(
+                    toPosInt(positions[index]), _cutoff, _worldSize, [&](int block) { _newEntityBlockStamps[block] = _updateNumber; });
+                _hasNewEntities = true;
+                continue;
+            }
+            auto listIndex = findResult->second;
+            _listIndices[index] = listIndex;
+            _entityIndices[listIndex] = index;
+            if (NeighborListLayout::isOutdated(_cellList.getDistance(positions[index], _refPositions[listIndex]))) {
+                rebuild(positions, ids);
+                return true;
+            }
+        }
+
+        //corresponds to the cell map of the GPU engine which is built in each time step
+        if (_hasNewEntities) {
+            _cellList.build(positions);
+        }
+        return false;
+    }
+
+    void rebuild(std::vector<float2> const& positions, std::vector<uint64_t> const& ids)
+    {
+        auto numEntities = static_cast<int>(positions.size());
+        _cellList.build(positions);
+        _refPositions = positions;
+        _listIndexById.clear();
+        _listIndexById.reserve(numEntities);
+        _listIndices.resize(numEntities);
+        _entityIndices.resize(numEntities);
+        for (int index = 0; index < numEntities; ++index) {
+            _listIndexById.emplace(ids[index], index);
+            _listIndices[index] = index;
+            _entityIndices[index] = index;
+        }
+        _hasNewEntities = false;
+
+        std::vector<int> neighborCounts(numEntities);
+        ParallelAlgorithms::parallelFor(
+            0,
+            numEntities,
+            [&](int index) {
+                int numNeighbors = 0;
+                _cellList.executeForEach(positions[index], NeighborListLayout::getBuildRadius(_cutoff), [&](int otherIndex) {
+                    if (otherIndex != index) {
+                        ++numNeighbors;
+                    }
+                });
+                neighborCounts[index] = numNeighbors;
+            },
+            GrainSize);
+
+        _neighborStarts.assign(numEntities + 1, 0);
+        for (int index = 0; index < numEntities; ++index) {
+            _neighborStarts[index + 1] = _neighborStarts[index] + neighborCounts[index];
+        }
+
+        _neighbors.resize(_neighborStarts[numEntities]);
+        ParallelAlgorithms::parallelFor(
+            0,
+            numEntities,
+            [&](int index) {
+                auto neighborIndex = _neighborStarts[index];
+                _cellList.executeForEach(positions[index], NeighborListLayout::getBuildRadius(_cutoff), [&](int otherIndex) {
+                    if (otherIndex != index) {
+                        _neighbors[neighborIndex++] = otherIndex;
+                    }
+                });
+            },
+            GrainSize);
+    }
+
+    //calls func for all other entities within radius (<= cutoff) around the entity at index
+    template <typename Func>
+    void executeForEach(int index, float radius, std::vector<float2> const& positions, Func const& func) const
+    {
+        auto listIndex = _listIndices[index];
+        if (listIndex == -1) {
+            _cellList.executeForEach(positions[index], radius, [&](int otherIndex) {
+                if (otherIndex != index) {
+                    func(otherIndex);
+                }
+            });
+            return;
+        }
+        NeighborListRanges<int>(_neighborStarts.data(), _neighbors.data()).executeForEach(listIndex, [&](int otherListIndex) {
+            auto otherIndex = _entityIndices[otherListIndex];
+            if (otherIndex != -1 && _cellList.getDistance(positions[otherIndex], positions[index]) <= radius) {
+                func(otherIndex);
+            }
+        });
+        if (_hasNewEntities
+            && _newEntityBlockStamps[NeighborListLayout::getNewEntityBlock(toPosInt(positions[index]), _worldSize)] == _updateNumber) {
+            _cellList.executeForEach(positions[index], radius, [&](int otherIndex) {
+                if (_listIndices[otherIndex] == -1) {
+                    func(otherIndex);
+                }
+            });
+        }
+    }
+
+    void get(std::vector<int>& result, int index, float radius, std::vector<float2> const& positions) const
+    {
+        result.clear();
+        executeForEach(index, radius, positions, [&](int otherIndex) { result.emplace_back(otherIndex); });
+    }
+
+    int getNumNeighbors() const { return _neighborStarts.empty() ? 0 : _neighborStarts.back(); }
+
+    //same accounting as NeighborList: ranges, reference positions and neighbors
+    size_t getMemorySize() const
+    {
+        auto numEntities = _refPositions.size();
+        return sizeof(int) * (2 * numEntities + 1) + sizeof(float2) * numEntities + sizeof(void*) * _neighbors.size();
+    }
+
+private:
+    static auto constexpr GrainSize = 1024;
+
+    static int2 toPosInt(float2 const& pos) { return {static_cast<int>(std::floor(pos.x)), static_cast<int>(std::floor(pos.y))}; }
+
+    int2 _worldSize;
+    HostCellList _cellList;
+    float _cutoff;
+    std::vector<float2> _refPositions;
+    std::vector<int> _neighborStarts;
+    std::vector<int> _neighbors;   //list indices
+
+    //correspond to Cell::neighborListIndex
+    std::unordered_map<uint64_t, int> _listIndexById;
+    std::vector<int> _listIndices;     //per entity, -1 = added since the last build
+    std::vector<int> _entityIndices;   //per list index, -1 = removed since the last build
+    bool _hasNewEntities = false;
+    int _updateNumber = 0;
+    std::vector<int> _newEntityBlockStamps;   //per block: number of the last update which marked the block
+};
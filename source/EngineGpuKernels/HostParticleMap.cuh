@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Base/ParallelAlgorithms.h"
+
+#include "ParticleBins.cuh"
+
+struct HostParticle
+{
+    uint64_t id;
+    float2 absPos;
+    float2 vel;
+    float energy;
+};
+
+struct HostAbsorbingCell
+{
+    uint64_t id;
+    float2 absPos;
+    float energy;
+    bool barrier;
+};
+
+//host-executable counterpart of ParticleMap and ParticleProcessor::collision with the same bucket layout and the same
+//bin rules (ParticleBins)
+class HostParticleMap
+{
+public:
+    //mergeDistance corresponds to SimulationParameters::particleMergeDistance
+    HostParticleMap(int2 const& worldSize, float mergeDistance)
+        : _worldSize(worldSize)
+        , _mergeDistance(mergeDistance)
+    {}
+
+    void build(std::vector<HostParticle> const& particles)
+    {
+        auto numEntities = static_cast<int>(particles.size());
+        _layout.init(_worldSize, numEntities);
+        auto numBuckets = _layout.getNumBuckets();
+
+        //counting sort of the particles by bucket
+        _bucketStarts.assign(numBuckets + 1, 0);
+        _entityPosIndices.resize(numEntities);
+        _entityIds.resize(numEntities);
+        for (int index = 0; index < numEntities; ++index) {
+            _entityPosIndices[index] = _layout.getPosIndex(particles[index].absPos);
+            _entityIds[index] = particles[index].id;
+            ++_bucketStarts[_layout.getBucket(_entityPosIndices[index]) + 1];
+        }
+        for (int i = 0; i < numBuckets; ++i) {
+            _bucketStarts[i + 1] += _bucketStarts[i];
+        }
+        std::vector<int> bucketFillLevels(_bucketStarts.begin(), _bucketStarts.end() - 1);
+        _sortedPosIndices.resize(numEntities);
+        _sortedEntityIndices.resize(numEntities);
+        for (int index = 0; index < numEntities; ++index) {
+            auto sortedIndex = bucketFillLevels[_layout.getBucket(_entityPosIndices[index])]++;
+            _sortedPosIndices[sortedIndex] = _entityPosIndices[index];
+            _sortedEntityIndices[sortedIndex] = index;
+        }
+
+        _entitySortedIndices.resize(numEntities);
+        ParallelAlgorithms::parallelFor(
+            0,
+            numBuckets,
+            [&](int bucket) {
+                ParticleBins::sortBucket(
+                    _bucketStarts[bucket],
+                    _bucketStarts[bucket + 1],
+                    _sortedPosIndices.data(),
+                    _sortedEntityIndices.data(),
+                    _entityIds.data(),
+                    _entitySortedIndices.data());
+            },
+            GrainSize);
+    }
+
+    //merged and absorbed particles are removed, the order of the remaining particles is kept
+    void collision(std::vector<HostParticle>& particles, std::vector<HostAbsorbingCell>& cells, int grainSize = 4096)
+    {
+        build(particles);
+
+        //non-barrier cell with the smallest id per unit square
+        std::unordered_map<int, int> cellIndexByPosIndex;
+        for (int index = 0; index < static_cast<int>(cells.size()); ++index) {
+            if (cells[index].barrier) {
+                continue;
+            }
+            auto [iter, inserted] = cellIndexByPosIndex.emplace(_layout.getPosIndex(cells[index].absPos), index);
+            if (!inserted && cells[index].id < cells[iter->second].id) {
+                iter->second = index;
+            }
+        }
+
+        ParticleAccess access{particles, std::vector<char>(particles.size(), 0)};
+        auto const bins = getBins();
+        ParallelAlgorithms::parallelFor(
+            0,
+            static_cast<int>(particles.size()),
+            [&](int sortedIndex) {
+                auto leaderIndex = _sortedEntityIndices[sortedIndex];
+                if (!bins.isLeader(leaderIndex)) {
+                    return;
+                }
+                auto cellFindResult = cellIndexByPosIndex.find(_entityPosIndices[leaderIndex]);
+                auto cell = cellFindResult != cellIndexByPosIndex.end() ? &cells[cellFindResult->second] : nullptr;
+                bins.collide(leaderIndex, access, cell, _mergeDistance);
+            },
+            grainSize);
+
+        int numRemaining = 0;
+        for (int index = 0; index < static_cast<int>(particles.size()); ++index) {
+            if (!access.removed[index]) {
+                particles[numRemaining++] = particles[index];
+            }
+        }
+        particles.resize(numRemaining);
+    }
+
+private:
+    //corresponds to ParticlePointerAccess
+    struct ParticleAccess
+    {
+        std::vector<HostParticle>& particles;
+        std::vector<char> removed;
+
+        HostParticle& get(int index) { return particles[index]; }
+        void remove(int index)
+        {
+            particles[index].energy = 0;
+            removed[index] = 1;
+        }
+    };
+
+    ParticleBins getBins() const
+    {
+        return {
+            CellListBuckets<int>(_layout, _bucketStarts.data(), _sortedPosIndices.data(), _sortedEntityIndices.data()),
+            _entityPosIndices.data(),
+            _entitySortedIndices.data()};
+    }
+
+    static auto constexpr GrainSize = 4096;
+
+    int2 _worldSize;
+    float _mergeDistance;
+    CellListLayout _layout;
+    std::vector<int> _bucketStarts;
+    std::vector<int> _entityPosIndices;
+    std::vector<uint64_t> _entityIds;
+    std::vector<int> _sortedPosIndices;
+    std::vector<int> _sortedEntityIndices;
+    std::vector<int> _entitySortedIndices;
+};
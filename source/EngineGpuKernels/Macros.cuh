@@ -48,5 +48,7 @@ void checkAndThrowError(T result, char const *const func, const char *const file
 
 #define KERNEL_CALL_1_1(func, ...) func<<<1, 1>>>(__VA_ARGS__);
 
+#define KERNEL_CALL_1_BLOCK(func, ...) func<<<1, gpuSettings.numThreadsPerBlock>>>(__VA_ARGS__);
+
 #define KERNEL_CALL(func, ...) \
     func<<<gpuSettings.numBlocks, gpuSettings.numThreadsPerBlock>>>(__VA_ARGS__);
@@ -4,6 +4,8 @@
 #include "Cell.cuh"
 #include "Particle.cuh"
 #include "Math.cuh"
+#include "CellListLayout.cuh"
+#include "ParticleBins.cuh"
 #include "cuda_runtime_api.h"
 
 class BaseMap
@@ -72,196 +74,277 @@ class BasicMap : public BaseMap
 public:
 };
 
+//cell list built by counting sort: cells are counted per bucket, the counts are converted to ranges by a prefix sum
+//and the cells are scattered into the ranges; memory is proportional to the number of cells and a unit square can hold any
+//number of cells
 class CellMap : public BaseMap
 {
 public:
     __host__ __inline__ void init(int2 const& size)
     {
         BaseMap::init(size);
-        CudaMemoryManager::getInstance().acquireMemory<Cell*>(size.x * size.y * 2, _map);
-        _mapEntries.init();
-
-        std::vector<Cell*> hostMap(size.x * size.y * 2, 0);
-        CHECK_FOR_CUDA_ERROR(cudaMemcpy(_map, hostMap.data(), sizeof(Cell*) * size.x * size.y * 2, cudaMemcpyHostToDevice));
+        resize(1);
     }
 
-    __host__ __inline__ void resize(int maxEntries) { _mapEntries.resize(maxEntries); }
-
-    __device__ __inline__ void reset() { _mapEntries.reset(); }
+    __host__ __inline__ void resize(int maxEntries)
+    {
+        free();
+        _layout.init(_size, maxEntries);
+        auto numBuckets = _layout.getNumBuckets();
+        CudaMemoryManager::getInstance().acquireMemory<int>(numBuckets, _bucketCounts);
+        CudaMemoryManager::getInstance().acquireMemory<int>(numBuckets + 1, _bucketStarts);
+        CudaMemoryManager::getInstance().acquireMemory<int>(maxEntries, _entityPosIndices);
+        CudaMemoryManager::getInstance().acquireMemory<int>(maxEntries, _entityOffsets);
+        CudaMemoryManager::getInstance().acquireMemory<int>(maxEntries, _sortedPosIndices);
+        CudaMemoryManager::getInstance().acquireMemory<Cell*>(maxEntries, _sortedCells);
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_bucketCounts, 0, sizeof(int) * numBuckets));
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_bucketStarts, 0, sizeof(int) * (numBuckets + 1)));
+    }
 
     __host__ __inline__ void free()
     {
-        CudaMemoryManager::getInstance().freeMemory(_map);
-        _mapEntries.free();
+        CudaMemoryManager::getInstance().freeMemory(_bucketCounts);
+        CudaMemoryManager::getInstance().freeMemory(_bucketStarts);
+        CudaMemoryManager::getInstance().freeMemory(_entityPosIndices);
+        CudaMemoryManager::getInstance().freeMemory(_entityOffsets);
+        CudaMemoryManager::getInstance().freeMemory(_sortedPosIndices);
+        CudaMemoryManager::getInstance().freeMemory(_sortedCells);
     }
 
-    __device__ __inline__ void set_block(int numEntities, Cell** entities)
+    //first pass: count cells per bucket
+    __device__ __inline__ void set_system(int numEntities, Cell** entities)
     {
-        if (0 == numEntities) {
-            return;
+        auto const partition = calcAllThreadsPartition(numEntities);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto posIndex = _layout.getPosIndex(entities[index]->absPos);
+            _entityPosIndices[index] = posIndex;
+            _entityOffsets[index] = atomicAdd(&_bucketCounts[_layout.getBucket(posIndex)], 1);
         }
+    }
 
-        __shared__ int* entrySubarray;
-        if (0 == threadIdx.x) {
-            entrySubarray = _mapEntries.getNewSubarray(numEntities);
-        }
-        __syncthreads();
+    //second pass: exclusive prefix sum of the counts, needs to be executed by a single block
+    __device__ __inline__ void prepareRanges_block() { exclusiveScan_block(_bucketCounts, _bucketStarts, _layout.getNumBuckets()); }
 
-        auto partition = calcPartition(numEntities, threadIdx.x, blockDim.x);
+    //third pass: scatter cells into the bucket ranges
+    __device__ __inline__ void sort_system(int numEntities, Cell** entities)
+    {
+        auto const partition = calcAllThreadsPartition(numEntities);
         for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
-            auto const& entity = entities[index];
-            int2 posInt = {floorInt(entity->absPos.x), floorInt(entity->absPos.y)};
-            correctPosition(posInt);
-            auto mapEntry = (posInt.x + posInt.y * _size.x) * 2;
-            auto old = reinterpret_cast<Cell*>(atomicCAS(
-                reinterpret_cast<unsigned long long int*>(&_map[mapEntry]),
-                reinterpret_cast<unsigned long long int>(nullptr),
-                reinterpret_cast<unsigned long long int>(entity)));
-            if (old != nullptr) {
-                alienAtomicExch(&_map[mapEntry + 1], entity);
-            }
-            entrySubarray[index] = mapEntry;
+            auto posIndex = _entityPosIndices[index];
+            auto sortedIndex = _bucketStarts[_layout.getBucket(posIndex)] + _entityOffsets[index];
+            _sortedPosIndices[sortedIndex] = posIndex;
+            _sortedCells[sortedIndex] = entities[index];
         }
-        __syncthreads();
     }
 
-    //returns at most 18 cells
-    __device__ __inline__ void get(Cell* cells[], int& numCells, float2 const& pos) const
+    //calls func for all cells in the 3x3 unit squares around pos
+    template <typename Func>
+    __device__ __inline__ void executeForEach(float2 const& pos, Func const& func) const
+    {
+        getBuckets().executeForEachInUnitSquares(pos, 1, func);
+    }
+
+    //calls func for all cells within radius around pos
+    template <typename Func>
+    __device__ __inline__ void executeForEach(float2 const& pos, float radius, Func const& func) const
+    {
+        getBuckets().executeForEachInUnitSquares(pos, static_cast<int>(ceilf(radius)), [&](Cell* cell) {
+            if (getDistance(cell->absPos, pos) <= radius) {
+                func(cell);
+            }
+        });
+    }
+
+    __device__ __inline__ void get(Cell* cells[], int arraySize, int& numCells, float2 const& pos) const
     {
-        int2 posInt = {floorInt(pos.x), floorInt(pos.y)};
         numCells = 0;
-        for (int dx = -1; dx <= 1; ++dx) {
-            for (int dy = -1; dy <= 1; ++dy) {
-                int2 scanPos{posInt.x + dx, posInt.y + dy};
-                correctPosition(scanPos);
-
-                auto mapEntry = (scanPos.x + scanPos.y * _size.x) * 2;
-                if (cells[numCells] = _map[mapEntry]) {
-                    ++numCells;
-                    if (cells[numCells] = _map[mapEntry + 1]) {
-                        ++numCells;
-                    }
-                }
+        executeForEach(pos, [&](Cell* cell) {
+            if (numCells < arraySize) {
+                cells[numCells++] = cell;
             }
-        }
+        });
     }
 
     __device__ __inline__ void get(Cell* cells[], int arraySize, int& numCells, float2 const& pos, float radius) const
     {
-        int2 posInt = {floorInt(pos.x), floorInt(pos.y)};
         numCells = 0;
-        int radiusInt = ceilf(radius);
-        for (int dx = -radiusInt; dx <= radiusInt; ++dx) {
-            for (int dy = -radiusInt; dy <= radiusInt; ++dy) {
-                int2 scanPos{posInt.x + dx, posInt.y + dy};
-                correctPosition(scanPos);
-
-                auto mapEntry = (scanPos.x + scanPos.y * _size.x) * 2;
-                auto cell1 = _map[mapEntry];
-                if (cell1 && Math::length(cell1->absPos - pos) <= radius && numCells < arraySize) {
-                    cells[numCells] = cell1;
-                    ++numCells;
-
-                    auto cell2 = _map[mapEntry + 1];
-                    if (cell2 && Math::length(cell2->absPos - pos) <= radius && numCells < arraySize) {
-                        cells[numCells] = cell2;
-                        ++numCells;
-                    }
-                }
+        getBuckets().executeForEachInUnitSquares(pos, static_cast<int>(ceilf(radius)), [&](Cell* cell) {
+            if (Math::length(cell->absPos - pos) <= radius && numCells < arraySize) {
+                cells[numCells++] = cell;
             }
-        }
+        });
     }
 
     __device__ __inline__ Cell* getFirst(float2 const& pos) const
     {
-        int2 posInt = {floorInt(pos.x), floorInt(pos.y)};
-        correctPosition(posInt);
-        auto mapEntry = (posInt.x + posInt.y * _size.x) * 2;
-        return _map[mapEntry];
+        Cell* result = nullptr;
+        getBuckets().executeForEachInUnitSquare(_layout.getPosIndex(pos), [&](Cell* cell) {
+            if (!result) {
+                result = cell;
+            }
+        });
+        return result;
+    }
+
+    //unlike getFirst independent of the sort order
+    __device__ __inline__ Cell* getWithSmallestId(float2 const& pos) const
+    {
+        return getWithSmallestId(pos, [](Cell*) { return true; });
+    }
+
+    //smallest id among the cells fulfilling the predicate
+    template <typename Predicate>
+    __device__ __inline__ Cell* getWithSmallestId(float2 const& pos, Predicate const& predicate) const
+    {
+        Cell* result = nullptr;
+        getBuckets().executeForEachInUnitSquare(_layout.getPosIndex(pos), [&](Cell* cell) {
+            if (predicate(cell) && (!result || cell->id < result->id)) {
+                result = cell;
+            }
+        });
+        return result;
     }
 
     __device__ __inline__ void cleanup_system()
     {
-        auto partition =
-            calcPartition(_mapEntries.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        auto numBuckets = _layout.getNumBuckets();
+        auto const partition = calcAllThreadsPartition(numBuckets + 1);
         for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
-            auto const& mapEntry = _mapEntries.at(index);
-            _map[mapEntry] = nullptr;
-            _map[mapEntry + 1] = nullptr;
+            if (index < numBuckets) {
+                _bucketCounts[index] = 0;
+            }
+            _bucketStarts[index] = 0;
         }
     }
 
 private:
-    Cell** _map;
-    Array<int> _mapEntries;
+    __device__ __inline__ CellListBuckets<Cell*> getBuckets() const { return {_layout, _bucketStarts, _sortedPosIndices, _sortedCells}; }
+
+    CellListLayout _layout;
+    int* _bucketCounts = nullptr;
+    int* _bucketStarts = nullptr;
+    int* _entityPosIndices = nullptr;  //indexed as the input of set_system
+    int* _entityOffsets = nullptr;
+    int* _sortedPosIndices = nullptr;
+    Cell** _sortedCells = nullptr;
 };
 
+//particle list built by counting sort as CellMap, the particles are processed in bins (see ParticleBins)
 class ParticleMap : public BaseMap
 {
 public:
     __host__ __inline__ void init(int2 const& size)
     {
         BaseMap::init(size);
-        CudaMemoryManager::getInstance().acquireMemory<Particle*>(size.x * size.y, _map);
-        _mapEntries.init();
-
-        std::vector<Particle*> hostMap(size.x * size.y, 0);
-        CHECK_FOR_CUDA_ERROR(cudaMemcpy(_map, hostMap.data(), sizeof(Particle*) * size.x * size.y, cudaMemcpyHostToDevice));
+        resize(1);
     }
 
-    __host__ __inline__ void resize(int maxEntries) { _mapEntries.resize(maxEntries); }
-
-    __device__ __inline__ void reset() { _mapEntries.reset(); }
+    __host__ __inline__ void resize(int maxEntries)
+    {
+        free();
+        _layout.init(_size, maxEntries);
+        auto numBuckets = _layout.getNumBuckets();
+        CudaMemoryManager::getInstance().acquireMemory<int>(numBuckets, _bucketCounts);
+        CudaMemoryManager::getInstance().acquireMemory<int>(numBuckets + 1, _bucketStarts);
+        CudaMemoryManager::getInstance().acquireMemory<int>(maxEntries, _entityPosIndices);
+        CudaMemoryManager::getInstance().acquireMemory<int>(maxEntries, _entityOffsets);
+        CudaMemoryManager::getInstance().acquireMemory<uint64_t>(maxEntries, _entityIds);
+        CudaMemoryManager::getInstance().acquireMemory<int>(maxEntries, _sortedPosIndices);
+        CudaMemoryManager::getInstance().acquireMemory<int>(maxEntries, _sortedEntityIndices);
+        CudaMemoryManager::getInstance().acquireMemory<int>(maxEntries, _entitySortedIndices);
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_bucketCounts, 0, sizeof(int) * numBuckets));
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_bucketStarts, 0, sizeof(int) * (numBuckets + 1)));
+    }
 
     __host__ __inline__ void free()
     {
-        CudaMemoryManager::getInstance().freeMemory(_map);
-        _mapEntries.free();
+        CudaMemoryManager::getInstance().freeMemory(_bucketCounts);
+        CudaMemoryManager::getInstance().freeMemory(_bucketStarts);
+        CudaMemoryManager::getInstance().freeMemory(_entityPosIndices);
+        CudaMemoryManager::getInstance().freeMemory(_entityOffsets);
+        CudaMemoryManager::getInstance().freeMemory(_entityIds);
+        CudaMemoryManager::getInstance().freeMemory(_sortedPosIndices);
+        CudaMemoryManager::getInstance().freeMemory(_sortedEntityIndices);
+        CudaMemoryManager::getInstance().freeMemory(_entitySortedIndices);
     }
 
-    __device__ __inline__ void set_block(int numEntities, Particle** entities)
+    //first pass: count particles per bucket
+    __device__ __inline__ void set_system(int numEntities, Particle** entities)
     {
-        if (0 == numEntities) {
-            return;
+        auto const partition = calcAllThreadsPartition(numEntities);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto posIndex = _layout.getPosIndex(entities[index]->absPos);
+            _entityPosIndices[index] = posIndex;
+            _entityOffsets[index] = atomicAdd(&_bucketCounts[_layout.getBucket(posIndex)], 1);
+            _entityIds[index] = entities[index]->id;
         }
+    }
 
-        __shared__ int* entrySubarray;
-        if (0 == threadIdx.x) {
-            entrySubarray = _mapEntries.getNewSubarray(numEntities);
-        }
-        __syncthreads();
+    //second pass: exclusive prefix sum of the counts, needs to be executed by a single block
+    __device__ __inline__ void prepareRanges_block() { exclusiveScan_block(_bucketCounts, _bucketStarts, _layout.getNumBuckets()); }
 
-        auto partition = calcPartition(numEntities, threadIdx.x, blockDim.x);
+    //third pass: scatter particle indices into the bucket ranges
+    __device__ __inline__ void sort_system(int numEntities)
+    {
+        auto const partition = calcAllThreadsPartition(numEntities);
         for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
-            auto const& entity = entities[index];
-            int2 posInt = {floorInt(entity->absPos.x), floorInt(entity->absPos.y)};
-            correctPosition(posInt);
-            auto mapEntry = posInt.x + posInt.y * _size.x;
-            _map[mapEntry] = entity;
-            entrySubarray[index] = mapEntry;
+            auto posIndex = _entityPosIndices[index];
+            auto sortedIndex = _bucketStarts[_layout.getBucket(posIndex)] + _entityOffsets[index];
+            _sortedPosIndices[sortedIndex] = posIndex;
+            _sortedEntityIndices[sortedIndex] = index;
         }
-        __syncthreads();
     }
 
-    __device__ __inline__ Particle* get(float2 const& pos) const
+    //fourth pass: sort each bucket by position index and id (see ParticleBins::sortBucket)
+    __device__ __inline__ void sortBins_system()
     {
-        int2 posInt = { floorInt(pos.x), floorInt(pos.y) };
-        correctPosition(posInt);
-        auto mapEntry = posInt.x + posInt.y * _size.x;
-        return _map[mapEntry];
+        auto const partition = calcAllThreadsPartition(_layout.getNumBuckets());
+        for (int bucket = partition.startIndex; bucket <= partition.endIndex; ++bucket) {
+            ParticleBins::sortBucket(
+                _bucketStarts[bucket], _bucketStarts[bucket + 1], _sortedPosIndices, _sortedEntityIndices, _entityIds, _entitySortedIndices);
+        }
+    }
+
+    //calls func(leaderIndex) once per bin, leaderIndex is the index of the particle with the smallest id in the input of
+    //set_system; the bin order is determined by sortBins_system, hence func may remove particles
+    template <typename Func>
+    __device__ __inline__ void executeForEachBin_system(int numEntities, Func const& func) const
+    {
+        auto const bins = getBins();
+        auto const partition = calcAllThreadsPartition(numEntities);
+        for (int sortedIndex = partition.startIndex; sortedIndex <= partition.endIndex; ++sortedIndex) {
+            auto entityIndex = _sortedEntityIndices[sortedIndex];
+            if (bins.isLeader(entityIndex)) {
+                func(entityIndex);
+            }
+        }
+    }
+
+    __device__ __inline__ ParticleBins getBins() const
+    {
+        return {CellListBuckets<int>(_layout, _bucketStarts, _sortedPosIndices, _sortedEntityIndices), _entityPosIndices, _entitySortedIndices};
     }
 
     __device__ __inline__ void cleanup_system()
     {
-        auto partition =
-            calcPartition(_mapEntries.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        auto numBuckets = _layout.getNumBuckets();
+        auto const partition = calcAllThreadsPartition(numBuckets + 1);
         for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
-            auto const& mapEntry = _mapEntries.at(index);
-            _map[mapEntry] = nullptr;
+            if (index < numBuckets) {
+                _bucketCounts[index] = 0;
+            }
+            _bucketStarts[index] = 0;
         }
     }
 
 private:
-    Particle** _map;
-    Array<int> _mapEntries;
+    CellListLayout _layout;
+    int* _bucketCounts = nullptr;
+    int* _bucketStarts = nullptr;
+    int* _entityPosIndices = nullptr;  //indexed as the input of set_system
+    int* _entityOffsets = nullptr;
+    uint64_t* _entityIds = nullptr;
+    int* _sortedPosIndices = nullptr;
+    int* _sortedEntityIndices = nullptr;
+    int* _entitySortedIndices = nullptr;  //indexed as the input of set_system
 };
@@ -45,6 +45,7 @@ __global__ void cudaGetCudaMonitorData_substep1(SimulationData data, CudaMonitor
     monitorData.setNumParticles(data.entities.particlePointers.getNumEntries());
     monitorData.setNumTokens(data.entities.tokenPointers.getNumEntries());
     monitorData.setNumTokens(data.entities.tokenPointers.getNumEntries());
+    monitorData.setNumDroppedStructuralOperations(data.structuralOperationBuckets.getNumDroppedOperations());
 
     //    KERNEL_CALL(getEnergyForMonitorData, data, monitorData);
 }
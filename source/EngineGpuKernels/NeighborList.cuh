@@ -0,0 +1,230 @@
+#pragma once
+
+#include <algorithm>
+
+#include "Base.cuh"
+#include "Cell.cuh"
+#include "CudaMemoryManager.cuh"
+#include "Map.cuh"
+#include "NeighborListLayout.cuh"
+
+//verlet list of the cells around each cell in CSR layout (see NeighborListLayout): the neighbors are counted per cell,
+//the counts are converted to ranges and the neighbors are written into the ranges (same scheme as CellMap)
+//the list is only rebuilt if a listed cell is outdated or the cell array has been relocated, hence the list contains all
+//cells within cutoff as long as it is valid; cells deleted after the last build are skipped and cells created after the
+//last build are looked up in the cell map, by themselves and by the listed cells around them
+class NeighborList
+{
+public:
+    __host__ __inline__ void init(int2 const& worldSize)
+    {
+        _worldSize = worldSize;
+        auto numNewCellBlocks = NeighborListLayout::getNumNewEntityBlocks(worldSize);
+        CudaMemoryManager::getInstance().acquireMemory<float>(1, _cutoff);
+        CudaMemoryManager::getInstance().acquireMemory<int>(1, _needsRebuild);
+        CudaMemoryManager::getInstance().acquireMemory<int>(1, _valid);
+        CudaMemoryManager::getInstance().acquireMemory<int>(1, _numRequiredNeighbors);
+        CudaMemoryManager::getInstance().acquireMemory<int>(1, _checkNumber);
+        CudaMemoryManager::getInstance().acquireMemory<int>(numNewCellBlocks, _newCellBlockStamps);
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_cutoff, 0, sizeof(float)));
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_needsRebuild, 0, sizeof(int)));
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_numRequiredNeighbors, 0, sizeof(int)));
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_checkNumber, 0, sizeof(int)));
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_newCellBlockStamps, 0, sizeof(int) * numNewCellBlocks));
+        resize(1);
+    }
+
+    //invalidates the list
+    __host__ __inline__ void resize(int maxCells)
+    {
+        freeCellBuffers();
+        CudaMemoryManager::getInstance().acquireMemory<int>(maxCells, _neighborCounts);
+        CudaMemoryManager::getInstance().acquireMemory<int>(maxCells + 1, _neighborStarts);
+        CudaMemoryManager::getInstance().acquireMemory<float2>(maxCells, _refPositions);
+        resizeNeighbors(std::max(_maxNeighbors, maxCells * InitialNeighborsPerCell));
+    }
+
+    //invalidates the list
+    __host__ __inline__ void resizeNeighbors(int maxNeighbors)
+    {
+        CudaMemoryManager::getInstance().freeMemory(_neighbors);
+        _maxNeighbors = maxNeighbors;
+        CudaMemoryManager::getInstance().acquireMemory<Cell*>(maxNeighbors, _neighbors);
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_valid, 0, sizeof(int)));
+    }
+
+    __host__ __inline__ void free()
+    {
+        freeCellBuffers();
+        CudaMemoryManager::getInstance().freeMemory(_neighbors);
+        CudaMemoryManager::getInstance().freeMemory(_cutoff);
+        CudaMemoryManager::getInstance().freeMemory(_needsRebuild);
+        CudaMemoryManager::getInstance().freeMemory(_valid);
+        CudaMemoryManager::getInstance().freeMemory(_numRequiredNeighbors);
+        CudaMemoryManager::getInstance().freeMemory(_checkNumber);
+        CudaMemoryManager::getInstance().freeMemory(_newCellBlockStamps);
+    }
+
+    __host__ __inline__ int getMaxNeighbors() const { return _maxNeighbors; }
+
+    //number of neighbors of the largest build which did not fit into the buffer
+    __host__ __inline__ int getNumRequiredNeighbors_host() const
+    {
+        int result;
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy(&result, _numRequiredNeighbors, sizeof(int), cudaMemcpyDeviceToHost));
+        return result;
+    }
+
+    //the listed cells are referred by their addresses => needs to be called after the cell array has been relocated
+    __device__ __inline__ void invalidate() { *_valid = 0; }
+
+    //first pass: decide whether the list needs to be rebuilt, needs to be executed by a single thread
+    __device__ __inline__ void prepareCheck(float cutoff)
+    {
+        *_needsRebuild = !*_valid || cutoff != *_cutoff ? 1 : 0;
+        ++*_checkNumber;
+    }
+
+    //cells deleted after the last build are not contained in cells and are therefore not checked, cells created after
+    //the last build mark their block (see NeighborListLayout) for the lookups in executeForEach
+    __device__ __inline__ void check_system(int numCells, Cell** cells, BaseMap const& map)
+    {
+        if (*_needsRebuild) {
+            return;
+        }
+        auto const partition = calcAllThreadsPartition(numCells);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto const& cell = cells[index];
+            if (cell->neighborListIndex == -1) {
+                NeighborListLayout::executeForEachBlockAroundNewEntity(
+                    toInt2(cell->absPos), *_cutoff, _worldSize, [&](int block) { _newCellBlockStamps[block] = *_checkNumber; });
+            } else if (NeighborListLayout::isOutdated(map.getDistance(cell->absPos, _refPositions[cell->neighborListIndex]))) {
+                *_needsRebuild = 1;
+            }
+        }
+    }
+
+    //second pass: count neighbors per cell
+    __device__ __inline__ void count_system(int numCells, Cell** cells, CellMap const& cellMap, float cutoff)
+    {
+        if (!*_needsRebuild) {
+            return;
+        }
+        auto const partition = calcAllThreadsPartition(numCells);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto const& cell = cells[index];
+            int numNeighbors = 0;
+            cellMap.executeForEach(cell->absPos, NeighborListLayout::getBuildRadius(cutoff), [&](Cell* otherCell) {
+                if (otherCell != cell) {
+                    ++numNeighbors;
+                }
+            });
+            _neighborCounts[index] = numNeighbors;
+        }
+    }
+
+    //third pass: exclusive prefix sum of the counts, needs to be executed by a single block
+    __device__ __inline__ void prepareRanges_block(int numCells, float cutoff)
+    {
+        if (!*_needsRebuild) {
+            return;
+        }
+        exclusiveScan_block(_neighborCounts, _neighborStarts, numCells);
+        if (0 == threadIdx.x) {
+            auto numNeighbors = _neighborStarts[numCells];
+            *_valid = numNeighbors <= _maxNeighbors ? 1 : 0;
+            if (!*_valid) {
+                *_numRequiredNeighbors = max(*_numRequiredNeighbors, numNeighbors);
+            }
+            *_cutoff = cutoff;
+        }
+    }
+
+    //fourth pass: write neighbors into the ranges
+    __device__ __inline__ void fill_system(int numCells, Cell** cells, CellMap const& cellMap, float cutoff)
+    {
+        if (!*_needsRebuild || !*_valid) {
+            return;
+        }
+        auto const partition = calcAllThreadsPartition(numCells);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto const& cell = cells[index];
+            cell->neighborListIndex = index;
+            _refPositions[index] = cell->absPos;
+
+            auto neighborIndex = _neighborStarts[index];
+            cellMap.executeForEach(cell->absPos, NeighborListLayout::getBuildRadius(cutoff), [&](Cell* otherCell) {
+                if (otherCell != cell) {
+                    _neighbors[neighborIndex++] = otherCell;
+                }
+            });
+        }
+    }
+
+    //calls func for all other cells within radius (<= cutoff) around cell, cells created after the last build are
+    //looked up in the cell map
+    template <typename Func>
+    __device__ __inline__ void executeForEach(Cell* cell, float radius, CellMap const& cellMap, Func const& func) const
+    {
+        if (*_valid && cell->neighborListIndex != -1) {
+            NeighborListRanges<Cell*>(_neighborStarts, _neighbors)
+                .executeForEachWithin(
+                    cell->neighborListIndex,
+                    radius,
+                    [&](Cell* otherCell) { return cellMap.getDistance(otherCell->absPos, cell->absPos); },
+                    [&](Cell* otherCell) {
+                        if (!otherCell->isDeleted()) {
+                            func(otherCell);
+                        }
+                    });
+
+            if (_newCellBlockStamps[NeighborListLayout::getNewEntityBlock(toInt2(cell->absPos), _worldSize)] == *_checkNumber) {
+                cellMap.executeForEach(cell->absPos, radius, [&](Cell* otherCell) {
+                    if (otherCell->neighborListIndex == -1) {
+                        func(otherCell);
+                    }
+                });
+            }
+        } else {
+            cellMap.executeForEach(cell->absPos, radius, [&](Cell* otherCell) {
+                if (otherCell != cell) {
+                    func(otherCell);
+                }
+            });
+        }
+    }
+
+    __device__ __inline__ void get(Cell* cells[], int arraySize, int& numCells, Cell* cell, float radius, CellMap const& cellMap) const
+    {
+        numCells = 0;
+        executeForEach(cell, radius, cellMap, [&](Cell* otherCell) {
+            if (numCells < arraySize) {
+                cells[numCells++] = otherCell;
+            }
+        });
+    }
+
+private:
+    static auto constexpr InitialNeighborsPerCell = 16;
+
+    __host__ __inline__ void freeCellBuffers()
+    {
+        CudaMemoryManager::getInstance().freeMemory(_neighborCounts);
+        CudaMemoryManager::getInstance().freeMemory(_neighborStarts);
+        CudaMemoryManager::getInstance().freeMemory(_refPositions);
+    }
+
+    int _maxNeighbors = 0;
+    int2 _worldSize;
+
+    float* _cutoff = nullptr;  //cutoff of the last build
+    int* _needsRebuild = nullptr;
+    int* _valid = nullptr;
+    int* _numRequiredNeighbors = nullptr;
+    int* _checkNumber = nullptr;  //incremented by each check
+    int* _newCellBlockStamps = nullptr;  //per block: number of the last check which marked the block
+    int* _neighborCounts = nullptr;
+    int* _neighborStarts = nullptr;
+    float2* _refPositions = nullptr;  //indexed by Cell::neighborListIndex
+    Cell** _neighbors = nullptr;
+};
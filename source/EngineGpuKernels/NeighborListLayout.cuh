@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cmath>
+
+#include <cuda_runtime.h>
+
+//rebuild rule of the verlet lists, shared by NeighborList and HostNeighborList: the lists contain all entities within
+//cutoff + Skin, hence they contain all entities within cutoff as long as no entity has moved more than Skin / 2 since
+//the last build
+class NeighborListLayout
+{
+public:
+    static auto constexpr Skin = 0.5f;
+
+    __host__ __device__ __inline__ static float getBuildRadius(float cutoff) { return cutoff + Skin; }
+
+    __host__ __device__ __inline__ static bool isOutdated(float displacement) { return displacement > Skin / 2; }
+
+    //entities added since the last build are not contained in the lists: they mark the blocks of
+    //NewEntityBlockSize x NewEntityBlockSize unit squares within cutoff around them, hence only the listed entities in
+    //marked blocks need to look up new entities
+    static auto constexpr NewEntityBlockSize = 4;
+
+    __host__ __device__ __inline__ static int getNumNewEntityBlocks(int2 const& worldSize)
+    {
+        return getNumNewEntityBlocksX(worldSize) * ((worldSize.y + NewEntityBlockSize - 1) / NewEntityBlockSize);
+    }
+
+    //posInt may lie outside of the world by less than the world size
+    __host__ __device__ __inline__ static int getNewEntityBlock(int2 posInt, int2 const& worldSize)
+    {
+        posInt.x += posInt.x < 0 ? worldSize.x : (posInt.x >= worldSize.x ? -worldSize.x : 0);
+        posInt.y += posInt.y < 0 ? worldSize.y : (posInt.y >= worldSize.y ? -worldSize.y : 0);
+        return posInt.x / NewEntityBlockSize + posInt.y / NewEntityBlockSize * getNumNewEntityBlocksX(worldSize);
+    }
+
+    //calls func(block) for the blocks to be marked by a new entity at posInt, blocks may be passed several times
+    template <typename Func>
+    __host__ __device__ __inline__ static void
+    executeForEachBlockAroundNewEntity(int2 const& posInt, float cutoff, int2 const& worldSize, Func const& func)
+    {
+        auto squareRadius = static_cast<int>(ceilf(cutoff));
+        for (int dx = -squareRadius; dx <= squareRadius; ++dx) {
+            for (int dy = -squareRadius; dy <= squareRadius; ++dy) {
+                func(getNewEntityBlock(int2{posInt.x + dx, posInt.y + dy}, worldSize));
+            }
+        }
+    }
+
+private:
+    __host__ __device__ __inline__ static int getNumNewEntityBlocksX(int2 const& worldSize)
+    {
+        return (worldSize.x + NewEntityBlockSize - 1) / NewEntityBlockSize;
+    }
+};
+
+//CSR view of a verlet list, shared by NeighborList and HostNeighborList: the neighbors of the entity at index are
+//stored in [neighborStarts[index], neighborStarts[index + 1])
+template <typename Entry>
+class NeighborListRanges
+{
+public:
+    __host__ __device__ __inline__ NeighborListRanges(int const* neighborStarts, Entry const* neighbors)
+        : _neighborStarts(neighborStarts)
+        , _neighbors(neighbors)
+    {}
+
+    //calls func(entry) for all neighbors of the entity at index
+    template <typename Func>
+    __host__ __device__ __inline__ void executeForEach(int index, Func const& func) const
+    {
+        for (int neighborIndex = _neighborStarts[index]; neighborIndex < _neighborStarts[index + 1]; ++neighborIndex) {
+            func(_neighbors[neighborIndex]);
+        }
+    }
+
+    //calls func(entry) for all neighbors of the entity at index within radius, getDistance(entry) returns the distance
+    //of the neighbor to the entity
+    template <typename DistanceFunc, typename Func>
+    __host__ __device__ __inline__ void
+    executeForEachWithin(int index, float radius, DistanceFunc const& getDistance, Func const& func) const
+    {
+        executeForEach(index, [&](Entry const& entry) {
+            if (getDistance(entry) <= radius) {
+                func(entry);
+            }
+        });
+    }
+
+private:
+    int const* _neighborStarts;
+    Entry const* _neighbors;
+};
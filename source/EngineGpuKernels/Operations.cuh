@@ -2,6 +2,7 @@
 
 #include "Base.cuh"
 #include "Definitions.cuh"
+#include "StructuralOperationSegments.cuh"
 
 struct AddConnectionOperation {
     bool addTokens;
@@ -43,14 +44,7 @@ union StructureOperationData
 
 struct StructuralOperation
 {
-    enum class Type
-    {
-        AddConnections,
-        DelConnections,
-        DelConnection,
-        DelCell,
-        DelCellAndConnections,
-    };
+    using Type = StructuralOperationType;
     Type type;
     StructureOperationData data;
 };
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#include <cuda_runtime.h>
+
+#include "CellListLayout.cuh"
+
+//bins of a particle list, shared by ParticleMap and HostParticleMap: the particles of a unit square form a bin which is
+//processed as a whole by its leader, i.e. the particle with the smallest id, hence bins can be processed in parallel
+//without locks; entities are referred by their index in the input of the build
+//after the scatter of the build each bucket is sorted once (sortBucket), hence the particles of a bin are contiguous in
+//ascending order of their ids and the leader is the first of them
+class ParticleBins
+{
+public:
+    __host__ __device__ __inline__ ParticleBins(CellListBuckets<int> const& buckets, int const* entityPosIndices, int const* entitySortedIndices)
+        : _buckets(buckets)
+        , _entityPosIndices(entityPosIndices)
+        , _entitySortedIndices(entitySortedIndices)
+    {}
+
+    //sorts the entries in [bucketStart, bucketEnd) by position index, id and entity index and stores the resulting
+    //sorted index of each entity; heap sort as it needs neither recursion nor extra memory on the device
+    __host__ __device__ __inline__ static void sortBucket(
+        int bucketStart,
+        int bucketEnd,
+        int* sortedPosIndices,
+        int* sortedEntityIndices,
+        uint64_t const* entityIds,
+        int* entitySortedIndices)
+    {
+        auto isOrderedBefore = [&](int offset, int otherOffset) {
+            auto posIndex = sortedPosIndices[bucketStart + offset];
+            auto otherPosIndex = sortedPosIndices[bucketStart + otherOffset];
+            if (posIndex != otherPosIndex) {
+                return posIndex < otherPosIndex;
+            }
+            auto entityIndex = sortedEntityIndices[bucketStart + offset];
+            auto otherEntityIndex = sortedEntityIndices[bucketStart + otherOffset];
+            auto id = entityIds[entityIndex];
+            auto otherId = entityIds[otherEntityIndex];
+            return id < otherId || (id == otherId && entityIndex < otherEntityIndex);
+        };
+        auto swap = [&](int offset, int otherOffset) {
+            auto posIndex = sortedPosIndices[bucketStart + offset];
+            sortedPosIndices[bucketStart + offset] = sortedPosIndices[bucketStart + otherOffset];
+            sortedPosIndices[bucketStart + otherOffset] = posIndex;
+            auto entityIndex = sortedEntityIndices[bucketStart + offset];
+            sortedEntityIndices[bucketStart + offset] = sortedEntityIndices[bucketStart + otherOffset];
+            sortedEntityIndices[bucketStart + otherOffset] = entityIndex;
+        };
+        auto siftDown = [&](int root, int heapSize) {
+            auto child = 2 * root + 1;
+            while (child < heapSize) {
+                if (child + 1 < heapSize && isOrderedBefore(child, child + 1)) {
+                    ++child;
+                }
+                if (!isOrderedBefore(root, child)) {
+                    return;
+                }
+                swap(root, child);
+                root = child;
+                child = 2 * root + 1;
+            }
+        };
+
+        auto size = bucketEnd - bucketStart;
+        for (int offset = size / 2 - 1; offset >= 0; --offset) {
+            siftDown(offset, size);
+        }
+        for (int heapSize = size - 1; heapSize > 0; --heapSize) {
+            swap(0, heapSize);
+            siftDown(0, heapSize);
+        }
+        for (int sortedIndex = bucketStart; sortedIndex < bucketEnd; ++sortedIndex) {
+            entitySortedIndices[sortedEntityIndices[sortedIndex]] = sortedIndex;
+        }
+    }
+
+    //entries of the same unit square are contiguous in a bucket, hence the preceding entry of another unit square (or
+    //bucket) identifies the leader
+    __host__ __device__ __inline__ bool isLeader(int entityIndex) const
+    {
+        auto sortedIndex = _entitySortedIndices[entityIndex];
+        return sortedIndex == 0 || _buckets.getSortedPosIndex(sortedIndex - 1) != _entityPosIndices[entityIndex];
+    }
+
+    //calls func(entityIndex) for the given particle and the following particles in its bin in ascending order of their
+    //ids, i.e. for the whole bin if the given particle is the leader
+    template <typename Func>
+    __host__ __device__ __inline__ void executeForEachInBinOrderedById(int entityIndex, Func const& func) const
+    {
+        auto posIndex = _entityPosIndices[entityIndex];
+        auto bucketEnd = _buckets.getBucketEnd(posIndex);
+        for (int sortedIndex = _entitySortedIndices[entityIndex];
+             sortedIndex < bucketEnd && _buckets.getSortedPosIndex(sortedIndex) == posIndex;
+             ++sortedIndex) {
+            func(_buckets.getSortedEntry(sortedIndex));
+        }
+    }
+
+    //calls func(entityIndex) for all particles in the bin of the given particle
+    template <typename Func>
+    __host__ __device__ __inline__ void executeForEachInBin(int entityIndex, Func const& func) const
+    {
+        _buckets.executeForEachInUnitSquare(_entityPosIndices[entityIndex], func);
+    }
+
+    //collision of the bin of leaderIndex: the bin is absorbed by absorbingCell (if not nullptr) or the particles closer
+    //than mergeDistance to the leader are merged into the leader, energies are summed up in the order of the particle ids;
+    //particles.get(index) returns the particle (with absPos, vel and energy) and particles.remove(index) removes it
+    template <typename ParticleAccess, typename AbsorbingCell>
+    __host__ __device__ __inline__ void collide(int leaderIndex, ParticleAccess& particles, AbsorbingCell* absorbingCell, float mergeDistance) const
+    {
+        auto& leader = particles.get(leaderIndex);
+        auto isAffected = [&](int index) {
+            if (absorbingCell || index == leaderIndex) {
+                return true;
+            }
+            auto const& particle = particles.get(index);
+            auto dx = particle.absPos.x - leader.absPos.x;
+            auto dy = particle.absPos.y - leader.absPos.y;
+            return sqrtf(dx * dx + dy * dy) < mergeDistance;
+        };
+
+        auto energy = 0.0f;
+        float2 momentum{0, 0};
+        executeForEachInBinOrderedById(leaderIndex, [&](int index) {
+            if (isAffected(index)) {
+                auto const& particle = particles.get(index);
+                energy += particle.energy;
+                momentum = {momentum.x + particle.vel.x * particle.energy, momentum.y + particle.vel.y * particle.energy};
+            }
+        });
+
+        if (absorbingCell) {
+            absorbingCell->energy += energy;
+        } else {
+            if (energy > FpPrecision) {
+                leader.vel = {momentum.x / energy, momentum.y / energy};
+            }
+            leader.energy = energy;
+        }
+
+        executeForEachInBin(leaderIndex, [&](int index) {
+            if (isAffected(index) && (absorbingCell || index != leaderIndex)) {
+                particles.remove(index);
+            }
+        });
+    }
+
+private:
+    static auto constexpr FpPrecision = 0.00001f;
+
+    CellListBuckets<int> _buckets;
+    int const* _entityPosIndices;
+    int const* _entitySortedIndices;
+};
@@ -8,11 +8,31 @@
 #include "Physics.cuh"
 #include "Map.cuh"
 
+//particle access for ParticleBins::collide
+struct ParticlePointerAccess
+{
+    Array<Particle*>& particles;
+
+    __inline__ __device__ Particle& get(int index) { return *particles.at(index); }
+    __inline__ __device__ void remove(int index)
+    {
+        particles.at(index)->energy = 0;
+        particles.at(index) = nullptr;
+    }
+};
+
 class ParticleProcessor
 {
 public:
-    __inline__ __device__ void updateMap(SimulationData& data);
     __inline__ __device__ void movement(SimulationData& data);
+
+    __inline__ __device__ void updateMap(SimulationData& data);  //particle map is complete after prepareMapRanges, sortMap and sortMapBins
+    __inline__ __device__ void prepareMapRanges(SimulationData& data);  //single block
+    __inline__ __device__ void sortMap(SimulationData& data);
+    __inline__ __device__ void sortMapBins(SimulationData& data);
+
+    //the particles of each unit square are absorbed by the non-barrier cell with the smallest id there or merged into
+    //the particle with the smallest id (see ParticleBins::collide)
     __inline__ __device__ void collision(SimulationData& data);
     __inline__ __device__ void transformation(SimulationData& data);
 };
@@ -22,14 +42,6 @@ public:
 /* Implementation                                                       */
 /************************************************************************/
 
-__inline__ __device__ void ParticleProcessor::updateMap(SimulationData& data)
-{
-    auto partition = calcPartition(data.entities.particlePointers.getNumEntries(), blockIdx.x, gridDim.x);
-
-    Particle** particlePointers = &data.entities.particlePointers.at(partition.startIndex);
-    data.particleMap.set_block(partition.numElements(), particlePointers);
-}
-
 __inline__ __device__ void ParticleProcessor::movement(SimulationData& data)
 {
     auto partition = calcPartition(
@@ -42,54 +54,37 @@ __inline__ __device__ void ParticleProcessor::movement(SimulationData& data)
     }
 }
 
-__inline__ __device__ void ParticleProcessor::collision(SimulationData& data)
+__inline__ __device__ void ParticleProcessor::updateMap(SimulationData& data)
 {
-    auto partition = calcPartition(
-        data.entities.particlePointers.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    auto& particles = data.entities.particlePointers;
+    data.particleMap.set_system(particles.getNumEntries(), particles.getArray());
+}
 
-    for (int particleIndex = partition.startIndex; particleIndex <= partition.endIndex; ++particleIndex) {
-        auto& particle = data.entities.particlePointers.at(particleIndex);
-        auto otherParticle = data.particleMap.get(particle->absPos);
-        if (otherParticle && otherParticle != particle
-            && Math::lengthSquared(particle->absPos - otherParticle->absPos) < 0.5) {
-
-            SystemDoubleLock lock;
-            lock.init(&particle->locked, &otherParticle->locked);
-            if (lock.tryLock()) {
-                __threadfence();
-
-                if (particle->energy > FP_PRECISION && otherParticle->energy > FP_PRECISION) {
-                    auto factor1 = particle->energy / (particle->energy + otherParticle->energy);
-                    otherParticle->vel = particle->vel * factor1 + otherParticle->vel * (1.0f - factor1);
-                    otherParticle->energy += particle->energy;
-                    particle->energy = 0;
-                    particle = nullptr;
-                }
-
-                __threadfence();
-                lock.releaseLock();
-            }
-        } else {
-            if (auto cell = data.cellMap.getFirst(particle->absPos)) {
-                if (!cell->tryLock()) {
-                    continue;
-                }
-                if (cell->barrier) {
-                    continue;
-                }
-                if (particle->tryLock()) {
-                    
-                    atomicAdd(&cell->energy, particle->energy);
-                    particle->energy = 0;
-
-                    particle->releaseLock();
-
-                    particle = nullptr;
-                }
-                cell->releaseLock();
-            }
-        }
-    }
+__inline__ __device__ void ParticleProcessor::prepareMapRanges(SimulationData& data)
+{
+    data.particleMap.prepareRanges_block();
+}
+
+__inline__ __device__ void ParticleProcessor::sortMap(SimulationData& data)
+{
+    data.particleMap.sort_system(data.entities.particlePointers.getNumEntries());
+}
+
+__inline__ __device__ void ParticleProcessor::sortMapBins(SimulationData& data)
+{
+    data.particleMap.sortBins_system();
+}
+
+__inline__ __device__ void ParticleProcessor::collision(SimulationData& data)
+{
+    ParticlePointerAccess particles{data.entities.particlePointers};
+    auto const bins = data.particleMap.getBins();
+    data.particleMap.executeForEachBin_system(data.entities.particlePointers.getNumEntries(), [&](int leaderIndex) {
+        auto cell = data.cellMap.getWithSmallestId(particles.get(leaderIndex).absPos, [](Cell* cell) { return !cell->barrier; });
+
+        //bins are disjoint, hence no other thread accesses these particles
+        bins.collide(leaderIndex, particles, cell, cudaSimulationParameters.particleMergeDistance);
+    });
 }
 
 __inline__ __device__ void ParticleProcessor::transformation(SimulationData& data)
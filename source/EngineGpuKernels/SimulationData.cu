@@ -1,33 +1,50 @@
 ﻿#include "SimulationData.cuh"
 
+#include <random>
+
+#include "CudaMemoryManager.cuh"
 #include "Token.cuh"
 #include "GarbageCollectorKernels.cuh"
 
-void SimulationData::init(int2 const& worldSize_)
+void SimulationData::init(Settings const& settings)
 {
-    worldSize = worldSize_;
+    auto const& generalSettings = settings.generalSettings;
+    worldSize = {generalSettings.worldSizeX, generalSettings.worldSizeY};
+    tokenMemoryStride = calcTokenMemoryStride(settings.simulationParameters.tokenMemorySize);
 
     entities.init();
     entitiesForCleanup.init();
     cellFunctionData.init(worldSize);
+    tokenFunctionBins.init();
     cellMap.init(worldSize);
+    neighborList.init(worldSize);
     particleMap.init(worldSize);
+    resizeFlowFieldGrid(settings.flowFieldSettings.gridSpacing);
 
     processMemory.init();
-    numberGen1.init(40312357);   //some array size for random numbers (~ 40 MB)
-    numberGen2.init(1536941);  //some array size for random numbers (~ 1.5 MB)
+    auto seed = generalSettings.useSeed ? generalSettings.seed : std::random_device()();
+    numberGen1.init(seed);
+    numberGen2.init(~seed);
 
     structuralOperations.init();
+    structuralOperationBuckets.init();
     sensorOperations.init();
+    constructionReservations.init();
+}
+
+void SimulationData::setTimestep(uint64_t timestep)
+{
+    numberGen1.setTimestep(timestep);
+    numberGen2.setTimestep(timestep);
 }
 
 __device__ void SimulationData::prepareForNextTimestep()
 {
-    cellMap.reset();
-    particleMap.reset();
     processMemory.reset();
+    tokenFunctionBins.reset();
+    constructionReservations.reset();
 
-    auto maxStructureOperations = entities.cellPointers.getNumEntries() / 2;
+    auto maxStructureOperations = structuralOperationBuckets.getMaxOperations_device();
     structuralOperations.setMemory(processMemory.getArray<StructuralOperation>(maxStructureOperations), maxStructureOperations);
 
     auto maxSensorOperations = entities.cellPointers.getNumEntries() / 2;
@@ -67,6 +84,7 @@ void SimulationData::resizeEntitiesForCleanup(int additionalCells, int additiona
     resizeTargetIntern(entities.particlePointers, entitiesForCleanup.particlePointers, cellAndParticleArraySizeInc * 10);
     resizeTargetIntern(entities.tokens, entitiesForCleanup.tokens, tokenArraySizeInc);
     resizeTargetIntern(entities.tokenPointers, entitiesForCleanup.tokenPointers, tokenArraySizeInc * 10);
+    resizeTokenMemoryForCleanup(tokenMemoryStride);
 }
 
 void SimulationData::resizeRemainings()
@@ -77,13 +95,49 @@ void SimulationData::resizeRemainings()
     entities.particlePointers.resize(entitiesForCleanup.particlePointers.getSize_host());
     entities.tokens.resize(entitiesForCleanup.tokens.getSize_host());
     entities.tokenPointers.resize(entitiesForCleanup.tokenPointers.getSize_host());
+    entities.tokenMemory.resize(entitiesForCleanup.tokenMemory.getSize_host());
+    tokenFunctionBins.resize(entities.tokenPointers.getSize_host());
+    constructionReservations.resize(entities.tokenPointers.getSize_host());
 
     auto cellArraySize = entities.cells.getSize_host();
     cellMap.resize(cellArraySize);
-    particleMap.resize(cellArraySize);
+    neighborList.resize(cellArraySize);
+    particleMap.resize(entities.particlePointers.getSize_host());
+    if (cellArraySize / 2 > structuralOperationBuckets.getMaxOperations()) {
+        structuralOperationBuckets.resize(cellArraySize / 2);
+    }
+
+    resizeProcessMemory();
+}
+
+void SimulationData::resizeStructuralOperations(int maxOperations)
+{
+    structuralOperationBuckets.resize(maxOperations);
+    resizeProcessMemory();
+}
 
+void SimulationData::resizeTokenMemoryForCleanup(int newTokenMemoryStride)
+{
+    //token memory is allocated together with the tokens and therefore has the same fill level
+    entitiesForCleanup.tokenMemory.resize(entitiesForCleanup.tokens.getSize_host() * newTokenMemoryStride);
+}
+
+void SimulationData::resizeFlowFieldGrid(int gridSpacing)
+{
+    auto velocities = flowFieldGrid.getVelocities();
+    CudaMemoryManager::getInstance().freeMemory(velocities);
+
+    flowFieldGrid.init(worldSize, gridSpacing);
+    CudaMemoryManager::getInstance().acquireMemory<float2>(flowFieldGrid.getNumNodes(), velocities);
+    flowFieldGrid.setVelocities(velocities);
+}
+
+void SimulationData::resizeProcessMemory()
+{
     //heuristic
-    int upperBoundDynamicMemory = (sizeof(StructuralOperation) + 200) * (cellArraySize + 1000);
+    auto cellArraySize = entities.cells.getSize_host();
+    int upperBoundDynamicMemory = (sizeof(StructuralOperation) + 200) * (cellArraySize + 1000)
+        + sizeof(StructuralOperation) * structuralOperationBuckets.getMaxOperations();
     processMemory.resize(upperBoundDynamicMemory);
 }
 
@@ -98,14 +152,21 @@ void SimulationData::free()
     entities.free();
     entitiesForCleanup.free();
     cellFunctionData.free();
+    tokenFunctionBins.free();
     cellMap.free();
+    neighborList.free();
     particleMap.free();
+    auto flowFieldVelocities = flowFieldGrid.getVelocities();
+    CudaMemoryManager::getInstance().freeMemory(flowFieldVelocities);
+    flowFieldGrid.setVelocities(nullptr);
     numberGen1.free();
     numberGen2.free();
     processMemory.free();
 
     structuralOperations.free();
+    structuralOperationBuckets.free();
     sensorOperations.free();
+    constructionReservations.free();
 }
 
 template <typename Entity>
@@ -4,41 +4,57 @@
 
 #include "Base.cuh"
 #include "CellFunctionData.cuh"
+#include "ConstructionReservations.cuh"
 #include "Definitions.cuh"
 #include "EngineInterface/GpuSettings.h"
+#include "EngineInterface/Settings.h"
 #include "Entities.cuh"
+#include "FlowFieldGrid.cuh"
 #include "Map.cuh"
+#include "NeighborList.cuh"
 #include "Operations.cuh"
+#include "StructuralOperationBuckets.cuh"
 #include "Token.cuh"
+#include "TokenFunctionBins.cuh"
 
 struct SimulationData
 {
     //maps
     int2 worldSize;
     CellMap cellMap;
+    NeighborList neighborList;
     ParticleMap particleMap;
+    FlowFieldGrid flowFieldGrid;
 
     //objects
     Entities entities;
     Entities entitiesForCleanup;
+    int tokenMemoryStride = MIN_TOKEN_MEM_STRIDE;
 
     //additional data for cell functions
     RawMemory processMemory;
     CellFunctionData cellFunctionData;
+    TokenFunctionBins tokenFunctionBins;
 
     //scheduled operations
     TempArray<StructuralOperation> structuralOperations;
+    StructuralOperationBuckets structuralOperationBuckets;
     TempArray<SensorOperation> sensorOperations;
     TempArray<NeuralNetOperation> neuralNetOperations;
+    ConstructionReservations constructionReservations;
 
     //number generators
     CudaNumberGenerator numberGen1;
     CudaNumberGenerator numberGen2;  //second random number generator used in combination with the first generator for evaluating very low probabilities
 
-    void init(int2 const& worldSize);
+    void init(Settings const& settings);
+    void setTimestep(uint64_t timestep);
     bool shouldResize(int additionalCells, int additionalParticles, int additionalTokens);
     void resizeEntitiesForCleanup(int additionalCells, int additionalParticles, int additionalTokens);
     void resizeRemainings();
+    void resizeTokenMemoryForCleanup(int newTokenMemoryStride);
+    void resizeFlowFieldGrid(int gridSpacing);
+    void resizeStructuralOperations(int maxOperations);
     bool isEmpty();
     void free();
 
@@ -46,6 +62,8 @@ struct SimulationData
     __device__ bool shouldResize();
 
 private:
+    void resizeProcessMemory();
+
     template <typename Entity>
     void resizeTargetIntern(Array<Entity> const& sourceArray, Array<Entity>& targetArray, int additionalEntities);
 };
@@ -18,14 +18,53 @@ __global__ void cudaNextTimestep_substep1(SimulationData data)
     cellProcessor.clearDensityMap(data);
 }
 
+__global__ void cudaPrepareCellMapRanges(SimulationData data)
+{
+    CellProcessor cellProcessor;
+    cellProcessor.prepareMapRanges(data);
+}
+
+__global__ void cudaSortCellMap(SimulationData data)
+{
+    CellProcessor cellProcessor;
+    cellProcessor.sortMap(data);
+}
+
+__global__ void cudaPrepareNeighborListCheck(SimulationData data)
+{
+    CellProcessor cellProcessor;
+    cellProcessor.prepareNeighborListCheck(data);
+}
+
+__global__ void cudaCheckNeighborList(SimulationData data)
+{
+    CellProcessor cellProcessor;
+    cellProcessor.checkNeighborList(data);
+}
+
+__global__ void cudaCountNeighbors(SimulationData data)
+{
+    CellProcessor cellProcessor;
+    cellProcessor.countNeighbors(data);
+}
+
+__global__ void cudaPrepareNeighborListRanges(SimulationData data)
+{
+    CellProcessor cellProcessor;
+    cellProcessor.prepareNeighborListRanges(data);
+}
+
+__global__ void cudaFillNeighborList(SimulationData data)
+{
+    CellProcessor cellProcessor;
+    cellProcessor.fillNeighborList(data);
+}
+
 __global__ void cudaNextTimestep_substep2(SimulationData data)
 {
     CellProcessor cellProcessor;
     cellProcessor.collisions(data);
     cellProcessor.fillDensityMap(data);
-
-    ParticleProcessor particleProcessor;
-    particleProcessor.updateMap(data);
 }
 
 __global__ void cudaNextTimestep_substep3(SimulationData data)
@@ -38,12 +77,41 @@ __global__ void cudaNextTimestep_substep3(SimulationData data)
 
     ParticleProcessor particleProcessor;
     particleProcessor.movement(data);
-    particleProcessor.collision(data);
 
     TokenProcessor tokenProcessor;
     tokenProcessor.applyMutation(data);
 }
 
+__global__ void cudaUpdateParticleMap(SimulationData data)
+{
+    ParticleProcessor particleProcessor;
+    particleProcessor.updateMap(data);
+}
+
+__global__ void cudaPrepareParticleMapRanges(SimulationData data)
+{
+    ParticleProcessor particleProcessor;
+    particleProcessor.prepareMapRanges(data);
+}
+
+__global__ void cudaSortParticleMap(SimulationData data)
+{
+    ParticleProcessor particleProcessor;
+    particleProcessor.sortMap(data);
+}
+
+__global__ void cudaSortParticleMapBins(SimulationData data)
+{
+    ParticleProcessor particleProcessor;
+    particleProcessor.sortMapBins(data);
+}
+
+__global__ void cudaParticleCollision(SimulationData data)
+{
+    ParticleProcessor particleProcessor;
+    particleProcessor.collision(data);
+}
+
 __global__ void cudaNextTimestep_substep4(SimulationData data)
 {
     CellProcessor cellProcessor;
@@ -62,11 +130,38 @@ __global__ void cudaNextTimestep_substep5(SimulationData data)
     data.entities.tokenPointers.saveNumEntries();
 }
 
-__global__ void cudaNextTimestep_substep6(SimulationData data, SimulationResult result)
+__global__ void cudaCountTokenFunctionBins(SimulationData data)
+{
+    TokenProcessor tokenProcessor;
+    tokenProcessor.countFunctionBins(data);
+}
+
+__global__ void cudaPrepareTokenFunctionBinRanges(SimulationData data)
+{
+    TokenProcessor tokenProcessor;
+    tokenProcessor.prepareFunctionBinRanges(data);
+}
+
+__global__ void cudaSortTokenFunctionBins(SimulationData data)
+{
+    TokenProcessor tokenProcessor;
+    tokenProcessor.sortFunctionBins(data);
+}
+
+__global__ void cudaNextTimestep_substep6(SimulationData data)
 {
     CellProcessor cellProcessor;
     cellProcessor.calcConnectionForces(data);
+}
 
+__global__ void cudaExecuteReadonlyCellFunctions(SimulationData data, SimulationResult result, Enums::CellFunction cellFunctionType)
+{
+    TokenProcessor tokenProcessor;
+    tokenProcessor.executeReadonlyCellFunctions(data, result, cellFunctionType);
+}
+
+__global__ void cudaExecuteReadonlyCellFunctionBins(SimulationData data, SimulationResult result)
+{
     TokenProcessor tokenProcessor;
     tokenProcessor.executeReadonlyCellFunctions(data, result);
 }
@@ -79,10 +174,46 @@ __global__ void cudaNextTimestep_substep7(SimulationData data)
     cellProcessor.verletUpdateVelocities(data);
 }
 
-__global__ void cudaNextTimestep_substep8(SimulationData data, SimulationResult result)
+__global__ void cudaExecuteModifyingCellFunctions(SimulationData data, SimulationResult result, Enums::CellFunction cellFunctionType)
+{
+    TokenProcessor tokenProcessor;
+    tokenProcessor.executeModifyingCellFunctions(data, result, cellFunctionType);
+}
+
+__global__ void cudaExecuteModifyingCellFunctionBins(SimulationData data, SimulationResult result, int firstCellFunction, int endCellFunction)
 {
     TokenProcessor tokenProcessor;
-    tokenProcessor.executeModifyingCellFunctions(data, result);
+    tokenProcessor.executeModifyingCellFunctions(data, result, firstCellFunction, endCellFunction);
+}
+
+__global__ void cudaClaimConstructionCells(SimulationData data)
+{
+    ConstructionProcessor::claimCells(data);
+}
+
+__global__ void cudaResolveConstructionClaimTies(SimulationData data)
+{
+    ConstructionProcessor::resolveClaimTies(data);
+}
+
+__global__ void cudaGrantConstructions(SimulationData data)
+{
+    ConstructionProcessor::grantConstructions(data);
+}
+
+__global__ void cudaReleaseConstructionCells(SimulationData data)
+{
+    ConstructionProcessor::releaseCells(data);
+}
+
+__global__ void cudaExecuteGrantedConstructions(SimulationData data, SimulationResult result)
+{
+    ConstructionProcessor::executeGrantedConstructions(data, result);
+}
+
+__global__ void cudaExecuteRemainingConstructionRounds(SimulationData data, SimulationResult result)
+{
+    ConstructionProcessor::executeRemainingRounds_block(data, result);
 }
 
 __global__ void cudaNextTimestep_substep9(SimulationData data)
@@ -98,25 +229,59 @@ __global__ void cudaNextTimestep_substep10(SimulationData data)
     cellProcessor.decay(data);
 }
 
-__global__ void cudaNextTimestep_substep11(SimulationData data)
+__global__ void cudaPrepareStructuralOperations(SimulationData data)
 {
     data.structuralOperations.saveNumEntries();
+    data.structuralOperationBuckets.reset();
 }
 
-__global__ void cudaNextTimestep_substep12(SimulationData data)
+__global__ void cudaSplitStructuralOperations(SimulationData data)
+{
+    CellConnectionProcessor::splitOperations(data);
+}
+
+__global__ void cudaPrepareStructuralOperationBuckets(SimulationData data)
+{
+    data.structuralOperationBuckets.prepareBuckets();
+}
+
+__global__ void cudaCountStructuralOperationEntries(SimulationData data)
+{
+    data.structuralOperationBuckets.count_system();
+}
+
+__global__ void cudaPrepareStructuralOperationRanges(SimulationData data)
 {
-    CellConnectionProcessor::processConnectionsOperations(data);
+    data.structuralOperationBuckets.prepareRanges_block();
 }
 
-__global__ void cudaNextTimestep_substep13(SimulationData data)
+__global__ void cudaSortStructuralOperationEntries(SimulationData data)
+{
+    data.structuralOperationBuckets.sort_system();
+}
+
+__global__ void cudaApplyStructuralOperationDeletions(SimulationData data)
+{
+    CellConnectionProcessor::applyDeletionsAndGrantConnections(data);
+}
+
+__global__ void cudaApplyStructuralOperationConnections(SimulationData data)
+{
+    CellConnectionProcessor::applyConnectionsAndCellDeletions(data);
+}
+
+__global__ void cudaFinishStructuralOperations(SimulationData data)
+{
+    data.structuralOperations.reset();
+}
+
+__global__ void cudaNextTimestep_substep11(SimulationData data)
 {
     ParticleProcessor particleProcessor;
     particleProcessor.transformation(data);
-
-    CellConnectionProcessor::processDelCellOperations(data);
 }
 
-__global__ void cudaNextTimestep_substep14(SimulationData data)
+__global__ void cudaNextTimestep_substep12(SimulationData data)
 {
     TokenProcessor tokenProcessor;
     tokenProcessor.deleteTokenIfCellDeleted(data);
@@ -17,19 +17,51 @@
 
 __global__ void cudaPrepareNextTimestep(SimulationData data, SimulationResult result);
 __global__ void cudaNextTimestep_substep1(SimulationData data);
+__global__ void cudaPrepareCellMapRanges(SimulationData data);
+__global__ void cudaSortCellMap(SimulationData data);
+__global__ void cudaPrepareNeighborListCheck(SimulationData data);
+__global__ void cudaCheckNeighborList(SimulationData data);
+__global__ void cudaCountNeighbors(SimulationData data);
+__global__ void cudaPrepareNeighborListRanges(SimulationData data);
+__global__ void cudaFillNeighborList(SimulationData data);
 __global__ void cudaNextTimestep_substep2(SimulationData data);
 __global__ void cudaNextTimestep_substep3(SimulationData data);
+__global__ void cudaUpdateParticleMap(SimulationData data);
+__global__ void cudaPrepareParticleMapRanges(SimulationData data);
+__global__ void cudaSortParticleMap(SimulationData data);
+__global__ void cudaSortParticleMapBins(SimulationData data);
+__global__ void cudaParticleCollision(SimulationData data);
 __global__ void cudaNextTimestep_substep4(SimulationData data);
 __global__ void cudaNextTimestep_substep5(SimulationData data);
-__global__ void cudaNextTimestep_substep6(SimulationData data, SimulationResult result);
+__global__ void cudaCountTokenFunctionBins(SimulationData data);
+__global__ void cudaPrepareTokenFunctionBinRanges(SimulationData data);
+__global__ void cudaSortTokenFunctionBins(SimulationData data);
+__global__ void cudaNextTimestep_substep6(SimulationData data);
+__global__ void cudaExecuteReadonlyCellFunctions(SimulationData data, SimulationResult result, Enums::CellFunction cellFunctionType);
+__global__ void cudaExecuteReadonlyCellFunctionBins(SimulationData data, SimulationResult result);
 __global__ void cudaNextTimestep_substep7(SimulationData data);
-__global__ void cudaNextTimestep_substep8(SimulationData data, SimulationResult result);
+__global__ void cudaExecuteModifyingCellFunctions(SimulationData data, SimulationResult result, Enums::CellFunction cellFunctionType);
+__global__ void cudaExecuteModifyingCellFunctionBins(SimulationData data, SimulationResult result, int firstCellFunction, int endCellFunction);
+__global__ void cudaClaimConstructionCells(SimulationData data);
+__global__ void cudaResolveConstructionClaimTies(SimulationData data);
+__global__ void cudaGrantConstructions(SimulationData data);
+__global__ void cudaReleaseConstructionCells(SimulationData data);
+__global__ void cudaExecuteGrantedConstructions(SimulationData data, SimulationResult result);
+__global__ void cudaExecuteRemainingConstructionRounds(SimulationData data, SimulationResult result);
 __global__ void cudaNextTimestep_substep9(SimulationData data);
 __global__ void cudaNextTimestep_substep10(SimulationData data);
 __global__ void cudaNextTimestep_substep11(SimulationData data);
 __global__ void cudaNextTimestep_substep12(SimulationData data);
-__global__ void cudaNextTimestep_substep13(SimulationData data);
-__global__ void cudaNextTimestep_substep14(SimulationData data);
+
+__global__ void cudaPrepareStructuralOperations(SimulationData data);
+__global__ void cudaSplitStructuralOperations(SimulationData data);
+__global__ void cudaPrepareStructuralOperationBuckets(SimulationData data);
+__global__ void cudaCountStructuralOperationEntries(SimulationData data);
+__global__ void cudaPrepareStructuralOperationRanges(SimulationData data);
+__global__ void cudaSortStructuralOperationEntries(SimulationData data);
+__global__ void cudaApplyStructuralOperationDeletions(SimulationData data);
+__global__ void cudaApplyStructuralOperationConnections(SimulationData data);
+__global__ void cudaFinishStructuralOperations(SimulationData data);
 
 __global__ void cudaInitClusterData(SimulationData data);
 __global__ void cudaFindClusterIteration(SimulationData data);
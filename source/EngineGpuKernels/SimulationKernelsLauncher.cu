@@ -7,6 +7,20 @@
 _SimulationKernelsLauncher::_SimulationKernelsLauncher()
 {
     _garbageCollector = std::make_shared<_GarbageCollectorKernelsLauncher>();
+    for (int i = 0; i < Enums::CellFunction_Count; ++i) {
+        for (auto& event : _cellFunctionEvents[i]) {
+            CHECK_FOR_CUDA_ERROR(cudaEventCreate(&event));
+        }
+    }
+}
+
+_SimulationKernelsLauncher::~_SimulationKernelsLauncher()
+{
+    for (int i = 0; i < Enums::CellFunction_Count; ++i) {
+        for (auto const& event : _cellFunctionEvents[i]) {
+            cudaEventDestroy(event);
+        }
+    }
 }
 
 void _SimulationKernelsLauncher::calcTimestep(Settings const& settings, SimulationData const& data, SimulationResult const& result)
@@ -17,13 +31,30 @@ void _SimulationKernelsLauncher::calcTimestep(Settings const& settings, Simulati
         KERNEL_CALL(cudaApplyFlowFieldSettings, data);
     }
     KERNEL_CALL(cudaNextTimestep_substep1, data);
+    KERNEL_CALL_1_BLOCK(cudaPrepareCellMapRanges, data);
+    KERNEL_CALL(cudaSortCellMap, data);
+    updateNeighborList(gpuSettings, data);
     KERNEL_CALL(cudaNextTimestep_substep2, data);
     KERNEL_CALL(cudaNextTimestep_substep3, data);
+    KERNEL_CALL(cudaUpdateParticleMap, data);
+    KERNEL_CALL_1_BLOCK(cudaPrepareParticleMapRanges, data);
+    KERNEL_CALL(cudaSortParticleMap, data);
+    KERNEL_CALL(cudaSortParticleMapBins, data);
+    KERNEL_CALL(cudaParticleCollision, data);
     KERNEL_CALL(cudaNextTimestep_substep4, data);
     KERNEL_CALL(cudaNextTimestep_substep5, data);
-    KERNEL_CALL(cudaNextTimestep_substep6, data, result);
+    KERNEL_CALL(cudaCountTokenFunctionBins, data);
+    KERNEL_CALL_1_BLOCK(cudaPrepareTokenFunctionBinRanges, data);
+    KERNEL_CALL(cudaSortTokenFunctionBins, data);
+    KERNEL_CALL(cudaNextTimestep_substep6, data);
+    auto timeCellFunctions = _cellFunctionBatchTimesRequested;
+    executeCellFunctions(gpuSettings, data, result, false, timeCellFunctions);
     KERNEL_CALL(cudaNextTimestep_substep7, data);
-    KERNEL_CALL(cudaNextTimestep_substep8, data, result);
+    executeCellFunctions(gpuSettings, data, result, true, timeCellFunctions);
+    if (timeCellFunctions) {
+        _cellFunctionBatchTimesRequested = false;
+        _cellFunctionBatchTimesAvailable = true;
+    }
     if (_counter == 0) {
         KERNEL_CALL(cudaNextTimestep_substep9, data);
     }
@@ -41,10 +72,9 @@ void _SimulationKernelsLauncher::calcTimestep(Settings const& settings, Simulati
             KERNEL_CALL(cudaApplyClusterData, data);
         }
     }
-    KERNEL_CALL_1_1(cudaNextTimestep_substep11, data);
+    processStructuralOperations(gpuSettings, data);
+    KERNEL_CALL(cudaNextTimestep_substep11, data);
     KERNEL_CALL(cudaNextTimestep_substep12, data);
-    KERNEL_CALL(cudaNextTimestep_substep13, data);
-    KERNEL_CALL(cudaNextTimestep_substep14, data);
 
     _garbageCollector->cleanupAfterTimestep(settings.gpuSettings, data);
     if (++_counter == 3) {
@@ -52,6 +82,104 @@ void _SimulationKernelsLauncher::calcTimestep(Settings const& settings, Simulati
     }
 }
 
+void _SimulationKernelsLauncher::getCellFunctionBatchTimes(float* result)
+{
+    _cellFunctionBatchTimesRequested = true;
+    for (int i = 0; i < Enums::CellFunction_Count; ++i) {
+        result[i] = 0;
+        if (!_cellFunctionBatchTimesAvailable) {
+            continue;
+        }
+        auto const& events = _cellFunctionEvents[i];
+        CHECK_FOR_CUDA_ERROR(cudaEventElapsedTime(&result[i], events[ModifyingStart], events[ModifyingEnd]));
+        if (TokenFunctionBins::isReadonlyCellFunction(i)) {
+            float readonlyTime;
+            CHECK_FOR_CUDA_ERROR(cudaEventElapsedTime(&readonlyTime, events[ReadonlyStart], events[ReadonlyEnd]));
+            result[i] += readonlyTime;
+        }
+    }
+}
+
+void _SimulationKernelsLauncher::updateNeighborList(GpuSettings const& gpuSettings, SimulationData const& data)
+{
+    KERNEL_CALL_1_1(cudaPrepareNeighborListCheck, data);
+    KERNEL_CALL(cudaCheckNeighborList, data);
+    KERNEL_CALL(cudaCountNeighbors, data);
+    KERNEL_CALL_1_BLOCK(cudaPrepareNeighborListRanges, data);
+    KERNEL_CALL(cudaFillNeighborList, data);
+}
+
+void _SimulationKernelsLauncher::processStructuralOperations(GpuSettings const& gpuSettings, SimulationData const& data)
+{
+    KERNEL_CALL_1_1(cudaPrepareStructuralOperations, data);
+    KERNEL_CALL(cudaSplitStructuralOperations, data);
+    KERNEL_CALL_1_1(cudaPrepareStructuralOperationBuckets, data);
+    KERNEL_CALL(cudaCountStructuralOperationEntries, data);
+    KERNEL_CALL_1_BLOCK(cudaPrepareStructuralOperationRanges, data);
+    KERNEL_CALL(cudaSortStructuralOperationEntries, data);
+    KERNEL_CALL(cudaApplyStructuralOperationDeletions, data);
+    KERNEL_CALL(cudaApplyStructuralOperationConnections, data);
+    KERNEL_CALL_1_1(cudaFinishStructuralOperations, data);
+}
+
+void _SimulationKernelsLauncher::updateFlowFieldGrid(GpuSettings const& gpuSettings, SimulationData const& data)
+{
+    KERNEL_CALL(cudaUpdateFlowFieldGrid, data);
+}
+
+void _SimulationKernelsLauncher::executeCellFunctions(
+    GpuSettings const& gpuSettings,
+    SimulationData const& data,
+    SimulationResult const& result,
+    bool modifying,
+    bool timed)
+{
+    //without timing the bins are processed by one kernel per phase, hence empty bins cost no launch (the bin sizes are
+    //only known on the device); the constructions are still executed right after the constructor bin
+    if (!timed) {
+        if (modifying) {
+            KERNEL_CALL(cudaExecuteModifyingCellFunctionBins, data, result, 0, Enums::CellFunction_Constructor + 1);
+            executeConstructions(gpuSettings, data, result);
+            KERNEL_CALL(cudaExecuteModifyingCellFunctionBins, data, result, Enums::CellFunction_Constructor + 1, Enums::CellFunction_Count);
+        } else {
+            KERNEL_CALL(cudaExecuteReadonlyCellFunctionBins, data, result);
+        }
+        return;
+    }
+
+    //each cell function is executed as a separate batch on its token bin
+    for (int i = 0; i < Enums::CellFunction_Count; ++i) {
+        auto const& events = _cellFunctionEvents[i];
+        if (modifying) {
+            CHECK_FOR_CUDA_ERROR(cudaEventRecord(events[ModifyingStart]));
+            KERNEL_CALL(cudaExecuteModifyingCellFunctions, data, result, i);
+            if (Enums::CellFunction_Constructor == i) {
+                executeConstructions(gpuSettings, data, result);
+            }
+            CHECK_FOR_CUDA_ERROR(cudaEventRecord(events[ModifyingEnd]));
+        } else if (TokenFunctionBins::isReadonlyCellFunction(i)) {
+            CHECK_FOR_CUDA_ERROR(cudaEventRecord(events[ReadonlyStart]));
+            KERNEL_CALL(cudaExecuteReadonlyCellFunctions, data, result, i);
+            CHECK_FOR_CUDA_ERROR(cudaEventRecord(events[ReadonlyEnd]));
+        }
+    }
+}
+
+void _SimulationKernelsLauncher::executeConstructions(GpuSettings const& gpuSettings, SimulationData const& data, SimulationResult const& result)
+{
+    //at least one pending construction is executed per round and the construction priorities let most constructions
+    //pass in the first rounds, the rounds are launched without checking for pending constructions on the host (the
+    //kernels are no-ops if none is pending), the remaining ones are executed by a single block looping on the device
+    for (int i = 0; i < NumConstructionRounds; ++i) {
+        KERNEL_CALL(cudaClaimConstructionCells, data);
+        KERNEL_CALL(cudaResolveConstructionClaimTies, data);
+        KERNEL_CALL(cudaGrantConstructions, data);
+        KERNEL_CALL(cudaReleaseConstructionCells, data);
+        KERNEL_CALL(cudaExecuteGrantedConstructions, data, result);
+    }
+    KERNEL_CALL_1_BLOCK(cudaExecuteRemainingConstructionRounds, data, result);
+}
+
 bool _SimulationKernelsLauncher::isRigidityUpdateEnabled(Settings const& settings) const
 {
     for(int i = 0; i < settings.simulationParametersSpots.numSpots; ++i) {
@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include "EngineInterface/Enums.h"
 #include "EngineInterface/Settings.h"
 
 #include "Definitions.cuh"
@@ -10,13 +11,39 @@ class _SimulationKernelsLauncher
 {
 public:
     _SimulationKernelsLauncher();
+    ~_SimulationKernelsLauncher();
 
     void calcTimestep(Settings const& settings, SimulationData const& simulationData, SimulationResult const& result);
+    void updateFlowFieldGrid(GpuSettings const& gpuSettings, SimulationData const& simulationData);
+
+    //batch times of the last timed time step in milliseconds, result needs Enums::CellFunction_Count elements
+    //the cell functions are only timed on request, each call requests the timing of the next time step
+    void getCellFunctionBatchTimes(float* result);
+
+    //also used for structural operations scheduled by edit functions
+    static void updateNeighborList(GpuSettings const& gpuSettings, SimulationData const& simulationData);  //rebuilt only if necessary
+    static void processStructuralOperations(GpuSettings const& gpuSettings, SimulationData const& simulationData);
 
 private:
+    void executeCellFunctions(GpuSettings const& gpuSettings, SimulationData const& data, SimulationResult const& result, bool modifying, bool timed);
+    void executeConstructions(GpuSettings const& gpuSettings, SimulationData const& data, SimulationResult const& result);
     bool isRigidityUpdateEnabled(Settings const& settings) const;
 
+    static auto constexpr NumConstructionRounds = 4;  //rounds executed by the whole grid
+
     GarbageCollectorKernelsLauncher _garbageCollector;
     int _counter = 0;
+
+    enum CellFunctionEvent_
+    {
+        ReadonlyStart,
+        ReadonlyEnd,
+        ModifyingStart,
+        ModifyingEnd,
+        CellFunctionEvent_Count
+    };
+    cudaEvent_t _cellFunctionEvents[Enums::CellFunction_Count][CellFunctionEvent_Count];
+    bool _cellFunctionBatchTimesRequested = false;
+    bool _cellFunctionBatchTimesAvailable = false;
 };
 
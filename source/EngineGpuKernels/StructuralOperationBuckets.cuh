@@ -0,0 +1,134 @@
+#pragma once
+
+#include "Base.cuh"
+#include "CudaMemoryManager.cuh"
+#include "StructuralOperationSegments.cuh"
+
+//device buffers for processing the scheduled structural operations by StructuralOperationSegments:
+//the entries of the operations are counted per bucket, the counts are converted to ranges and the entries are scattered
+//into the ranges (same scheme as CellMap)
+class StructuralOperationBuckets
+{
+public:
+    __host__ __inline__ void init()
+    {
+        CudaMemoryManager::getInstance().acquireMemory<int>(1, _numEntries);
+        CudaMemoryManager::getInstance().acquireMemory<int>(1, _numBuckets);
+        CudaMemoryManager::getInstance().acquireMemory<int>(1, _numDroppedOperations);
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_numEntries, 0, sizeof(int)));
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_numBuckets, 0, sizeof(int)));
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_numDroppedOperations, 0, sizeof(int)));
+        resize(1);
+    }
+
+    __host__ __inline__ void resize(int maxOperations)
+    {
+        freeBuffers();
+        _maxOperations = maxOperations;
+        _maxEntries = maxOperations * EntriesPerOperation;
+        auto maxBuckets = StructuralOperationSegments::calcNumBuckets(_maxEntries);
+        CudaMemoryManager::getInstance().acquireMemory<CellOperationEntry>(_maxEntries, _entries);
+        CudaMemoryManager::getInstance().acquireMemory<CellOperationEntry>(_maxEntries, _sortedEntries);
+        CudaMemoryManager::getInstance().acquireMemory<int>(_maxEntries, _entryOffsets);
+        CudaMemoryManager::getInstance().acquireMemory<int>(maxBuckets, _bucketCounts);
+        CudaMemoryManager::getInstance().acquireMemory<int>(maxBuckets + 1, _bucketStarts);
+        CudaMemoryManager::getInstance().acquireMemory<unsigned char>(maxOperations * 2, _grants);
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_bucketCounts, 0, sizeof(int) * maxBuckets));
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_bucketStarts, 0, sizeof(int) * (maxBuckets + 1)));
+    }
+
+    __host__ __inline__ void free()
+    {
+        freeBuffers();
+        CudaMemoryManager::getInstance().freeMemory(_numEntries);
+        CudaMemoryManager::getInstance().freeMemory(_numBuckets);
+        CudaMemoryManager::getInstance().freeMemory(_numDroppedOperations);
+    }
+
+    __host__ __inline__ int getMaxOperations() const { return _maxOperations; }
+
+    //number of operations dropped since the simulation start because the buffers were full
+    __host__ __inline__ int getNumDroppedOperations_host() const
+    {
+        int result;
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy(&result, _numDroppedOperations, sizeof(int), cudaMemcpyDeviceToHost));
+        return result;
+    }
+
+    __device__ __inline__ int getMaxOperations_device() const { return _maxOperations; }
+    __device__ __inline__ int getNumDroppedOperations() const { return *_numDroppedOperations; }  //read by the monitor kernels
+    __device__ __inline__ void reportDroppedOperation() { atomicAdd(_numDroppedOperations, 1); }
+    __device__ __inline__ void reset() { *_numEntries = 0; }
+
+    //reserves consecutive entries for one operation, nullptr if there is not enough space
+    __device__ __inline__ CellOperationEntry* tryReserveEntries(int numEntries)
+    {
+        int origNumEntries = *_numEntries;
+        int assumed;
+        do {
+            if (origNumEntries + numEntries > _maxEntries) {
+                return nullptr;
+            }
+            assumed = origNumEntries;
+            origNumEntries = atomicCAS(_numEntries, assumed, assumed + numEntries);
+        } while (assumed != origNumEntries);
+        return &_entries[origNumEntries];
+    }
+
+    __device__ __inline__ void prepareBuckets() { *_numBuckets = StructuralOperationSegments::calcNumBuckets(*_numEntries); }
+
+    //first pass: count entries per bucket
+    __device__ __inline__ void count_system()
+    {
+        auto const partition = calcAllThreadsPartition(*_numEntries);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto bucket = StructuralOperationSegments::getBucket(_entries[index].cellIndex, *_numBuckets);
+            _entryOffsets[index] = atomicAdd(&_bucketCounts[bucket], 1);
+        }
+    }
+
+    //second pass: exclusive prefix sum of the counts, needs to be executed by a single block
+    __device__ __inline__ void prepareRanges_block() { exclusiveScan_block(_bucketCounts, _bucketStarts, *_numBuckets); }
+
+    //third pass: scatter entries into the bucket ranges
+    __device__ __inline__ void sort_system()
+    {
+        auto const partition = calcAllThreadsPartition(*_numEntries);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto bucket = StructuralOperationSegments::getBucket(_entries[index].cellIndex, *_numBuckets);
+            _sortedEntries[_bucketStarts[bucket] + _entryOffsets[index]] = _entries[index];
+        }
+    }
+
+    __device__ __inline__ int getNumBuckets() const { return *_numBuckets; }
+    __device__ __inline__ CellOperationEntry* getSegment(int bucket) const { return &_sortedEntries[_bucketStarts[bucket]]; }
+    __device__ __inline__ int getSegmentSize(int bucket) const { return _bucketCounts[bucket]; }
+    __device__ __inline__ void clearSegment(int bucket) { _bucketCounts[bucket] = 0; }
+    __device__ __inline__ unsigned char* getGrants() const { return _grants; }
+
+private:
+    static auto constexpr EntriesPerOperation = 4;
+
+    __host__ __inline__ void freeBuffers()
+    {
+        CudaMemoryManager::getInstance().freeMemory(_entries);
+        CudaMemoryManager::getInstance().freeMemory(_sortedEntries);
+        CudaMemoryManager::getInstance().freeMemory(_entryOffsets);
+        CudaMemoryManager::getInstance().freeMemory(_bucketCounts);
+        CudaMemoryManager::getInstance().freeMemory(_bucketStarts);
+        CudaMemoryManager::getInstance().freeMemory(_grants);
+    }
+
+    int _maxOperations = 0;
+    int _maxEntries = 0;
+
+    int* _numEntries = nullptr;
+    int* _numBuckets = nullptr;
+    int* _numDroppedOperations = nullptr;
+    CellOperationEntry* _entries = nullptr;
+    CellOperationEntry* _sortedEntries = nullptr;
+    int* _entryOffsets = nullptr;
+    int* _bucketCounts = nullptr;
+    int* _bucketStarts = nullptr;
+    unsigned char* _grants = nullptr;
+};
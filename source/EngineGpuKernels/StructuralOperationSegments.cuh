@@ -0,0 +1,263 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <cuda_runtime.h>
+
+enum class StructuralOperationType
+{
+    AddConnections,
+    DelConnections,
+    DelConnection,
+    DelCell,
+    DelCellAndConnections,
+};
+
+//part of a structural operation which affects a single cell: an operation is split into one entry for each affected
+//cell such that a cell is only modified by the thread owning the segment of its entries
+struct CellOperationEntry
+{
+    enum class Type  //processing order within the entries of a cell
+    {
+        DelConnection,
+        DelConnections,
+        AddConnection,
+        DelCell,
+    };
+    Type type;
+    int cellIndex;
+    int otherCellIndex;
+    int operationIndex;
+    int side;  //0 = cell is the first cell of the operation, 1 = second cell
+};
+
+//sort-and-segment processing of structural operations, the entries are sorted into buckets by cell index and each
+//bucket is processed by one thread without locks
+//
+//CellAccess provides the cell data and changes by cell index:
+//  getNumConnections, getMaxConnections, getConnectedCellIndex, isConnected,
+//  delConnectionOneWay, delConnectionsOneWay, addConnectionOneWay(cellIndex, otherCellIndex, operationIndex), delCell(cellIndex, operationIndex)
+class StructuralOperationSegments
+{
+public:
+    template <typename CellAccess>
+    __host__ __device__ __inline__ static int getNumEntries(CellAccess const& cells, StructuralOperationType type, int cellIndex)
+    {
+        switch (type) {
+        case StructuralOperationType::AddConnections:
+        case StructuralOperationType::DelConnection:
+            return 2;
+        case StructuralOperationType::DelConnections:
+            return 1 + cells.getNumConnections(cellIndex);
+        case StructuralOperationType::DelCell:
+            return 1;
+        case StructuralOperationType::DelCellAndConnections:
+            return 2 + cells.getNumConnections(cellIndex);
+        }
+        return 0;
+    }
+
+    //entries needs space for getNumEntries(...) elements
+    template <typename CellAccess>
+    __host__ __device__ __inline__ static void createEntries(
+        CellAccess const& cells,
+        StructuralOperationType type,
+        int cellIndex,
+        int otherCellIndex,
+        int operationIndex,
+        CellOperationEntry* entries)
+    {
+        switch (type) {
+        case StructuralOperationType::AddConnections:
+            entries[0] = {CellOperationEntry::Type::AddConnection, cellIndex, otherCellIndex, operationIndex, 0};
+            entries[1] = {CellOperationEntry::Type::AddConnection, otherCellIndex, cellIndex, operationIndex, 1};
+            return;
+        case StructuralOperationType::DelConnection:
+            entries[0] = {CellOperationEntry::Type::DelConnection, cellIndex, otherCellIndex, operationIndex, 0};
+            entries[1] = {CellOperationEntry::Type::DelConnection, otherCellIndex, cellIndex, operationIndex, 1};
+            return;
+        case StructuralOperationType::DelCell:
+            entries[0] = {CellOperationEntry::Type::DelCell, cellIndex, -1, operationIndex, 0};
+            return;
+        case StructuralOperationType::DelConnections:
+        case StructuralOperationType::DelCellAndConnections: {
+            auto numConnections = cells.getNumConnections(cellIndex);
+            entries[0] = {CellOperationEntry::Type::DelConnections, cellIndex, -1, operationIndex, 0};
+            for (int i = 0; i < numConnections; ++i) {
+                entries[1 + i] = {CellOperationEntry::Type::DelConnection, cells.getConnectedCellIndex(cellIndex, i), cellIndex, operationIndex, 1};
+            }
+            if (StructuralOperationType::DelCellAndConnections == type) {
+                entries[1 + numConnections] = {CellOperationEntry::Type::DelCell, cellIndex, -1, operationIndex, 0};
+            }
+            return;
+        }
+        }
+    }
+
+    __host__ __device__ __inline__ static int calcNumBuckets(int numEntries)
+    {
+        int result = 1;
+        while (result < numEntries) {
+            result *= 2;
+        }
+        return result;
+    }
+
+    __host__ __device__ __inline__ static int getBucket(int cellIndex, int numBuckets)
+    {
+        auto hash = static_cast<uint32_t>(cellIndex) * 0x9e3779b1u;
+        hash ^= hash >> 16;
+        return static_cast<int>(hash & static_cast<uint32_t>(numBuckets - 1));
+    }
+
+    //segments are small (about one cell per bucket), hence insertion sort
+    __host__ __device__ __inline__ static void sortSegment(CellOperationEntry* entries, int numEntries)
+    {
+        for (int i = 1; i < numEntries; ++i) {
+            auto entry = entries[i];
+            int j = i - 1;
+            for (; j >= 0 && isLess(entry, entries[j]); --j) {
+                entries[j + 1] = entries[j];
+            }
+            entries[j + 1] = entry;
+        }
+    }
+
+    //first pass on a sorted segment: deletions are applied and requested connections are granted while the cell has free
+    //bonds, grants has two elements per operation (one for each side)
+    template <typename CellAccess>
+    __host__ __device__ __inline__ static void
+    applyDeletionsAndGrantConnections(CellAccess& cells, CellOperationEntry const* entries, int numEntries, unsigned char* grants)
+    {
+        int freeBonds = 0;
+        for (int i = 0; i < numEntries; ++i) {
+            auto const& entry = entries[i];
+            auto isFirstEntryOfCell = 0 == i || entries[i - 1].cellIndex != entry.cellIndex;
+            auto isFirstAddEntryOfCell =
+                isFirstEntryOfCell || entries[i - 1].type != CellOperationEntry::Type::AddConnection;
+
+            switch (entry.type) {
+            case CellOperationEntry::Type::DelConnection:
+                cells.delConnectionOneWay(entry.cellIndex, entry.otherCellIndex);
+                break;
+            case CellOperationEntry::Type::DelConnections:
+                cells.delConnectionsOneWay(entry.cellIndex);
+                break;
+            case CellOperationEntry::Type::AddConnection: {
+                if (isFirstAddEntryOfCell) {
+                    freeBonds = cells.getMaxConnections(entry.cellIndex) - cells.getNumConnections(entry.cellIndex);
+                }
+                auto isDuplicate = !isFirstAddEntryOfCell && entries[i - 1].otherCellIndex == entry.otherCellIndex;
+                auto granted = !isDuplicate && freeBonds > 0 && !cells.isConnected(entry.cellIndex, entry.otherCellIndex);
+                grants[entry.operationIndex * 2 + entry.side] = granted ? 1 : 0;
+                if (granted) {
+                    --freeBonds;
+                }
+                break;
+            }
+            default:
+                break;
+            }
+        }
+    }
+
+    //second pass: connections granted by both cells are established and cell deletions are applied
+    template <typename CellAccess>
+    __host__ __device__ __inline__ static void
+    applyConnectionsAndCellDeletions(CellAccess& cells, CellOperationEntry const* entries, int numEntries, unsigned char const* grants)
+    {
+        for (int i = 0; i < numEntries; ++i) {
+            auto const& entry = entries[i];
+            if (CellOperationEntry::Type::AddConnection == entry.type) {
+                if (grants[entry.operationIndex * 2] && grants[entry.operationIndex * 2 + 1]) {
+                    cells.addConnectionOneWay(entry.cellIndex, entry.otherCellIndex, entry.operationIndex);
+                }
+            }
+            if (CellOperationEntry::Type::DelCell == entry.type) {
+                auto isDuplicate = i > 0 && entries[i - 1].cellIndex == entry.cellIndex && entries[i - 1].type == entry.type;
+                if (!isDuplicate) {
+                    cells.delCell(entry.cellIndex, entry.operationIndex);
+                }
+            }
+        }
+    }
+
+private:
+    __host__ __device__ __inline__ static bool isLess(CellOperationEntry const& entry1, CellOperationEntry const& entry2)
+    {
+        if (entry1.cellIndex != entry2.cellIndex) {
+            return entry1.cellIndex < entry2.cellIndex;
+        }
+        if (entry1.type != entry2.type) {
+            return entry1.type < entry2.type;
+        }
+        if (entry1.otherCellIndex != entry2.otherCellIndex) {
+            return entry1.otherCellIndex < entry2.otherCellIndex;
+        }
+        return entry1.operationIndex < entry2.operationIndex;
+    }
+};
+
+//host-executable counterpart of the device passes with the same bucket layout
+template <typename CellAccess>
+class HostStructuralOperationProcessor
+{
+public:
+    struct Operation
+    {
+        StructuralOperationType type;
+        int cellIndex;
+        int otherCellIndex;
+    };
+
+    void process(CellAccess& cells, std::vector<Operation> const& operations)
+    {
+        //split operations into entries
+        _entries.clear();
+        for (int operationIndex = 0; operationIndex < static_cast<int>(operations.size()); ++operationIndex) {
+            auto const& operation = operations[operationIndex];
+            auto numEntries = StructuralOperationSegments::getNumEntries(cells, operation.type, operation.cellIndex);
+            auto offset = _entries.size();
+            _entries.resize(offset + numEntries);
+            StructuralOperationSegments::createEntries(
+                cells, operation.type, operation.cellIndex, operation.otherCellIndex, operationIndex, &_entries[offset]);
+        }
+
+        //counting sort into buckets
+        auto numEntries = static_cast<int>(_entries.size());
+        auto numBuckets = StructuralOperationSegments::calcNumBuckets(numEntries);
+        _bucketStarts.assign(numBuckets + 1, 0);
+        for (auto const& entry : _entries) {
+            ++_bucketStarts[StructuralOperationSegments::getBucket(entry.cellIndex, numBuckets) + 1];
+        }
+        for (int bucket = 0; bucket < numBuckets; ++bucket) {
+            _bucketStarts[bucket + 1] += _bucketStarts[bucket];
+        }
+        _sortedEntries.resize(numEntries);
+        auto bucketOffsets = _bucketStarts;
+        for (auto const& entry : _entries) {
+            _sortedEntries[bucketOffsets[StructuralOperationSegments::getBucket(entry.cellIndex, numBuckets)]++] = entry;
+        }
+
+        //process segments
+        _grants.assign(operations.size() * 2, 0);
+        for (int bucket = 0; bucket < numBuckets; ++bucket) {
+            auto segment = _sortedEntries.data() + _bucketStarts[bucket];
+            auto segmentSize = _bucketStarts[bucket + 1] - _bucketStarts[bucket];
+            StructuralOperationSegments::sortSegment(segment, segmentSize);
+            StructuralOperationSegments::applyDeletionsAndGrantConnections(cells, segment, segmentSize, _grants.data());
+        }
+        for (int bucket = 0; bucket < numBuckets; ++bucket) {
+            auto segment = _sortedEntries.data() + _bucketStarts[bucket];
+            auto segmentSize = _bucketStarts[bucket + 1] - _bucketStarts[bucket];
+            StructuralOperationSegments::applyConnectionsAndCellDeletions(cells, segment, segmentSize, _grants.data());
+        }
+    }
+
+private:
+    std::vector<CellOperationEntry> _entries;
+    std::vector<CellOperationEntry> _sortedEntries;
+    std::vector<int> _bucketStarts;
+    std::vector<unsigned char> _grants;
+};
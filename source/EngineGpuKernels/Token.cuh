@@ -1,11 +1,19 @@
 #pragma once
+#include "AccessTOs.cuh"
 #include "Base.cuh"
 #include "Definitions.cuh"
 #include "ConstantMemory.cuh"
 
+__host__ __device__ __inline__ int calcTokenMemoryStride(int tokenMemorySize)
+{
+    auto result = tokenMemorySize > MIN_TOKEN_MEM_STRIDE ? tokenMemorySize : MIN_TOKEN_MEM_STRIDE;
+    return result < MAX_TOKEN_MEM_SIZE ? result : MAX_TOKEN_MEM_SIZE;
+}
+
 struct Token
 {
-    char memory[MAX_TOKEN_MEM_SIZE];
+    uint64_t id;   //derived from the ids of the originating token and cells, see CudaNumberGenerator::createDerivedId
+    char* memory;  //points to SimulationData::tokenMemoryStride bytes in Entities::tokenMemory
     Cell* cell;
     float energy;
 
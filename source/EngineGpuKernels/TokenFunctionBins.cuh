@@ -0,0 +1,116 @@
+#pragma once
+
+#include "EngineInterface/Enums.h"
+
+#include "Base.cuh"
+#include "Cell.cuh"
+#include "CudaMemoryManager.cuh"
+#include "Token.cuh"
+
+//token indices grouped by the cell function of the underlying cell so that each cell function can be executed as a
+//homogeneous batch: tokens are counted per cell function, the counts are converted to ranges and the indices are
+//scattered into the ranges (same scheme as StructuralOperationBuckets)
+class TokenFunctionBins
+{
+public:
+    //readonly cell functions are executed before the modifying ones
+    __host__ __device__ __inline__ static bool isReadonlyCellFunction(Enums::CellFunction cellFunctionType)
+    {
+        return Enums::CellFunction_Scanner == cellFunctionType || Enums::CellFunction_Digestion == cellFunctionType
+            || Enums::CellFunction_Sensor == cellFunctionType;
+    }
+
+    __host__ __inline__ void init()
+    {
+        CudaMemoryManager::getInstance().acquireMemory<int>(Enums::CellFunction_Count, _binCounts);
+        CudaMemoryManager::getInstance().acquireMemory<int>(Enums::CellFunction_Count + 1, _binStarts);
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_binCounts, 0, sizeof(int) * Enums::CellFunction_Count));
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_binStarts, 0, sizeof(int) * (Enums::CellFunction_Count + 1)));
+        resize(1);
+    }
+
+    __host__ __inline__ void resize(int maxTokens)
+    {
+        freeBuffers();
+        CudaMemoryManager::getInstance().acquireMemory<int>(maxTokens, _tokenOffsets);
+        CudaMemoryManager::getInstance().acquireMemory<int>(maxTokens, _sortedTokenIndices);
+    }
+
+    __host__ __inline__ void free()
+    {
+        freeBuffers();
+        CudaMemoryManager::getInstance().freeMemory(_binCounts);
+        CudaMemoryManager::getInstance().freeMemory(_binStarts);
+    }
+
+    //bin sizes of the last time step
+    __host__ __inline__ void getBinSizes_host(int* result) const
+    {
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy(result, _binCounts, sizeof(int) * Enums::CellFunction_Count, cudaMemcpyDeviceToHost));
+    }
+
+    __device__ __inline__ void reset()
+    {
+        for (int i = 0; i < Enums::CellFunction_Count; ++i) {
+            _binCounts[i] = 0;
+        }
+    }
+
+    //first pass: count tokens per cell function
+    __device__ __inline__ void count_system(int numTokens, Token** tokens)
+    {
+        auto const partition = calcAllThreadsPartition(numTokens);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            if (auto const& token = tokens[index]) {
+                _tokenOffsets[index] = atomicAdd(&_binCounts[token->cell->getCellFunctionType()], 1);
+            } else {
+                _tokenOffsets[index] = -1;
+            }
+        }
+    }
+
+    //second pass: exclusive prefix sum of the counts, needs to be executed by a single block
+    __device__ __inline__ void prepareRanges_block() { exclusiveScan_block(_binCounts, _binStarts, Enums::CellFunction_Count); }
+
+    //third pass: scatter token indices into the bin ranges
+    __device__ __inline__ void sort_system(int numTokens, Token** tokens)
+    {
+        auto const partition = calcAllThreadsPartition(numTokens);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            if (_tokenOffsets[index] != -1) {
+                auto bin = tokens[index]->cell->getCellFunctionType();
+                _sortedTokenIndices[_binStarts[bin] + _tokenOffsets[index]] = index;
+            }
+        }
+    }
+
+    template <typename Func>
+    __device__ __inline__ void executeForEachInBin_system(Enums::CellFunction cellFunctionType, Func const& func) const
+    {
+        auto const partition = calcAllThreadsPartition(_binCounts[cellFunctionType]);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            func(_sortedTokenIndices[_binStarts[cellFunctionType] + index]);
+        }
+    }
+
+    template <typename Func>
+    __device__ __inline__ void executeForEachInBin_block(Enums::CellFunction cellFunctionType, Func const& func) const
+    {
+        auto const partition = calcPartition(_binCounts[cellFunctionType], threadIdx.x, blockDim.x);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            func(_sortedTokenIndices[_binStarts[cellFunctionType] + index]);
+        }
+    }
+
+private:
+    __host__ __inline__ void freeBuffers()
+    {
+        CudaMemoryManager::getInstance().freeMemory(_tokenOffsets);
+        CudaMemoryManager::getInstance().freeMemory(_sortedTokenIndices);
+    }
+
+    int* _binCounts = nullptr;
+    int* _binStarts = nullptr;
+    int* _tokenOffsets = nullptr;
+    int* _sortedTokenIndices = nullptr;
+};
@@ -22,8 +22,20 @@ public:
     __inline__ __device__ void movement(SimulationData& data);  //prerequisite: cell tags = 0
 
     __inline__ __device__ void applyMutation(SimulationData& data);
-    __inline__ __device__ void executeReadonlyCellFunctions(SimulationData& data, SimulationResult& result);  //energy values are allowed to change
-    __inline__ __device__ void executeModifyingCellFunctions(SimulationData& data, SimulationResult& result);
+
+    //tokens are binned by cell function after movement, the bins are complete after prepareFunctionBinRanges and sortFunctionBins
+    __inline__ __device__ void countFunctionBins(SimulationData& data);
+    __inline__ __device__ void prepareFunctionBinRanges(SimulationData& data);  //single block
+    __inline__ __device__ void sortFunctionBins(SimulationData& data);
+
+    //process the bin of the given cell function
+    __inline__ __device__ void executeReadonlyCellFunctions(SimulationData& data, SimulationResult& result, Enums::CellFunction cellFunctionType);  //energy values are allowed to change
+    __inline__ __device__ void executeModifyingCellFunctions(SimulationData& data, SimulationResult& result, Enums::CellFunction cellFunctionType);
+
+    //process the bins of several cell functions one after another in the same kernel
+    __inline__ __device__ void executeReadonlyCellFunctions(SimulationData& data, SimulationResult& result);
+    __inline__ __device__ void
+    executeModifyingCellFunctions(SimulationData& data, SimulationResult& result, int firstCellFunction, int endCellFunction);
     __inline__ __device__ void deleteTokenIfCellDeleted(SimulationData& data);
 };
 
@@ -128,69 +140,95 @@ __inline__ __device__ void TokenProcessor::applyMutation(SimulationData& data)
         auto& token = tokens.at(index);
         auto const& cell = token->cell;
         auto mutationRate = SpotCalculator::calcParameter(&SimulationParametersSpotValues::tokenMutationRate, data, cell->absPos);
-        if (data.numberGen1.random() < mutationRate) {
-            token->memory[data.numberGen1.random(MAX_TOKEN_MEM_SIZE - 1)] = data.numberGen1.random(255);
+
+        //several tokens can be on the same cell => key the draws by the token id instead of the cell id
+        if (data.numberGen1.random(token->id, RandomCallSite::TokenMutation) < mutationRate) {
+            auto address = data.numberGen1.random(data.tokenMemoryStride - 1, token->id, RandomCallSite::TokenMutationAddress);
+            token->memory[address] = data.numberGen1.random(255, token->id, RandomCallSite::TokenMutationValue);
         }
     }
 }
 
-__inline__ __device__ void TokenProcessor::executeReadonlyCellFunctions(SimulationData& data, SimulationResult& result)
+__inline__ __device__ void TokenProcessor::countFunctionBins(SimulationData& data)
 {
     auto& tokens = data.entities.tokenPointers;
-    auto partition =
-        calcPartition(tokens.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    data.tokenFunctionBins.count_system(tokens.getNumOrigEntries(), tokens.getArray());
+}
 
-    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+__inline__ __device__ void TokenProcessor::prepareFunctionBinRanges(SimulationData& data)
+{
+    data.tokenFunctionBins.prepareRanges_block();
+}
+
+__inline__ __device__ void TokenProcessor::sortFunctionBins(SimulationData& data)
+{
+    auto& tokens = data.entities.tokenPointers;
+    data.tokenFunctionBins.sort_system(tokens.getNumOrigEntries(), tokens.getArray());
+}
+
+__inline__ __device__ void
+TokenProcessor::executeReadonlyCellFunctions(SimulationData& data, SimulationResult& result, Enums::CellFunction cellFunctionType)
+{
+    auto& tokens = data.entities.tokenPointers;
+    data.tokenFunctionBins.executeForEachInBin_system(cellFunctionType, [&](int index) {
         auto& token = tokens.at(index);
-        auto& cell = token->cell;
-        if (token) {
-            auto cellFunctionType = cell->getCellFunctionType();
-            if (Enums::CellFunction_Scanner == cellFunctionType) {
-                ScannerProcessor::process(token, data);
-            }
-            if (Enums::CellFunction_Sensor == cellFunctionType) {
-                SensorProcessor::scheduleOperation(token, data);
-            }
-            if (Enums::CellFunction_Digestion == cellFunctionType) {  //modifies energy
-                DigestionProcessor::process(token, data, result);
-            }
+        if (Enums::CellFunction_Scanner == cellFunctionType) {
+            ScannerProcessor::process(token, data);
         }
-    }
+        if (Enums::CellFunction_Sensor == cellFunctionType) {
+            SensorProcessor::scheduleOperation(token, data);
+        }
+        if (Enums::CellFunction_Digestion == cellFunctionType) {  //modifies energy
+            DigestionProcessor::process(token, data, result);
+        }
+    });
 }
 
 __inline__ __device__ void
-TokenProcessor::executeModifyingCellFunctions(SimulationData& data, SimulationResult& result)
+TokenProcessor::executeModifyingCellFunctions(SimulationData& data, SimulationResult& result, Enums::CellFunction cellFunctionType)
 {
     auto& tokens = data.entities.tokenPointers;
-    auto const partition = calcAllThreadsPartition(tokens.getNumOrigEntries());
-
-    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+    data.tokenFunctionBins.executeForEachInBin_system(cellFunctionType, [&](int index) {
         auto& token = tokens.at(index);
         auto& cell = token->cell;
-        if (token) {
-            auto cellFunctionType = cell->getCellFunctionType();
 
-            //cell functions need a lock since they should be executed consecutively on a cell
-            //make a certain number of attempts
-            for (int i = 0; i < 100; ++i) {
-                if (cell->tryLock()) {
+        //cell functions need a lock since they should be executed consecutively on a cell
+        //make a certain number of attempts
+        for (int i = 0; i < 100; ++i) {
+            if (cell->tryLock()) {
 
-                    EnergyGuidance::processing(data, token);
-                    if (Enums::CellFunction_Computation == cellFunctionType) {
-                        CellComputationProcessor::process(token);
-                    }
-                    if (Enums::CellFunction_Constructor == cellFunctionType) {
-                        ConstructionProcessor::process(token, data, result);
-                    }
-                    if (Enums::CellFunction_Muscle == cellFunctionType) {
-                        MuscleProcessor::process(token, data, result);
-                    }
-
-                    cell->releaseLock();
-                    break;
+                EnergyGuidance::processing(data, token);
+                if (Enums::CellFunction_Computation == cellFunctionType) {
+                    CellComputationProcessor::process(token);
+                }
+                if (Enums::CellFunction_Constructor == cellFunctionType) {
+                    ConstructionProcessor::scheduleConstruction(token, index, data);
                 }
+                if (Enums::CellFunction_Muscle == cellFunctionType) {
+                    MuscleProcessor::process(token, data, result);
+                }
+
+                cell->releaseLock();
+                break;
             }
         }
+    });
+}
+
+__inline__ __device__ void TokenProcessor::executeReadonlyCellFunctions(SimulationData& data, SimulationResult& result)
+{
+    for (int i = 0; i < Enums::CellFunction_Count; ++i) {
+        if (TokenFunctionBins::isReadonlyCellFunction(i)) {
+            executeReadonlyCellFunctions(data, result, i);
+        }
+    }
+}
+
+__inline__ __device__ void
+TokenProcessor::executeModifyingCellFunctions(SimulationData& data, SimulationResult& result, int firstCellFunction, int endCellFunction)
+{
+    for (int i = firstCellFunction; i < endCellFunction; ++i) {
+        executeModifyingCellFunctions(data, result, i);
     }
 }
 
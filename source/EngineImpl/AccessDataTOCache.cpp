@@ -33,6 +33,7 @@ DataAccessTO _AccessDataTOCache::getDataTO(ArraySizes const& arraySizes)
             *result.numParticles = 0;
             *result.numTokens = 0;
             *result.numStringBytes = 0;
+            *result.numTokenMemoryBytes = 0;
     };
 
     DataAccessTO result;
@@ -69,10 +70,12 @@ DataAccessTO _AccessDataTOCache::getNewDataTO()
         result.numParticles = new int;
         result.numTokens = new int;
         result.numStringBytes = new int;
+        result.numTokenMemoryBytes = new int;
         result.cells = new CellAccessTO[_arraySizes->cellArraySize];
         result.particles = new ParticleAccessTO[_arraySizes->particleArraySize];
         result.tokens = new TokenAccessTO[_arraySizes->tokenArraySize];
         result.stringBytes = new char[MAX_STRING_BYTES];
+        result.tokenMemory = new char[_arraySizes->tokenArraySize * _arraySizes->tokenMemorySize];
         return result;
     } catch (std::bad_alloc const&) {
         throw BugReportException("There is not sufficient CPU memory available.");
@@ -85,8 +88,10 @@ void _AccessDataTOCache::deleteDataTO(DataAccessTO const& dataTO)
     delete dataTO.numParticles;
     delete dataTO.numTokens;
     delete dataTO.numStringBytes;
+    delete dataTO.numTokenMemoryBytes;
     delete[] dataTO.cells;
     delete[] dataTO.particles;
     delete[] dataTO.tokens;
     delete[] dataTO.stringBytes;
+    delete[] dataTO.tokenMemory;
 }
@@ -18,11 +18,12 @@ public:
         int cellArraySize;
         int particleArraySize;
         int tokenArraySize;
+        int tokenMemorySize;    //bytes per token in DataAccessTO::tokenMemory
 
         bool operator==(ArraySizes const& other) const
         {
             return cellArraySize == other.cellArraySize && particleArraySize == other.particleArraySize
-                && tokenArraySize == other.tokenArraySize;
+                && tokenArraySize == other.tokenArraySize && tokenMemorySize == other.tokenMemorySize;
         }
 
         bool operator!=(ArraySizes const& other) const { return !operator==(other); };
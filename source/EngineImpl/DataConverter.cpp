@@ -5,6 +5,7 @@
 
 #include "Base/NumberGenerator.h"
 #include "Base/Exceptions.h"
+#include "Base/ParallelAlgorithms.h"
 #include "EngineInterface/Descriptions.h"
 
 
@@ -44,10 +45,7 @@ ClusteredDataDescription DataConverter::convertAccessTOtoClusteredDataDescriptio
     for (int i = 0; i < *dataTO.numTokens; ++i) {
         TokenAccessTO const& token = dataTO.tokens[i];
 
-        std::string data(_parameters.tokenMemorySize, 0);
-        for (int i = 0; i < _parameters.tokenMemorySize; ++i) {
-            data[i] = token.memory[i];
-        }
+        std::string data(&dataTO.tokenMemory[token.memoryIndex], _parameters.tokenMemorySize);
         auto clusterDescIndex = cellTOIndexToClusterDescIndex.at(token.cellIndex);
         auto cellDescIndex = cellTOIndexToCellDescIndex.at(token.cellIndex);
         CellDescription& cell = result.clusters.at(clusterDescIndex).cells.at(cellDescIndex);
@@ -88,45 +86,48 @@ DataDescription DataConverter::convertAccessTOtoDataDescription(DataAccessTO con
     DataDescription result;
 
     //cells
-    std::vector<CellDescription> cells;
-    for (int i = 0; i < *dataTO.numCells; ++i) {
-        cells.emplace_back(createCellDescription(dataTO, i));
-    }
-    result.addCells(cells);
+    result.cells.resize(*dataTO.numCells);
+    ParallelAlgorithms::parallelFor(
+        0, *dataTO.numCells, [&](int index) { result.cells[index] = createCellDescription(dataTO, index); }, ConversionGrainSize);
 
     //tokens
     for (int i = 0; i < *dataTO.numTokens; ++i) {
         TokenAccessTO const& token = dataTO.tokens[i];
 
-        std::string data(_parameters.tokenMemorySize, 0);
-        for (int i = 0; i < _parameters.tokenMemorySize; ++i) {
-            data[i] = token.memory[i];
-        }
+        std::string data(&dataTO.tokenMemory[token.memoryIndex], _parameters.tokenMemorySize);
         auto cellDescIndex = token.cellIndex;
         CellDescription& cell = result.cells.at(cellDescIndex);
         cell.addToken(TokenDescription().setEnergy(token.energy).setData(data).setSequenceNumber(token.sequenceNumber));
     }
     //sort tokens by sequence number
     if (sortTokens == SortTokens::Yes) {
-        for (auto& cell: result.cells) {
-            std::sort(cell.tokens.begin(), cell.tokens.end(), [](TokenDescription const& left, TokenDescription const& right) {
-                return left.sequenceNumber < right.sequenceNumber;
-            });
-        }
+        ParallelAlgorithms::parallelFor(
+            0,
+            toInt(result.cells.size()),
+            [&](int index) {
+                auto& cell = result.cells[index];
+                std::sort(cell.tokens.begin(), cell.tokens.end(), [](TokenDescription const& left, TokenDescription const& right) {
+                    return left.sequenceNumber < right.sequenceNumber;
+                });
+            },
+            ConversionGrainSize);
     }
 
     //particles
-    std::vector<ParticleDescription> particles;
-    for (int i = 0; i < *dataTO.numParticles; ++i) {
-        ParticleAccessTO const& particle = dataTO.particles[i];
-        particles.emplace_back(ParticleDescription()
-                                   .setId(particle.id)
-                                   .setPos({particle.pos.x, particle.pos.y})
-                                   .setVel({particle.vel.x, particle.vel.y})
-                                   .setEnergy(particle.energy)
-                                   .setMetadata(ParticleMetadata().setColor(particle.metadata.color)));
-    }
-    result.addParticles(particles);
+    result.particles.resize(*dataTO.numParticles);
+    ParallelAlgorithms::parallelFor(
+        0,
+        *dataTO.numParticles,
+        [&](int index) {
+            ParticleAccessTO const& particle = dataTO.particles[index];
+            result.particles[index] = ParticleDescription()
+                                          .setId(particle.id)
+                                          .setPos({particle.pos.x, particle.pos.y})
+                                          .setVel({particle.vel.x, particle.vel.y})
+                                          .setEnergy(particle.energy)
+                                          .setMetadata(ParticleMetadata().setColor(particle.metadata.color));
+        },
+        ConversionGrainSize);
 
     return result;
 }
@@ -407,7 +408,9 @@ void DataConverter::addCell(
         TokenAccessTO& tokenTO = dataTO.tokens[tokenIndex];
         tokenTO.energy = toFloat(tokenDesc.energy);
         tokenTO.cellIndex = cellIndex;
-        convertToArray(tokenDesc.data, tokenTO.memory, _parameters.tokenMemorySize);
+        tokenTO.memoryIndex = *dataTO.numTokenMemoryBytes;
+        convertToArray(tokenDesc.data, &dataTO.tokenMemory[tokenTO.memoryIndex], _parameters.tokenMemorySize);
+        (*dataTO.numTokenMemoryBytes) += _parameters.tokenMemorySize;
     }
 	cellIndexTOByIds.insert_or_assign(cellTO.id, cellIndex);
 }
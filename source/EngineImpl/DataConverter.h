@@ -47,6 +47,8 @@ private:
     int convertStringAndReturnStringIndex(DataAccessTO const& dataTO, std::string const& s) const;
 
 private:
+    static auto constexpr ConversionGrainSize = 1024;
+
 	SimulationParameters _parameters;
     GpuSettings _gpuConstants;
 };
@@ -7,6 +7,7 @@
 #include "EngineGpuKernels/CudaSimulationFacade.cuh"
 #include "AccessDataTOCache.h"
 #include "DataConverter.h"
+#include "SimulationDataSnapshotImpl.h"
 
 namespace
 {
@@ -88,9 +89,7 @@ std::optional<OverlayDescription> EngineWorker::tryDrawVectorGraphicsAndReturnOv
             {imageSize.x, imageSize.y},
             zoom);
 
-        auto arraySizes = _cudaSimulation->getArraySizes();
-        DataAccessTO dataTO = _dataTOCache->getDataTO(
-            {arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
+        DataAccessTO dataTO = provideTO();
 
         _cudaSimulation->getOverlayData(
             {toInt(rectUpperLeft.x), toInt(rectUpperLeft.y)},
@@ -110,9 +109,7 @@ ClusteredDataDescription EngineWorker::getClusteredSimulationData(IntVector2D co
 {
     EngineWorkerGuard access(this);
 
-    auto arraySizes = _cudaSimulation->getArraySizes();
-    DataAccessTO dataTO =
-        _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
+    DataAccessTO dataTO = provideTO();
     _cudaSimulation->getSimulationData(
         {rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
 
@@ -124,12 +121,24 @@ ClusteredDataDescription EngineWorker::getClusteredSimulationData(IntVector2D co
     return result;
 }
 
+SimulationDataSnapshot EngineWorker::getSimulationDataSnapshot(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
+{
+    EngineWorkerGuard access(this);
+
+    DataAccessTO dataTO = provideTO();
+    _cudaSimulation->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
+
+    auto result = std::make_shared<_SimulationDataSnapshotImpl>(dataTO, _settings.simulationParameters);
+    _dataTOCache->releaseDataTO(dataTO);
+
+    return result;
+}
+
 DataDescription EngineWorker::getSimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
 {
     EngineWorkerGuard access(this);
 
-    auto arraySizes = _cudaSimulation->getArraySizes();
-    DataAccessTO dataTO = _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
+    DataAccessTO dataTO = provideTO();
     _cudaSimulation->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
 
     DataConverter converter(_settings.simulationParameters);
@@ -144,8 +153,7 @@ ClusteredDataDescription EngineWorker::getSelectedClusteredSimulationData(bool i
 {
     EngineWorkerGuard access(this);
 
-    auto arraySizes = _cudaSimulation->getArraySizes();
-    DataAccessTO dataTO = _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
+    DataAccessTO dataTO = provideTO();
     _cudaSimulation->getSelectedSimulationData(includeClusters, dataTO);
 
     DataConverter converter(_settings.simulationParameters);
@@ -160,9 +168,7 @@ DataDescription EngineWorker::getSelectedSimulationData(bool includeClusters)
 {
     EngineWorkerGuard access(this);
 
-    auto arraySizes = _cudaSimulation->getArraySizes();
-    DataAccessTO dataTO =
-        _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
+    DataAccessTO dataTO = provideTO();
     _cudaSimulation->getSelectedSimulationData(includeClusters, dataTO);
 
     DataConverter converter(_settings.simulationParameters);
@@ -177,9 +183,7 @@ DataDescription EngineWorker::getInspectedSimulationData(std::vector<uint64_t> e
 {
     EngineWorkerGuard access(this);
 
-    auto arraySizes = _cudaSimulation->getArraySizes();
-    DataAccessTO dataTO =
-        _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
+    DataAccessTO dataTO = provideTO();
     _cudaSimulation->getInspectedSimulationData(entityIds, dataTO);
 
     DataConverter converter(_settings.simulationParameters);
@@ -552,7 +556,8 @@ bool EngineWorker::isSimulationRunning() const
 DataAccessTO EngineWorker::provideTO()
 {
     auto arraySizes = _cudaSimulation->getArraySizes();
-    return _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
+    return _dataTOCache->getDataTO(
+        {arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize, _settings.simulationParameters.tokenMemorySize});
 }
 
 void EngineWorker::resetProcessMonitorData()
@@ -577,6 +582,7 @@ void EngineWorker::processJobs()
     std::unique_lock<std::mutex> asyncJobsLock(_mutexForAsyncJobs);
     if (_updateSimulationParametersJob) {
         _cudaSimulation->setSimulationParameters(*_updateSimulationParametersJob);
+        _settings.simulationParameters = *_updateSimulationParametersJob;
         _updateSimulationParametersJob = std::nullopt;
     }
     if (_updateSimulationParametersSpotsJob) {
@@ -0,0 +1,82 @@
+#include "HostReplayHarness.h"
+
+#include <cstring>
+
+namespace
+{
+    uint64_t mix(uint64_t value)
+    {
+        value ^= value >> 30;
+        value *= 0xbf58476d1ce4e5b9ull;
+        value ^= value >> 27;
+        value *= 0x94d049bb133111ebull;
+        value ^= value >> 31;
+        return value;
+    }
+
+    uint64_t getBits(float2 const& value)
+    {
+        uint32_t x, y;
+        std::memcpy(&x, &value.x, sizeof(x));
+        std::memcpy(&y, &value.y, sizeof(y));
+        return (static_cast<uint64_t>(x) << 32) | y;
+    }
+}
+
+HostReplayHarness::HostReplayHarness(int2 const& worldSize, SimulationParameters const& parameters, int hashInterval)
+    : _processor(worldSize, parameters)
+    , _hashInterval(std::max(1, hashInterval))
+{}
+
+std::vector<uint64_t> HostReplayHarness::record(HostCellArrays& cells, int numTimesteps)
+{
+    std::vector<uint64_t> result;
+    result.emplace_back(calcHash(cells));
+    for (int timestep = 1; timestep <= numTimesteps; ++timestep) {
+        calcTimestep(cells);
+        if (timestep % _hashInterval == 0) {
+            result.emplace_back(calcHash(cells));
+        }
+    }
+    return result;
+}
+
+std::optional<int> HostReplayHarness::verify(HostCellArrays& cells, std::vector<uint64_t> const& hashes)
+{
+    if (hashes.empty()) {
+        return std::nullopt;
+    }
+    if (calcHash(cells) != hashes.front()) {
+        return 0;
+    }
+    auto numTimesteps = static_cast<int>(hashes.size() - 1) * _hashInterval;
+    for (int timestep = 1; timestep <= numTimesteps; ++timestep) {
+        calcTimestep(cells);
+        if (timestep % _hashInterval == 0 && calcHash(cells) != hashes.at(timestep / _hashInterval)) {
+            return timestep;
+        }
+    }
+    return std::nullopt;
+}
+
+uint64_t HostReplayHarness::calcHash(HostCellArrays& cells)
+{
+    //sum of independent per-cell hashes => invariant under reordering of the cells
+    uint64_t result = 0;
+    for (int index = 0; index < cells.getNumCells(); ++index) {
+        auto cell = cells.getHandle(index);
+        auto cellHash = mix(cell.id());
+        cellHash = mix(cellHash ^ getBits(cell.absPos()));
+        cellHash = mix(cellHash ^ getBits(cell.vel()));
+        cellHash = mix(cellHash ^ static_cast<uint32_t>(cell.numConnections()));
+        result += cellHash;
+    }
+    return result;
+}
+
+void HostReplayHarness::calcTimestep(HostCellArrays& cells)
+{
+    _processor.verletUpdatePositions(cells);
+    _processor.collisions(cells);
+    _processor.verletUpdateVelocities(cells);
+}
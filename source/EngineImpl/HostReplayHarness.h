@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Base/Definitions.h"
+#include "EngineInterface/SimulationParameters.h"
+#include "EngineGpuKernels/CellArrays.cuh"
+#include "EngineGpuKernels/HostCellProcessor.cuh"
+
+//host-executable counterpart of ReplayHarness for the physics path of HostCellProcessor: records hashes of the cell state
+//in fixed intervals and replays the run to find the first time step where it diverges, the hash does not depend on the
+//order of the cells
+class HostReplayHarness
+{
+public:
+    HostReplayHarness(int2 const& worldSize, SimulationParameters const& parameters, int hashInterval = 1);
+
+    std::vector<uint64_t> record(HostCellArrays& cells, int numTimesteps);
+
+    //returns the time step of the first mismatching hash or nothing if the replay is identical
+    std::optional<int> verify(HostCellArrays& cells, std::vector<uint64_t> const& hashes);
+
+    static uint64_t calcHash(HostCellArrays& cells);
+
+private:
+    void calcTimestep(HostCellArrays& cells);
+
+    HostCellProcessor<HostCellArrays> _processor;
+    int _hashInterval;
+};
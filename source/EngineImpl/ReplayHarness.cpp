@@ -0,0 +1,128 @@
+#include "ReplayHarness.h"
+
+#include <cstring>
+
+#include "EngineInterface/SimulationController.h"
+
+namespace
+{
+    uint64_t mix(uint64_t value)
+    {
+        value ^= value >> 30;
+        value *= 0xbf58476d1ce4e5b9ull;
+        value ^= value >> 27;
+        value *= 0x94d049bb133111ebull;
+        value ^= value >> 31;
+        return value;
+    }
+
+    uint64_t getBits(RealVector2D const& value)
+    {
+        uint32_t x, y;
+        std::memcpy(&x, &value.x, sizeof(x));
+        std::memcpy(&y, &value.y, sizeof(y));
+        return (static_cast<uint64_t>(x) << 32) | y;
+    }
+
+    uint64_t getBits(double value)
+    {
+        uint64_t result;
+        std::memcpy(&result, &value, sizeof(result));
+        return result;
+    }
+
+    uint64_t calcTokenHash(TokenDescription const& token)
+    {
+        auto result = mix(getBits(token.energy));
+        for (auto const& byte : token.data) {
+            result = mix(result ^ static_cast<unsigned char>(byte));
+        }
+        return result;
+    }
+}
+
+ReplayHarness::ReplayHarness(SimulationController const& simController, int hashInterval)
+    : _simController(simController)
+    , _hashInterval(std::max(1, hashInterval))
+{}
+
+std::vector<uint64_t> ReplayHarness::record(DeserializedSimulation const& simulation, int numTimesteps)
+{
+    load(simulation);
+
+    std::vector<uint64_t> result;
+    result.emplace_back(calcHash());
+    for (int timestep = 1; timestep <= numTimesteps; ++timestep) {
+        _simController->calcSingleTimestep();
+        if (timestep % _hashInterval == 0) {
+            result.emplace_back(calcHash());
+        }
+    }
+    return result;
+}
+
+std::optional<int> ReplayHarness::verify(DeserializedSimulation const& simulation, std::vector<uint64_t> const& hashes)
+{
+    if (hashes.empty()) {
+        return std::nullopt;
+    }
+    load(simulation);
+    if (calcHash() != hashes.front()) {
+        return 0;
+    }
+    auto numTimesteps = static_cast<int>(hashes.size() - 1) * _hashInterval;
+    for (int timestep = 1; timestep <= numTimesteps; ++timestep) {
+        _simController->calcSingleTimestep();
+        if (timestep % _hashInterval == 0 && calcHash() != hashes.at(timestep / _hashInterval)) {
+            return timestep;
+        }
+    }
+    return std::nullopt;
+}
+
+uint64_t ReplayHarness::calcHash(DataDescription const& data)
+{
+    //sums of independent per-entity hashes => invariant under reordering of the entities, their tokens and connections
+    uint64_t result = 0;
+    for (auto const& cell : data.cells) {
+        auto cellHash = mix(cell.id);
+        cellHash = mix(cellHash ^ getBits(cell.pos));
+        cellHash = mix(cellHash ^ getBits(cell.vel));
+        cellHash = mix(cellHash ^ getBits(cell.energy));
+        uint64_t connectionsHash = 0;
+        for (auto const& connection : cell.connections) {
+            connectionsHash += mix(connection.cellId);
+        }
+        cellHash = mix(cellHash ^ connectionsHash);
+        uint64_t tokensHash = 0;
+        for (auto const& token : cell.tokens) {
+            tokensHash += calcTokenHash(token);
+        }
+        cellHash = mix(cellHash ^ tokensHash);
+        result += cellHash;
+    }
+    for (auto const& particle : data.particles) {
+        auto particleHash = mix(~particle.id);
+        particleHash = mix(particleHash ^ getBits(particle.pos));
+        particleHash = mix(particleHash ^ getBits(particle.vel));
+        particleHash = mix(particleHash ^ getBits(particle.energy));
+        result += particleHash;
+    }
+    return result;
+}
+
+//replaces the open simulation of the controller as in OpenSimulationDialog, the random draws are seeded in any case
+void ReplayHarness::load(DeserializedSimulation const& simulation)
+{
+    auto settings = simulation.settings;
+    settings.generalSettings.useSeed = true;
+
+    _simController->closeSimulation();
+    _simController->newSimulation(simulation.timestep, settings, simulation.symbolMap);
+    _simController->setClusteredSimulationData(simulation.content);
+}
+
+uint64_t ReplayHarness::calcHash() const
+{
+    return calcHash(_simController->getSimulationData());
+}
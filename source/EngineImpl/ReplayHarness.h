@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Base/Definitions.h"
+#include "EngineInterface/Definitions.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/Serializer.h"
+
+//records hashes of the simulation data of engine time steps in fixed intervals, starting from a loaded simulation, and
+//replays the run to find the first time step where it diverges; the hash does not depend on the order of the entities
+//the random draws of both runs are derived from the seed of the simulation settings, hence a divergence is caused by
+//the remaining order dependencies of the engine (cell functions with locks, compaction of the entity arrays)
+class ReplayHarness
+{
+public:
+    //simController needs an open simulation, it is replaced by the given simulation in record and verify
+    ReplayHarness(SimulationController const& simController, int hashInterval = 1);
+
+    std::vector<uint64_t> record(DeserializedSimulation const& simulation, int numTimesteps);
+
+    //returns the time step of the first mismatching hash (relative to the time step of the simulation) or nothing if the
+    //replay is identical
+    std::optional<int> verify(DeserializedSimulation const& simulation, std::vector<uint64_t> const& hashes);
+
+    static uint64_t calcHash(DataDescription const& data);
+
+private:
+    void load(DeserializedSimulation const& simulation);
+    uint64_t calcHash() const;
+
+    SimulationController _simController;
+    int _hashInterval;
+};
@@ -1,5 +1,6 @@
 #include "SimulationControllerImpl.h"
 
+#include "Base/NumberGenerator.h"
 #include "EngineInterface/Descriptions.h"
 
 void _SimulationControllerImpl::initCuda()
@@ -13,6 +14,9 @@ void _SimulationControllerImpl::newSimulation(uint64_t timestep, Settings const&
     _origSettings = settings;
     _symbolMap = symbolMap;
     _origSymbolMap = symbolMap;
+    if (settings.generalSettings.useSeed) {
+        NumberGenerator::getInstance().setSeed(settings.generalSettings.seed);
+    }
     _worker.newSimulation(timestep, settings);
 
     _thread = new std::thread(&EngineWorker::runThreadLoop, &_worker);
@@ -56,6 +60,12 @@ ClusteredDataDescription _SimulationControllerImpl::getClusteredSimulationData()
     return _worker.getClusteredSimulationData({-10, -10}, {size.x + 10, size.y + 10});
 }
 
+SimulationDataSnapshot _SimulationControllerImpl::getSimulationDataSnapshot()
+{
+    auto size = getWorldSize();
+    return _worker.getSimulationDataSnapshot({-10, -10}, {size.x + 10, size.y + 10});
+}
+
 DataDescription _SimulationControllerImpl::getSimulationData()
 {
     auto size = getWorldSize();
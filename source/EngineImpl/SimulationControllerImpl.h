@@ -41,6 +41,7 @@ public:
         double zoom) override;
 
     ClusteredDataDescription getClusteredSimulationData() override;
+    SimulationDataSnapshot getSimulationDataSnapshot() override;
     DataDescription getSimulationData() override;
     ClusteredDataDescription getSelectedClusteredSimulationData(bool includeClusters) override;
     DataDescription getSelectedSimulationData(bool includeClusters) override;
@@ -0,0 +1,43 @@
+#include "SimulationDataSnapshotImpl.h"
+
+#include "DataConverter.h"
+
+_SimulationDataSnapshotImpl::_SimulationDataSnapshotImpl(DataAccessTO const& dataTO, SimulationParameters const& parameters)
+    : _parameters(parameters)
+    , _cells(dataTO.cells, dataTO.cells + *dataTO.numCells)
+    , _particles(dataTO.particles, dataTO.particles + *dataTO.numParticles)
+    , _tokens(dataTO.tokens, dataTO.tokens + *dataTO.numTokens)
+    , _stringBytes(dataTO.stringBytes, dataTO.stringBytes + *dataTO.numStringBytes)
+    , _tokenMemory(dataTO.tokenMemory, dataTO.tokenMemory + *dataTO.numTokenMemoryBytes)
+{}
+
+uint64_t _SimulationDataSnapshotImpl::getSizeInBytes() const
+{
+    return _cells.size() * sizeof(CellAccessTO) + _particles.size() * sizeof(ParticleAccessTO) + _tokens.size() * sizeof(TokenAccessTO)
+        + _stringBytes.size() + _tokenMemory.size();
+}
+
+ClusteredDataDescription _SimulationDataSnapshotImpl::getClusteredData() const
+{
+    //read-only view on the owned arrays
+    auto numCells = static_cast<int>(_cells.size());
+    auto numParticles = static_cast<int>(_particles.size());
+    auto numTokens = static_cast<int>(_tokens.size());
+    auto numStringBytes = static_cast<int>(_stringBytes.size());
+    auto numTokenMemoryBytes = static_cast<int>(_tokenMemory.size());
+
+    DataAccessTO dataTO;
+    dataTO.numCells = &numCells;
+    dataTO.cells = const_cast<CellAccessTO*>(_cells.data());
+    dataTO.numParticles = &numParticles;
+    dataTO.particles = const_cast<ParticleAccessTO*>(_particles.data());
+    dataTO.numTokens = &numTokens;
+    dataTO.tokens = const_cast<TokenAccessTO*>(_tokens.data());
+    dataTO.numStringBytes = &numStringBytes;
+    dataTO.stringBytes = const_cast<char*>(_stringBytes.data());
+    dataTO.numTokenMemoryBytes = &numTokenMemoryBytes;
+    dataTO.tokenMemory = const_cast<char*>(_tokenMemory.data());
+
+    DataConverter converter(_parameters);
+    return converter.convertAccessTOtoClusteredDataDescription(dataTO);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <vector>
+
+#include "EngineInterface/SimulationDataSnapshot.h"
+#include "EngineInterface/SimulationParameters.h"
+#include "EngineGpuKernels/AccessTOs.cuh"
+
+#include "Definitions.h"
+
+//owns a compact copy of the occupied parts of a DataAccessTO so that the cached transfer object can be released at once
+class _SimulationDataSnapshotImpl : public _SimulationDataSnapshot
+{
+public:
+    _SimulationDataSnapshotImpl(DataAccessTO const& dataTO, SimulationParameters const& parameters);
+
+    uint64_t getSizeInBytes() const override;
+    ClusteredDataDescription getClusteredData() const override;
+
+private:
+    SimulationParameters _parameters;
+    std::vector<CellAccessTO> _cells;
+    std::vector<ParticleAccessTO> _particles;
+    std::vector<TokenAccessTO> _tokens;
+    std::vector<char> _stringBytes;
+    std::vector<char> _tokenMemory;
+};
@@ -1,9 +1,16 @@
 #include "CellComputationCompiler.h"
 
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <tuple>
+#include <unordered_map>
 #include <boost/algorithm/string/case_conv.hpp>
 
 #include "SymbolMap.h"
+#include "SymbolTable.h"
 #include "SimulationParameters.h"
 #include "Definitions.h"
 
@@ -168,7 +175,7 @@ namespace
         return true;
     }
 
-    std::string applyTableToCode(SymbolMap const& symbols, std::string s)
+    std::string applyTableToCode(SymbolTable const& symbols, std::string s)
     {
         std::string prefix;
         std::string postfix;
@@ -186,15 +193,14 @@ namespace
                 s = s.substr(0, s.size() - 1);
             }
         }
-        auto findResult = symbols.find(s);
-        if (findResult != symbols.end()) {
-            s = findResult->second;
+        if (auto value = symbols.findValue(s)) {
+            s = *value;
         }
         return prefix + s + postfix;
     }
 
     bool resolveInstructionAndReturnSuccess(
-        SymbolMap const& symbols,
+        SymbolTable const& symbols,
         CellInstruction& instructionCoded,
         InstructionUncoded instructionUncoded)
     {
@@ -319,10 +325,111 @@ namespace
         }
         return true;
     }
+
+    //compilation results are reused for identical inputs with equal symbol maps and relevant parameters
+    class CompilationCache
+    {
+    public:
+        static CompilationCache& getInstance()
+        {
+            static CompilationCache instance;
+            return instance;
+        }
+
+        using CompilationKey = std::pair<int, int>;  //symbol map version, max bytes
+        using DecompilationKey = std::tuple<int, int, int>;  //symbol map version, token memory size, cell memory size
+
+        //equal symbol maps obtain the same version
+        std::pair<int, std::shared_ptr<SymbolTable const>> getSymbolTable(SymbolMap const& symbols)
+        {
+            std::lock_guard lock(_mutex);
+            for (auto it = _symbolTables.begin(); it != _symbolTables.end(); ++it) {
+                if (it->symbols == symbols) {
+                    std::rotate(_symbolTables.begin(), it, it + 1);
+                    return {_symbolTables.front().version, _symbolTables.front().table};
+                }
+            }
+            _symbolTables.insert(_symbolTables.begin(), {symbols, _nextSymbolMapVersion++, std::make_shared<SymbolTable const>(symbols)});
+            if (_symbolTables.size() > MaxNumSymbolTables) {
+                _symbolTables.pop_back();
+            }
+            return {_symbolTables.front().version, _symbolTables.front().table};
+        }
+
+        //the input is processed outside of the lock
+        template <typename Key, typename Function>
+        auto getOrCreate(Key const& key, std::string const& input, Function const& function)
+        {
+            {
+                std::lock_guard lock(_mutex);
+                auto const& resultByInput = getResultByInput(key);
+                auto findResult = resultByInput.find(input);
+                if (findResult != resultByInput.end()) {
+                    return findResult->second;
+                }
+            }
+
+            auto result = function(input);
+
+            std::lock_guard lock(_mutex);
+            if (++_numEntries > MaxNumEntries) {
+                _compilationResults.clear();
+                _decompilationResults.clear();
+                _numEntries = 1;
+            }
+            getResultByInput(key).insert_or_assign(input, result);
+            return result;
+        }
+
+    private:
+        std::unordered_map<std::string, CompilationResult>& getResultByInput(CompilationKey const& key) { return _compilationResults[key]; }
+        std::unordered_map<std::string, std::string>& getResultByInput(DecompilationKey const& key) { return _decompilationResults[key]; }
+
+        static auto constexpr MaxNumSymbolTables = 4;
+        static auto constexpr MaxNumEntries = 100000;
+
+        struct SymbolTableEntry
+        {
+            SymbolMap symbols;
+            int version;
+            std::shared_ptr<SymbolTable const> table;
+        };
+
+        std::mutex _mutex;
+        std::vector<SymbolTableEntry> _symbolTables;  //most recently used first
+        int _nextSymbolMapVersion = 0;
+        size_t _numEntries = 0;
+        std::map<CompilationKey, std::unordered_map<std::string, CompilationResult>> _compilationResults;
+        std::map<DecompilationKey, std::unordered_map<std::string, std::string>> _decompilationResults;
+    };
 }
 
 
 CompilationResult CellComputationCompiler::compileSourceCode(std::string const& code, SymbolMap const& symbols, SimulationParameters const& parameters)
+{
+    auto& cache = CompilationCache::getInstance();
+    auto [symbolMapVersion, symbolTable] = cache.getSymbolTable(symbols);
+    auto key = CompilationCache::CompilationKey{symbolMapVersion, getMaxBytes(parameters)};
+    return cache.getOrCreate(key, code, [&, symbolTable = symbolTable](std::string const& code) {
+        return compileSourceCodeIntern(code, *symbolTable, parameters);
+    });
+}
+
+std::string CellComputationCompiler::decompileSourceCode(
+    std::string const& data,
+    SymbolMap const& symbols,
+    SimulationParameters const& parameters)
+{
+    auto& cache = CompilationCache::getInstance();
+    auto [symbolMapVersion, symbolTable] = cache.getSymbolTable(symbols);
+    auto key = CompilationCache::DecompilationKey{symbolMapVersion, parameters.tokenMemorySize, parameters.cellFunctionComputerCellMemorySize};
+    return cache.getOrCreate(key, data, [&, symbolTable = symbolTable](std::string const& data) {
+        return decompileSourceCodeIntern(data, *symbolTable, parameters);
+    });
+}
+
+CompilationResult
+CellComputationCompiler::compileSourceCodeIntern(std::string const& code, SymbolTable const& symbols, SimulationParameters const& parameters)
 {
     CompilerState state = CompilerState::LOOKING_FOR_INSTR_START;
 
@@ -378,15 +485,11 @@ namespace
     }
 }
 
-std::string CellComputationCompiler::decompileSourceCode(
+std::string CellComputationCompiler::decompileSourceCodeIntern(
     std::string const& data,
-    SymbolMap const& symbols,
+    SymbolTable const& symbols,
     SimulationParameters const& parameters)
 {
-    SymbolMap revsymbols;
-    for (auto const& symbol : symbols) {
-        revsymbols[symbol.second] = symbol.first;
-    }
     std::string text;
     std::string textOp1, textOp2, comment1, comment2;
     size_t lineStart, opEnd;
@@ -465,44 +568,44 @@ std::string CellComputationCompiler::decompileSourceCode(
         //write operands
         if (instruction.opType1 == Enums::ComputationOpType_Mem) {
             comment1 = "[" + toDecString(convertToAddress(instruction.operand1, parameters.tokenMemorySize)) + "]";
-            if (revsymbols.find(comment1) != revsymbols.end())
-                comment1 = revsymbols[comment1];
+            if (auto name = symbols.findName(comment1))
+                comment1 = *name;
             textOp1 = "[" + toHexString(convertToAddress(instruction.operand1, parameters.tokenMemorySize)) + "]";
         }
         if (instruction.opType1 == Enums::ComputationOpType_MemMem) {
             comment1 = "[[" + toDecString(convertToAddress(instruction.operand1, parameters.tokenMemorySize)) + "]]";
-            if (revsymbols.find(comment1) != revsymbols.end())
-                comment1 = revsymbols[comment1];
+            if (auto name = symbols.findName(comment1))
+                comment1 = *name;
             textOp1 = "[[" + toHexString(convertToAddress(instruction.operand1, parameters.tokenMemorySize)) + "]]";
         }
         if (instruction.opType1 == Enums::ComputationOpType_Cmem) {
             comment1 = "("
                       + toDecString(convertToAddress(instruction.operand1, parameters.cellFunctionComputerCellMemorySize))
                       + ")";
-            if (revsymbols.find(comment1) != revsymbols.end())
-                comment1 = revsymbols[comment1];
+            if (auto name = symbols.findName(comment1))
+                comment1 = *name;
             textOp1 = "("
                       + toHexString(convertToAddress(instruction.operand1, parameters.cellFunctionComputerCellMemorySize))
                       + ")";
         }
         if (instruction.opType2 == Enums::ComputationOpType_Mem) {
             comment2 = "[" + toDecString(convertToAddress(instruction.operand2, parameters.tokenMemorySize)) + "]";
-            if (revsymbols.find(comment2) != revsymbols.end())
-                comment2 = revsymbols[comment2];
+            if (auto name = symbols.findName(comment2))
+                comment2 = *name;
             textOp2 = "[" + toHexString(convertToAddress(instruction.operand2, parameters.tokenMemorySize)) + "]";
         }
         if (instruction.opType2 == Enums::ComputationOpType_MemMem) {
             comment2 = "[[" + toDecString(convertToAddress(instruction.operand2, parameters.tokenMemorySize)) + "]]";
-            if (revsymbols.find(comment2) != revsymbols.end())
-                comment2 = revsymbols[comment2];
+            if (auto name = symbols.findName(comment2))
+                comment2 = *name;
             textOp2 = "[[" + toHexString(convertToAddress(instruction.operand2, parameters.tokenMemorySize)) + "]]";
         }
         if (instruction.opType2 == Enums::ComputationOpType_Cmem) {
             comment2 = "("
                       + toDecString(convertToAddress(instruction.operand2, parameters.cellFunctionComputerCellMemorySize))
                       + ")";
-            if (revsymbols.find(comment2) != revsymbols.end())
-                comment2 = revsymbols[comment2];
+            if (auto name = symbols.findName(comment2))
+                comment2 = *name;
             textOp2 = "("
                       + toHexString(convertToAddress(instruction.operand2, parameters.cellFunctionComputerCellMemorySize))
                       + ")";
@@ -511,12 +614,8 @@ std::string CellComputationCompiler::decompileSourceCode(
             // try to be smart about constants
             auto number = toDecString(convertToAddress(instruction.operand2, parameters.tokenMemorySize));
             comment2 = number;
-            for (auto &it : symbols) {
-                auto pos = it.first.find(':');
-                if (it.first.substr(0,pos) == comment1.substr(0,pos) && it.second == number) {
-                    comment2 = it.first;
-                    break;
-                }
+            if (auto name = symbols.findConstantName(comment1, number)) {
+                comment2 = *name;
             }
             textOp2 = toHexString(convertToAddress(instruction.operand2, parameters.tokenMemorySize));
         }
@@ -4,6 +4,7 @@
 
 #include "Definitions.h"
 #include "SymbolMap.h"
+#include "SymbolTable.h"
 #include "SimulationParameters.h"
 
 
@@ -20,6 +21,7 @@ struct CompilationResult
 class CellComputationCompiler
 {
 public:
+    //results are cached by source code, symbol map and the relevant simulation parameters
     static CompilationResult compileSourceCode(std::string const& code, SymbolMap const& symbols, SimulationParameters const& parameters);
     static std::string
     decompileSourceCode(std::string const& data, SymbolMap const& symbols, SimulationParameters const& parameters);
@@ -28,6 +30,9 @@ public:
     static int getMaxBytes(SimulationParameters const& parameters);
 
 private:
+    static CompilationResult compileSourceCodeIntern(std::string const& code, SymbolTable const& symbols, SimulationParameters const& parameters);
+    static std::string decompileSourceCodeIntern(std::string const& data, SymbolTable const& symbols, SimulationParameters const& parameters);
+
     static void writeInstruction(std::string& data, CellInstruction const& instructionCoded);
     static void readInstruction(
         std::string const& data,
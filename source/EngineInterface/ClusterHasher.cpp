@@ -0,0 +1,254 @@
+#include "ClusterHasher.h"
+
+#include <algorithm>
+
+#include "Base/ParallelAlgorithms.h"
+
+namespace
+{
+    auto const MaxMatchingSteps = 1000000;
+
+    uint64_t mix(uint64_t value)
+    {
+        value ^= value >> 30;
+        value *= 0xbf58476d1ce4e5b9ull;
+        value ^= value >> 27;
+        value *= 0x94d049bb133111ebull;
+        value ^= value >> 31;
+        return value;
+    }
+
+    uint64_t combine(uint64_t hash, uint64_t value) { return mix(hash ^ (value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2))); }
+
+    int countDistinct(std::vector<uint64_t> values)
+    {
+        std::sort(values.begin(), values.end());
+        return toInt(std::unique(values.begin(), values.end()) - values.begin());
+    }
+}
+
+auto ClusterHasher::calcStructure(ClusterDescription const& cluster) -> Structure
+{
+    auto result = createGraph(cluster);
+    result.colors = calcColors(result, result.numIterations);
+    result.hash = calcHash(result, result.colors);
+    return result;
+}
+
+uint64_t ClusterHasher::calcHash(ClusterDescription const& cluster)
+{
+    auto graph = createGraph(cluster);
+    int numIterations;
+    auto colors = calcColors(graph, numIterations);
+    return calcHash(graph, colors);
+}
+
+auto ClusterHasher::calcStructures(std::vector<ClusterDescription> const& clusters) -> std::vector<Structure>
+{
+    std::vector<Structure> result(clusters.size());
+    ParallelAlgorithms::parallelFor(0, toInt(clusters.size()), [&](int index) { result[index] = calcStructure(clusters[index]); }, GrainSize);
+    return result;
+}
+
+std::vector<uint64_t> ClusterHasher::calcHashes(std::vector<ClusterDescription> const& clusters)
+{
+    std::vector<uint64_t> result(clusters.size());
+    ParallelAlgorithms::parallelFor(0, toInt(clusters.size()), [&](int index) { result[index] = calcHash(clusters[index]); }, GrainSize);
+    return result;
+}
+
+bool ClusterHasher::isEquivalent(ClusterDescription const& cluster, ClusterDescription const& otherCluster)
+{
+    return isEquivalent(calcStructure(cluster), calcStructure(otherCluster));
+}
+
+bool ClusterHasher::isEquivalent(Structure const& graph, Structure const& otherGraph)
+{
+    if (graph.hasToken != otherGraph.hasToken || graph.features.size() != otherGraph.features.size()
+        || graph.numIterations != otherGraph.numIterations || graph.hash != otherGraph.hash) {
+        return false;
+    }
+    auto const& colors = graph.colors;
+    auto const& otherColors = otherGraph.colors;
+    auto numCells = toInt(colors.size());
+    if (numCells == 0) {
+        return true;
+    }
+
+    //cells are matched in breadth-first order starting with a cell of the rarest color such that all candidates
+    //for a cell (except the first in each connected component) are restricted to the neighbors of an already matched cell
+    std::unordered_map<uint64_t, int> colorFrequencies;
+    for (auto const& color : colors) {
+        ++colorFrequencies[color];
+    }
+    std::vector<int> order;
+    std::vector<int> parents(numCells, -1);
+    std::vector<bool> visited(numCells, false);
+    while (toInt(order.size()) < numCells) {
+        int start = -1;
+        for (int i = 0; i < numCells; ++i) {
+            if (!visited[i] && (start == -1 || colorFrequencies.at(colors[i]) < colorFrequencies.at(colors[start]))) {
+                start = i;
+            }
+        }
+        visited[start] = true;
+        order.emplace_back(start);
+        for (auto queueIndex = order.size() - 1; queueIndex < order.size(); ++queueIndex) {
+            auto cell = order[queueIndex];
+            for (auto const& neighbor : graph.neighbors[cell]) {
+                if (!visited[neighbor]) {
+                    visited[neighbor] = true;
+                    parents[neighbor] = cell;
+                    order.emplace_back(neighbor);
+                }
+            }
+        }
+    }
+
+    std::vector<int> mapping(numCells, -1);
+    std::vector<int> inverseMapping(numCells, -1);
+    std::vector<int> candidateIndices(numCells, 0);
+
+    auto getCandidates = [&](int cell) -> std::vector<int> const* {
+        return parents[cell] != -1 ? &otherGraph.neighbors[mapping[parents[cell]]] : nullptr;
+    };
+    auto isConsistent = [&](int cell, int otherCell) {
+        if (inverseMapping[otherCell] != -1 || colors[cell] != otherColors[otherCell]
+            || graph.neighbors[cell].size() != otherGraph.neighbors[otherCell].size()) {
+            return false;
+        }
+        for (auto const& neighbor : graph.neighbors[cell]) {
+            auto mappedNeighbor = mapping[neighbor];
+            if (mappedNeighbor != -1
+                && !std::binary_search(otherGraph.neighbors[otherCell].begin(), otherGraph.neighbors[otherCell].end(), mappedNeighbor)) {
+                return false;
+            }
+        }
+        for (auto const& otherNeighbor : otherGraph.neighbors[otherCell]) {
+            auto mappedNeighbor = inverseMapping[otherNeighbor];
+            if (mappedNeighbor != -1 && !std::binary_search(graph.neighbors[cell].begin(), graph.neighbors[cell].end(), mappedNeighbor)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    int depth = 0;
+    int numSteps = 0;
+    while (depth >= 0) {
+        if (depth == numCells) {
+            return true;
+        }
+        if (++numSteps > MaxMatchingSteps) {
+            return false;   //not verified within the budget => treat as distinct
+        }
+        auto cell = order[depth];
+        if (mapping[cell] != -1) {
+            inverseMapping[mapping[cell]] = -1;
+            mapping[cell] = -1;
+        }
+        auto candidates = getCandidates(cell);
+        auto numCandidates = candidates ? toInt(candidates->size()) : numCells;
+        auto& candidateIndex = candidateIndices[depth];
+        for (; candidateIndex < numCandidates; ++candidateIndex) {
+            auto otherCell = candidates ? (*candidates)[candidateIndex] : candidateIndex;
+            if (isConsistent(cell, otherCell)) {
+                break;
+            }
+        }
+        if (candidateIndex < numCandidates) {
+            auto otherCell = candidates ? (*candidates)[candidateIndex] : candidateIndex;
+            mapping[cell] = otherCell;
+            inverseMapping[otherCell] = cell;
+            ++candidateIndex;
+            ++depth;
+            if (depth < numCells) {
+                candidateIndices[depth] = 0;
+            }
+        } else {
+            --depth;
+        }
+    }
+    return false;
+}
+
+auto ClusterHasher::createGraph(ClusterDescription const& cluster) -> Structure
+{
+    Structure result;
+    auto numCells = cluster.cells.size();
+    result.features.reserve(numCells);
+    result.neighbors.resize(numCells);
+
+    std::unordered_map<uint64_t, int> cellIndexById;
+    cellIndexById.reserve(numCells);
+    for (size_t index = 0; index < numCells; ++index) {
+        cellIndexById.emplace(cluster.cells[index].id, toInt(index));
+    }
+
+    for (size_t index = 0; index < numCells; ++index) {
+        auto const& cell = cluster.cells[index];
+        auto feature = mix(static_cast<uint64_t>(cell.maxConnections));
+        feature = combine(feature, cell.connections.size());
+        feature = combine(feature, cell.tokenBlocked ? 1 : 0);
+        feature = combine(feature, static_cast<uint64_t>(cell.tokenBranchNumber));
+        feature = combine(feature, static_cast<uint64_t>(cell.cellFeature.getType()));
+        result.features.emplace_back(feature);
+
+        auto& neighbors = result.neighbors[index];
+        for (auto const& connection : cell.connections) {
+            auto findResult = cellIndexById.find(connection.cellId);
+            if (findResult != cellIndexById.end()) {
+                neighbors.emplace_back(findResult->second);
+            }
+        }
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+
+        if (!cell.tokens.empty()) {
+            result.hasToken = true;
+        }
+    }
+    return result;
+}
+
+std::vector<uint64_t> ClusterHasher::calcColors(Structure const& graph, int& numIterations)
+{
+    auto numCells = toInt(graph.features.size());
+    auto colors = graph.features;
+    auto numColors = countDistinct(colors);
+
+    std::vector<uint64_t> newColors(numCells);
+    std::vector<uint64_t> neighborColors;
+    for (numIterations = 0; numIterations < numCells; ++numIterations) {
+        for (int index = 0; index < numCells; ++index) {
+            neighborColors.clear();
+            for (auto const& neighbor : graph.neighbors[index]) {
+                neighborColors.emplace_back(colors[neighbor]);
+            }
+            std::sort(neighborColors.begin(), neighborColors.end());
+            auto newColor = colors[index];
+            for (auto const& neighborColor : neighborColors) {
+                newColor = combine(newColor, neighborColor);
+            }
+            newColors[index] = mix(newColor);
+        }
+        auto newNumColors = countDistinct(newColors);
+        colors.swap(newColors);
+        if (newNumColors == numColors) {
+            break;
+        }
+        numColors = newNumColors;
+    }
+    return colors;
+}
+
+uint64_t ClusterHasher::calcHash(Structure const& graph, std::vector<uint64_t> const& colors)
+{
+    auto sortedColors = colors;
+    std::sort(sortedColors.begin(), sortedColors.end());
+    auto result = combine(mix(graph.hasToken ? 1 : 0), sortedColors.size());
+    for (auto const& color : sortedColors) {
+        result = combine(result, color);
+    }
+    return result;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Base/Definitions.h"
+#include "Descriptions.h"
+
+//structural hash of a cluster which is invariant under rotation, translation and relabelling of the cells:
+//cell features (max/actual connections, token blocking, branch number, cell function) are refined along the bonds
+//in Weisfeiler-Lehman style until the partition of the cells is stable
+class ClusterHasher
+{
+public:
+    //bond graph with refined colors of a cluster, computed once per cluster for repeated comparisons
+    struct Structure
+    {
+        bool hasToken = false;
+        std::vector<uint64_t> features;
+        std::vector<std::vector<int>> neighbors;  //sorted
+        std::vector<uint64_t> colors;
+        int numIterations = 0;
+        uint64_t hash = 0;
+    };
+    static Structure calcStructure(ClusterDescription const& cluster);
+
+    static uint64_t calcHash(ClusterDescription const& cluster);
+
+    //computed in parallel over the clusters on the engine thread pool
+    static std::vector<Structure> calcStructures(std::vector<ClusterDescription> const& clusters);
+    static std::vector<uint64_t> calcHashes(std::vector<ClusterDescription> const& clusters);
+
+    //exact check for isomorphic bond graphs with identical cell features, used to resolve hash collisions
+    //returns false if the check does not finish within a fixed budget of matching steps, i.e. unverified clusters
+    //are treated as distinct
+    static bool isEquivalent(ClusterDescription const& cluster, ClusterDescription const& otherCluster);
+    static bool isEquivalent(Structure const& structure, Structure const& otherStructure);
+
+private:
+    static auto constexpr GrainSize = 64;
+
+    static Structure createGraph(ClusterDescription const& cluster);
+    static std::vector<uint64_t> calcColors(Structure const& structure, int& numIterations);
+    static uint64_t calcHash(Structure const& structure, std::vector<uint64_t> const& colors);
+};
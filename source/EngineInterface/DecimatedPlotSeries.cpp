@@ -0,0 +1,149 @@
+#include "DecimatedPlotSeries.h"
+
+#include <algorithm>
+
+#include "Base/Definitions.h"
+
+void DecimatedPlotSeries::update(RingBuffer<float> const& xs, RingBuffer<float> const& ys, int numPixels)
+{
+    CHECK(xs.size() == ys.size() && xs.numRemoved() == ys.numRemoved());
+
+    numPixels = std::max(1, numPixels);
+    auto begin = ys.numRemoved();
+    auto end = begin + ys.size();
+    if (!isContinuation(xs, ys) || !isBucketWidthValid(ys.size(), numPixels)) {
+        _source = &ys;
+        _bucketWidth = calcBucketWidth(ys.size(), numPixels);
+        _buckets.clear();
+        _begin = begin;
+        _end = begin;
+    }
+
+    removeSamples(xs, ys, begin);
+    addSamples(xs, ys, std::max(_end, begin), end);
+    _begin = begin;
+    _end = end;
+    if (!ys.empty()) {
+        _lastX = xs.back();
+        _lastY = ys.back();
+    }
+    updateOutput(xs, ys);
+}
+
+size_t DecimatedPlotSeries::calcBucketWidth(size_t numSamples, int numPixels)
+{
+    size_t result = 1;
+    while (numSamples > 2 * static_cast<size_t>(numPixels) * result) {
+        result *= 2;
+    }
+    return result;
+}
+
+bool DecimatedPlotSeries::isBucketWidthValid(size_t numSamples, int numPixels) const
+{
+    auto numPixelsTimesWidth = static_cast<size_t>(numPixels) * _bucketWidth;
+    return (_bucketWidth == 1 || numSamples >= numPixelsTimesWidth) && numSamples <= 4 * numPixelsTimesWidth;
+}
+
+bool DecimatedPlotSeries::isContinuation(RingBuffer<float> const& xs, RingBuffer<float> const& ys) const
+{
+    auto begin = ys.numRemoved();
+    auto end = begin + ys.size();
+    if (_source != &ys || begin < _begin || end < _end) {
+        return false;
+    }
+
+    //the buffer may have been replaced in the meantime
+    if (_end > _begin && _end > begin) {
+        auto lastIndex = _end - 1 - begin;
+        return xs[lastIndex] == _lastX && ys[lastIndex] == _lastY;
+    }
+    return true;
+}
+
+void DecimatedPlotSeries::removeSamples(RingBuffer<float> const& xs, RingBuffer<float> const& ys, size_t begin)
+{
+    if (begin >= _end) {
+        _buckets.clear();
+        _end = begin;
+        return;
+    }
+    auto numRemovedBuckets = std::min(begin / _bucketWidth - _begin / _bucketWidth, _buckets.size());
+    _buckets.erase(_buckets.begin(), _buckets.begin() + numRemovedBuckets);
+
+    //recalculate partially removed bucket
+    if (begin > _begin && begin % _bucketWidth != 0 && !_buckets.empty()) {
+        auto bucketEnd = std::min((begin / _bucketWidth + 1) * _bucketWidth, _end);
+        std::deque<Bucket> remainingBuckets;
+        remainingBuckets.swap(_buckets);
+        remainingBuckets.pop_front();
+        addSamples(xs, ys, begin, bucketEnd);
+        _buckets.insert(_buckets.end(), remainingBuckets.begin(), remainingBuckets.end());
+    }
+}
+
+void DecimatedPlotSeries::addSamples(RingBuffer<float> const& xs, RingBuffer<float> const& ys, size_t begin, size_t end)
+{
+    for (auto sampleNumber = begin; sampleNumber < end; ++sampleNumber) {
+        auto index = sampleNumber - ys.numRemoved();
+        auto x = xs[index];
+        auto y = ys[index];
+        if (_buckets.empty() || sampleNumber % _bucketWidth == 0) {
+            _buckets.emplace_back(Bucket{sampleNumber, sampleNumber, x, y, x, y});
+            continue;
+        }
+        auto& bucket = _buckets.back();
+        if (y < bucket.minY) {
+            bucket.minSampleNumber = sampleNumber;
+            bucket.minX = x;
+            bucket.minY = y;
+        }
+        if (y > bucket.maxY) {
+            bucket.maxSampleNumber = sampleNumber;
+            bucket.maxX = x;
+            bucket.maxY = y;
+        }
+    }
+}
+
+void DecimatedPlotSeries::updateOutput(RingBuffer<float> const& xs, RingBuffer<float> const& ys)
+{
+    _xs.clear();
+    _ys.clear();
+    if (_buckets.empty()) {
+        _min = 0;
+        _max = 0;
+        return;
+    }
+
+    //first and last sample are always emitted so that the plotted range does not change
+    auto const& firstBucket = _buckets.front();
+    if (std::min(firstBucket.minSampleNumber, firstBucket.maxSampleNumber) != _begin) {
+        _xs.emplace_back(xs.front());
+        _ys.emplace_back(ys.front());
+    }
+    _min = firstBucket.minY;
+    _max = firstBucket.maxY;
+    for (auto const& bucket : _buckets) {
+        if (bucket.minSampleNumber <= bucket.maxSampleNumber) {
+            _xs.emplace_back(bucket.minX);
+            _ys.emplace_back(bucket.minY);
+            if (bucket.minSampleNumber < bucket.maxSampleNumber) {
+                _xs.emplace_back(bucket.maxX);
+                _ys.emplace_back(bucket.maxY);
+            }
+        } else {
+            _xs.emplace_back(bucket.maxX);
+            _ys.emplace_back(bucket.maxY);
+            _xs.emplace_back(bucket.minX);
+            _ys.emplace_back(bucket.minY);
+        }
+        _min = std::min(_min, bucket.minY);
+        _max = std::max(_max, bucket.maxY);
+    }
+    auto const& lastBucket = _buckets.back();
+    if (std::max(lastBucket.minSampleNumber, lastBucket.maxSampleNumber) != _end - 1) {
+        _xs.emplace_back(xs.back());
+        _ys.emplace_back(ys.back());
+    }
+}
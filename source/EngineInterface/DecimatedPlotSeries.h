@@ -0,0 +1,60 @@
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include "Base/RingBuffer.h"
+
+//min/max decimated view of a growing and sliding series for plotting: consecutive samples are grouped into buckets of
+//a power-of-two width with at least one and at most four buckets per pixel, and of each bucket the minimum and the
+//maximum sample are emitted in the order of their occurrence (together with the first and last sample of the series),
+//hence the rendered envelope is the one of the full series
+//the buckets are aligned to the sample numbers of the ring buffers and are only updated for added and removed samples
+class DecimatedPlotSeries
+{
+public:
+    //xs and ys need to be filled in lockstep
+    void update(RingBuffer<float> const& xs, RingBuffer<float> const& ys, int numPixels);
+
+    float const* getXs() const { return _xs.data(); }
+    float const* getYs() const { return _ys.data(); }
+    int getSize() const { return static_cast<int>(_ys.size()); }
+
+    //extrema of the full series
+    float getMin() const { return _min; }
+    float getMax() const { return _max; }
+
+    size_t getBucketWidth() const { return _bucketWidth; }
+
+private:
+    struct Bucket
+    {
+        size_t minSampleNumber;
+        size_t maxSampleNumber;
+        float minX;
+        float minY;
+        float maxX;
+        float maxY;
+    };
+
+    static size_t calcBucketWidth(size_t numSamples, int numPixels);
+    bool isBucketWidthValid(size_t numSamples, int numPixels) const;
+    bool isContinuation(RingBuffer<float> const& xs, RingBuffer<float> const& ys) const;
+
+    void removeSamples(RingBuffer<float> const& xs, RingBuffer<float> const& ys, size_t begin);
+    void addSamples(RingBuffer<float> const& xs, RingBuffer<float> const& ys, size_t begin, size_t end);
+    void updateOutput(RingBuffer<float> const& xs, RingBuffer<float> const& ys);
+
+    RingBuffer<float> const* _source = nullptr;
+    size_t _bucketWidth = 1;
+    size_t _begin = 0;  //sample numbers of the covered samples
+    size_t _end = 0;
+    float _lastX = 0;
+    float _lastY = 0;
+    std::deque<Bucket> _buckets;
+
+    std::vector<float> _xs;
+    std::vector<float> _ys;
+    float _min = 0;
+    float _max = 0;
+};
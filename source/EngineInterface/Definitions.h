@@ -23,5 +23,11 @@ struct Settings;
 class _SimulationController;
 using SimulationController = std::shared_ptr<_SimulationController>;
 
+class _SimulationDataSnapshot;
+using SimulationDataSnapshot = std::shared_ptr<_SimulationDataSnapshot>;
+
+class _StatisticsRecorder;
+using StatisticsRecorder = std::shared_ptr<_StatisticsRecorder>;
+
 struct MonitorData;
 class SpaceCalculator;
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "Base/NumberGenerator.h"
 #include "Base/Math.h"
+#include "Base/ParallelAlgorithms.h"
 #include "SpaceCalculator.h"
 
 DataDescription DescriptionHelper::createRect(CreateRectParameters const& parameters)
@@ -97,29 +98,40 @@ namespace
 
 DataDescription DescriptionHelper::gridMultiply(DataDescription const& input, GridMultiplyParameters const& parameters)
 {
-    DataDescription result;
     auto clone = input;
     auto cloneWithoutMetadata = input;
     removeMetadata(cloneWithoutMetadata);
-    for (int i = 0; i < parameters._horizontalNumber; ++i) {
-        for (int j = 0; j < parameters._verticalNumber; ++j) {
-            auto templateData = [&] {
-                if (i == 0 && j == 0) {
-                    return clone;
-                }
-                return cloneWithoutMetadata;
-            }();
-            templateData.shift({i * parameters._horizontalDistance, j * parameters._verticalDistance});
-            templateData.rotate(i * parameters._horizontalAngleInc + j * parameters._verticalAngleInc);
-            templateData.accelerate(
-                {i * parameters._horizontalVelXinc + j * parameters._verticalVelXinc, i * parameters._horizontalVelYinc + j * parameters._verticalVelYinc},
-                i * parameters._horizontalAngularVelInc + j * parameters._verticalAngularVelInc);
-
-            makeValid(templateData);
-            result.add(templateData);
+
+    //ids are generated in the order of the serial loop so that the result does not depend on the number of threads
+    auto numCopies = parameters._horizontalNumber * parameters._verticalNumber;
+    auto& numberGen = NumberGenerator::getInstance();
+    std::vector<std::vector<uint64_t>> newIdsByCopy(numCopies);
+    for (auto& newIds : newIdsByCopy) {
+        newIds.resize(input.cells.size());
+        for (auto& newId : newIds) {
+            newId = numberGen.getId();
         }
     }
 
+    std::vector<DataDescription> copies(numCopies);
+    ParallelAlgorithms::parallelFor(0, numCopies, [&](int index) {
+        auto i = index / parameters._verticalNumber;
+        auto j = index % parameters._verticalNumber;
+        auto& templateData = copies[index];
+        templateData = i == 0 && j == 0 ? clone : cloneWithoutMetadata;
+        templateData.shift({i * parameters._horizontalDistance, j * parameters._verticalDistance});
+        templateData.rotate(i * parameters._horizontalAngleInc + j * parameters._verticalAngleInc);
+        templateData.accelerate(
+            {i * parameters._horizontalVelXinc + j * parameters._verticalVelXinc, i * parameters._horizontalVelYinc + j * parameters._verticalVelYinc},
+            i * parameters._horizontalAngularVelInc + j * parameters._verticalAngularVelInc);
+
+        makeValid(templateData, newIdsByCopy[index]);
+    });
+
+    DataDescription result;
+    for (auto const& copy : copies) {
+        result.add(copy);
+    }
     return result;
 }
 
@@ -322,11 +334,20 @@ void DescriptionHelper::generateBranchNumbers(DataDescription& data, std::unorde
 void DescriptionHelper::makeValid(DataDescription& data)
 {
     auto& numberGen = NumberGenerator::getInstance();
+    std::vector<uint64_t> newIds(data.cells.size());
+    for (auto& newId : newIds) {
+        newId = numberGen.getId();
+    }
+    makeValid(data, newIds);
+}
+
+void DescriptionHelper::makeValid(DataDescription& data, std::vector<uint64_t> const& newIds)
+{
     std::unordered_map<uint64_t, uint64_t> newByOldIds;
-    for (auto& cell : data.cells) {
-        uint64_t newId = numberGen.getId();
-        newByOldIds.insert_or_assign(cell.id, newId);
-        cell.id = newId;
+    for (size_t i = 0; i < data.cells.size(); ++i) {
+        auto& cell = data.cells[i];
+        newByOldIds.insert_or_assign(cell.id, newIds[i]);
+        cell.id = newIds[i];
     }
 
     for (auto& cell : data.cells) {
@@ -75,6 +75,7 @@ public:
 
 private:
     static void makeValid(DataDescription& data);
+    static void makeValid(DataDescription& data, std::vector<uint64_t> const& newIds);
     static void makeValid(ClusterDescription& cluster);
     static void removeMetadata(CellDescription& cell);
     static bool isCellPresent(
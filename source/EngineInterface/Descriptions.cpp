@@ -32,6 +32,77 @@ bool CellDescription::isConnectedTo(uint64_t id) const
         != connections.end();
 }
 
+void CellDescription::insertConnection(CellDescription const& otherCell, RealVector2D const& firstConnectedCellPos)
+{
+    CHECK(connections.size() < maxConnections);
+
+    auto newAngle = Math::angleOfVector(otherCell.pos - pos);
+
+    if (connections.empty()) {
+        ConnectionDescription newConnection;
+        newConnection.cellId = otherCell.id;
+        newConnection.distance = toFloat(Math::length(otherCell.pos - pos));
+        newConnection.angleFromPrevious = 360.0;
+        connections.emplace_back(newConnection);
+        return;
+    }
+    if (1 == connections.size()) {
+        ConnectionDescription newConnection;
+        newConnection.cellId = otherCell.id;
+        newConnection.distance = toFloat(Math::length(otherCell.pos - pos));
+
+        auto prevAngle = Math::angleOfVector(firstConnectedCellPos - pos);
+        auto angleDiff = newAngle - prevAngle;
+        if (angleDiff >= 0) {
+            newConnection.angleFromPrevious = toFloat(angleDiff);
+            connections.begin()->angleFromPrevious = 360.0f - toFloat(angleDiff);
+        } else {
+            newConnection.angleFromPrevious = 360.0f + toFloat(angleDiff);
+            connections.begin()->angleFromPrevious = toFloat(-angleDiff);
+        }
+        connections.emplace_back(newConnection);
+        return;
+    }
+
+    auto angle = Math::angleOfVector(firstConnectedCellPos - pos);
+    auto connectionIt = ++connections.begin();
+    while (true) {
+        auto nextAngle = angle + connectionIt->angleFromPrevious;
+
+        if ((angle < newAngle && newAngle <= nextAngle) || (angle < (newAngle + 360.0f) && (newAngle + 360.0f) <= nextAngle)) {
+            break;
+        }
+
+        ++connectionIt;
+        if (connectionIt == connections.end()) {
+            connectionIt = connections.begin();
+        }
+        angle = nextAngle;
+        if (angle > 360.0f) {
+            angle -= 360.0f;
+        }
+    }
+
+    ConnectionDescription newConnection;
+    newConnection.cellId = otherCell.id;
+    newConnection.distance = toFloat(Math::length(otherCell.pos - pos));
+
+    auto angleDiff1 = newAngle - angle;
+    if (angleDiff1 < 0) {
+        angleDiff1 += 360.0f;
+    }
+    auto angleDiff2 = connectionIt->angleFromPrevious;
+
+    auto factor = (angleDiff2 != 0) ? angleDiff1 / angleDiff2 : 0.5f;
+    newConnection.angleFromPrevious = toFloat(angleDiff2 * factor);
+    connectionIt = connections.insert(connectionIt, newConnection);
+    ++connectionIt;
+    if (connectionIt == connections.end()) {
+        connectionIt = connections.begin();
+    }
+    connectionIt->angleFromPrevious = toFloat(angleDiff2 * (1 - factor));
+}
+
 RealVector2D ClusterDescription::getClusterPosFromCells() const
 {
     RealVector2D result;
@@ -225,77 +296,8 @@ DataDescription::addConnection(uint64_t const& cellId1, uint64_t const& cellId2,
     auto& cell2 = getCellRef(cellId2, cache);
 
     auto addConnection = [this, &cache](auto& cell, auto& otherCell) {
-        CHECK(cell.connections.size() < cell.maxConnections);
-
-        auto newAngle = Math::angleOfVector(otherCell.pos - cell.pos);
-
-        if (cell.connections.empty()) {
-            ConnectionDescription newConnection;
-            newConnection.cellId = otherCell.id;
-            newConnection.distance = toFloat(Math::length(otherCell.pos - cell.pos));
-            newConnection.angleFromPrevious = 360.0;
-            cell.connections.emplace_back(newConnection);
-            return;
-        }
-        if (1 == cell.connections.size()) {
-            ConnectionDescription newConnection;
-            newConnection.cellId = otherCell.id;
-            newConnection.distance = toFloat(Math::length(otherCell.pos - cell.pos));
-
-            auto connectedCell = getCellRef(cell.connections.front().cellId, cache);
-            auto connectedCellDelta = connectedCell.pos - cell.pos;
-            auto prevAngle = Math::angleOfVector(connectedCellDelta);
-            auto angleDiff = newAngle - prevAngle;
-            if (angleDiff >= 0) {
-                newConnection.angleFromPrevious = toFloat(angleDiff);
-                cell.connections.begin()->angleFromPrevious = 360.0f - toFloat(angleDiff);
-            } else {
-                newConnection.angleFromPrevious = 360.0f + toFloat(angleDiff);
-                cell.connections.begin()->angleFromPrevious = toFloat(-angleDiff);
-            }
-            cell.connections.emplace_back(newConnection);
-            return;
-        }
-
-        auto firstConnectedCell = getCellRef(cell.connections.front().cellId, cache);
-        auto firstConnectedCellDelta = firstConnectedCell.pos - cell.pos;
-        auto angle = Math::angleOfVector(firstConnectedCellDelta);
-        auto connectionIt = ++cell.connections.begin();
-        while (true) {
-            auto nextAngle = angle + connectionIt->angleFromPrevious;
-
-            if ((angle < newAngle && newAngle <= nextAngle) || (angle < (newAngle + 360.0f) && (newAngle + 360.0f) <= nextAngle)) {
-                break;
-            }
-
-            ++connectionIt;
-            if (connectionIt == cell.connections.end()) {
-                connectionIt = cell.connections.begin();
-            }
-            angle = nextAngle;
-            if (angle > 360.0f) {
-                angle -= 360.0f;
-            }
-        }
-
-        ConnectionDescription newConnection;
-        newConnection.cellId = otherCell.id;
-        newConnection.distance = toFloat(Math::length(otherCell.pos - cell.pos));
-
-        auto angleDiff1 = newAngle - angle;
-        if (angleDiff1 < 0) {
-            angleDiff1 += 360.0f;
-        }
-        auto angleDiff2 = connectionIt->angleFromPrevious;
-
-        auto factor = (angleDiff2 != 0) ? angleDiff1 / angleDiff2 : 0.5f;
-        newConnection.angleFromPrevious = toFloat(angleDiff2 * factor);
-        connectionIt = cell.connections.insert(connectionIt, newConnection);
-        ++connectionIt;
-        if (connectionIt == cell.connections.end()) {
-            connectionIt = cell.connections.begin();
-        }
-        connectionIt->angleFromPrevious = toFloat(angleDiff2 * (1 - factor));
+        auto firstConnectedCellPos = cell.connections.empty() ? RealVector2D() : getCellRef(cell.connections.front().cellId, cache).pos;
+        cell.insertConnection(otherCell, firstConnectedCellPos);
     };
 
     addConnection(cell1, cell2);
@@ -163,6 +163,10 @@ struct CellDescription
         return *this;
     }
     bool isConnectedTo(uint64_t id) const;
+
+    //inserts a connection into the angle-ordered connection list, firstConnectedCellPos is the position of the cell
+    //referred by the first existing connection
+    void insertConnection(CellDescription const& otherCell, RealVector2D const& firstConnectedCellPos);
 };
 
 struct ClusterDescription
@@ -29,9 +29,19 @@ struct FlowFieldSettings
     int numCenters = 1; //only 2 centers supported
     FlowCenter centers[2];
 
+    int gridSpacing = 4;  //distance between the nodes of the cached velocity grid
+
     bool operator==(FlowFieldSettings const& other) const
     {
-        return active == other.active && numCenters == other.numCenters && centers == other.centers;
+        if (active != other.active || numCenters != other.numCenters || gridSpacing != other.gridSpacing) {
+            return false;
+        }
+        for (int i = 0; i < numCenters; ++i) {
+            if (centers[i] != other.centers[i]) {
+                return false;
+            }
+        }
+        return true;
     }
     bool operator!=(FlowFieldSettings const& other) const { return !operator==(other); }
 };
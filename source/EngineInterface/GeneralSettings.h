@@ -1,7 +1,15 @@
 #pragma once
 
+#include <cstdint>
+
 struct GeneralSettings
 {
     int worldSizeX;
     int worldSizeY;
+
+    //random numbers are derived from a seed, the time step and the entity id; with useSeed the given seed is used instead
+    //of a random one, hence the random draws are reproducible; the simulation itself can still diverge since cell
+    //functions with locks and the compaction of the entity arrays depend on thread scheduling (see ReplayHarness)
+    bool useSeed = false;
+    uint32_t seed = 0;
 };
@@ -0,0 +1,297 @@
+#include "ImageToPatternConverter.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <memory>
+
+#include "Base/NumberGenerator.h"
+#include "Base/ParallelAlgorithms.h"
+
+#include "Colors.h"
+
+namespace
+{
+    auto constexpr TileSize = 64;
+    auto constexpr ColumnGrainSize = 16;
+    auto constexpr MaxNeighbors = 6;
+    auto constexpr MaxDarkChannelValue = 20;
+    auto constexpr CellEnergy = 200;
+
+    using Hsv = std::array<float, 3>;
+
+    //same conversion as ImGui::ColorConvertRGBtoHSV
+    Hsv toHsv(float r, float g, float b)
+    {
+        float k = 0.0f;
+        if (g < b) {
+            std::swap(g, b);
+            k = -1.0f;
+        }
+        if (r < g) {
+            std::swap(r, g);
+            k = -2.0f / 6.0f - k;
+        }
+        auto chroma = r - (g < b ? g : b);
+        return {std::abs(k + (g - b) / (6.0f * chroma + 1e-20f)), chroma / (r + 1e-20f), r};
+    }
+
+    Hsv toHsv(uint32_t rgb)
+    {
+        return toHsv(toFloat((rgb >> 16) & 0xff) / 255, toFloat((rgb >> 8) & 0xff) / 255, toFloat(rgb & 0xff) / 255);
+    }
+
+    int calcMatchedCellColor(unsigned char r, unsigned char g, unsigned char b)
+    {
+        static std::array<Hsv, 7> const cellColors = [] {
+            std::array<Hsv, 7> result;
+            for (int i = 0; i < 7; ++i) {
+                result[i] = toHsv(Const::IndividualCellColors[i]);
+            }
+            return result;
+        }();
+
+        auto colorHsv = toHsv(toFloat(r) / 255, toFloat(g) / 255, toFloat(b) / 255);
+        int bestMatchIndex = 0;
+        float bestMatchDistance = 0;
+        for (int index = 0; index < 7; ++index) {
+            auto const& cellColor = cellColors[index];
+            auto distance = colorHsv[0] - cellColor[0];
+            if (distance > 0.5f) {
+                distance -= 1.0f;
+            }
+            if (distance < -0.5f) {
+                distance += 1.0f;
+            }
+            distance = std::abs(distance) * colorHsv[1] + std::abs(colorHsv[1] - cellColor[1]);
+            if (index == 0 || bestMatchDistance > distance) {
+                bestMatchIndex = index;
+                bestMatchDistance = distance;
+            }
+        }
+        return bestMatchIndex;
+    }
+
+    //lookup table for all 2^24 colors which is filled on demand, an entry contains the matched cell color + 1 or 0 if
+    //not yet calculated
+    class MatchedCellColorTable
+    {
+    public:
+        static MatchedCellColorTable& getInstance()
+        {
+            static MatchedCellColorTable instance;
+            return instance;
+        }
+
+        int get(unsigned char r, unsigned char g, unsigned char b)
+        {
+            auto& entry = _entries[(uint32_t(r) << 16) | (uint32_t(g) << 8) | uint32_t(b)];
+            auto value = entry.load(std::memory_order_relaxed);
+            if (value == 0) {
+                value = static_cast<uint8_t>(calcMatchedCellColor(r, g, b) + 1);
+                entry.store(value, std::memory_order_relaxed);
+            }
+            return value - 1;
+        }
+
+    private:
+        MatchedCellColorTable()
+            : _entries(new std::atomic<uint8_t>[1 << 24]())
+        {}
+
+        std::unique_ptr<std::atomic<uint8_t>[]> _entries;
+    };
+
+    struct Pixel
+    {
+        int8_t color;  //-1 = no cell
+        uint8_t intensity;
+    };
+
+    //neighbors on the hexagonal grid in the order of DescriptionHelper::reconnectCells: first the cells in the same row
+    //(distance 1), then the cells in the adjacent rows (distance sqrt(1.25)), each in ascending order of the cell indices
+    int getNeighbors(std::array<int, MaxNeighbors>& result, std::vector<int> const& cellIndices, int x, int y, int width, int height)
+    {
+        static std::array<std::array<int, 2>, MaxNeighbors> const EvenRowOffsets = {{{-1, 0}, {1, 0}, {-1, -1}, {-1, 1}, {0, -1}, {0, 1}}};
+        static std::array<std::array<int, 2>, MaxNeighbors> const OddRowOffsets = {{{-1, 0}, {1, 0}, {0, -1}, {0, 1}, {1, -1}, {1, 1}}};
+
+        auto const& offsets = y % 2 == 0 ? EvenRowOffsets : OddRowOffsets;
+        int numNeighbors = 0;
+        for (auto const& [dx, dy] : offsets) {
+            auto neighborX = x + dx;
+            auto neighborY = y + dy;
+            if (neighborX < 0 || neighborX >= width || neighborY < 0 || neighborY >= height) {
+                continue;
+            }
+            auto neighborIndex = cellIndices[neighborX * height + neighborY];
+            if (neighborIndex != -1) {
+                result[numNeighbors++] = neighborIndex;
+            }
+        }
+        return numNeighbors;
+    }
+}
+
+DataDescription ImageToPatternConverter::convert(unsigned char const* pixels, int width, int height, int numChannels, int maxConnections)
+{
+    CHECK(numChannels >= 3);
+
+    //matched colors are stored column by column since the cells are created in this order
+    std::vector<Pixel> pixelGrid(static_cast<size_t>(width) * height);
+    auto numTilesX = (width + TileSize - 1) / TileSize;
+    auto numTilesY = (height + TileSize - 1) / TileSize;
+    ParallelAlgorithms::parallelFor(0, numTilesX * numTilesY, [&](int tile) {
+        auto tileX = tile % numTilesX * TileSize;
+        auto tileY = tile / numTilesX * TileSize;
+        for (int y = tileY; y < std::min(tileY + TileSize, height); ++y) {
+            for (int x = tileX; x < std::min(tileX + TileSize, width); ++x) {
+                auto pixel = pixels + (static_cast<size_t>(y) * width + x) * numChannels;
+                auto r = pixel[0];
+                auto g = pixel[1];
+                auto b = pixel[2];
+                auto& gridPixel = pixelGrid[static_cast<size_t>(x) * height + y];
+                if (r > MaxDarkChannelValue || g > MaxDarkChannelValue || b > MaxDarkChannelValue) {
+                    gridPixel.color = static_cast<int8_t>(MatchedCellColorTable::getInstance().get(r, g, b));
+                    gridPixel.intensity = std::max(r, std::max(g, b));
+                } else {
+                    gridPixel.color = -1;
+                }
+            }
+        }
+    });
+
+    std::vector<int> columnStarts(width + 1, 0);
+    ParallelAlgorithms::parallelFor(
+        0,
+        width,
+        [&](int x) {
+            int numCells = 0;
+            for (int y = 0; y < height; ++y) {
+                if (pixelGrid[static_cast<size_t>(x) * height + y].color != -1) {
+                    ++numCells;
+                }
+            }
+            columnStarts[x + 1] = numCells;
+        },
+        ColumnGrainSize);
+    for (int x = 0; x < width; ++x) {
+        columnStarts[x + 1] += columnStarts[x];
+    }
+
+    DataDescription result;
+    result.cells.resize(columnStarts[width]);
+    std::vector<int> cellIndices(pixelGrid.size());
+    ParallelAlgorithms::parallelFor(
+        0,
+        width,
+        [&](int x) {
+            auto cellIndex = columnStarts[x];
+            for (int y = 0; y < height; ++y) {
+                auto const& gridPixel = pixelGrid[static_cast<size_t>(x) * height + y];
+                if (gridPixel.color == -1) {
+                    cellIndices[static_cast<size_t>(x) * height + y] = -1;
+                    continue;
+                }
+                auto xOffset = y % 2 == 0 ? 0.0f : 0.5f;
+                auto intensity = toFloat(gridPixel.intensity) / 255;
+                result.cells[cellIndex] = CellDescription()
+                                              .setEnergy(intensity * CellEnergy)
+                                              .setPos({toFloat(x) + xOffset, toFloat(y)})
+                                              .setMaxConnections(maxConnections)
+                                              .setMetadata(CellMetadata().setColor(gridPixel.color))
+                                              .setBarrier(false);
+                cellIndices[static_cast<size_t>(x) * height + y] = cellIndex++;
+            }
+        },
+        ColumnGrainSize);
+    pixelGrid = std::vector<Pixel>();
+
+    for (auto& cell : result.cells) {
+        cell.id = NumberGenerator::getInstance().getId();
+    }
+
+    //each pair of neighboring cells is connected if both have free connection slots, the pairs and the partners of a
+    //cell are considered in the same order as in DescriptionHelper::reconnectCells: a cell first receives the
+    //connections from its partners with lower indices (in ascending order) and then establishes the connections to its
+    //partners with higher indices (in neighbor order)
+    auto numCells = toInt(result.cells.size());
+    std::vector<std::array<int, MaxNeighbors>> partners(numCells);
+    std::vector<int8_t> numPartners(numCells, 0);
+    if (maxConnections >= MaxNeighbors) {
+        ParallelAlgorithms::parallelFor(
+            0,
+            width,
+            [&](int x) {
+                std::array<int, MaxNeighbors> neighbors;
+                for (int y = 0; y < height; ++y) {
+                    auto cellIndex = cellIndices[static_cast<size_t>(x) * height + y];
+                    if (cellIndex == -1) {
+                        continue;
+                    }
+                    auto numNeighbors = getNeighbors(neighbors, cellIndices, x, y, width, height);
+                    auto& cellPartners = partners[cellIndex];
+                    int numCellPartners = 0;
+                    for (int i = 0; i < numNeighbors; ++i) {
+                        if (neighbors[i] < cellIndex) {
+                            cellPartners[numCellPartners++] = neighbors[i];
+                        }
+                    }
+                    std::sort(cellPartners.begin(), cellPartners.begin() + numCellPartners);
+                    for (int i = 0; i < numNeighbors; ++i) {
+                        if (neighbors[i] > cellIndex) {
+                            cellPartners[numCellPartners++] = neighbors[i];
+                        }
+                    }
+                    numPartners[cellIndex] = static_cast<int8_t>(numCellPartners);
+                }
+            },
+            ColumnGrainSize);
+    } else {
+        std::array<int, MaxNeighbors> neighbors;
+        for (int x = 0; x < width; ++x) {
+            for (int y = 0; y < height; ++y) {
+                auto cellIndex = cellIndices[static_cast<size_t>(x) * height + y];
+                if (cellIndex == -1) {
+                    continue;
+                }
+                auto numNeighbors = getNeighbors(neighbors, cellIndices, x, y, width, height);
+                for (int i = 0; i < numNeighbors; ++i) {
+                    auto neighborIndex = neighbors[i];
+                    if (neighborIndex > cellIndex && numPartners[cellIndex] < maxConnections && numPartners[neighborIndex] < maxConnections) {
+                        partners[cellIndex][numPartners[cellIndex]++] = neighborIndex;
+                        partners[neighborIndex][numPartners[neighborIndex]++] = cellIndex;
+                    }
+                }
+            }
+        }
+    }
+    cellIndices = std::vector<int>();
+
+    ParallelAlgorithms::parallelFor(
+        0,
+        numCells,
+        [&](int cellIndex) {
+            auto& cell = result.cells[cellIndex];
+            auto const& cellPartners = partners[cellIndex];
+            cell.connections.reserve(numPartners[cellIndex]);
+            for (int i = 0; i < numPartners[cellIndex]; ++i) {
+                RealVector2D firstConnectedCellPos;
+                for (int j = 0; j < i; ++j) {
+                    auto const& partnerCell = result.cells[cellPartners[j]];
+                    if (partnerCell.id == cell.connections.front().cellId) {
+                        firstConnectedCellPos = partnerCell.pos;
+                    }
+                }
+                cell.insertConnection(result.cells[cellPartners[i]], firstConnectedCellPos);
+            }
+        },
+        TileSize * TileSize);
+
+    return result;
+}
+
+int ImageToPatternConverter::getMatchedCellColor(unsigned char r, unsigned char g, unsigned char b)
+{
+    return MatchedCellColorTable::getInstance().get(r, g, b);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Descriptions.h"
+
+//converts an image into a hexagonal cell pattern: each pixel which is not almost black yields a cell with the best
+//matching cell color, the cells of odd rows are shifted by half a cell and neighboring cells are connected
+//the result is the same as adding the cells column by column and calling DescriptionHelper::reconnectCells(data, 1.5f),
+//but the image is processed in parallel tiles and the connections are built from the pixel grid
+class ImageToPatternConverter
+{
+public:
+    //pixels are given row by row with numChannels (>= 3) interleaved channels starting with red, green and blue
+    static DataDescription convert(unsigned char const* pixels, int width, int height, int numChannels, int maxConnections);
+
+    static int getMatchedCellColor(unsigned char r, unsigned char g, unsigned char b);
+};
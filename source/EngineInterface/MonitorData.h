@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Enums.h"
+
 struct MonitorData
 {
     uint64_t timestep = 0;
@@ -16,4 +18,12 @@ struct MonitorData
     float numSuccessfulAttacks = 0;
     float numFailedAttacks = 0;
     float numMuscleActivities = 0;
+
+    //structural operation queue (counted since simulation start)
+    int numDroppedStructuralOperations = 0;
+    int numStructuralOperationQueueResizes = 0;
+
+    //token processing of the last time step
+    int numTokensByCellFunction[Enums::CellFunction_Count] = {};
+    float cellFunctionBatchTimes[Enums::CellFunction_Count] = {};  //in milliseconds, measured on the step after the previous request
 };
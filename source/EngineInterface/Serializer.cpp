@@ -393,14 +393,36 @@ bool Serializer::serializeSimulationToStrings(
     try {
         {
             std::stringstream stdStream;
-            zstr::ostream stream(stdStream, std::ios::binary);
-            if (!stream) {
-                return false;
-            }
-            serializeDataDescription(data.content, stream);
-            stream.flush();
+            serializeContentToStream(stdStream, data.content);
             content = stdStream.str();
         }
+        return serializeSettingsAndSymbolMapToStrings(timestepAndSettings, symbolMap, data);
+    } catch (...) {
+        return false;
+    }
+}
+
+void Serializer::serializeContentToStream(std::ostream& stream, ClusteredDataDescription const& content)
+{
+    {
+        //the compressed stream is finished on destruction
+        zstr::ostream zstrStream(stream, std::ios::binary);
+        if (!zstrStream) {
+            throw std::runtime_error("compression stream could not be created");
+        }
+        serializeDataDescription(content, zstrStream);
+    }
+    if (!stream) {
+        throw std::runtime_error("content could not be written");
+    }
+}
+
+bool Serializer::serializeSettingsAndSymbolMapToStrings(
+    std::string& timestepAndSettings,
+    std::string& symbolMap,
+    DeserializedSimulation const& data)
+{
+    try {
         {
             std::stringstream stream;
             serializeTimestepAndSettings(data.timestep, data.settings, stream);
@@ -34,6 +34,13 @@ public:
         std::string const& timestepAndSettings,
         std::string const& symbolMap);
 
+    //the compressed content is passed to the stream while being produced, throws on failure
+    static void serializeContentToStream(std::ostream& stream, ClusteredDataDescription const& content);
+    static bool serializeSettingsAndSymbolMapToStrings(
+        std::string& timestepAndSettings,
+        std::string& symbolMap,
+        DeserializedSimulation const& data);
+
     static bool serializeContentToFile(std::string const& filename, ClusteredDataDescription const& content);
     static bool deserializeContentFromFile(ClusteredDataDescription& content, std::string const& filenam);
 
@@ -43,6 +43,8 @@ void SettingsParser::encodeDecode(boost::property_tree::ptree& tree, uint64_t& t
         defaultSettings.generalSettings.worldSizeY,
         "general.world size.y",
         parserTask);
+    JsonParser::encodeDecode(tree, settings.generalSettings.useSeed, defaultSettings.generalSettings.useSeed, "general.use seed", parserTask);
+    JsonParser::encodeDecode(tree, settings.generalSettings.seed, defaultSettings.generalSettings.seed, "general.seed", parserTask);
 
     //simulation parameters
     auto& simPar = settings.simulationParameters;
@@ -73,6 +75,8 @@ void SettingsParser::encodeDecode(boost::property_tree::ptree& tree, uint64_t& t
     JsonParser::encodeDecode(tree, simPar.spotValues.cellMinEnergy, defaultPar.spotValues.cellMinEnergy, "simulation parameters.cell.min energy", parserTask);
     JsonParser::encodeDecode(
         tree, simPar.cellTransformationProb, defaultPar.cellTransformationProb, "simulation parameters.cell.transformation probability", parserTask);
+    JsonParser::encodeDecode(
+        tree, simPar.particleMergeDistance, defaultPar.particleMergeDistance, "simulation parameters.particle.merge distance", parserTask);
     JsonParser::encodeDecode(
         tree, simPar.spotValues.cellFusionVelocity, defaultPar.spotValues.cellFusionVelocity, "simulation parameters.cell.fusion velocity", parserTask);
     JsonParser::encodeDecode(
@@ -321,6 +325,7 @@ void SettingsParser::encodeDecode(boost::property_tree::ptree& tree, uint64_t& t
     //flow field settings
     JsonParser::encodeDecode(tree, settings.flowFieldSettings.active, defaultSettings.flowFieldSettings.active, "flow field.active", parserTask);
     JsonParser::encodeDecode(tree, settings.flowFieldSettings.numCenters, defaultSettings.flowFieldSettings.numCenters, "flow field.num centers", parserTask);
+    JsonParser::encodeDecode(tree, settings.flowFieldSettings.gridSpacing, defaultSettings.flowFieldSettings.gridSpacing, "flow field.grid spacing", parserTask);
     for (int i = 0; i < 2; ++i) {
         std::string node = "flow field.center" + std::to_string(i) + ".";
         auto& radialData = settings.flowFieldSettings.centers[i];
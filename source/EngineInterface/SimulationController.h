@@ -26,6 +26,10 @@ public:
     tryDrawVectorGraphicsAndReturnOverlay(RealVector2D const& rectUpperLeft, RealVector2D const& rectLowerRight, IntVector2D const& imageSize, double zoom) = 0;
 
     virtual ClusteredDataDescription getClusteredSimulationData() = 0;
+
+    //blocks the engine only for copying the raw data
+    virtual SimulationDataSnapshot getSimulationDataSnapshot() = 0;
+
     virtual DataDescription getSimulationData() = 0;
     virtual ClusteredDataDescription getSelectedClusteredSimulationData(bool includeClusters) = 0;
     virtual DataDescription getSelectedSimulationData(bool includeClusters) = 0;
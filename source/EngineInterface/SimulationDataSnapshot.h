@@ -0,0 +1,15 @@
+#pragma once
+
+#include "Definitions.h"
+#include "Descriptions.h"
+
+//raw simulation data copied while the engine is blocked, the expensive conversion into descriptions is deferred and
+//may be done on any thread
+class _SimulationDataSnapshot
+{
+public:
+    virtual ~_SimulationDataSnapshot() = default;
+
+    virtual uint64_t getSizeInBytes() const = 0;
+    virtual ClusteredDataDescription getClusteredData() const = 0;
+};
@@ -20,6 +20,7 @@ struct SimulationParameters
     int cellCreationMaxConnection = 4;
     int cellCreationTokenAccessNumber = 0;
     float cellTransformationProb = 0.2f;
+    float particleMergeDistance = 0.7071f;  //particles of a unit square closer to the one with the smallest id are merged into it
 
     float cellFunctionWeaponStrength = 0.1f;
     int cellFunctionComputerMaxInstructions = 15;
@@ -55,6 +56,7 @@ struct SimulationParameters
             && cellCreationMaxConnection == other.cellCreationMaxConnection
             && cellCreationTokenAccessNumber == other.cellCreationTokenAccessNumber
             && cellTransformationProb == other.cellTransformationProb
+            && particleMergeDistance == other.particleMergeDistance
             && cellFunctionWeaponStrength == other.cellFunctionWeaponStrength
             && cellFunctionComputerMaxInstructions == other.cellFunctionComputerMaxInstructions
             && cellFunctionComputerCellMemorySize == other.cellFunctionComputerCellMemorySize
@@ -0,0 +1,347 @@
+#include "StatisticsExporter.h"
+
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include <zlib.h>
+
+#include "MonitorData.h"
+
+namespace
+{
+    char const ColumnarMagic[8] = {'A', 'L', 'I', 'E', 'N', 'S', 'T', 'S'};
+    uint32_t const ColumnarVersion = 1;
+
+    enum class ColumnType : uint8_t
+    {
+        UInt64 = 0,
+        Float32 = 1
+    };
+
+    enum class Compression : uint32_t
+    {
+        None = 0,
+        Zlib = 1
+    };
+
+    std::vector<std::string> const ColumnNames = {
+        "time step",
+        "cells",
+        "cells (color 0)",
+        "cells (color 1)",
+        "cells (color 2)",
+        "cells (color 3)",
+        "cells (color 4)",
+        "cells (color 5)",
+        "cells (color 6)",
+        "cell connections",
+        "particles",
+        "tokens",
+        "created cells",
+        "successful attacks",
+        "failed attacks",
+        "muscle activities"};
+
+    auto const RecorderFlushInterval = std::chrono::milliseconds(500);
+
+    //values are stored in the byte order of the host, which is little-endian on all supported platforms
+    template <typename T>
+    void writeValue(std::ostream& stream, T const& value)
+    {
+        stream.write(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void readValue(std::istream& stream, T& value)
+    {
+        stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void writeColumn(std::ostream& stream, std::string const& name, ColumnType type, std::vector<T> const& values, Compression compression)
+    {
+        writeValue(stream, type);
+        writeValue(stream, static_cast<uint32_t>(name.size()));
+        stream.write(name.data(), name.size());
+
+        auto data = reinterpret_cast<Bytef const*>(values.data());
+        auto size = static_cast<uLong>(values.size() * sizeof(T));
+        if (compression == Compression::Zlib) {
+            std::vector<Bytef> compressedData(compressBound(size));
+            auto compressedSize = static_cast<uLongf>(compressedData.size());
+            if (compress2(compressedData.data(), &compressedSize, data, size, Z_BEST_SPEED) != Z_OK) {
+                throw std::runtime_error("compression failed");
+            }
+            writeValue(stream, static_cast<uint64_t>(compressedSize));
+            stream.write(reinterpret_cast<char const*>(compressedData.data()), compressedSize);
+        } else {
+            writeValue(stream, static_cast<uint64_t>(size));
+            stream.write(reinterpret_cast<char const*>(data), size);
+        }
+    }
+
+    template <typename T>
+    void readColumn(std::istream& stream, std::string const& name, ColumnType type, std::vector<T>& values, uint64_t numRows, Compression compression)
+    {
+        ColumnType storedType;
+        uint32_t nameLength;
+        readValue(stream, storedType);
+        readValue(stream, nameLength);
+        std::string storedName(nameLength, '\0');
+        stream.read(storedName.data(), nameLength);
+        uint64_t storedSize;
+        readValue(stream, storedSize);
+        if (!stream || storedType != type || storedName != name) {
+            throw std::runtime_error("unexpected column");
+        }
+
+        values.resize(numRows);
+        auto size = static_cast<uLongf>(numRows * sizeof(T));
+        if (compression == Compression::Zlib) {
+            std::vector<Bytef> compressedData(storedSize);
+            stream.read(reinterpret_cast<char*>(compressedData.data()), storedSize);
+            auto uncompressedSize = size;
+            if (!stream
+                || uncompress(reinterpret_cast<Bytef*>(values.data()), &uncompressedSize, compressedData.data(), static_cast<uLong>(storedSize))
+                    != Z_OK
+                || uncompressedSize != size) {
+                throw std::runtime_error("decompression failed");
+            }
+        } else {
+            if (storedSize != size) {
+                throw std::runtime_error("unexpected column size");
+            }
+            stream.read(reinterpret_cast<char*>(values.data()), size);
+        }
+    }
+
+    void appendValue(std::string& output, uint64_t value)
+    {
+        char buffer[24];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        output.append(buffer, result.ptr);
+    }
+
+    void appendValue(std::string& output, float value)
+    {
+        char buffer[32];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        output.append(buffer, result.ptr);
+    }
+}
+
+StatisticsTable StatisticsTable::fromRollup(StatisticsRollup const& rollup)
+{
+    StatisticsTable result;
+    auto numRows = rollup.timestepHistory.size();
+    result.timesteps.reserve(numRows);
+    for (auto const& timestep : rollup.timestepHistory) {
+        result.timesteps.emplace_back(static_cast<uint64_t>(timestep));
+    }
+    for (int i = 0; i < NumStatisticsSeries; ++i) {
+        CHECK(rollup.means[i].size() == numRows);
+        result.columns[i].assign(rollup.means[i].begin(), rollup.means[i].end());
+    }
+    return result;
+}
+
+void StatisticsTable::add(uint64_t timestep, StatisticsSample const& sample)
+{
+    timesteps.emplace_back(timestep);
+    for (int i = 0; i < NumStatisticsSeries; ++i) {
+        columns[i].emplace_back(sample[i]);
+    }
+}
+
+std::string const StatisticsExporter::ColumnarFileExtension = ".alstats";
+
+std::string const& StatisticsExporter::getCsvHeader()
+{
+    static std::string const result = [] {
+        std::string header;
+        for (auto const& name : ColumnNames) {
+            header += header.empty() ? name : ", " + name;
+        }
+        return header + "\n";
+    }();
+    return result;
+}
+
+void StatisticsExporter::appendCsvRows(std::string& output, StatisticsTable const& table, size_t beginRow, size_t endRow)
+{
+    output.reserve(output.size() + (endRow - beginRow) * (NumStatisticsSeries + 1) * 8);
+    for (auto row = beginRow; row < endRow; ++row) {
+        appendValue(output, table.timesteps[row]);
+        for (auto const& column : table.columns) {
+            output += ", ";
+            appendValue(output, column[row]);
+        }
+        output += '\n';
+    }
+}
+
+bool StatisticsExporter::writeCsv(std::string const& filename, StatisticsTable const& table)
+{
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    file << getCsvHeader();
+
+    //rows are formatted in chunks to bound the memory overhead
+    size_t const RowsPerChunk = 16384;
+    std::string chunk;
+    for (size_t beginRow = 0; beginRow < table.getNumRows(); beginRow += RowsPerChunk) {
+        chunk.clear();
+        appendCsvRows(chunk, table, beginRow, std::min(beginRow + RowsPerChunk, table.getNumRows()));
+        file.write(chunk.data(), chunk.size());
+    }
+    return static_cast<bool>(file);
+}
+
+bool StatisticsExporter::writeColumnar(std::string const& filename, StatisticsTable const& table, bool compressed)
+{
+    try {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        auto compression = compressed ? Compression::Zlib : Compression::None;
+        file.write(ColumnarMagic, sizeof(ColumnarMagic));
+        writeValue(file, ColumnarVersion);
+        writeValue(file, compression);
+        writeValue(file, static_cast<uint32_t>(ColumnNames.size()));
+        writeValue(file, static_cast<uint64_t>(table.getNumRows()));
+
+        writeColumn(file, ColumnNames.front(), ColumnType::UInt64, table.timesteps, compression);
+        for (int i = 0; i < NumStatisticsSeries; ++i) {
+            CHECK(table.columns[i].size() == table.getNumRows());
+            writeColumn(file, ColumnNames[i + 1], ColumnType::Float32, table.columns[i], compression);
+        }
+        return static_cast<bool>(file);
+    } catch (std::exception const&) {
+        return false;
+    }
+}
+
+bool StatisticsExporter::readColumnar(StatisticsTable& table, std::string const& filename)
+{
+    try {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        char magic[sizeof(ColumnarMagic)];
+        uint32_t version;
+        Compression compression;
+        uint32_t numColumns;
+        uint64_t numRows;
+        file.read(magic, sizeof(magic));
+        readValue(file, version);
+        readValue(file, compression);
+        readValue(file, numColumns);
+        readValue(file, numRows);
+        if (!file || std::memcmp(magic, ColumnarMagic, sizeof(magic)) != 0 || version != ColumnarVersion
+            || numColumns != ColumnNames.size() || (compression != Compression::None && compression != Compression::Zlib)) {
+            return false;
+        }
+
+        readColumn(file, ColumnNames.front(), ColumnType::UInt64, table.timesteps, numRows, compression);
+        for (int i = 0; i < NumStatisticsSeries; ++i) {
+            readColumn(file, ColumnNames[i + 1], ColumnType::Float32, table.columns[i], numRows, compression);
+        }
+        return static_cast<bool>(file);
+    } catch (std::exception const&) {
+        return false;
+    }
+}
+
+bool StatisticsExporter::write(std::string const& filename, StatisticsTable const& table)
+{
+    return isColumnarFile(filename) ? writeColumnar(filename, table) : writeCsv(filename, table);
+}
+
+bool StatisticsExporter::isColumnarFile(std::string const& filename)
+{
+    return std::filesystem::path(filename).extension().string() == ColumnarFileExtension;
+}
+
+_StatisticsRecorder::_StatisticsRecorder(std::string const& filename)
+    : _filename(filename)
+{
+    std::ofstream file(filename, std::ios::binary);
+    file << StatisticsExporter::getCsvHeader();
+    if (!file) {
+        _valid = false;
+        return;
+    }
+    _thread = std::thread([this] { run(); });
+}
+
+_StatisticsRecorder::~_StatisticsRecorder()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _finished = true;
+    }
+    _condition.notify_all();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+bool _StatisticsRecorder::isValid() const
+{
+    return _valid;
+}
+
+void _StatisticsRecorder::add(MonitorData const& statistics)
+{
+    if (_lastTimestep && *_lastTimestep == statistics.timestep) {
+        return;
+    }
+    _lastTimestep = statistics.timestep;
+    ++_numSamples;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pendingSamples.add(statistics.timestep, toStatisticsSample(statistics));
+    }
+}
+
+uint64_t _StatisticsRecorder::getNumSamples() const
+{
+    return _numSamples;
+}
+
+void _StatisticsRecorder::run()
+{
+    std::ofstream file(_filename, std::ios::binary | std::ios::app);
+    StatisticsTable samples;
+    std::string output;
+    auto finished = false;
+    while (!finished) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait_for(lock, RecorderFlushInterval, [this] { return _finished; });
+            finished = _finished;
+            std::swap(samples, _pendingSamples);
+        }
+        if (samples.getNumRows() == 0) {
+            continue;
+        }
+        output.clear();
+        StatisticsExporter::appendCsvRows(output, samples, 0, samples.getNumRows());
+        file.write(output.data(), output.size());
+        file.flush();
+        if (!file) {
+            _valid = false;
+        }
+
+        samples.timesteps.clear();
+        for (auto& column : samples.columns) {
+            column.clear();
+        }
+    }
+}
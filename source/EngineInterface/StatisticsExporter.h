@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Definitions.h"
+#include "StatisticsHistory.h"
+
+//statistics in column-oriented layout: one time step column and one float column per series
+struct StatisticsTable
+{
+    std::vector<uint64_t> timesteps;
+    std::array<std::vector<float>, NumStatisticsSeries> columns;
+
+    static StatisticsTable fromRollup(StatisticsRollup const& rollup);  //uses the means
+
+    void add(uint64_t timestep, StatisticsSample const& sample);
+    size_t getNumRows() const { return timesteps.size(); }
+};
+
+//file formats for statistics:
+//csv: one row per sample, floats are written in their shortest round-trip representation
+//columnar: binary file consisting of a header and one block per column with typed little-endian values, each block
+//can be zlib-compressed
+class StatisticsExporter
+{
+public:
+    static std::string const& getCsvHeader();
+    static void appendCsvRows(std::string& output, StatisticsTable const& table, size_t beginRow, size_t endRow);
+
+    static bool writeCsv(std::string const& filename, StatisticsTable const& table);
+    static bool writeColumnar(std::string const& filename, StatisticsTable const& table, bool compressed = true);
+    static bool readColumnar(StatisticsTable& table, std::string const& filename);
+
+    //columnar for ".alstats" and csv otherwise
+    static bool write(std::string const& filename, StatisticsTable const& table);
+    static bool isColumnarFile(std::string const& filename);
+
+    static std::string const ColumnarFileExtension;
+};
+
+//appends statistics samples to a csv file while the simulation is running, formatting and writing are done on a
+//background thread
+class _StatisticsRecorder
+{
+public:
+    _StatisticsRecorder(std::string const& filename);
+    ~_StatisticsRecorder();  //writes the remaining samples
+
+    bool isValid() const;  //false if the file could not be opened or written
+
+    void add(MonitorData const& statistics);  //repeated samples from a paused simulation are ignored
+    uint64_t getNumSamples() const;
+
+private:
+    void run();
+
+    std::string _filename;
+    std::optional<uint64_t> _lastTimestep;
+    uint64_t _numSamples = 0;
+    std::atomic<bool> _valid = true;
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    StatisticsTable _pendingSamples;
+    bool _finished = false;
+    std::thread _thread;
+};
@@ -0,0 +1,143 @@
+#include "StatisticsHistory.h"
+
+#include <algorithm>
+
+#include "MonitorData.h"
+
+namespace
+{
+    size_t const LiveCapacity = static_cast<size_t>((LiveStatistics::MaxLiveHistory + 1.0f) * LiveStatistics::MaxSamplesPerSecond);
+}
+
+StatisticsSample toStatisticsSample(MonitorData const& statistics)
+{
+    StatisticsSample result;
+    int numCells = 0;
+    for (int i = 0; i < 7; ++i) {
+        numCells += statistics.numCellsByColor[i];
+    }
+    result[0] = toFloat(numCells);
+    for (int i = 0; i < 7; ++i) {
+        result[1 + i] = toFloat(statistics.numCellsByColor[i]);
+    }
+    result[8] = toFloat(statistics.numConnections);
+    result[9] = toFloat(statistics.numParticles);
+    result[10] = toFloat(statistics.numTokens);
+    result[11] = statistics.numCreatedCells;
+    result[12] = statistics.numSuccessfulAttacks;
+    result[13] = statistics.numFailedAttacks;
+    result[14] = statistics.numMuscleActivities;
+    return result;
+}
+
+LiveStatistics::LiveStatistics()
+    : timepointsHistory(LiveCapacity)
+{
+    for (auto& data : datas) {
+        data = RingBuffer<float>(LiveCapacity);
+    }
+}
+
+void LiveStatistics::truncate()
+{
+    while (!timepointsHistory.empty() && timepointsHistory.back() - timepointsHistory.front() > (MaxLiveHistory + 1.0f)) {
+        timepointsHistory.popFront();
+        for (auto& data : datas) {
+            data.popFront();
+        }
+    }
+}
+
+void LiveStatistics::add(MonitorData const& newStatistics, float deltaTime)
+{
+    truncate();
+
+    timepoint += deltaTime;
+    timepointsHistory.add(timepoint);
+    auto sample = toStatisticsSample(newStatistics);
+    for (int i = 0; i < NumStatisticsSeries; ++i) {
+        datas[i].add(sample[i]);
+    }
+}
+
+StatisticsRollup::StatisticsRollup(uint64_t resolution_, size_t capacity)
+    : resolution(resolution_)
+    , timestepHistory(capacity)
+{
+    for (int i = 0; i < NumStatisticsSeries; ++i) {
+        mins[i] = RingBuffer<float>(capacity);
+        maxs[i] = RingBuffer<float>(capacity);
+        means[i] = RingBuffer<float>(capacity);
+    }
+}
+
+void StatisticsRollup::add(uint64_t timestep, StatisticsSample const& sample)
+{
+    auto interval = timestep / resolution;
+    if (_numSamples > 0 && interval != _currentInterval) {
+        flush();
+    }
+    if (_numSamples == 0) {
+        _currentInterval = interval;
+        _min = sample;
+        _max = sample;
+        _sum = sample;
+    } else {
+        for (int i = 0; i < NumStatisticsSeries; ++i) {
+            _min[i] = std::min(_min[i], sample[i]);
+            _max[i] = std::max(_max[i], sample[i]);
+            _sum[i] += sample[i];
+        }
+    }
+    ++_numSamples;
+}
+
+void StatisticsRollup::flush()
+{
+    timestepHistory.add(toFloat(_currentInterval * resolution));
+    for (int i = 0; i < NumStatisticsSeries; ++i) {
+        mins[i].add(_min[i]);
+        maxs[i].add(_max[i]);
+        means[i].add(_sum[i] / _numSamples);
+    }
+    _numSamples = 0;
+}
+
+LongtermStatistics::LongtermStatistics(size_t memoryCap)
+{
+    auto capacity = getCapacity(memoryCap);
+    for (auto const& resolution : Resolutions) {
+        rollups.emplace_back(resolution, capacity);
+    }
+}
+
+void LongtermStatistics::add(MonitorData const& newStatistics)
+{
+    //ignore repeated samples from a paused simulation
+    if (_lastTimestep && *_lastTimestep == newStatistics.timestep) {
+        return;
+    }
+    _lastTimestep = newStatistics.timestep;
+
+    auto sample = toStatisticsSample(newStatistics);
+    for (auto& rollup : rollups) {
+        rollup.add(newStatistics.timestep, sample);
+    }
+}
+
+StatisticsRollup const& LongtermStatistics::getBestRollup() const
+{
+    for (auto const& rollup : rollups) {
+        if (!rollup.timestepHistory.full()) {
+            return rollup;
+        }
+    }
+    return rollups.back();
+}
+
+size_t LongtermStatistics::getCapacity(size_t memoryCap)
+{
+    //each entry consists of a time step and min/max/mean for all series, stored twice by the ring buffers
+    auto bytesPerEntry = (1 + 3 * NumStatisticsSeries) * sizeof(float) * 2;
+    return std::max(size_t(1), memoryCap / (bytesPerEntry * Resolutions.size()));
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Base/RingBuffer.h"
+
+#include "Definitions.h"
+
+int constexpr NumStatisticsSeries = 15;  //cells, cells by colors (7x), connections, particles, tokens, created cells, successful attacks, failed attacks, muscle activities
+using StatisticsSample = std::array<float, NumStatisticsSeries>;
+
+struct LiveStatistics
+{
+    static float constexpr MaxLiveHistory = 120.0f;  //in seconds
+    static int constexpr MaxSamplesPerSecond = 240;
+
+    float timepoint = 0.0f;  //in seconds
+    float history = 10.0f;   //in seconds
+
+    RingBuffer<float> timepointsHistory;
+    std::array<RingBuffer<float>, NumStatisticsSeries> datas;
+
+    LiveStatistics();
+
+    void truncate();
+    void add(MonitorData const& statistics, float deltaTime);
+};
+
+//min/max/mean of all samples falling into consecutive time step intervals of fixed length
+struct StatisticsRollup
+{
+    uint64_t resolution = 0;  //in time steps
+
+    RingBuffer<float> timestepHistory;  //begin of each interval
+    std::array<RingBuffer<float>, NumStatisticsSeries> mins;
+    std::array<RingBuffer<float>, NumStatisticsSeries> maxs;
+    std::array<RingBuffer<float>, NumStatisticsSeries> means;
+
+    StatisticsRollup(uint64_t resolution, size_t capacity);
+
+    void add(uint64_t timestep, StatisticsSample const& sample);
+
+private:
+    void flush();
+
+    uint64_t _currentInterval = 0;
+    int _numSamples = 0;
+    StatisticsSample _min;
+    StatisticsSample _max;
+    StatisticsSample _sum;
+};
+
+//round-robin store with rollups per 10, 100 and 1000 time steps, bounded by a memory cap
+struct LongtermStatistics
+{
+    static std::array<uint64_t, 3> constexpr Resolutions = {10, 100, 1000};
+    static size_t constexpr DefaultMemoryCap = 16 * 1024 * 1024;  //in bytes
+
+    std::vector<StatisticsRollup> rollups;
+
+    LongtermStatistics(size_t memoryCap = DefaultMemoryCap);
+
+    void add(MonitorData const& statistics);
+
+    //finest rollup which still contains the whole history, or the coarsest rollup if all have wrapped around
+    StatisticsRollup const& getBestRollup() const;
+
+    static size_t getCapacity(size_t memoryCap);
+
+private:
+    std::optional<uint64_t> _lastTimestep;
+};
+
+StatisticsSample toStatisticsSample(MonitorData const& statistics);
@@ -0,0 +1,77 @@
+#include "SymbolTable.h"
+
+SymbolTable::SymbolTable(SymbolMap const& symbols)
+{
+    _trie.emplace_back();
+
+    //symbol map is ordered by names
+    for (auto const& [name, value] : symbols) {
+        _valueByName.emplace(name, value);
+        _lastNameByValue.insert_or_assign(value, name);
+
+        auto pos = name.find(':');
+        if (pos == std::string::npos) {
+            continue;
+        }
+        int nodeIndex = 0;
+        for (size_t i = 0; i < pos; ++i) {
+            auto findResult = _trie[nodeIndex].childIndexByChar.find(name[i]);
+            if (findResult != _trie[nodeIndex].childIndexByChar.end()) {
+                nodeIndex = findResult->second;
+            } else {
+                auto childIndex = static_cast<int>(_trie.size());
+                _trie[nodeIndex].childIndexByChar.emplace(name[i], childIndex);
+                _trie.emplace_back();
+                nodeIndex = childIndex;
+            }
+        }
+        _trie[nodeIndex].firstNameByValue.emplace(value, name);
+    }
+}
+
+std::string const* SymbolTable::findValue(std::string const& name) const
+{
+    auto findResult = _valueByName.find(name);
+    return findResult != _valueByName.end() ? &findResult->second : nullptr;
+}
+
+std::string const* SymbolTable::findName(std::string const& value) const
+{
+    auto findResult = _lastNameByValue.find(value);
+    return findResult != _lastNameByValue.end() ? &findResult->second : nullptr;
+}
+
+std::string const* SymbolTable::findConstantName(std::string const& operandName, std::string const& value) const
+{
+    std::string const* result = nullptr;
+    auto updateResult = [&](std::string const* candidate) {
+        if (!result || *candidate < *result) {
+            result = candidate;
+        }
+    };
+
+    if (auto candidateValue = findValue(operandName)) {
+        if (*candidateValue == value) {
+            updateResult(&_valueByName.find(operandName)->first);
+        }
+    }
+
+    //walk along the operand name and collect the matches of all prefixes
+    int nodeIndex = 0;
+    for (size_t i = 0;; ++i) {
+        auto const& node = _trie[nodeIndex];
+        auto findResult = node.firstNameByValue.find(value);
+        if (findResult != node.firstNameByValue.end()) {
+            updateResult(&findResult->second);
+        }
+        if (i == operandName.size()) {
+            break;
+        }
+        auto childFindResult = node.childIndexByChar.find(operandName[i]);
+        if (childFindResult == node.childIndexByChar.end()) {
+            break;
+        }
+        nodeIndex = childFindResult->second;
+    }
+    return result;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "SymbolMap.h"
+
+//hashed lookup structure of a symbol map for compiling and decompiling cell programs:
+//names of the form "PREFIX::NAME" are stored in a trie over PREFIX so that the constant names matching an operand
+//are found without scanning the whole symbol map
+class SymbolTable
+{
+public:
+    SymbolTable(SymbolMap const& symbols);
+
+    //nullptr if not found
+    std::string const* findValue(std::string const& name) const;
+
+    //alphabetically last name with the given value, nullptr if not found
+    std::string const* findName(std::string const& value) const;
+
+    //alphabetically first name with the given value which either equals the operand name or whose prefix before ':'
+    //is a prefix of the operand name, nullptr if not found
+    std::string const* findConstantName(std::string const& operandName, std::string const& value) const;
+
+private:
+    struct TrieNode
+    {
+        std::unordered_map<char, int> childIndexByChar;
+        std::unordered_map<std::string, std::string> firstNameByValue;
+    };
+
+    std::unordered_map<std::string, std::string> _valueByName;
+    std::unordered_map<std::string, std::string> _lastNameByValue;
+    std::vector<TrieNode> _trie;  //root at index 0
+};
@@ -0,0 +1,73 @@
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/CellComputationCompiler.h"
+
+class CellComputationCompilerTests : public ::testing::Test
+{
+protected:
+    SymbolMap _symbols = SymbolMapHelper::getDefaultSymbolMap();
+    SimulationParameters _parameters;
+};
+
+TEST_F(CellComputationCompilerTests, decompileUsesSymbolNames)
+{
+    auto compilationResult = CellComputationCompiler::compileSourceCode(
+        "mov SCANNER_OUT, SCANNER_OUT::SUCCESS\nif CONSTR_IN_OPTION = CONSTR_IN::CONSTRUCT\nadd (3), i\nendif", _symbols, _parameters);
+    ASSERT_TRUE(compilationResult.compilationOk);
+
+    //addresses are named by the alphabetically last symbol, constants by the first symbol whose prefix matches the operand
+    EXPECT_EQ(
+        "mov [0x5], 0x0      # mov SENSOR_OUT, SENSOR_OUT::NOTHING_FOUND\n"
+        "if [0x7] = 0x1      # if CONSTR_IN_OPTION = CONSTR_IN::CONSTRUCT\n"
+        "  add (0x3), [0xff]     #   add (3), i\n"
+        "endif",
+        CellComputationCompiler::decompileSourceCode(compilationResult.compilation, _symbols, _parameters));
+}
+
+TEST_F(CellComputationCompilerTests, cachedResultsMatchFirstResults)
+{
+    std::vector<std::string> const lines = {
+        "mov [1], 3", "add i, j", "if SCANNER_OUT = SCANNER_OUT::FINISHED", "else", "endif", "xor (2), [[0x10]]", "mul k", "# comment"};
+    std::mt19937 randomEngine(42);
+    std::vector<std::string> codes;
+    for (int i = 0; i < 1000; ++i) {
+        std::string code;
+        for (int j = 0; j < 6; ++j) {
+            code += lines[randomEngine() % 3 + (i % 5)] + "\n";
+        }
+        codes.emplace_back(code);
+    }
+
+    std::vector<CompilationResult> compilationResults;
+    std::vector<std::string> decompilations;
+    for (auto const& code : codes) {
+        compilationResults.emplace_back(CellComputationCompiler::compileSourceCode(code, _symbols, _parameters));
+        decompilations.emplace_back(CellComputationCompiler::decompileSourceCode(compilationResults.back().compilation, _symbols, _parameters));
+    }
+    for (size_t i = 0; i < codes.size(); ++i) {
+        auto compilationResult = CellComputationCompiler::compileSourceCode(codes[i], _symbols, _parameters);
+        EXPECT_EQ(compilationResults[i].compilationOk, compilationResult.compilationOk);
+        EXPECT_EQ(compilationResults[i].lineOfFirstError, compilationResult.lineOfFirstError);
+        EXPECT_EQ(compilationResults[i].compilation, compilationResult.compilation);
+        EXPECT_EQ(decompilations[i], CellComputationCompiler::decompileSourceCode(compilationResult.compilation, _symbols, _parameters));
+    }
+}
+
+TEST_F(CellComputationCompilerTests, cachedResultsDependOnSymbolsAndParameters)
+{
+    auto code = std::string("mov [255], MY_CONSTANT");
+    _symbols["MY_CONSTANT"] = "1";
+    EXPECT_EQ(std::string("\xff\x01", 2), CellComputationCompiler::compileSourceCode(code, _symbols, _parameters).compilation.substr(1));
+
+    _symbols["MY_CONSTANT"] = "2";
+    EXPECT_EQ(std::string("\xff\x02", 2), CellComputationCompiler::compileSourceCode(code, _symbols, _parameters).compilation.substr(1));
+
+    _parameters.cellFunctionComputerMaxInstructions = 0;
+    EXPECT_FALSE(CellComputationCompiler::compileSourceCode(code, _symbols, _parameters).compilationOk);
+
+    auto data = CellComputationCompiler::compileSourceCode(code, _symbols, SimulationParameters()).compilation;
+    _parameters.tokenMemorySize = 16;
+    EXPECT_EQ("mov [0xf], 0x2      # mov SCANNER_OUT_ANGLE, 2", CellComputationCompiler::decompileSourceCode(data, _symbols, _parameters));
+}
@@ -0,0 +1,117 @@
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "EngineGpuKernels/CellArrays.cuh"
+#include "EngineGpuKernels/HostCellProcessor.cuh"
+
+class CellLayoutTests : public ::testing::Test
+{
+protected:
+    int2 const WorldSize{100, 100};
+
+    template <typename CellStorage>
+    void initRandomCells(CellStorage& cells) const
+    {
+        std::mt19937 generator(0);
+        std::uniform_real_distribution<float> posDistribution(0.0f, 100.0f);
+        std::uniform_real_distribution<float> velDistribution(-1.0f, 1.0f);
+        for (int index = 0; index < cells.getNumCells(); ++index) {
+            auto cell = cells.getHandle(index);
+            cell.absPos() = {posDistribution(generator), posDistribution(generator)};
+            cell.vel() = {velDistribution(generator), velDistribution(generator)};
+            cell.temp1() = {0, 0};
+            cell.temp2() = {0, 0};
+            cell.barrier() = index % 50 == 0;
+            cell.numConnections() = 0;
+        }
+    }
+
+    template <typename CellStorage>
+    void runTimesteps(CellStorage& cells, int numTimesteps) const
+    {
+        HostCellProcessor<CellStorage> processor(WorldSize, SimulationParameters());
+        for (int i = 0; i < numTimesteps; ++i) {
+            processor.collisions(cells);
+            processor.verletUpdatePositions(cells);
+        }
+    }
+};
+
+TEST_F(CellLayoutTests, structureOfArraysMatchesArrayOfStructures)
+{
+    HostCellArrays cellArrays(5000);
+    HostCellRecords cellRecords(5000);
+    initRandomCells(cellArrays);
+    initRandomCells(cellRecords);
+
+    runTimesteps(cellArrays, 10);
+    runTimesteps(cellRecords, 10);
+
+    for (int index = 0; index < 5000; ++index) {
+        auto cell = cellArrays.getHandle(index);
+        auto record = cellRecords.getHandle(index);
+        EXPECT_EQ(record.absPos().x, cell.absPos().x);
+        EXPECT_EQ(record.absPos().y, cell.absPos().y);
+        EXPECT_EQ(record.temp2().x, cell.temp2().x);
+        EXPECT_EQ(record.temp2().y, cell.temp2().y);
+    }
+}
+
+TEST_F(CellLayoutTests, collisionRepelsCellsAcrossWorldBoundary)
+{
+    HostCellArrays cells(2);
+    initRandomCells(cells);
+    cells.getHandle(0).absPos() = {99.8f, 50.0f};
+    cells.getHandle(1).absPos() = {0.2f, 50.0f};
+    cells.getHandle(0).vel() = {0, 0};
+    cells.getHandle(1).vel() = {0, 0};
+
+    HostCellProcessor<HostCellArrays> processor(WorldSize, SimulationParameters());
+    processor.collisions(cells);
+
+    EXPECT_LT(cells.getHandle(0).temp1().x, 0);
+    EXPECT_GT(cells.getHandle(1).temp1().x, 0);
+    EXPECT_FLOAT_EQ(0, cells.getHandle(0).temp1().x + cells.getHandle(1).temp1().x);
+}
+
+TEST_F(CellLayoutTests, connectedCellsDoNotCollide)
+{
+    HostCellArrays cells(2);
+    initRandomCells(cells);
+    cells.getHandle(0).absPos() = {50.0f, 50.0f};
+    cells.getHandle(1).absPos() = {50.5f, 50.0f};
+    for (int index = 0; index < 2; ++index) {
+        auto cell = cells.getHandle(index);
+        cell.vel() = {0, 0};
+        cell.numConnections() = 1;
+        cell.connection(0) = {1 - index, 0.5f, 0};
+    }
+
+    HostCellProcessor<HostCellArrays> processor(WorldSize, SimulationParameters());
+    processor.collisions(cells);
+
+    EXPECT_EQ(0, cells.getHandle(0).temp1().x);
+    EXPECT_EQ(0, cells.getHandle(1).temp1().x);
+}
+
+TEST_F(CellLayoutTests, parallelCollisionsMatchSerialCollisions)
+{
+    for (auto numThreads : {1, 4}) {
+        HostCellArrays serialCells(5000);
+        HostCellArrays parallelCells(5000);
+        initRandomCells(serialCells);
+        initRandomCells(parallelCells);
+
+        HostCellProcessor<HostCellArrays> processor(WorldSize, SimulationParameters());
+        processor.collisions(serialCells);
+        processor.collisions(parallelCells, numThreads);
+
+        for (int index = 0; index < 5000; ++index) {
+            auto serialForce = serialCells.getHandle(index).temp1();
+            auto parallelForce = parallelCells.getHandle(index).temp1();
+            EXPECT_NEAR(serialForce.x, parallelForce.x, 1e-4f);
+            EXPECT_NEAR(serialForce.y, parallelForce.y, 1e-4f);
+        }
+    }
+}
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/NumberGenerator.h"
+#include "EngineGpuKernels/HostCellList.cuh"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SimulationController.h"
+#include "IntegrationTestFramework.h"
+
+class CellListTests : public ::testing::Test
+{
+protected:
+    int2 const WorldSize{100, 100};
+
+    std::vector<int> sorted(std::vector<int> values) const
+    {
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+};
+
+TEST_F(CellListTests, denseUnitSquareKeepsAllCells)
+{
+    std::vector<float2> positions;
+    for (int i = 0; i < 50; ++i) {
+        positions.emplace_back(float2{10.0f + toFloat(i) / 50, 20.5f});
+    }
+    positions.emplace_back(float2{30.0f, 30.0f});
+
+    HostCellList cellList(WorldSize);
+    cellList.build(positions);
+
+    std::vector<int> result;
+    cellList.get(result, {10.5f, 20.5f});
+    EXPECT_EQ(50, result.size());
+
+    cellList.get(result, {10.5f, 20.5f}, 0.31f);
+    for (auto const& index : result) {
+        EXPECT_LE(std::abs(positions.at(index).x - 10.5f), 0.31f);
+    }
+    EXPECT_EQ(31, result.size());
+
+    auto first = cellList.getFirst({10.9f, 20.1f});
+    ASSERT_NE(-1, first);
+    EXPECT_LT(first, 50);
+    EXPECT_EQ(-1, cellList.getFirst({50.0f, 50.0f}));
+}
+
+TEST_F(CellListTests, radiusQueryMatchesBruteForce)
+{
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> posDistribution(5.0f, 95.0f);
+    std::normal_distribution<float> clumpDistribution(0.0f, 0.5f);
+    std::vector<float2> positions;
+    for (int i = 0; i < 5000; ++i) {
+        positions.emplace_back(float2{posDistribution(generator), posDistribution(generator)});
+    }
+    for (int i = 0; i < 5000; ++i) {
+        positions.emplace_back(float2{50.0f + clumpDistribution(generator), 50.0f + clumpDistribution(generator)});
+    }
+
+    HostCellList cellList(WorldSize);
+    cellList.build(positions);
+
+    std::vector<int> result;
+    for (int i = 0; i < 200; ++i) {
+        float2 pos{posDistribution(generator), posDistribution(generator)};
+        if (i % 2 == 0) {
+            pos = {50.0f + clumpDistribution(generator), 50.0f + clumpDistribution(generator)};
+        }
+        std::vector<int> expected;
+        for (int index = 0; index < toInt(positions.size()); ++index) {
+            auto const& otherPos = positions.at(index);
+            if (std::sqrt((otherPos.x - pos.x) * (otherPos.x - pos.x) + (otherPos.y - pos.y) * (otherPos.y - pos.y)) <= 1.6f) {
+                expected.emplace_back(index);
+            }
+        }
+        cellList.get(result, pos, 1.6f);
+        EXPECT_EQ(expected, sorted(result));
+    }
+}
+
+TEST_F(CellListTests, neighborhoodWrapsAroundWorldBoundary)
+{
+    HostCellList cellList(WorldSize);
+    cellList.build({{99.5f, 50.5f}, {0.5f, 50.5f}, {50.0f, 50.0f}});
+
+    std::vector<int> result;
+    cellList.get(result, {0.2f, 50.2f});
+    EXPECT_EQ(std::vector<int>({0, 1}), sorted(result));
+}
+
+TEST_F(CellListTests, memoryIsProportionalToNumberOfCells)
+{
+    int2 worldSize{6000, 3000};
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> xDistribution(0.0f, 6000.0f);
+    std::uniform_real_distribution<float> yDistribution(0.0f, 3000.0f);
+    std::vector<float2> positions;
+    for (int i = 0; i < 100000; ++i) {
+        positions.emplace_back(float2{xDistribution(generator), yDistribution(generator)});
+    }
+
+    HostCellList cellList(worldSize);
+    cellList.build(positions);
+
+    auto twoSlotMapMemory = sizeof(void*) * worldSize.x * worldSize.y * 2;
+    EXPECT_LT(cellList.getMemorySize() * 50, twoSlotMapMemory);
+    EXPECT_NE(-1, cellList.getFirst(positions.front()));
+}
+
+//the cell map of the engine is observed by the collisions of unconnected cells
+class CellMapEngineTests : public IntegrationTestFramework
+{
+public:
+    CellMapEngineTests()
+        : IntegrationTestFramework({100, 100})
+    {}
+
+protected:
+    void SetUp() override
+    {
+        auto parameters = _simController->getSimulationParameters();
+        parameters.radiationProb = 0;
+        parameters.spotValues.tokenMutationRate = 0;
+        parameters.spotValues.cellMutationRate = 0;
+        _simController->setSimulationParameters_async(parameters);
+    }
+
+    CellDescription createCell(RealVector2D const& pos) const
+    {
+        return CellDescription().setId(NumberGenerator::getInstance().getId()).setPos(pos).setEnergy(100).setMaxConnections(0);
+    }
+};
+
+TEST_F(CellMapEngineTests, allCellsOfDenseUnitSquareCollide)
+{
+    DataDescription data;
+    for (int i = 0; i < 8; ++i) {
+        data.addCell(createCell({50.1f + toFloat(i) * 0.1f, 50.5f}));
+    }
+    _simController->setSimulationData(data);
+    _simController->calcSingleTimestep();
+
+    //the previous map held at most two cells per unit square, hence the others were not repelled
+    auto result = _simController->getSimulationData();
+    ASSERT_EQ(8, result.cells.size());
+    for (auto const& cell : result.cells) {
+        EXPECT_NE(0.0f, cell.vel.x);
+    }
+}
+
+TEST_F(CellMapEngineTests, cellsCollideAcrossWorldBoundary)
+{
+    DataDescription data;
+    auto leftCell = createCell({0.2f, 50.5f});
+    auto rightCell = createCell({99.8f, 50.5f});
+    data.addCell(leftCell);
+    data.addCell(rightCell);
+    _simController->setSimulationData(data);
+    _simController->calcSingleTimestep();
+
+    auto cellById = getCellById(_simController->getSimulationData());
+    EXPECT_GT(cellById.at(leftCell.id).vel.x, 0.0f);
+    EXPECT_LT(cellById.at(rightCell.id).vel.x, 0.0f);
+}
@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/ClusterHasher.h"
+
+class ClusterHasherTests : public ::testing::Test
+{
+protected:
+    //cells with ids startId, startId + 1, ... connected by the given index pairs
+    ClusterDescription createCluster(int numCells, std::vector<std::pair<int, int>> const& bonds, uint64_t startId = 1) const
+    {
+        ClusterDescription result;
+        for (int i = 0; i < numCells; ++i) {
+            auto angle = toFloat(i) * 2.0f * 3.14159f / toFloat(numCells);
+            result.addCell(CellDescription()
+                               .setId(startId + i)
+                               .setPos({std::cos(angle) * 5.0f, std::sin(angle) * 5.0f})
+                               .setMaxConnections(4)
+                               .setFlagTokenBlocked(false)
+                               .setTokenBranchNumber(i % 3)
+                               .setCellFeature(CellFeatureDescription().setType(Enums::CellFunction_Computation)));
+        }
+        for (auto const& [index1, index2] : bonds) {
+            result.cells.at(index1).connections.emplace_back(ConnectionDescription{startId + index2, 1.0f, 0});
+            result.cells.at(index2).connections.emplace_back(ConnectionDescription{startId + index1, 1.0f, 0});
+        }
+        return result;
+    }
+
+    //rotated and translated copy with new ids and shuffled cell order
+    ClusterDescription createRelabelledCopy(ClusterDescription const& cluster, float angle, uint64_t idOffset) const
+    {
+        auto result = cluster;
+        for (auto& cell : result.cells) {
+            cell.id += idOffset;
+            cell.pos = {
+                std::cos(angle) * cell.pos.x - std::sin(angle) * cell.pos.y + 100.0f,
+                std::sin(angle) * cell.pos.x + std::cos(angle) * cell.pos.y + 50.0f};
+            for (auto& connection : cell.connections) {
+                connection.cellId += idOffset;
+            }
+            std::reverse(cell.connections.begin(), cell.connections.end());
+        }
+        std::shuffle(result.cells.begin(), result.cells.end(), std::mt19937(7));
+        return result;
+    }
+
+    std::vector<std::pair<int, int>> createRingBonds(int numCells, int offset = 0) const
+    {
+        std::vector<std::pair<int, int>> result;
+        for (int i = 0; i < numCells; ++i) {
+            result.emplace_back(offset + i, offset + (i + 1) % numCells);
+        }
+        return result;
+    }
+};
+
+TEST_F(ClusterHasherTests, rotatedAndRelabelledCopyHasSameHash)
+{
+    auto cluster = createCluster(8, {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}, {5, 6}, {6, 7}, {2, 6}, {1, 5}});
+    auto copy = createRelabelledCopy(cluster, 1.3f, 1000);
+
+    EXPECT_EQ(ClusterHasher::calcHash(cluster), ClusterHasher::calcHash(copy));
+    EXPECT_TRUE(ClusterHasher::isEquivalent(cluster, copy));
+}
+
+TEST_F(ClusterHasherTests, differentFeaturesYieldDifferentHashes)
+{
+    auto cluster = createCluster(6, createRingBonds(6));
+    auto otherCluster = cluster;
+    otherCluster.cells.at(3).tokenBranchNumber = 5;
+
+    EXPECT_NE(ClusterHasher::calcHash(cluster), ClusterHasher::calcHash(otherCluster));
+    EXPECT_FALSE(ClusterHasher::isEquivalent(cluster, otherCluster));
+}
+
+TEST_F(ClusterHasherTests, differentBondsYieldDifferentHashes)
+{
+    auto chain = createCluster(5, {{0, 1}, {1, 2}, {2, 3}, {3, 4}});
+    auto star = createCluster(5, {{0, 1}, {0, 2}, {0, 3}, {0, 4}});
+    EXPECT_NE(ClusterHasher::calcHash(chain), ClusterHasher::calcHash(star));
+}
+
+TEST_F(ClusterHasherTests, hashCollisionIsResolvedByVerification)
+{
+    //a ring of 6 cells and two rings of 3 cells cannot be distinguished by color refinement
+    auto clusterWithOneRing = createCluster(6, createRingBonds(6));
+    auto twoRingBonds = createRingBonds(3);
+    for (auto const& bond : createRingBonds(3, 3)) {
+        twoRingBonds.emplace_back(bond);
+    }
+    auto clusterWithTwoRings = createCluster(6, twoRingBonds);
+    for (auto& cluster : {&clusterWithOneRing, &clusterWithTwoRings}) {
+        for (auto& cell : cluster->cells) {
+            cell.tokenBranchNumber = 0;
+        }
+    }
+
+    EXPECT_EQ(ClusterHasher::calcHash(clusterWithOneRing), ClusterHasher::calcHash(clusterWithTwoRings));
+    EXPECT_FALSE(ClusterHasher::isEquivalent(clusterWithOneRing, clusterWithTwoRings));
+    EXPECT_TRUE(ClusterHasher::isEquivalent(clusterWithOneRing, createRelabelledCopy(clusterWithOneRing, 0.5f, 100)));
+}
+
+TEST_F(ClusterHasherTests, parallelHashesMatchSequentialHashes)
+{
+    std::vector<ClusterDescription> clusters;
+    for (int i = 0; i < 1000; ++i) {
+        clusters.emplace_back(createCluster(3 + i % 7, createRingBonds(3 + i % 7), i * 100));
+    }
+    auto hashes = ClusterHasher::calcHashes(clusters);
+    auto structures = ClusterHasher::calcStructures(clusters);
+    ASSERT_EQ(clusters.size(), hashes.size());
+    ASSERT_EQ(clusters.size(), structures.size());
+    for (size_t i = 0; i < clusters.size(); ++i) {
+        EXPECT_EQ(ClusterHasher::calcHash(clusters.at(i)), hashes.at(i));
+        EXPECT_EQ(hashes.at(i), structures.at(i).hash);
+    }
+    EXPECT_EQ(hashes.at(0), hashes.at(7));
+    EXPECT_TRUE(ClusterHasher::isEquivalent(structures.at(0), structures.at(7)));
+}
+
+TEST_F(ClusterHasherTests, precomputedStructuresGiveSameResult)
+{
+    auto cluster = createCluster(6, createRingBonds(6));
+    auto structure = ClusterHasher::calcStructure(cluster);
+    EXPECT_EQ(ClusterHasher::calcHash(cluster), structure.hash);
+
+    auto copyStructure = ClusterHasher::calcStructure(createRelabelledCopy(cluster, 1.0f, 50));
+    auto chainStructure = ClusterHasher::calcStructure(createCluster(6, {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}}));
+    EXPECT_TRUE(ClusterHasher::isEquivalent(structure, copyStructure));
+    EXPECT_FALSE(ClusterHasher::isEquivalent(structure, chainStructure));
+}
@@ -0,0 +1,174 @@
+#include <atomic>
+
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/ThreadPool.h"
+#include "EngineGpuKernels/HostConstructionReservations.cuh"
+#include "EngineInterface/DescriptionHelper.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SimulationController.h"
+#include "IntegrationTestFramework.h"
+
+class ConstructionReservationTests : public ::testing::Test
+{
+protected:
+    void TearDown() override { ThreadPool::getInstance().setNumThreads(0); }
+
+    //replicator colony on a ring: each constructor modifies its own cell and the neighboring cells
+    HostConstructionRequest createRingRequest(int index, int numConstructors) const
+    {
+        return HostConstructionRequest{
+            calcConstructionPriority(index + 1),
+            {(index + numConstructors - 1) % numConstructors, index, (index + 1) % numConstructors}};
+    }
+
+    //round in which each construction is executed
+    std::vector<int> executeRing(int numConstructors)
+    {
+        std::vector<std::atomic<int>> numEvaluations(numConstructors);
+        HostConstructionReservations reservations;
+        reservations.executeConstructions(
+            numConstructors,
+            [&](int index) {
+                ++numEvaluations[index];
+                return createRingRequest(index, numConstructors);
+            },
+            [](int) {});
+
+        std::vector<int> result;
+        for (auto const& value : numEvaluations) {
+            result.emplace_back(value.load());
+        }
+        return result;
+    }
+};
+
+TEST_F(ConstructionReservationTests, conflictsAreResolvedByPriority)
+{
+    std::vector<HostConstructionRequest> requests = {{5, {0, 1}}, {2, {1, 2}}, {9, {2, 3}}, {7, {10}}};
+    std::vector<int> rounds(requests.size(), 0);
+
+    HostConstructionReservations reservations;
+    auto numRounds = reservations.executeConstructions(
+        toInt(requests.size()),
+        [&](int index) {
+            ++rounds.at(index);
+            return requests.at(index);
+        },
+        [](int) {});
+
+    EXPECT_EQ(2, numRounds);
+    EXPECT_EQ((std::vector<int>{2, 1, 2, 1}), rounds);
+}
+
+TEST_F(ConstructionReservationTests, tiesAreResolvedByRequestIndex)
+{
+    std::vector<int> order;
+    HostConstructionReservations reservations;
+    auto numRounds = reservations.executeConstructions(
+        3, [](int) { return HostConstructionRequest{1, {4}}; }, [&](int index) { order.emplace_back(index); });
+
+    EXPECT_EQ(3, numRounds);
+    EXPECT_EQ((std::vector<int>{0, 1, 2}), order);
+}
+
+TEST_F(ConstructionReservationTests, replicatorThroughputPer1000Steps)
+{
+    ThreadPool::getInstance().setNumThreads(4);
+    auto const NumConstructors = 1000;
+    auto const NumSteps = 1000;
+
+    std::vector<std::atomic<int>> cellsInUse(NumConstructors);
+    std::atomic<int> numConstructions = 0;
+    std::atomic<int> numConflicts = 0;
+    int numRounds = 0;
+    HostConstructionReservations reservations;
+    for (int step = 0; step < NumSteps; ++step) {
+        numRounds += reservations.executeConstructions(
+            NumConstructors,
+            [&](int index) { return createRingRequest(index, NumConstructors); },
+            [&](int index) {
+                auto request = createRingRequest(index, NumConstructors);
+                for (auto const& cellIndex : request.cellIndices) {
+                    if (cellsInUse[cellIndex].exchange(1) != 0) {
+                        ++numConflicts;
+                    }
+                }
+                ++numConstructions;
+                for (auto const& cellIndex : request.cellIndices) {
+                    cellsInUse[cellIndex] = 0;
+                }
+            });
+    }
+
+    //every construction succeeds and granted constructions never overlap
+    EXPECT_EQ(NumConstructors * NumSteps, numConstructions.load());
+    EXPECT_EQ(0, numConflicts.load());
+    EXPECT_GE(NumSteps * 16, numRounds);
+}
+
+TEST_F(ConstructionReservationTests, roundsAreIndependentOfNumberOfThreads)
+{
+    ThreadPool::getInstance().setNumThreads(1);
+    auto expected = executeRing(5000);
+
+    ThreadPool::getInstance().setNumThreads(8);
+    EXPECT_EQ(expected, executeRing(5000));
+}
+
+class ConstructionReservationEngineTests : public IntegrationTestFramework
+{
+public:
+    ConstructionReservationEngineTests()
+        : IntegrationTestFramework({1000, 1000})
+    {}
+
+protected:
+    void SetUp() override
+    {
+        auto parameters = _simController->getSimulationParameters();
+        parameters.radiationProb = 0;
+        parameters.spotValues.tokenMutationRate = 0;
+        parameters.spotValues.cellMutationRate = 0;
+        parameters.cellFunctionConstructorTokenDataMutationProb = 0;
+        parameters.cellFunctionConstructorCellDataMutationProb = 0;
+        parameters.cellFunctionConstructorCellPropertyMutationProb = 0;
+        parameters.cellFunctionConstructorCellStructureMutationProb = 0;
+        _simController->setSimulationParameters_async(parameters);
+    }
+};
+
+TEST_F(ConstructionReservationEngineTests, overlappingConstructionsSucceedInOneStep)
+{
+    //lower row: cells passing a construct token each, upper row: constructors whose construction sites overlap with
+    //those of their neighbors
+    auto const NumConstructors = 50;
+    auto data = DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(NumConstructors).height(2).center({500, 500}));
+    std::vector<uint64_t> constructorIds;
+    for (auto& cell : data.cells) {
+        if (cell.pos.y < 500) {
+            auto token = createSimpleToken();
+            token.energy = 1000;
+            token.data[Enums::Constr_Input] = Enums::ConstrIn_Construct;
+            token.data[Enums::Constr_InOption] = Enums::ConstrInOption_Standard;
+            cell.tokenBranchNumber = 0;
+            cell.addToken(token);
+        } else {
+            cell.tokenBranchNumber = 1;
+            cell.cellFeature = CellFeatureDescription().setType(Enums::CellFunction_Constructor);
+            constructorIds.emplace_back(cell.id);
+        }
+    }
+    _simController->setSimulationData(data);
+    _simController->calcSingleTimestep();
+
+    auto result = _simController->getSimulationData();
+    EXPECT_EQ(NumConstructors * 3, result.cells.size());
+    auto cellById = getCellById(result);
+    for (auto const& constructorId : constructorIds) {
+        auto const& constructor = cellById.at(constructorId);
+        ASSERT_EQ(1, constructor.tokens.size());
+        EXPECT_EQ(Enums::ConstrOut_Success, constructor.tokens.at(0).data[Enums::Constr_Output]);
+    }
+}
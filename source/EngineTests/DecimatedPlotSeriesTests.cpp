@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "EngineInterface/DecimatedPlotSeries.h"
+
+class DecimatedPlotSeriesTests : public ::testing::Test
+{
+protected:
+    void addRandomWalk(RingBuffer<float>& xs, RingBuffer<float>& ys, int numSamples, std::mt19937& generator) const
+    {
+        std::normal_distribution<float> distribution(0.0f, 1.0f);
+        for (int i = 0; i < numSamples; ++i) {
+            auto x = xs.empty() ? 0.0f : xs.back() + 1.0f;
+            auto y = ys.empty() ? 0.0f : ys.back() + distribution(generator);
+            xs.add(x);
+            ys.add(y);
+        }
+    }
+
+    //x = sample number, buckets are aligned to the sample numbers
+    void checkEnvelope(DecimatedPlotSeries const& series, RingBuffer<float> const& xs, RingBuffer<float> const& ys) const
+    {
+        auto begin = toInt(ys.numRemoved());
+        auto end = begin + toInt(ys.size());
+        ASSERT_LT(0, series.getSize());
+        EXPECT_EQ(xs.front(), series.getXs()[0]);
+        EXPECT_EQ(xs.back(), series.getXs()[series.getSize() - 1]);
+        for (int i = 0; i < series.getSize(); ++i) {
+            auto index = toInt(series.getXs()[i]) - begin;
+            EXPECT_EQ(ys[index], series.getYs()[i]);
+            if (i > 0) {
+                EXPECT_LT(series.getXs()[i - 1], series.getXs()[i]);
+            }
+        }
+
+        auto bucketWidth = toInt(series.getBucketWidth());
+        for (int bucketBegin = begin / bucketWidth * bucketWidth; bucketBegin < end; bucketBegin += bucketWidth) {
+            auto first = std::max(bucketBegin, begin) - begin;
+            auto last = std::min(bucketBegin + bucketWidth, end) - begin;
+            auto minValue = *std::min_element(ys.begin() + first, ys.begin() + last);
+            auto maxValue = *std::max_element(ys.begin() + first, ys.begin() + last);
+
+            std::vector<float> emittedValues;
+            for (int i = 0; i < series.getSize(); ++i) {
+                auto index = toInt(series.getXs()[i]) - begin;
+                if (index >= first && index < last) {
+                    emittedValues.emplace_back(series.getYs()[i]);
+                }
+            }
+            ASSERT_FALSE(emittedValues.empty());
+            EXPECT_EQ(minValue, *std::min_element(emittedValues.begin(), emittedValues.end()));
+            EXPECT_EQ(maxValue, *std::max_element(emittedValues.begin(), emittedValues.end()));
+        }
+        EXPECT_EQ(*std::min_element(ys.begin(), ys.end()), series.getMin());
+        EXPECT_EQ(*std::max_element(ys.begin(), ys.end()), series.getMax());
+    }
+};
+
+TEST_F(DecimatedPlotSeriesTests, envelopeOfEachBucketIsKept)
+{
+    int const NumSamples = 100000;
+    int const NumPixels = 500;
+    std::mt19937 generator(0);
+    RingBuffer<float> xs(NumSamples);
+    RingBuffer<float> ys(NumSamples);
+    addRandomWalk(xs, ys, NumSamples, generator);
+
+    DecimatedPlotSeries series;
+    series.update(xs, ys, NumPixels);
+
+    auto bucketWidth = toInt(series.getBucketWidth());
+    auto numBuckets = (NumSamples + bucketWidth - 1) / bucketWidth;
+    EXPECT_GE(numBuckets, NumPixels);
+    EXPECT_LE(numBuckets, 4 * NumPixels);
+    EXPECT_LE(series.getSize(), 2 * numBuckets + 2);
+
+    checkEnvelope(series, xs, ys);
+}
+
+TEST_F(DecimatedPlotSeriesTests, envelopeIsKeptOnIncrementalUpdates)
+{
+    int const Capacity = 20000;
+    int const NumPixels = 300;
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<int> batchSizeDistribution(0, 500);
+    RingBuffer<float> xs(Capacity);
+    RingBuffer<float> ys(Capacity);
+
+    DecimatedPlotSeries series;
+    for (int i = 0; i < 200; ++i) {
+        addRandomWalk(xs, ys, batchSizeDistribution(generator), generator);
+        if (i % 3 == 0 && xs.size() > 100) {
+            for (int j = 0; j < 50; ++j) {
+                xs.popFront();
+                ys.popFront();
+            }
+        }
+        series.update(xs, ys, NumPixels);
+        if (!xs.empty()) {
+            checkEnvelope(series, xs, ys);
+        }
+    }
+    EXPECT_TRUE(xs.full());
+}
+
+TEST_F(DecimatedPlotSeriesTests, replacedBufferIsDetected)
+{
+    std::mt19937 generator(0);
+    RingBuffer<float> xs(1000);
+    RingBuffer<float> ys(1000);
+    addRandomWalk(xs, ys, 500, generator);
+
+    DecimatedPlotSeries series;
+    series.update(xs, ys, 100);
+
+    xs = RingBuffer<float>(1000);
+    ys = RingBuffer<float>(1000);
+    addRandomWalk(xs, ys, 600, generator);
+    series.update(xs, ys, 100);
+    checkEnvelope(series, xs, ys);
+}
@@ -0,0 +1,214 @@
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "Base/NumberGenerator.h"
+#include "Base/Philox.h"
+#include "EngineImpl/HostReplayHarness.h"
+#include "EngineImpl/ReplayHarness.h"
+#include "EngineInterface/SimulationController.h"
+#include "IntegrationTestFramework.h"
+
+class DeterminismTests : public ::testing::Test
+{
+protected:
+    int2 const WorldSize{100, 100};
+
+    void initRandomCells(HostCellArrays& cells, uint32_t seed) const
+    {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> posDistribution(0.0f, 100.0f);
+        std::uniform_real_distribution<float> velDistribution(-1.0f, 1.0f);
+        for (int index = 0; index < cells.getNumCells(); ++index) {
+            auto cell = cells.getHandle(index);
+            cell.id() = index + 1;
+            cell.absPos() = {posDistribution(generator), posDistribution(generator)};
+            cell.vel() = {velDistribution(generator), velDistribution(generator)};
+            cell.temp1() = {0, 0};
+            cell.temp2() = {0, 0};
+            cell.barrier() = false;
+            cell.numConnections() = 0;
+        }
+    }
+};
+
+TEST_F(DeterminismTests, philoxKnownAnswer)
+{
+    auto block = Philox::generate(0, 0, 0);
+    EXPECT_EQ(0x6627e8d5u, block.values[0]);
+    EXPECT_EQ(0xe169c58du, block.values[1]);
+    EXPECT_EQ(0xbc57ac4cu, block.values[2]);
+    EXPECT_EQ(0x9b00dbd8u, block.values[3]);
+}
+
+TEST_F(DeterminismTests, philoxDependsOnAllInputs)
+{
+    auto reference = Philox::generate(1, 2, 3, 4);
+    EXPECT_EQ(reference, Philox::generate(1, 2, 3, 4));
+    EXPECT_NE(reference, Philox::generate(5, 2, 3, 4));
+    EXPECT_NE(reference, Philox::generate(1, 5, 3, 4));
+    EXPECT_NE(reference, Philox::generate(1, 2, 5, 4));
+    EXPECT_NE(reference, Philox::generate(1, 2, 3, 5));
+
+    auto value = Philox::generateFloat(1, 2, 3, 4);
+    EXPECT_GE(value, 0.0f);
+    EXPECT_LT(value, 1.0f);
+}
+
+TEST_F(DeterminismTests, replayWithSameInitialStateMatches)
+{
+    HostCellArrays cells(2000);
+    initRandomCells(cells, 42);
+    HostReplayHarness harness(WorldSize, SimulationParameters(), 5);
+    auto hashes = harness.record(cells, 50);
+    ASSERT_EQ(11, hashes.size());
+
+    HostCellArrays replayedCells(2000);
+    initRandomCells(replayedCells, 42);
+    EXPECT_FALSE(harness.verify(replayedCells, hashes).has_value());
+}
+
+TEST_F(DeterminismTests, replayDetectsPerturbation)
+{
+    HostCellArrays cells(2000);
+    initRandomCells(cells, 42);
+    HostReplayHarness harness(WorldSize, SimulationParameters());
+    auto hashes = harness.record(cells, 20);
+
+    HostCellArrays replayedCells(2000);
+    initRandomCells(replayedCells, 42);
+    replayedCells.getHandle(7).vel().x += 1e-3f;
+    auto divergingTimestep = harness.verify(replayedCells, hashes);
+    ASSERT_TRUE(divergingTimestep.has_value());
+    EXPECT_EQ(0, *divergingTimestep);
+}
+
+TEST_F(DeterminismTests, replayDetectsDivergenceDuringRun)
+{
+    HostCellArrays cells(2000);
+    initRandomCells(cells, 42);
+    HostReplayHarness harness(WorldSize, SimulationParameters());
+    auto hashes = harness.record(cells, 20);
+
+    auto parameters = SimulationParameters();
+    parameters.cellRepulsionStrength *= 1.01f;
+    HostReplayHarness perturbedHarness(WorldSize, parameters);
+    HostCellArrays replayedCells(2000);
+    initRandomCells(replayedCells, 42);
+    auto divergingTimestep = perturbedHarness.verify(replayedCells, hashes);
+    ASSERT_TRUE(divergingTimestep.has_value());
+    EXPECT_GT(*divergingTimestep, 0);
+}
+
+TEST_F(DeterminismTests, hashIsIndependentOfCellOrder)
+{
+    HostCellArrays cells(100);
+    HostCellArrays reversedCells(100);
+    initRandomCells(cells, 1);
+    for (int index = 0; index < 100; ++index) {
+        auto cell = cells.getHandle(index);
+        auto reversedCell = reversedCells.getHandle(99 - index);
+        reversedCell.id() = cell.id();
+        reversedCell.absPos() = cell.absPos();
+        reversedCell.vel() = cell.vel();
+        reversedCell.numConnections() = 0;
+    }
+    EXPECT_EQ(HostReplayHarness::calcHash(cells), HostReplayHarness::calcHash(reversedCells));
+}
+
+TEST_F(DeterminismTests, engineHashIsIndependentOfEntityOrder)
+{
+    DataDescription data;
+    for (int i = 0; i < 10; ++i) {
+        data.addCell(CellDescription()
+                         .setId(i + 1)
+                         .setPos({toFloat(i), 2.0f})
+                         .setEnergy(100)
+                         .setTokens({TokenDescription().setEnergy(i).setData("a"), TokenDescription().setEnergy(1).setData("b")}));
+    }
+    data.cells.at(0).connections = {{2, 1.0f, 0}, {3, 1.0f, 180.0f}};
+    data.addParticle(ParticleDescription().setId(20).setPos({5.0f, 5.0f}).setEnergy(3));
+
+    auto reorderedData = data;
+    std::reverse(reorderedData.cells.begin(), reorderedData.cells.end());
+    for (auto& cell : reorderedData.cells) {
+        std::reverse(cell.tokens.begin(), cell.tokens.end());
+        std::reverse(cell.connections.begin(), cell.connections.end());
+    }
+    EXPECT_EQ(ReplayHarness::calcHash(data), ReplayHarness::calcHash(reorderedData));
+
+    auto changedData = data;
+    changedData.cells.at(3).tokens.at(1).data = "c";
+    EXPECT_NE(ReplayHarness::calcHash(data), ReplayHarness::calcHash(changedData));
+}
+
+TEST_F(DeterminismTests, seededNumberGeneratorIsReproducible)
+{
+    auto& numberGen = NumberGenerator::getInstance();
+    numberGen.setSeed(123);
+    std::vector<uint32_t> numbers;
+    for (int i = 0; i < 100; ++i) {
+        numbers.emplace_back(numberGen.getRandomInt());
+    }
+    auto id = numberGen.getId();
+
+    numberGen.setSeed(123);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(numbers.at(i), numberGen.getRandomInt());
+    }
+    EXPECT_EQ(id, numberGen.getId());
+}
+
+class ReplayHarnessEngineTests : public IntegrationTestFramework
+{
+public:
+    ReplayHarnessEngineTests()
+        : IntegrationTestFramework({100, 100})
+    {}
+
+protected:
+    DeserializedSimulation createSimulation() const
+    {
+        DeserializedSimulation result;
+        result.timestep = 10;
+        result.settings = _simController->getSettings();
+        result.settings.generalSettings.seed = 7;
+        result.symbolMap = _simController->getSymbolMap();
+        for (int i = 0; i < 20; ++i) {
+            result.content.addCluster(ClusterDescription().addCell(CellDescription()
+                                                                       .setId(i + 1)
+                                                                       .setPos({toFloat(i) * 4.0f + 10.0f, 50.0f})
+                                                                       .setVel({0.1f, 0})
+                                                                       .setEnergy(100)
+                                                                       .setMaxConnections(2)
+                                                                       .setTokens({createSimpleToken()})));
+        }
+        result.content.addParticle(ParticleDescription().setId(100).setPos({50.0f, 20.0f}).setVel({0, 0.2f}).setEnergy(1));
+        return result;
+    }
+};
+
+TEST_F(ReplayHarnessEngineTests, recordHashesEngineTimesteps)
+{
+    auto simulation = createSimulation();
+    ReplayHarness harness(_simController, 5);
+    auto hashes = harness.record(simulation, 20);
+
+    ASSERT_EQ(5, hashes.size());
+    EXPECT_EQ(30, _simController->getCurrentTimestep());
+    EXPECT_TRUE(_simController->getGeneralSettings().useSeed);
+    EXPECT_NE(hashes.at(0), hashes.at(1));
+}
+
+TEST_F(ReplayHarnessEngineTests, replayDetectsPerturbation)
+{
+    auto simulation = createSimulation();
+    ReplayHarness harness(_simController);
+    auto hashes = harness.record(simulation, 5);
+
+    auto perturbedSimulation = simulation;
+    perturbedSimulation.content.particles.at(0).vel.x += 1e-3f;
+    auto divergingTimestep = harness.verify(perturbedSimulation, hashes);
+    ASSERT_TRUE(divergingTimestep.has_value());
+    EXPECT_EQ(0, *divergingTimestep);
+}
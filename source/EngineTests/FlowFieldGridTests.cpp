@@ -0,0 +1,163 @@
+#include <cmath>
+#include <optional>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/NumberGenerator.h"
+#include "EngineGpuKernels/FlowFieldGrid.cuh"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SimulationController.h"
+#include "IntegrationTestFramework.h"
+
+namespace
+{
+    FlowFieldSettings createSettings()
+    {
+        FlowFieldSettings result;
+        result.active = true;
+        result.numCenters = 2;
+        result.centers[0].posX = 300.0f;
+        result.centers[0].posY = 400.0f;
+        result.centers[0].radius = 250.0f;
+        result.centers[0].strength = 0.05f;
+        result.centers[1].posX = 950.0f;
+        result.centers[1].posY = 30.0f;
+        result.centers[1].radius = 150.0f;
+        result.centers[1].strength = 0.02f;
+        result.centers[1].orientation = Orientation::CounterClockwise;
+        return result;
+    }
+}
+
+class FlowFieldGridTests : public ::testing::Test
+{
+protected:
+    int2 const WorldSize{1001, 801};
+    int const GridSpacing = 4;
+
+    float getDistance(float2 const& pos, FlowCenter const& center) const
+    {
+        auto dx = std::remainder(pos.x - center.posX, static_cast<float>(WorldSize.x));
+        auto dy = std::remainder(pos.y - center.posY, static_cast<float>(WorldSize.y));
+        return std::sqrt(dx * dx + dy * dy);
+    }
+
+    //bilinear interpolation error is bounded by the second derivatives of the velocity, which decay with distance^(-5/2)
+    //for the square root profile; the analytic field is not smooth at the centers and at the radii
+    std::optional<float> calcErrorBound(FlowFieldSettings const& settings, float2 const& pos) const
+    {
+        auto margin = toFloat(GridSpacing) * std::sqrt(2.0f) + 1.0f;  //grid cell diagonal plus finite difference step
+        float result = 0;
+        for (int i = 0; i < settings.numCenters; ++i) {
+            auto const& center = settings.centers[i];
+            auto distance = getDistance(pos, center);
+            if (distance < 2 * margin || std::abs(distance - center.radius) < margin) {
+                return std::nullopt;
+            }
+            if (distance < center.radius) {
+                result += toFloat(GridSpacing * GridSpacing) * center.strength * std::pow(distance - margin, -2.5f);
+            }
+        }
+        return result;
+    }
+};
+
+TEST_F(FlowFieldGridTests, gridNodesMatchAnalyticField)
+{
+    auto settings = createSettings();
+    HostFlowFieldGrid grid(WorldSize, GridSpacing);
+    grid.build(settings);
+
+    auto nodeDistanceX = toFloat(WorldSize.x) / toFloat((WorldSize.x + GridSpacing - 1) / GridSpacing);
+    auto nodeDistanceY = toFloat(WorldSize.y) / toFloat((WorldSize.y + GridSpacing - 1) / GridSpacing);
+    for (int y = 0; y < 20; ++y) {
+        for (int x = 0; x < 20; ++x) {
+            float2 pos{toFloat(x * 11) * nodeDistanceX, toFloat(y * 9) * nodeDistanceY};
+            auto expected = FlowFieldGrid::calcVelocity(settings, WorldSize, pos);
+            auto actual = grid.getVelocity(pos);
+            EXPECT_NEAR(expected.x, actual.x, 1e-6f);
+            EXPECT_NEAR(expected.y, actual.y, 1e-6f);
+        }
+    }
+}
+
+TEST_F(FlowFieldGridTests, interpolationErrorIsBounded)
+{
+    auto settings = createSettings();
+    HostFlowFieldGrid grid(WorldSize, GridSpacing);
+    grid.build(settings);
+
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> posXDistribution(0.0f, toFloat(WorldSize.x));
+    std::uniform_real_distribution<float> posYDistribution(0.0f, toFloat(WorldSize.y));
+    auto numCheckedPositions = 0;
+    for (int i = 0; i < 100000; ++i) {
+        float2 pos{posXDistribution(generator), posYDistribution(generator)};
+        auto errorBound = calcErrorBound(settings, pos);
+        if (!errorBound) {
+            continue;
+        }
+        auto expected = FlowFieldGrid::calcVelocity(settings, WorldSize, pos);
+        auto actual = grid.getVelocity(pos);
+        auto error = std::sqrt((expected.x - actual.x) * (expected.x - actual.x) + (expected.y - actual.y) * (expected.y - actual.y));
+        EXPECT_LE(error, *errorBound + 1e-6f);
+        ++numCheckedPositions;
+    }
+    EXPECT_GT(numCheckedPositions, 90000);
+}
+
+TEST_F(FlowFieldGridTests, interpolationWrapsAroundWorldBoundary)
+{
+    auto settings = createSettings();
+    HostFlowFieldGrid grid(WorldSize, GridSpacing);
+    grid.build(settings);
+
+    for (auto const& pos : {float2{1000.9f, 30.0f}, float2{950.0f, 800.8f}, float2{-0.3f, 20.0f}, float2{1001.2f, 40.0f}}) {
+        auto expected = FlowFieldGrid::calcVelocity(settings, WorldSize, pos);
+        auto actual = grid.getVelocity(pos);
+        EXPECT_NEAR(expected.x, actual.x, 1e-3f);
+        EXPECT_NEAR(expected.y, actual.y, 1e-3f);
+    }
+}
+
+//the engine samples the cached grid, the world size differs from the default to cover the grid initialization
+class FlowFieldEngineTests : public IntegrationTestFramework
+{
+public:
+    FlowFieldEngineTests()
+        : IntegrationTestFramework({1001, 801})
+    {}
+
+protected:
+    void SetUp() override
+    {
+        auto parameters = _simController->getSimulationParameters();
+        parameters.radiationProb = 0;
+        parameters.spotValues.friction = 0;
+        parameters.spotValues.tokenMutationRate = 0;
+        parameters.spotValues.cellMutationRate = 0;
+        _simController->setSimulationParameters_async(parameters);
+        _simController->setFlowFieldSettings_async(createSettings());
+    }
+};
+
+TEST_F(FlowFieldEngineTests, cellsAreDrivenByFlowField)
+{
+    std::vector<RealVector2D> positions{{200.0f, 400.0f}, {350.0f, 420.0f}, {1000.5f, 30.0f}, {950.0f, 790.0f}, {600.0f, 600.0f}};
+    DataDescription data;
+    for (auto const& pos : positions) {
+        data.addCell(CellDescription().setId(NumberGenerator::getInstance().getId()).setPos(pos).setEnergy(100).setMaxConnections(0));
+    }
+    _simController->setSimulationData(data);
+    _simController->calcSingleTimestep();
+
+    auto cellById = getCellById(_simController->getSimulationData());
+    for (auto const& cell : data.cells) {
+        auto expected = FlowFieldGrid::calcVelocity(createSettings(), {1001, 801}, {cell.pos.x, cell.pos.y});
+        auto actual = cellById.at(cell.id).vel;
+        EXPECT_NEAR(expected.x, actual.x, 1e-3f);
+        EXPECT_NEAR(expected.y, actual.y, 1e-3f);
+    }
+}
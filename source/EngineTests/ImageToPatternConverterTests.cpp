@@ -0,0 +1,138 @@
+#include <cmath>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "Base/NumberGenerator.h"
+#include "EngineInterface/Colors.h"
+#include "EngineInterface/DescriptionHelper.h"
+#include "EngineInterface/ImageToPatternConverter.h"
+
+class ImageToPatternConverterTests : public ::testing::Test
+{
+protected:
+    std::vector<unsigned char> createRandomImage(int width, int height, int numChannels, std::mt19937& generator) const
+    {
+        std::uniform_int_distribution<int> distribution(0, 255);
+        std::bernoulli_distribution darkDistribution(0.2);
+        std::vector<unsigned char> result(width * height * numChannels);
+        for (int i = 0; i < width * height; ++i) {
+            auto dark = darkDistribution(generator);
+            for (int j = 0; j < numChannels; ++j) {
+                result[i * numChannels + j] = static_cast<unsigned char>(dark ? distribution(generator) % 21 : distribution(generator));
+            }
+        }
+        return result;
+    }
+
+    //former per-pixel conversion of the image-to-pattern dialog (with the HSV conversion of ImGui)
+    static std::array<float, 3> toHsv(float r, float g, float b)
+    {
+        float k = 0.f;
+        if (g < b) {
+            std::swap(g, b);
+            k = -1.f;
+        }
+        if (r < g) {
+            std::swap(r, g);
+            k = -2.f / 6.f - k;
+        }
+        float const chroma = r - (g < b ? g : b);
+        return {std::fabs(k + (g - b) / (6.f * chroma + 1e-20f)), chroma / (r + 1e-20f), r};
+    }
+
+    static std::array<float, 3> toHsv(uint32_t rgb)
+    {
+        return toHsv(toFloat((rgb >> 16) & 0xff) / 255, toFloat((rgb >> 8) & 0xff) / 255, toFloat((rgb & 0xff)) / 255);
+    }
+
+    DataDescription convertByReference(std::vector<unsigned char> const& image, int width, int height, int numChannels, int maxConnections) const
+    {
+        DataDescription result;
+        for (int x = 0; x < width; ++x) {
+            for (int y = 0; y < height; ++y) {
+                auto address = (x + y * width) * numChannels;
+                int r = image[address];
+                int g = image[address + 1];
+                int b = image[address + 2];
+                auto xOffset = y % 2 == 0 ? 0.0f : 0.5f;
+                if (r > 20 || g > 20 || b > 20) {
+                    auto colorHsv = toHsv(toFloat(r) / 255, toFloat(g) / 255, toFloat(b) / 255);
+                    std::optional<int> bestMatchIndex;
+                    std::optional<float> bestMatchDistance;
+                    for (int index = 0; index < 7; ++index) {
+                        auto cellColor = toHsv(Const::IndividualCellColors[index]);
+                        auto distance = colorHsv[0] - cellColor[0];
+                        if (distance > 0.5f) {
+                            distance -= 1.0f;
+                        }
+                        if (distance < -0.5f) {
+                            distance += 1.0f;
+                        }
+                        distance = std::abs(distance) * colorHsv[1] + std::abs(colorHsv[1] - cellColor[1]);
+                        if (!bestMatchDistance || *bestMatchDistance > distance) {
+                            bestMatchIndex = index;
+                            bestMatchDistance = distance;
+                        }
+                    }
+                    result.addCell(CellDescription()
+                                       .setId(NumberGenerator::getInstance().getId())
+                                       .setEnergy(colorHsv[2] * 200)
+                                       .setPos({toFloat(x) + xOffset, toFloat(y)})
+                                       .setMaxConnections(maxConnections)
+                                       .setMetadata(CellMetadata().setColor(*bestMatchIndex))
+                                       .setBarrier(false));
+                }
+            }
+        }
+        DescriptionHelper::reconnectCells(result, 1 * 1.5f);
+        return result;
+    }
+
+    void checkEqual(DataDescription const& expected, DataDescription const& actual) const
+    {
+        ASSERT_EQ(expected.cells.size(), actual.cells.size());
+        ASSERT_FALSE(expected.cells.empty());
+        auto expectedFirstId = expected.cells.front().id;
+        auto actualFirstId = actual.cells.front().id;
+        for (size_t i = 0; i < expected.cells.size(); ++i) {
+            auto const& expectedCell = expected.cells[i];
+            auto const& actualCell = actual.cells[i];
+            EXPECT_EQ(expectedCell.id - expectedFirstId, actualCell.id - actualFirstId);
+            EXPECT_EQ(expectedCell.pos, actualCell.pos);
+            EXPECT_EQ(expectedCell.energy, actualCell.energy);
+            EXPECT_EQ(expectedCell.metadata.color, actualCell.metadata.color);
+            EXPECT_EQ(expectedCell.maxConnections, actualCell.maxConnections);
+            ASSERT_EQ(expectedCell.connections.size(), actualCell.connections.size());
+            for (size_t j = 0; j < expectedCell.connections.size(); ++j) {
+                auto const& expectedConnection = expectedCell.connections[j];
+                auto const& actualConnection = actualCell.connections[j];
+                EXPECT_EQ(expectedConnection.cellId - expectedFirstId, actualConnection.cellId - actualFirstId);
+                EXPECT_EQ(expectedConnection.distance, actualConnection.distance);
+                EXPECT_EQ(expectedConnection.angleFromPrevious, actualConnection.angleFromPrevious);
+            }
+        }
+    }
+};
+
+TEST_F(ImageToPatternConverterTests, sameResultAsPerPixelConversion)
+{
+    std::mt19937 generator(0);
+    for (auto numChannels : {3, 4}) {
+        auto image = createRandomImage(150, 97, numChannels, generator);
+        auto expected = convertByReference(image, 150, 97, numChannels, 6);
+        auto actual = ImageToPatternConverter::convert(image.data(), 150, 97, numChannels, 6);
+        checkEqual(expected, actual);
+    }
+}
+
+TEST_F(ImageToPatternConverterTests, sameResultAsPerPixelConversion_limitedConnections)
+{
+    std::mt19937 generator(0);
+    for (auto maxConnections : {0, 2, 3, 5}) {
+        auto image = createRandomImage(80, 71, 3, generator);
+        auto expected = convertByReference(image, 80, 71, 3, maxConnections);
+        auto actual = ImageToPatternConverter::convert(image.data(), 80, 71, 3, maxConnections);
+        checkEqual(expected, actual);
+    }
+}
@@ -0,0 +1,147 @@
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Base/LoggingService.h"
+#include "Base/MpscQueue.h"
+
+class LoggingServiceTests : public ::testing::Test
+{
+protected:
+    class TestCallBack : public LoggingCallBack
+    {
+    public:
+        void newLogMessage(Priority priority, std::string const& message) override
+        {
+            std::lock_guard lock(_mutex);
+            messages.emplace_back(LogMessage{priority, message});
+        }
+
+        void newLogMessages(std::vector<LogMessage> const& messages_) override
+        {
+            ++numBatches;
+            LoggingCallBack::newLogMessages(messages_);
+        }
+
+        std::vector<LogMessage> messages;
+        std::atomic<int> numBatches = 0;
+
+    private:
+        std::mutex _mutex;
+    };
+
+    //messages have the form "<time>: <producer> <number>"
+    static std::pair<int, int> parseMessage(std::string const& message)
+    {
+        auto pos = message.find(": ");
+        auto producer = std::stoi(message.substr(pos + 2));
+        auto number = std::stoi(message.substr(message.find(' ', pos + 2) + 1));
+        return {producer, number};
+    }
+};
+
+TEST_F(LoggingServiceTests, mpscQueue_fifoAndCapacity)
+{
+    MpscQueue<int> queue(4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.tryPush(int(i)));
+    }
+    EXPECT_FALSE(queue.tryPush(4));
+
+    int value;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(i, value);
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+    EXPECT_TRUE(queue.tryPush(5));
+    EXPECT_EQ(5, queue.getNumPushed());
+}
+
+TEST_F(LoggingServiceTests, multipleProducers_noMessageLost)
+{
+    auto constexpr NumProducers = 8;
+    auto constexpr NumMessagesPerProducer = 20000;
+
+    TestCallBack callback;
+    {
+        LoggingService service(1 << 10);
+        service.registerCallBack(&callback);
+
+        std::vector<std::thread> producers;
+        for (int producer = 0; producer < NumProducers; ++producer) {
+            producers.emplace_back([&service, producer] {
+                for (int number = 0; number < NumMessagesPerProducer; ++number) {
+                    service.log(Priority::Unimportant, std::to_string(producer) + " " + std::to_string(number));
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        service.flush();
+
+        //every message is either delivered or counted as dropped, messages of a producer keep their order
+        std::vector<int> lastNumbers(NumProducers, -1);
+        uint64_t numDelivered = 0;
+        std::string dropReport;
+        for (auto const& message : callback.messages) {
+            if (message.message.find("dropped") != std::string::npos) {
+                dropReport = message.message;
+                continue;
+            }
+            auto [producer, number] = parseMessage(message.message);
+            EXPECT_LT(lastNumbers.at(producer), number);
+            lastNumbers.at(producer) = number;
+            ++numDelivered;
+        }
+        EXPECT_EQ(NumProducers * NumMessagesPerProducer, numDelivered + service.getNumDroppedMessages());
+        EXPECT_EQ(service.getNumDroppedMessages() > 0, !dropReport.empty());
+        EXPECT_GT(callback.numBatches.load(), 0);
+
+        service.unregisterCallBack(&callback);
+    }
+}
+
+TEST_F(LoggingServiceTests, flush_deliversAllMessagesIfNotFull)
+{
+    TestCallBack callback;
+    LoggingService service(1 << 12);
+    service.registerCallBack(&callback);
+
+    for (int i = 0; i < 1000; ++i) {
+        service.log(Priority::Important, "0 " + std::to_string(i));
+    }
+    service.flush();
+
+    ASSERT_EQ(1000, callback.messages.size());
+    EXPECT_EQ(0, service.getNumDroppedMessages());
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(i, parseMessage(callback.messages.at(i).message).second);
+        EXPECT_EQ(Priority::Important, callback.messages.at(i).priority);
+    }
+    service.unregisterCallBack(&callback);
+}
+
+TEST_F(LoggingServiceTests, minPriority_filtersBeforeEnqueue)
+{
+    TestCallBack callback;
+    LoggingService service(4);
+    service.registerCallBack(&callback);
+    service.setMinPriority(Priority::Important);
+
+    for (int i = 0; i < 100; ++i) {
+        service.log(Priority::Unimportant, "0 " + std::to_string(i));
+    }
+    service.log(Priority::Important, "0 100");
+    service.flush();
+
+    ASSERT_EQ(1, callback.messages.size());
+    EXPECT_EQ(100, parseMessage(callback.messages.front().message).second);
+    EXPECT_EQ(0, service.getNumDroppedMessages());
+    service.unregisterCallBack(&callback);
+}
@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/NumberGenerator.h"
+#include "EngineGpuKernels/HostNeighborList.cuh"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SimulationController.h"
+#include "IntegrationTestFramework.h"
+
+class NeighborListTests : public ::testing::Test
+{
+protected:
+    int2 const WorldSize{60, 60};
+    float const Cutoff = 1.6f;
+
+    std::vector<float2> createRandomPositions(int numPositions, std::mt19937& generator) const
+    {
+        std::uniform_real_distribution<float> xDistribution(0.0f, toFloat(WorldSize.x));
+        std::uniform_real_distribution<float> yDistribution(0.0f, toFloat(WorldSize.y));
+        std::vector<float2> result;
+        for (int i = 0; i < numPositions; ++i) {
+            result.emplace_back(float2{xDistribution(generator), yDistribution(generator)});
+        }
+        return result;
+    }
+
+    void move(std::vector<float2>& positions, float maxDistance, std::mt19937& generator) const
+    {
+        std::uniform_real_distribution<float> distribution(-maxDistance, maxDistance);
+        for (auto& pos : positions) {
+            pos.x = std::fmod(pos.x + distribution(generator) + toFloat(WorldSize.x), toFloat(WorldSize.x));
+            pos.y = std::fmod(pos.y + distribution(generator) + toFloat(WorldSize.y), toFloat(WorldSize.y));
+        }
+    }
+
+    std::vector<int> getByBruteForce(std::vector<float2> const& positions, int index, float radius) const
+    {
+        std::vector<int> result;
+        for (int otherIndex = 0; otherIndex < toInt(positions.size()); ++otherIndex) {
+            auto dx = std::remainder(positions[otherIndex].x - positions[index].x, toFloat(WorldSize.x));
+            auto dy = std::remainder(positions[otherIndex].y - positions[index].y, toFloat(WorldSize.y));
+            if (otherIndex != index && std::sqrt(dx * dx + dy * dy) <= radius) {
+                result.emplace_back(otherIndex);
+            }
+        }
+        return result;
+    }
+
+    std::vector<uint64_t> createIds(int numIds) const
+    {
+        std::vector<uint64_t> result(numIds);
+        for (int i = 0; i < numIds; ++i) {
+            result[i] = i + 1;
+        }
+        return result;
+    }
+
+    std::vector<int> sorted(std::vector<int> values) const
+    {
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+};
+
+TEST_F(NeighborListTests, queriesMatchBruteForceWhileEntitiesMove)
+{
+    std::mt19937 generator(0);
+    auto positions = createRandomPositions(5000, generator);
+    auto ids = createIds(5000);
+
+    HostNeighborList neighborList(WorldSize, Cutoff);
+    std::vector<int> result;
+    int numRebuilds = 0;
+    for (int timestep = 0; timestep < 40; ++timestep) {
+        if (neighborList.update(positions, ids)) {
+            ++numRebuilds;
+        }
+        for (int i = 0; i < 50; ++i) {
+            auto index = (timestep * 50 + i) * 97 % toInt(positions.size());
+            neighborList.get(result, index, Cutoff, positions);
+            EXPECT_EQ(getByBruteForce(positions, index, Cutoff), sorted(result));
+            neighborList.get(result, index, 1.0f, positions);
+            EXPECT_EQ(getByBruteForce(positions, index, 1.0f), sorted(result));
+        }
+        move(positions, 0.05f, generator);
+    }
+    EXPECT_LT(numRebuilds, 40);
+}
+
+TEST_F(NeighborListTests, queriesMatchBruteForceWhileEntitiesAreRemovedAndAdded)
+{
+    std::mt19937 generator(0);
+    auto positions = createRandomPositions(5000, generator);
+    auto ids = createIds(5000);
+    auto nextId = ids.back() + 1;
+
+    HostNeighborList neighborList(WorldSize, Cutoff);
+    std::vector<int> result;
+    int numRebuilds = 0;
+    for (int timestep = 0; timestep < 40; ++timestep) {
+        if (neighborList.update(positions, ids)) {
+            ++numRebuilds;
+        }
+        for (int i = 0; i < 50; ++i) {
+            auto index = (timestep * 50 + i) * 97 % toInt(positions.size());
+            neighborList.get(result, index, Cutoff, positions);
+            EXPECT_EQ(getByBruteForce(positions, index, Cutoff), sorted(result));
+        }
+        move(positions, 0.005f, generator);   //less than half the skin in 40 steps
+
+        //removals shift the indices of the remaining entities
+        for (int i = 0; i < 20; ++i) {
+            auto index = (timestep * 20 + i) * 31 % toInt(positions.size());
+            positions.erase(positions.begin() + index);
+            ids.erase(ids.begin() + index);
+        }
+        for (auto const& pos : createRandomPositions(20, generator)) {
+            positions.emplace_back(pos);
+            ids.emplace_back(nextId++);
+        }
+    }
+    EXPECT_EQ(1, numRebuilds);
+}
+
+TEST_F(NeighborListTests, listIsOnlyRebuiltIfDisplacementExceedsHalfSkin)
+{
+    std::vector<float2> positions = {{10.0f, 10.0f}, {11.0f, 10.0f}, {59.9f, 30.0f}};
+    auto ids = createIds(3);
+
+    HostNeighborList neighborList(WorldSize, Cutoff);
+    EXPECT_TRUE(neighborList.update(positions, ids));
+    EXPECT_FALSE(neighborList.update(positions, ids));
+
+    positions[0].x += 0.2f;
+    EXPECT_FALSE(neighborList.update(positions, ids));
+
+    //displacement across the world boundary is corrected
+    positions[2].x = 0.05f;
+    EXPECT_FALSE(neighborList.update(positions, ids));
+
+    //added and removed entities do not cause a rebuild
+    positions.emplace_back(float2{30.0f, 30.0f});
+    ids.emplace_back(4);
+    EXPECT_FALSE(neighborList.update(positions, ids));
+    positions.erase(positions.begin() + 1);
+    ids.erase(ids.begin() + 1);
+    EXPECT_FALSE(neighborList.update(positions, ids));
+
+    positions[0].x += 0.1f;
+    EXPECT_TRUE(neighborList.update(positions, ids));
+}
+
+TEST_F(NeighborListTests, storageIsCompact)
+{
+    std::mt19937 generator(0);
+    auto sparsePositions = createRandomPositions(1000, generator);
+    auto densePositions = createRandomPositions(5000, generator);
+
+    for (auto const& positions : {sparsePositions, densePositions}) {
+        HostNeighborList neighborList(WorldSize, Cutoff);
+        neighborList.update(positions, createIds(toInt(positions.size())));
+
+        int expectedNumNeighbors = 0;
+        for (int index = 0; index < toInt(positions.size()); ++index) {
+            expectedNumNeighbors += toInt(getByBruteForce(positions, index, NeighborListLayout::getBuildRadius(Cutoff)).size());
+        }
+        EXPECT_EQ(expectedNumNeighbors, neighborList.getNumNeighbors());
+    }
+}
+
+class NeighborListEngineTests : public IntegrationTestFramework
+{
+public:
+    NeighborListEngineTests()
+        : IntegrationTestFramework({100, 100})
+    {}
+
+protected:
+    void SetUp() override
+    {
+        auto parameters = _simController->getSimulationParameters();
+        parameters.radiationProb = 0;
+        parameters.spotValues.tokenMutationRate = 0;
+        parameters.spotValues.cellMutationRate = 0;
+        _simController->setSimulationParameters_async(parameters);
+    }
+
+    CellDescription createCell(RealVector2D const& pos, RealVector2D const& vel) const
+    {
+        return CellDescription().setId(NumberGenerator::getInstance().getId()).setPos(pos).setVel(vel).setEnergy(100).setMaxConnections(0);
+    }
+};
+
+TEST_F(NeighborListEngineTests, approachingCellsCollideAfterRebuild)
+{
+    //the cells are not in each other's list at the first build
+    DataDescription data;
+    auto leftCell = createCell({45.0f, 50.5f}, {0.1f, 0});
+    auto rightCell = createCell({55.0f, 50.5f}, {-0.1f, 0});
+    data.addCell(leftCell);
+    data.addCell(rightCell);
+    data.addCell(createCell({20.0f, 20.5f}, {0, 0}));
+    _simController->setSimulationData(data);
+    for (int i = 0; i < 80; ++i) {
+        _simController->calcSingleTimestep();
+    }
+
+    auto cellById = getCellById(_simController->getSimulationData());
+    EXPECT_LT(cellById.at(leftCell.id).vel.x, 0.0f);
+    EXPECT_GT(cellById.at(rightCell.id).vel.x, 0.0f);
+    EXPECT_LT(cellById.at(leftCell.id).pos.x, cellById.at(rightCell.id).pos.x);
+}
@@ -0,0 +1,338 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <cpp-httplib/httplib.h>
+
+#include "Network/NetworkService.h"
+#include "Network/SimulationCache.h"
+#include "Network/SimulationDownload.h"
+
+namespace
+{
+    auto constexpr UploadContentSize = 64 * 1024 * 1024;
+
+    uint8_t getContentByte(uint64_t pos)
+    {
+        return static_cast<uint8_t>((pos * 2654435761u) >> 13);
+    }
+
+    void writeUploadContent(std::ostream& stream)
+    {
+        std::vector<char> block(4096);
+        for (uint64_t pos = 0; pos < UploadContentSize; pos += block.size()) {
+            for (size_t i = 0; i < block.size(); ++i) {
+                block[i] = static_cast<char>(getContentByte(pos + i));
+            }
+            stream.write(block.data(), block.size());
+        }
+    }
+
+    uint64_t getResidentBytes()
+    {
+#ifdef __linux__
+        std::ifstream statm("/proc/self/statm");
+        uint64_t size = 0, resident = 0;
+        statm >> size >> resident;
+        return resident * sysconf(_SC_PAGESIZE);
+#else
+        return 0;
+#endif
+    }
+
+    //growth of the resident memory while the function is executed
+    template <typename Function>
+    uint64_t measurePeakMemory(Function const& function)
+    {
+        auto baseline = getResidentBytes();
+        std::atomic<bool> finished{false};
+        std::atomic<uint64_t> peak{baseline};
+        std::thread sampler([&] {
+            while (!finished) {
+                peak = std::max(peak.load(), getResidentBytes());
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+        function();
+        finished = true;
+        sampler.join();
+        return std::max(peak.load(), getResidentBytes()) - baseline;
+    }
+}
+
+//plain http stand-in for the alien server
+class NetworkServiceTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _cacheDirectory = std::filesystem::temp_directory_path() / ("alien network tests " + std::to_string(std::rand()));
+        _cache = std::make_shared<_SimulationCache>(_cacheDirectory, 1024 * 1024);
+
+        _server.Get("/alien-server/downloadcontent.php", [&](auto const& request, auto& response) {
+            registerRequest(request);
+            waitForParallelRequests();
+            if (_slowContent) {
+                response.set_content_provider(1000000, "application/octet-stream", [&](size_t offset, size_t, httplib::DataSink& sink) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    std::string chunk(std::min<size_t>(1000, 1000000 - offset), 'x');
+                    sink.write(chunk.data(), chunk.size());
+                    return true;
+                });
+                return;
+            }
+            response.set_content("content " + request.get_param_value("id"), "application/octet-stream");
+        });
+        _server.Get("/alien-server/downloadsettings.php", [&](auto const& request, auto& response) {
+            registerRequest(request);
+            waitForParallelRequests();
+            response.set_content("settings " + request.get_param_value("id"), "text/plain");
+        });
+        _server.Get("/alien-server/downloadsymbolmap.php", [&](auto const& request, auto& response) {
+            registerRequest(request);
+            waitForParallelRequests();
+            response.set_content("symbolMap " + request.get_param_value("id"), "text/plain");
+        });
+        _server.Post("/alien-server/login.php", [&](auto const& request, auto& response) {
+            registerRequest(request);
+            response.set_content("{\"result\":true}", "text/plain");
+        });
+
+        //the upload is consumed while being received in order not to distort memory measurements
+        _server.Post(
+            "/alien-server/uploadsimulation.php",
+            [&](httplib::Request const& request, httplib::Response& response, httplib::ContentReader const& contentReader) {
+                registerRequest(request);
+                std::string name;
+                contentReader(
+                    [&](httplib::MultipartFormData const& item) {
+                        name = item.name;
+                        return true;
+                    },
+                    [&](char const* data, size_t length) {
+                        if (name == "content") {
+                            for (size_t i = 0; i < length; ++i) {
+                                _contentValid &= static_cast<uint8_t>(data[i]) == getContentByte(_receivedContentBytes + i);
+                            }
+                            _receivedContentBytes += length;
+                        } else {
+                            _receivedFields[name].append(data, length);
+                        }
+                        return true;
+                    });
+                response.set_content("{\"result\":true}", "text/plain");
+            });
+
+        _server.set_keep_alive_max_count(100);
+        _server.set_tcp_nodelay(true);
+        auto port = _server.bind_to_any_port("127.0.0.1");
+        _serverAddress = "http://127.0.0.1:" + std::to_string(port);
+        _serverThread = std::thread([&] { _server.listen_after_bind(); });
+    }
+
+    void TearDown() override
+    {
+        _server.stop();
+        _serverThread.join();
+        std::filesystem::remove_all(_cacheDirectory);
+    }
+
+    void registerRequest(httplib::Request const& request)
+    {
+        std::lock_guard lock(_mutex);
+        ++_numRequests;
+        _clientPorts.insert(request.remote_port);
+    }
+
+    //blocks until the expected number of requests are processed simultaneously
+    void waitForParallelRequests()
+    {
+        std::unique_lock lock(_mutex);
+        if (0 == _numExpectedParallelRequests) {
+            return;
+        }
+        ++_numParallelRequests;
+        _condition.notify_all();
+        _allRequestsParallel = _condition.wait_for(
+            lock, std::chrono::seconds(5), [&] { return _numParallelRequests >= _numExpectedParallelRequests; });
+    }
+
+    int getNumRequests()
+    {
+        std::lock_guard lock(_mutex);
+        return _numRequests;
+    }
+
+    void waitUntilFinished(SimulationDownload const& download)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+        while (!download->isFinished() && std::chrono::steady_clock::now() - startTime < std::chrono::seconds(10)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    std::filesystem::path _cacheDirectory;
+    SimulationCache _cache;
+
+    httplib::Server _server;
+    std::thread _serverThread;
+    std::string _serverAddress;
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    int _numRequests = 0;
+    std::set<int> _clientPorts;
+    int _numExpectedParallelRequests = 0;
+    int _numParallelRequests = 0;
+    bool _allRequestsParallel = true;
+    bool _slowContent = false;
+
+    uint64_t _receivedContentBytes = 0;
+    bool _contentValid = true;
+    std::map<std::string, std::string> _receivedFields;
+};
+
+TEST_F(NetworkServiceTests, partsAreDownloadedInParallel)
+{
+    _numExpectedParallelRequests = 3;
+    auto networkService = std::make_shared<_NetworkService>(_serverAddress, 3);
+
+    auto download = std::make_shared<_SimulationDownload>(networkService, _cache, "42", "3.3.1");
+    waitUntilFinished(download);
+
+    ASSERT_TRUE(download->isSucceeded());
+    EXPECT_FALSE(download->isFromCache());
+    EXPECT_TRUE(_allRequestsParallel);
+    EXPECT_EQ("content 42", download->getContent());
+    EXPECT_EQ("settings 42", download->getSettings());
+    EXPECT_EQ("symbolMap 42", download->getSymbolMap());
+    EXPECT_EQ(1.0f, download->getProgress());
+}
+
+TEST_F(NetworkServiceTests, connectionIsReused)
+{
+    auto networkService = std::make_shared<_NetworkService>(_serverAddress, 1);
+
+    NetworkRequest request;
+    request.method = NetworkRequest::Method::Post;
+    request.path = "/alien-server/login.php";
+    request.params.emplace_back("userName", "user");
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ("{\"result\":true}", networkService->execute(request));
+    }
+    EXPECT_EQ(20, getNumRequests());
+    EXPECT_EQ(1, _clientPorts.size());
+}
+
+TEST_F(NetworkServiceTests, cachedSimulationIsOpenedWithoutRequests)
+{
+    auto networkService = std::make_shared<_NetworkService>(_serverAddress, 3);
+    {
+        auto download = std::make_shared<_SimulationDownload>(networkService, _cache, "7", "3.3.1");
+        waitUntilFinished(download);
+        ASSERT_TRUE(download->isSucceeded());
+    }
+    auto numRequests = getNumRequests();
+
+    auto download = std::make_shared<_SimulationDownload>(networkService, _cache, "7", "3.3.1");
+    EXPECT_TRUE(download->isFinished());
+    EXPECT_TRUE(download->isSucceeded());
+    EXPECT_TRUE(download->isFromCache());
+    EXPECT_EQ("content 7", download->getContent());
+    EXPECT_EQ("settings 7", download->getSettings());
+    EXPECT_EQ("symbolMap 7", download->getSymbolMap());
+    EXPECT_EQ(numRequests, getNumRequests());
+
+    auto otherVersionDownload = std::make_shared<_SimulationDownload>(networkService, _cache, "7", "3.4.0");
+    EXPECT_FALSE(otherVersionDownload->isFromCache());
+    waitUntilFinished(otherVersionDownload);
+}
+
+TEST_F(NetworkServiceTests, runningDownloadCanBeCanceled)
+{
+    _slowContent = true;
+    auto networkService = std::make_shared<_NetworkService>(_serverAddress, 3);
+
+    auto download = std::make_shared<_SimulationDownload>(networkService, _cache, "1", "3.3.1");
+    auto startTime = std::chrono::steady_clock::now();
+    while (download->getProgress() == 0 && std::chrono::steady_clock::now() - startTime < std::chrono::seconds(5)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_GT(download->getProgress(), 0.0f);
+    EXPECT_LT(download->getProgress(), 1.0f);
+
+    download->cancel();
+    waitUntilFinished(download);
+    EXPECT_TRUE(download->isFinished());
+    EXPECT_FALSE(download->isSucceeded());
+    EXPECT_LT(std::chrono::steady_clock::now() - startTime, std::chrono::seconds(5));
+    EXPECT_FALSE(_cache->load("1", "3.3.1", "content"));
+}
+
+TEST_F(NetworkServiceTests, streamedUploadNeedsLessMemory)
+{
+#ifndef __linux__
+    GTEST_SKIP() << "resident memory is only measured on Linux";
+#endif
+    auto networkService = std::make_shared<_NetworkService>(_serverAddress, 1);
+
+    NetworkRequest request;
+    request.method = NetworkRequest::Method::Post;
+    request.path = "/alien-server/uploadsimulation.php";
+    request.multipartItems = {{"simName", "test", ""}, {"content", "", "application/octet-stream", writeUploadContent}};
+    auto streamedUploadMemory = measurePeakMemory([&] { EXPECT_EQ("{\"result\":true}", networkService->execute(request)); });
+    EXPECT_EQ(UploadContentSize, _receivedContentBytes);
+    EXPECT_TRUE(_contentValid);
+    EXPECT_EQ("test", _receivedFields["simName"]);
+
+    //previous approach: serialization into a string which is copied into the request
+    _receivedContentBytes = 0;
+    auto inMemoryUploadMemory = measurePeakMemory([&] {
+        std::stringstream stream;
+        writeUploadContent(stream);
+        request.multipartItems = {{"simName", "test", ""}, {"content", stream.str(), "application/octet-stream"}};
+        EXPECT_EQ("{\"result\":true}", networkService->execute(request));
+    });
+    EXPECT_EQ(UploadContentSize, _receivedContentBytes);
+    EXPECT_TRUE(_contentValid);
+
+    EXPECT_LT(streamedUploadMemory, UploadContentSize / 8);
+    EXPECT_GT(inMemoryUploadMemory, UploadContentSize * 2);
+}
+
+TEST_F(NetworkServiceTests, streamedUploadCanBeCanceled)
+{
+    auto networkService = std::make_shared<_NetworkService>(_serverAddress, 1);
+
+    NetworkRequest request;
+    request.method = NetworkRequest::Method::Post;
+    request.path = "/alien-server/uploadsimulation.php";
+    request.multipartItems = {{"content", "", "application/octet-stream", [](std::ostream& stream) {
+                                   std::vector<char> block(4096, 'x');
+                                   while (stream) {
+                                       stream.write(block.data(), block.size());
+                                   }
+                               }}};
+    auto task = networkService->schedule(request);
+    auto startTime = std::chrono::steady_clock::now();
+    while (task->getSentBytes() < 1024 * 1024 && std::chrono::steady_clock::now() - startTime < std::chrono::seconds(5)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_GE(task->getSentBytes(), 1024 * 1024);
+
+    task->cancel();
+    task->wait();
+    EXPECT_EQ(_NetworkTask::State::Canceled, task->getState());
+}
@@ -0,0 +1,278 @@
+#include <algorithm>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/NumberGenerator.h"
+#include "Base/ThreadPool.h"
+#include "EngineGpuKernels/HostParticleMap.cuh"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SimulationController.h"
+#include "EngineInterface/SimulationParameters.h"
+#include "IntegrationTestFramework.h"
+
+class ParticleMapTests : public ::testing::Test
+{
+protected:
+    int2 const WorldSize{100, 100};
+    float const DefaultMergeDistance = SimulationParameters().particleMergeDistance;
+    float const UnitSquareMergeDistance = 1.5f;
+
+    void TearDown() override { ThreadPool::getInstance().setNumThreads(0); }
+
+    std::vector<HostParticle> createRandomParticles(int numParticles, int2 const& areaSize) const
+    {
+        std::mt19937 randomEngine(42);
+        std::uniform_real_distribution<float> posXDistribution(0.0f, toFloat(areaSize.x));
+        std::uniform_real_distribution<float> posYDistribution(0.0f, toFloat(areaSize.y));
+        std::uniform_real_distribution<float> velDistribution(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> energyDistribution(0.1f, 10.0f);
+        std::vector<HostParticle> result;
+        for (int i = 0; i < numParticles; ++i) {
+            result.emplace_back(HostParticle{
+                static_cast<uint64_t>(i + 1),
+                {posXDistribution(randomEngine), posYDistribution(randomEngine)},
+                {velDistribution(randomEngine), velDistribution(randomEngine)},
+                energyDistribution(randomEngine)});
+        }
+        return result;
+    }
+
+    std::vector<HostParticle> sortedById(std::vector<HostParticle> particles) const
+    {
+        std::sort(particles.begin(), particles.end(), [](auto const& p1, auto const& p2) { return p1.id < p2.id; });
+        return particles;
+    }
+
+    double calcTotalEnergy(std::vector<HostParticle> const& particles, std::vector<HostAbsorbingCell> const& cells) const
+    {
+        double result = 0;
+        for (auto const& particle : particles) {
+            result += particle.energy;
+        }
+        for (auto const& cell : cells) {
+            result += cell.energy;
+        }
+        return result;
+    }
+};
+
+TEST_F(ParticleMapTests, binIsMergedIntoParticleWithSmallestId)
+{
+    std::vector<HostParticle> particles = {
+        {7, {10.2f, 20.2f}, {1.0f, 0}, 1.0f},
+        {3, {10.8f, 20.9f}, {0, 1.0f}, 3.0f},
+        {5, {10.5f, 20.1f}, {0, 0}, 4.0f},
+        {4, {11.5f, 20.5f}, {0.5f, 0.5f}, 2.0f}};
+    std::vector<HostAbsorbingCell> cells;
+
+    HostParticleMap map(WorldSize, UnitSquareMergeDistance);
+    map.collision(particles, cells);
+
+    ASSERT_EQ(2, particles.size());
+    EXPECT_EQ(3, particles.at(0).id);
+    EXPECT_FLOAT_EQ(8.0f, particles.at(0).energy);
+    EXPECT_FLOAT_EQ(1.0f / 8, particles.at(0).vel.x);
+    EXPECT_FLOAT_EQ(3.0f / 8, particles.at(0).vel.y);
+    EXPECT_EQ(4, particles.at(1).id);
+    EXPECT_FLOAT_EQ(2.0f, particles.at(1).energy);
+    EXPECT_FLOAT_EQ(0.5f, particles.at(1).vel.x);
+}
+
+TEST_F(ParticleMapTests, binIsAbsorbedByCellWithSmallestId)
+{
+    std::vector<HostParticle> particles = {{1, {10.2f, 20.2f}, {0, 0}, 1.0f}, {2, {10.7f, 20.7f}, {0, 0}, 2.0f}, {3, {30.5f, 30.5f}, {0, 0}, 4.0f}};
+    std::vector<HostAbsorbingCell> cells = {
+        {9, {10.9f, 20.1f}, 100.0f, false}, {8, {10.1f, 20.9f}, 100.0f, false}, {10, {30.5f, 30.1f}, 100.0f, true}};
+
+    HostParticleMap map(WorldSize, DefaultMergeDistance);
+    map.collision(particles, cells);
+
+    //particle in the unit square of a barrier cell is not absorbed
+    ASSERT_EQ(1, particles.size());
+    EXPECT_EQ(3, particles.at(0).id);
+    EXPECT_FLOAT_EQ(4.0f, particles.at(0).energy);
+    EXPECT_FLOAT_EQ(100.0f, cells.at(0).energy);
+    EXPECT_FLOAT_EQ(103.0f, cells.at(1).energy);
+    EXPECT_FLOAT_EQ(100.0f, cells.at(2).energy);
+}
+
+TEST_F(ParticleMapTests, onlyParticlesWithinMergeDistanceAreMerged)
+{
+    std::vector<HostParticle> particles = {{2, {10.9f, 20.9f}, {0, 0}, 1.0f}, {6, {10.8f, 20.7f}, {0, 0}, 2.0f}, {4, {10.1f, 20.1f}, {0, 0}, 4.0f}};
+    std::vector<HostAbsorbingCell> cells;
+
+    HostParticleMap map(WorldSize, DefaultMergeDistance);
+    map.collision(particles, cells);
+
+    ASSERT_EQ(2, particles.size());
+    EXPECT_EQ(2, particles.at(0).id);
+    EXPECT_FLOAT_EQ(3.0f, particles.at(0).energy);
+    EXPECT_EQ(4, particles.at(1).id);
+    EXPECT_FLOAT_EQ(4.0f, particles.at(1).energy);
+}
+
+TEST_F(ParticleMapTests, barrierCellDoesNotPreventAbsorption)
+{
+    std::vector<HostParticle> particles = {{1, {10.2f, 20.2f}, {0, 0}, 1.0f}, {2, {10.7f, 20.7f}, {0, 0}, 2.0f}};
+    std::vector<HostAbsorbingCell> cells = {{3, {10.5f, 20.5f}, 100.0f, true}, {5, {10.9f, 20.1f}, 100.0f, false}};
+
+    HostParticleMap map(WorldSize, DefaultMergeDistance);
+    map.collision(particles, cells);
+
+    //the barrier cell has the smallest id, the particles are absorbed by the other cell
+    EXPECT_TRUE(particles.empty());
+    EXPECT_FLOAT_EQ(100.0f, cells.at(0).energy);
+    EXPECT_FLOAT_EQ(103.0f, cells.at(1).energy);
+}
+
+TEST_F(ParticleMapTests, denseBinIsMergedIntoParticleWithSmallestId)
+{
+    auto particles = createRandomParticles(2000, {1, 1});
+    for (auto& particle : particles) {
+        particle.absPos = {particle.absPos.x + 10.0f, particle.absPos.y + 20.0f};
+    }
+    std::shuffle(particles.begin(), particles.end(), std::mt19937(3));
+    std::vector<HostAbsorbingCell> cells;
+    auto energyBefore = calcTotalEnergy(particles, cells);
+
+    HostParticleMap map(WorldSize, UnitSquareMergeDistance);
+    map.collision(particles, cells);
+
+    ASSERT_EQ(1, particles.size());
+    EXPECT_EQ(1, particles.at(0).id);
+    EXPECT_NEAR(energyBefore, particles.at(0).energy, energyBefore * 1e-5);
+}
+
+TEST_F(ParticleMapTests, energyIsConserved)
+{
+    auto particles = createRandomParticles(200000, {100, 100});
+    std::vector<HostAbsorbingCell> cells;
+    for (int i = 0; i < 2000; ++i) {
+        cells.emplace_back(HostAbsorbingCell{static_cast<uint64_t>(1000000 + i), {toFloat(i % 50) + 0.5f, toFloat(i / 50) + 0.5f}, 1.0f, i % 7 == 0});
+    }
+    auto energyBefore = calcTotalEnergy(particles, cells);
+
+    HostParticleMap map(WorldSize, UnitSquareMergeDistance);
+    map.collision(particles, cells);
+
+    EXPECT_NEAR(energyBefore, calcTotalEnergy(particles, cells), energyBefore * 1e-5);
+    EXPECT_GE(10000, particles.size());  //at most one particle per unit square
+    for (auto const& particle : particles) {
+        EXPECT_GT(particle.energy, 0.0f);
+    }
+}
+
+TEST_F(ParticleMapTests, resultIsIndependentOfNumberOfThreadsAndInputOrder)
+{
+    auto input = createRandomParticles(300000, {200, 200});
+    std::vector<HostAbsorbingCell> inputCells;
+    for (int i = 0; i < 1000; ++i) {
+        inputCells.emplace_back(HostAbsorbingCell{static_cast<uint64_t>(1000000 + i), {toFloat(i % 40) * 2.3f, toFloat(i / 40) * 3.1f}, 0.0f, false});
+    }
+    auto collision = [&](int numThreads, bool shuffle) {
+        ThreadPool::getInstance().setNumThreads(numThreads);
+        auto particles = input;
+        if (shuffle) {
+            std::shuffle(particles.begin(), particles.end(), std::mt19937(7));
+        }
+        auto cells = inputCells;
+        HostParticleMap map({200, 200}, DefaultMergeDistance);
+        map.collision(particles, cells);
+        return std::make_pair(sortedById(particles), cells);
+    };
+
+    auto [expectedParticles, expectedCells] = collision(1, false);
+    for (auto const& [numThreads, shuffle] : std::vector<std::pair<int, bool>>{{8, false}, {1, true}, {5, true}}) {
+        auto [particles, cells] = collision(numThreads, shuffle);
+        ASSERT_EQ(expectedParticles.size(), particles.size());
+        for (size_t i = 0; i < particles.size(); ++i) {
+            EXPECT_EQ(expectedParticles[i].id, particles[i].id);
+            EXPECT_EQ(expectedParticles[i].energy, particles[i].energy);
+            EXPECT_EQ(expectedParticles[i].vel.x, particles[i].vel.x);
+            EXPECT_EQ(expectedParticles[i].vel.y, particles[i].vel.y);
+        }
+        for (size_t i = 0; i < cells.size(); ++i) {
+            EXPECT_EQ(expectedCells[i].energy, cells[i].energy);
+        }
+    }
+}
+
+class ParticleMapEngineTests : public IntegrationTestFramework
+{
+public:
+    ParticleMapEngineTests()
+        : IntegrationTestFramework({100, 100})
+    {}
+
+protected:
+    void SetUp() override
+    {
+        auto parameters = _simController->getSimulationParameters();
+        parameters.radiationProb = 0;
+        parameters.cellTransformationProb = 0;
+        parameters.spotValues.tokenMutationRate = 0;
+        parameters.spotValues.cellMutationRate = 0;
+        _simController->setSimulationParameters_async(parameters);
+    }
+
+    CellDescription createCell(RealVector2D const& pos, bool barrier) const
+    {
+        return CellDescription().setId(NumberGenerator::getInstance().getId()).setPos(pos).setEnergy(100).setMaxConnections(0).setBarrier(barrier);
+    }
+
+    ParticleDescription createParticle(RealVector2D const& pos, double energy) const
+    {
+        return ParticleDescription().setId(NumberGenerator::getInstance().getId()).setPos(pos).setVel({0, 0}).setEnergy(energy);
+    }
+
+    double calcTotalEnergy(DataDescription const& data) const
+    {
+        double result = 0;
+        for (auto const& cell : data.cells) {
+            result += cell.energy;
+        }
+        for (auto const& particle : data.particles) {
+            result += particle.energy;
+        }
+        return result;
+    }
+};
+
+TEST_F(ParticleMapEngineTests, particlesAreAbsorbedByNonBarrierCell)
+{
+    DataDescription data;
+    auto barrierCell = createCell({50.5f, 50.5f}, true);
+    auto cell = createCell({50.8f, 50.2f}, false);
+    data.addCell(barrierCell);
+    data.addCell(cell);
+    data.addParticle(createParticle({50.2f, 50.2f}, 1.0));
+    data.addParticle(createParticle({50.8f, 50.8f}, 2.0));
+    _simController->setSimulationData(data);
+    _simController->calcSingleTimestep();
+
+    //the barrier cell has the smaller id
+    auto result = _simController->getSimulationData();
+    EXPECT_TRUE(result.particles.empty());
+    auto cellById = getCellById(result);
+    EXPECT_NEAR(100.0, cellById.at(barrierCell.id).energy, 1e-4);
+    EXPECT_NEAR(103.0, cellById.at(cell.id).energy, 1e-4);
+    EXPECT_NEAR(calcTotalEnergy(data), calcTotalEnergy(result), 1e-4);
+}
+
+TEST_F(ParticleMapEngineTests, particlesAreNotAbsorbedByBarrierCell)
+{
+    DataDescription data;
+    data.addCell(createCell({50.5f, 50.5f}, true));
+    data.addParticle(createParticle({50.2f, 50.2f}, 1.0));
+    data.addParticle(createParticle({50.3f, 50.3f}, 2.0));
+    _simController->setSimulationData(data);
+    _simController->calcSingleTimestep();
+
+    //the particles are merged instead
+    auto result = _simController->getSimulationData();
+    ASSERT_EQ(1, result.particles.size());
+    EXPECT_NEAR(3.0, result.particles.front().energy, 1e-4);
+    EXPECT_NEAR(calcTotalEnergy(data), calcTotalEnergy(result), 1e-4);
+}
@@ -0,0 +1,153 @@
+#include <array>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Base/NumberGenerator.h"
+#include "Base/Philox.h"
+
+class RandomNumberTests : public ::testing::Test
+{
+protected:
+    static auto constexpr NumSamples = 1 << 20;
+    static auto constexpr NumBuckets = 256;
+
+    //chi-square statistic of the bucket counts against a uniform distribution
+    static double calcChiSquare(std::vector<int> const& counts, int numSamples)
+    {
+        auto expected = static_cast<double>(numSamples) / counts.size();
+        double result = 0;
+        for (auto const& count : counts) {
+            result += (count - expected) * (count - expected) / expected;
+        }
+        return result;
+    }
+
+    //upper bound for the chi-square statistic with 255 degrees of freedom at significance level ~1e-4
+    static double getChiSquareLimit() { return 350.0; }
+
+    static double calcCorrelation(std::vector<float> const& values1, std::vector<float> const& values2)
+    {
+        double mean1 = 0, mean2 = 0;
+        for (size_t i = 0; i < values1.size(); ++i) {
+            mean1 += values1[i];
+            mean2 += values2[i];
+        }
+        mean1 /= values1.size();
+        mean2 /= values2.size();
+        double covariance = 0, variance1 = 0, variance2 = 0;
+        for (size_t i = 0; i < values1.size(); ++i) {
+            covariance += (values1[i] - mean1) * (values2[i] - mean2);
+            variance1 += (values1[i] - mean1) * (values1[i] - mean1);
+            variance2 += (values2[i] - mean2) * (values2[i] - mean2);
+        }
+        return covariance / std::sqrt(variance1 * variance2);
+    }
+};
+
+TEST_F(RandomNumberTests, philox_uniformOverConsecutiveEntities)
+{
+    std::vector<int> counts(NumBuckets, 0);
+    for (int entityId = 0; entityId < NumSamples; ++entityId) {
+        ++counts[Philox::generate(7, 1000, entityId, 0) >> 24];
+    }
+    EXPECT_LT(calcChiSquare(counts, NumSamples), getChiSquareLimit());
+}
+
+TEST_F(RandomNumberTests, philox_uniformOverConsecutiveTimesteps)
+{
+    std::vector<int> counts(NumBuckets, 0);
+    for (int timestep = 0; timestep < NumSamples; ++timestep) {
+        ++counts[Philox::generate(7, timestep, 42, 3) & 0xff];
+    }
+    EXPECT_LT(calcChiSquare(counts, NumSamples), getChiSquareLimit());
+}
+
+TEST_F(RandomNumberTests, philox_bitsBalanced)
+{
+    std::array<int, 32> numOnes = {};
+    for (int entityId = 0; entityId < NumSamples; ++entityId) {
+        auto value = Philox::generate(0, 0, entityId, 0);
+        for (int bit = 0; bit < 32; ++bit) {
+            numOnes[bit] += (value >> bit) & 1;
+        }
+    }
+    //standard deviation of the number of ones is sqrt(NumSamples) / 2 = 512
+    for (int bit = 0; bit < 32; ++bit) {
+        EXPECT_NEAR(NumSamples / 2, numOnes[bit], 512 * 5) << "bit: " << bit;
+    }
+}
+
+TEST_F(RandomNumberTests, philox_noCorrelationBetweenKeys)
+{
+    auto constexpr NumValues = 1 << 16;
+    std::vector<float> values(NumValues), neighborEntityValues(NumValues), otherCallSiteValues(NumValues), otherSeedValues(NumValues),
+        nextTimestepValues(NumValues);
+    for (int i = 0; i < NumValues; ++i) {
+        values[i] = Philox::generateFloat(1, 10, i, 0);
+        neighborEntityValues[i] = Philox::generateFloat(1, 10, i + 1, 0);
+        otherCallSiteValues[i] = Philox::generateFloat(1, 10, i, 1);
+        otherSeedValues[i] = Philox::generateFloat(2, 10, i, 0);
+        nextTimestepValues[i] = Philox::generateFloat(1, 11, i, 0);
+    }
+    //standard deviation of the sample correlation is 1 / sqrt(NumValues) ~ 0.004
+    EXPECT_NEAR(0.0, calcCorrelation(values, neighborEntityValues), 0.02);
+    EXPECT_NEAR(0.0, calcCorrelation(values, otherCallSiteValues), 0.02);
+    EXPECT_NEAR(0.0, calcCorrelation(values, otherSeedValues), 0.02);
+    EXPECT_NEAR(0.0, calcCorrelation(values, nextTimestepValues), 0.02);
+}
+
+TEST_F(RandomNumberTests, philox_floatInUnitInterval)
+{
+    double sum = 0;
+    for (int entityId = 0; entityId < NumSamples; ++entityId) {
+        auto value = Philox::generateFloat(3, 0, entityId, 0);
+        ASSERT_GE(value, 0.0f);
+        ASSERT_LT(value, 1.0f);
+        sum += value;
+    }
+    EXPECT_NEAR(0.5, sum / NumSamples, 0.002);
+}
+
+TEST_F(RandomNumberTests, numberGenerator_uniform)
+{
+    auto& numberGen = NumberGenerator::getInstance();
+    numberGen.setSeed(5);
+    std::vector<int> counts(NumBuckets, 0);
+    for (int i = 0; i < NumSamples; ++i) {
+        ++counts[numberGen.getRandomInt(NumBuckets)];
+    }
+    EXPECT_LT(calcChiSquare(counts, NumSamples), getChiSquareLimit());
+}
+
+TEST_F(RandomNumberTests, numberGenerator_threadsDrawFromSelectedStreams)
+{
+    auto constexpr NumThreads = 4;
+    auto constexpr NumValuesPerThread = 1 << 14;
+    auto& numberGen = NumberGenerator::getInstance();
+    numberGen.setSeed(9);
+
+    std::vector<std::vector<uint32_t>> values(NumThreads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NumThreads; ++i) {
+        threads.emplace_back([&, i] {
+            numberGen.setStreamId(i + 1);
+            for (int j = 0; j < NumValuesPerThread; ++j) {
+                values[i].emplace_back(numberGen.getRandomInt());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    //the numbers of each thread only depend on its stream id, not on the order in which the threads start drawing
+    for (int i = 0; i < NumThreads; ++i) {
+        for (int j = 0; j < NumValuesPerThread; ++j) {
+            ASSERT_EQ(Philox::generate(j, i + 1, 9).values[0], values[i][j]);
+        }
+    }
+    EXPECT_EQ(Philox::generate(0, 0, 9).values[0], numberGen.getRandomInt());
+}
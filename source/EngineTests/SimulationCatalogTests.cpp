@@ -0,0 +1,246 @@
+#include <algorithm>
+#include <filesystem>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#include <boost/algorithm/string.hpp>
+#include <gtest/gtest.h>
+
+#include <cpp-httplib/httplib.h>
+
+#include "Network/NetworkService.h"
+#include "Network/NgramIndex.h"
+#include "Network/SimulationCatalog.h"
+
+namespace
+{
+    struct ServerSimulation
+    {
+        int id;
+        std::string timestamp;
+        int numDownloads;
+        std::set<std::string> userLikes;
+    };
+
+    std::string getTimestamp(int seconds)
+    {
+        char result[32];
+        snprintf(result, sizeof(result), "2022-01-01 %06d", seconds);
+        return result;
+    }
+}
+
+//plain http stand-in for the simulation list scripts of the alien server
+class SimulationCatalogTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _server.Get("/alien-server/getsimulationinfo.php", [&](auto const& request, auto& response) {
+            std::lock_guard lock(_mutex);
+            auto since = request.get_param_value("since");
+            auto offset = std::stoi(request.get_param_value("offset"));
+            auto limit = std::stoi(request.get_param_value("limit"));
+
+            std::vector<ServerSimulation const*> page;
+            for (auto const& simulation : _simulations) {
+                if (simulation.timestamp >= since) {
+                    page.emplace_back(&simulation);
+                }
+            }
+            std::sort(page.begin(), page.end(), [](auto const& left, auto const& right) {
+                return std::make_pair(left->timestamp, left->id) < std::make_pair(right->timestamp, right->id);
+            });
+            page.erase(page.begin(), page.begin() + std::min<size_t>(offset, page.size()));
+            page.resize(std::min<size_t>(limit, page.size()));
+
+            std::vector<std::string> items;
+            for (auto const& simulation : page) {
+                items.emplace_back(
+                    "{\"id\":" + std::to_string(simulation->id) + ",\"simulationName\":\"sim " + std::to_string(simulation->id)
+                    + "\",\"userName\":\"user\",\"description\":\"\",\"width\":100,\"height\":50,\"particles\":0,\"version\":\"3.3.1\""
+                    + ",\"timestamp\":\"" + simulation->timestamp + "\",\"contentSize\":\"1000\",\"likes\":"
+                    + std::to_string(simulation->userLikes.size()) + ",\"numDownloads\":" + std::to_string(simulation->numDownloads) + "}");
+            }
+            _numTransferredEntries += static_cast<int>(page.size());
+            response.set_content("[" + boost::algorithm::join(items, ",") + "]", "text/plain");
+        });
+        _server.Get("/alien-server/getsimulationstats.php", [&](auto const&, auto& response) {
+            std::lock_guard lock(_mutex);
+            std::vector<std::string> items;
+            for (auto const& simulation : _simulations) {
+                items.emplace_back(
+                    "{\"id\":" + std::to_string(simulation.id) + ",\"likes\":" + std::to_string(simulation.userLikes.size())
+                    + ",\"numDownloads\":" + std::to_string(simulation.numDownloads) + "}");
+            }
+            response.set_content("[" + boost::algorithm::join(items, ",") + "]", "text/plain");
+        });
+        _server.Post("/alien-server/getuserlikesbatch.php", [&](auto const& request, auto& response) {
+            std::lock_guard lock(_mutex);
+            ++_numUserLikesRequests;
+            std::vector<std::string> simIds;
+            boost::split(simIds, request.get_param_value("simIds"), boost::is_any_of(","));
+            std::vector<std::string> items;
+            for (auto const& simulation : _simulations) {
+                if (std::find(simIds.begin(), simIds.end(), std::to_string(simulation.id)) == simIds.end()) {
+                    continue;
+                }
+                for (auto const& userName : simulation.userLikes) {
+                    items.emplace_back("{\"simId\":" + std::to_string(simulation.id) + ",\"userName\":\"" + userName + "\"}");
+                }
+            }
+            response.set_content("[" + boost::algorithm::join(items, ",") + "]", "text/plain");
+        });
+
+        _server.set_keep_alive_max_count(100);
+        _server.set_tcp_nodelay(true);
+        auto port = _server.bind_to_any_port("127.0.0.1");
+        _serverAddress = "http://127.0.0.1:" + std::to_string(port);
+        _serverThread = std::thread([&] { _server.listen_after_bind(); });
+
+        _networkService = std::make_shared<_NetworkService>(_serverAddress, 1);
+    }
+
+    void TearDown() override
+    {
+        _networkService.reset();  //closes the persistent connection
+        _server.stop();
+        _serverThread.join();
+    }
+
+    void addSimulations(int num)
+    {
+        std::lock_guard lock(_mutex);
+        for (int i = 0; i < num; ++i) {
+            ServerSimulation simulation;
+            simulation.id = _nextId++;
+            simulation.timestamp = getTimestamp(simulation.id / 10);
+            simulation.numDownloads = 0;
+            _simulations.emplace_back(simulation);
+        }
+    }
+
+    httplib::Server _server;
+    std::thread _serverThread;
+    std::string _serverAddress;
+    NetworkService _networkService;
+
+    std::mutex _mutex;
+    std::vector<ServerSimulation> _simulations;
+    int _nextId = 1;
+    int _numTransferredEntries = 0;
+    int _numUserLikesRequests = 0;
+};
+
+TEST_F(SimulationCatalogTests, ngramIndexMatchesSubstringSearch)
+{
+    std::vector<std::string> const words = {"Glider", "swarm", "Fluid", "rotor", "evolution", "ab", "Ecosystem", "gun", "Worm", "x"};
+    std::mt19937 randomEngine(42);
+    std::vector<std::string> texts;
+    for (int i = 0; i < 50000; ++i) {
+        std::string text;
+        for (int j = 0; j < 4; ++j) {
+            text += words[randomEngine() % words.size()] + (j < 3 ? " " : "\n");
+        }
+        texts.emplace_back(text + std::to_string(i));
+    }
+    NgramIndex index;
+    index.build(texts);
+
+    for (auto const& filter : {"", "x", "AB", "glider", "ROTOR gun", "worm\nec", "uid s", "12345", "missing", "flu"}) {
+        std::vector<int> expected;
+        for (int i = 0; i < static_cast<int>(texts.size()); ++i) {
+            if (boost::algorithm::to_lower_copy(texts[i]).find(boost::algorithm::to_lower_copy(std::string(filter))) != std::string::npos) {
+                expected.emplace_back(i);
+            }
+        }
+        EXPECT_EQ(expected, index.find(filter)) << "filter: " << filter;
+    }
+}
+
+TEST_F(SimulationCatalogTests, refreshFetchesOnlyNewSimulations)
+{
+    addSimulations(2500);
+    auto catalog = std::make_shared<_SimulationCatalog>(_serverAddress);
+    catalog->refresh(_networkService, false);
+    EXPECT_EQ(2500, catalog->getEntries().size());
+    EXPECT_EQ(2500, _numTransferredEntries);
+
+    _numTransferredEntries = 0;
+    addSimulations(20);
+    {
+        std::lock_guard lock(_mutex);
+        _simulations.erase(_simulations.begin(), _simulations.begin() + 5);
+        _simulations.front().numDownloads = 7;
+        _simulations.front().userLikes = {"user1", "user2"};
+    }
+    catalog->refresh(_networkService, false);
+
+    //only the new simulations and those of the previously latest timestamp are transferred again
+    EXPECT_LE(_numTransferredEntries, 30);
+    EXPECT_EQ(2515, catalog->getEntries().size());
+    std::set<std::string> ids;
+    for (auto const& entry : catalog->getEntries()) {
+        ids.insert(entry.id);
+        if (entry.id == "6") {
+            EXPECT_EQ(7, entry.numDownloads);
+            EXPECT_EQ(2, entry.likes);
+        }
+    }
+    EXPECT_EQ(2515, ids.size());
+    EXPECT_EQ(0, ids.count("5"));
+    EXPECT_EQ(1, ids.count("2520"));
+    EXPECT_EQ((std::set<std::string>{"user1", "user2"}), catalog->getUserLikes("6"));
+}
+
+TEST_F(SimulationCatalogTests, userLikesArePrefetchedInBatches)
+{
+    addSimulations(1200);
+    {
+        std::lock_guard lock(_mutex);
+        for (auto& simulation : _simulations) {
+            simulation.userLikes = {"user" + std::to_string(simulation.id % 3)};
+        }
+    }
+    auto catalog = std::make_shared<_SimulationCatalog>(_serverAddress);
+    catalog->refresh(_networkService, false);
+    EXPECT_EQ(3, _numUserLikesRequests);
+    EXPECT_EQ((std::set<std::string>{"user1"}), catalog->getUserLikes("100"));
+
+    //unchanged like counts do not require any further requests
+    catalog->refresh(_networkService, false);
+    EXPECT_EQ(3, _numUserLikesRequests);
+
+    catalog->setUserLike("100", "user2", true);
+    EXPECT_EQ((std::set<std::string>{"user1", "user2"}), catalog->getUserLikes("100"));
+}
+
+TEST_F(SimulationCatalogTests, catalogIsRestoredFromFile)
+{
+    addSimulations(100);
+    {
+        std::lock_guard lock(_mutex);
+        _simulations.at(10).userLikes = {"user"};
+    }
+    auto catalog = std::make_shared<_SimulationCatalog>(_serverAddress);
+    catalog->refresh(_networkService, false);
+
+    auto path = std::filesystem::temp_directory_path() / ("alien simulation catalog " + std::to_string(std::rand()) + ".bin");
+    catalog->save(path);
+
+    auto restoredCatalog = std::make_shared<_SimulationCatalog>(_serverAddress);
+    restoredCatalog->load(path);
+    ASSERT_EQ(catalog->getEntries().size(), restoredCatalog->getEntries().size());
+    for (size_t i = 0; i < catalog->getEntries().size(); ++i) {
+        EXPECT_EQ(catalog->getEntries()[i].getSearchText(), restoredCatalog->getEntries()[i].getSearchText());
+    }
+    EXPECT_EQ(catalog->getLatestTimestamp(), restoredCatalog->getLatestTimestamp());
+    EXPECT_EQ((std::set<std::string>{"user"}), restoredCatalog->getUserLikes("11"));
+
+    auto otherServerCatalog = std::make_shared<_SimulationCatalog>("other server");
+    otherServerCatalog->load(path);
+    EXPECT_TRUE(otherServerCatalog->getEntries().empty());
+
+    std::filesystem::remove(path);
+}
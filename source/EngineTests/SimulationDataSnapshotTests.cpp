@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include "EngineInterface/DescriptionHelper.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SimulationController.h"
+#include "EngineInterface/SimulationDataSnapshot.h"
+#include "IntegrationTestFramework.h"
+
+class SimulationDataSnapshotTests : public IntegrationTestFramework
+{
+public:
+    SimulationDataSnapshotTests()
+        : IntegrationTestFramework({1000, 1000})
+    {}
+
+    ~SimulationDataSnapshotTests() = default;
+};
+
+TEST_F(SimulationDataSnapshotTests, snapshotYieldsSameDataAsDirectAccess)
+{
+    DataDescription data = DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(10).height(10).center({100, 100}));
+    data.cells.at(0).metadata.name = "first cell";
+    data.cells.at(0).addToken(createSimpleToken());
+    data.cells.at(5).metadata.description = "description";
+    data.particles.emplace_back(ParticleDescription().setId(1000).setPos({500, 500}).setEnergy(10));
+    _simController->setSimulationData(data);
+
+    auto snapshot = _simController->getSimulationDataSnapshot();
+    auto expected = _simController->getClusteredSimulationData();
+
+    //the snapshot must not be affected by later changes of the simulation
+    _simController->calcSingleTimestep();
+    _simController->clear();
+
+    auto actual = snapshot->getClusteredData();
+    EXPECT_GT(snapshot->getSizeInBytes(), 0);
+    ASSERT_EQ(expected.clusters.size(), actual.clusters.size());
+    ASSERT_EQ(expected.particles.size(), actual.particles.size());
+    for (size_t i = 0; i < expected.clusters.size(); ++i) {
+        auto const& expectedCells = expected.clusters.at(i).cells;
+        auto const& actualCells = actual.clusters.at(i).cells;
+        ASSERT_EQ(expectedCells.size(), actualCells.size());
+        for (size_t j = 0; j < expectedCells.size(); ++j) {
+            EXPECT_EQ(expectedCells.at(j).id, actualCells.at(j).id);
+            EXPECT_EQ(expectedCells.at(j).pos, actualCells.at(j).pos);
+            EXPECT_EQ(expectedCells.at(j).metadata, actualCells.at(j).metadata);
+            EXPECT_EQ(expectedCells.at(j).tokens, actualCells.at(j).tokens);
+        }
+    }
+    EXPECT_EQ(expected.particles.at(0).id, actual.particles.at(0).id);
+    EXPECT_EQ(expected.particles.at(0).energy, actual.particles.at(0).energy);
+}
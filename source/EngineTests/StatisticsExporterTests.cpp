@@ -0,0 +1,94 @@
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/MonitorData.h"
+#include "EngineInterface/StatisticsExporter.h"
+
+class StatisticsExporterTests : public ::testing::Test
+{
+protected:
+    void TearDown() override { std::filesystem::remove(_filename); }
+
+    StatisticsTable createRandomTable(int numRows) const
+    {
+        std::mt19937 generator(0);
+        std::uniform_real_distribution<float> distribution(0.0f, 100000.0f);
+        StatisticsTable result;
+        for (int i = 0; i < numRows; ++i) {
+            StatisticsSample sample;
+            for (auto& value : sample) {
+                value = distribution(generator);
+            }
+            result.add(static_cast<uint64_t>(i) * 1000 + 7, sample);
+        }
+        return result;
+    }
+
+    std::vector<std::string> readLines() const
+    {
+        std::ifstream file(_filename);
+        std::vector<std::string> result;
+        std::string line;
+        while (std::getline(file, line)) {
+            result.emplace_back(line);
+        }
+        return result;
+    }
+
+    std::string const _filename = (std::filesystem::temp_directory_path() / "statistics_exporter_tests.tmp").string();
+};
+
+TEST_F(StatisticsExporterTests, columnarRoundTrip)
+{
+    auto table = createRandomTable(10000);
+    for (auto compressed : {false, true}) {
+        ASSERT_TRUE(StatisticsExporter::writeColumnar(_filename, table, compressed));
+
+        StatisticsTable readTable;
+        ASSERT_TRUE(StatisticsExporter::readColumnar(readTable, _filename));
+        EXPECT_EQ(table.timesteps, readTable.timesteps);
+        EXPECT_EQ(table.columns, readTable.columns);
+    }
+}
+
+TEST_F(StatisticsExporterTests, csvValuesRoundTrip)
+{
+    auto table = createRandomTable(100);
+    ASSERT_TRUE(StatisticsExporter::writeCsv(_filename, table));
+
+    auto lines = readLines();
+    ASSERT_EQ(101, lines.size());
+    EXPECT_EQ(StatisticsExporter::getCsvHeader(), lines.front() + "\n");
+    for (int row = 0; row < 100; ++row) {
+        std::istringstream stream(lines[row + 1]);
+        std::string value;
+        std::getline(stream, value, ',');
+        EXPECT_EQ(table.timesteps[row], std::stoull(value));
+        for (int i = 0; i < NumStatisticsSeries; ++i) {
+            std::getline(stream, value, ',');
+            EXPECT_EQ(table.columns[i][row], std::stof(value));
+        }
+    }
+}
+
+TEST_F(StatisticsExporterTests, recorderAppendsSamples)
+{
+    {
+        _StatisticsRecorder recorder(_filename);
+        ASSERT_TRUE(recorder.isValid());
+        MonitorData statistics;
+        for (int i = 0; i < 1000; ++i) {
+            statistics.timestep = i / 2;
+            statistics.numParticles = i;
+            recorder.add(statistics);
+        }
+        EXPECT_EQ(500, recorder.getNumSamples());
+    }
+    auto lines = readLines();
+    ASSERT_EQ(501, lines.size());
+    EXPECT_EQ("499, 0, 0, 0, 0, 0, 0, 0, 0, 0, 998, 0, 0, 0, 0, 0", lines.back());
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include "Base/RingBuffer.h"
+#include "EngineInterface/MonitorData.h"
+#include "EngineInterface/StatisticsHistory.h"
+
+class StatisticsHistoryTests : public ::testing::Test
+{
+protected:
+    MonitorData createMonitorData(uint64_t timestep, int numParticles) const
+    {
+        MonitorData result;
+        result.timestep = timestep;
+        result.numParticles = numParticles;
+        return result;
+    }
+};
+
+TEST_F(StatisticsHistoryTests, ringBufferIsContiguousAfterWrapAround)
+{
+    RingBuffer<int> buffer(4);
+    for (int i = 0; i < 10; ++i) {
+        buffer.add(i);
+    }
+    EXPECT_EQ(4, buffer.size());
+    EXPECT_EQ(4, buffer.capacity());
+    auto data = buffer.data();
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(6 + i, data[i]);
+    }
+    EXPECT_EQ(6, buffer.front());
+    EXPECT_EQ(9, buffer.back());
+}
+
+TEST_F(StatisticsHistoryTests, ringBufferPopFront)
+{
+    RingBuffer<int> buffer(3);
+    buffer.add(1);
+    buffer.add(2);
+    buffer.add(3);
+    buffer.popFront();
+    buffer.add(4);
+    buffer.add(5);
+    EXPECT_EQ(3, buffer.size());
+    EXPECT_EQ(3, buffer.at(0));
+    EXPECT_EQ(4, buffer.at(1));
+    EXPECT_EQ(5, buffer.at(2));
+}
+
+TEST_F(StatisticsHistoryTests, ringBufferAppendDoesNotReallocate)
+{
+    RingBuffer<float> buffer(1000);
+    buffer.add(0);
+    auto storageBegin = buffer.data();
+    for (int i = 1; i < 100000; ++i) {
+        buffer.add(toFloat(i));
+        EXPECT_GE(buffer.data(), storageBegin);
+        EXPECT_LT(buffer.data(), storageBegin + 1000);
+    }
+    EXPECT_EQ(1000, buffer.size());
+    EXPECT_EQ(99999.0f, buffer.back());
+}
+
+TEST_F(StatisticsHistoryTests, rollupMinMaxMean)
+{
+    StatisticsRollup rollup(10, 100);
+    StatisticsSample sample{};
+    for (uint64_t timestep = 0; timestep < 25; ++timestep) {
+        sample[0] = toFloat(timestep);
+        rollup.add(timestep, sample);
+    }
+
+    //third interval [20, 30) is still pending
+    ASSERT_EQ(2, rollup.timestepHistory.size());
+    EXPECT_EQ(0.0f, rollup.timestepHistory.at(0));
+    EXPECT_EQ(10.0f, rollup.timestepHistory.at(1));
+    EXPECT_EQ(0.0f, rollup.mins[0].at(0));
+    EXPECT_EQ(9.0f, rollup.maxs[0].at(0));
+    EXPECT_FLOAT_EQ(4.5f, rollup.means[0].at(0));
+    EXPECT_EQ(10.0f, rollup.mins[0].at(1));
+    EXPECT_EQ(19.0f, rollup.maxs[0].at(1));
+    EXPECT_FLOAT_EQ(14.5f, rollup.means[0].at(1));
+}
+
+TEST_F(StatisticsHistoryTests, rollupWithSparseSamples)
+{
+    StatisticsRollup rollup(100, 100);
+    StatisticsSample sample{};
+    sample[9] = 2.0f;
+    rollup.add(30, sample);
+    sample[9] = 4.0f;
+    rollup.add(450, sample);
+    sample[9] = 8.0f;
+    rollup.add(460, sample);
+    sample[9] = 1.0f;
+    rollup.add(1000, sample);
+
+    ASSERT_EQ(2, rollup.timestepHistory.size());
+    EXPECT_EQ(0.0f, rollup.timestepHistory.at(0));
+    EXPECT_EQ(400.0f, rollup.timestepHistory.at(1));
+    EXPECT_EQ(2.0f, rollup.means[9].at(0));
+    EXPECT_EQ(4.0f, rollup.mins[9].at(1));
+    EXPECT_EQ(8.0f, rollup.maxs[9].at(1));
+    EXPECT_EQ(6.0f, rollup.means[9].at(1));
+}
+
+TEST_F(StatisticsHistoryTests, longtermStatisticsSelectsFinestCompleteRollup)
+{
+    auto bytesPerEntry = (1 + 3 * NumStatisticsSeries) * sizeof(float) * 2;
+    LongtermStatistics statistics(bytesPerEntry * LongtermStatistics::Resolutions.size() * 5);
+    ASSERT_EQ(5, statistics.rollups.front().timestepHistory.capacity());
+
+    for (uint64_t timestep = 0; timestep <= 300; ++timestep) {
+        statistics.add(createMonitorData(timestep, 1));
+    }
+    EXPECT_EQ(100, statistics.getBestRollup().resolution);
+    EXPECT_EQ(3, statistics.getBestRollup().timestepHistory.size());
+
+    for (uint64_t timestep = 301; timestep <= 10000; ++timestep) {
+        statistics.add(createMonitorData(timestep, 1));
+    }
+    EXPECT_EQ(1000, statistics.getBestRollup().resolution);
+    EXPECT_EQ(5, statistics.getBestRollup().timestepHistory.size());
+    EXPECT_EQ(9000.0f, statistics.getBestRollup().timestepHistory.back());
+}
+
+TEST_F(StatisticsHistoryTests, longtermStatisticsIgnoresRepeatedTimesteps)
+{
+    LongtermStatistics statistics;
+    statistics.add(createMonitorData(0, 10));
+    for (int i = 0; i < 100; ++i) {
+        statistics.add(createMonitorData(5, 0));
+    }
+    statistics.add(createMonitorData(10, 0));
+
+    auto const& rollup = statistics.getBestRollup();
+    EXPECT_EQ(10, rollup.resolution);
+    ASSERT_EQ(1, rollup.timestepHistory.size());
+    EXPECT_EQ(5.0f, rollup.means[9].at(0));
+}
+
+TEST_F(StatisticsHistoryTests, longtermStatisticsMemoryCap)
+{
+    auto memoryCap = size_t(1024 * 1024);
+    auto capacity = LongtermStatistics::getCapacity(memoryCap);
+    auto bytesPerEntry = (1 + 3 * NumStatisticsSeries) * sizeof(float) * 2;
+    EXPECT_LE(capacity * bytesPerEntry * LongtermStatistics::Resolutions.size(), memoryCap);
+
+    LongtermStatistics statistics(memoryCap);
+    for (auto const& rollup : statistics.rollups) {
+        EXPECT_EQ(capacity, rollup.timestepHistory.capacity());
+    }
+}
@@ -0,0 +1,321 @@
+#include <algorithm>
+#include <random>
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "EngineGpuKernels/StructuralOperationSegments.cuh"
+#include "EngineInterface/DescriptionHelper.h"
+#include "EngineInterface/MonitorData.h"
+#include "EngineInterface/SimulationController.h"
+#include "IntegrationTestFramework.h"
+
+namespace
+{
+    class TestCells
+    {
+    public:
+        struct TestCell
+        {
+            int maxConnections = 0;
+            std::vector<int> connections;
+            bool deleted = false;
+        };
+        std::vector<TestCell> cells;
+
+        int getNumConnections(int cellIndex) const { return static_cast<int>(cells[cellIndex].connections.size()); }
+        int getMaxConnections(int cellIndex) const { return cells[cellIndex].maxConnections; }
+        int getConnectedCellIndex(int cellIndex, int i) const { return cells[cellIndex].connections[i]; }
+        bool isConnected(int cellIndex, int otherCellIndex) const
+        {
+            auto const& connections = cells[cellIndex].connections;
+            return std::find(connections.begin(), connections.end(), otherCellIndex) != connections.end();
+        }
+
+        void delConnectionOneWay(int cellIndex, int otherCellIndex)
+        {
+            auto& connections = cells[cellIndex].connections;
+            connections.erase(std::remove(connections.begin(), connections.end(), otherCellIndex), connections.end());
+        }
+        void delConnectionsOneWay(int cellIndex) { cells[cellIndex].connections.clear(); }
+        void addConnectionOneWay(int cellIndex, int otherCellIndex, int) { cells[cellIndex].connections.emplace_back(otherCellIndex); }
+        void delCell(int cellIndex, int)
+        {
+            if (cells[cellIndex].connections.empty()) {
+                cells[cellIndex].deleted = true;
+            }
+        }
+    };
+
+    using Processor = HostStructuralOperationProcessor<TestCells>;
+    using Operation = Processor::Operation;
+}
+
+class StructuralOperationTests : public ::testing::Test
+{
+protected:
+    TestCells createRandomCells(int numCells, std::mt19937& generator) const
+    {
+        TestCells result;
+        result.cells.resize(numCells);
+        for (auto& cell : result.cells) {
+            cell.maxConnections = std::uniform_int_distribution<int>(1, 6)(generator);
+        }
+        std::uniform_int_distribution<int> cellDistribution(0, numCells - 1);
+        for (int i = 0; i < numCells; ++i) {
+            auto cellIndex = cellDistribution(generator);
+            auto otherCellIndex = cellDistribution(generator);
+            if (cellIndex != otherCellIndex && !result.isConnected(cellIndex, otherCellIndex)
+                && result.getNumConnections(cellIndex) < result.getMaxConnections(cellIndex)
+                && result.getNumConnections(otherCellIndex) < result.getMaxConnections(otherCellIndex)) {
+                result.addConnectionOneWay(cellIndex, otherCellIndex, 0);
+                result.addConnectionOneWay(otherCellIndex, cellIndex, 0);
+            }
+        }
+        return result;
+    }
+
+    Operation createRandomOperation(int numCells, std::mt19937& generator) const
+    {
+        std::uniform_int_distribution<int> cellDistribution(0, numCells - 1);
+        auto type = static_cast<StructuralOperationType>(std::uniform_int_distribution<int>(0, 4)(generator));
+        auto cellIndex = cellDistribution(generator);
+        auto otherCellIndex = cellIndex;
+        while (otherCellIndex == cellIndex) {
+            otherCellIndex = cellDistribution(generator);
+        }
+        return {type, cellIndex, otherCellIndex};
+    }
+
+    //current semantics: operations are applied one after another, cell deletions after all connection changes
+    void processSequentially(TestCells& cells, std::vector<Operation> const& operations) const
+    {
+        std::vector<int> cellsToDelete;
+        for (auto const& operation : operations) {
+            auto cellIndex = operation.cellIndex;
+            auto otherCellIndex = operation.otherCellIndex;
+            switch (operation.type) {
+            case StructuralOperationType::AddConnections:
+                if (!cells.isConnected(cellIndex, otherCellIndex) && cells.getNumConnections(cellIndex) < cells.getMaxConnections(cellIndex)
+                    && cells.getNumConnections(otherCellIndex) < cells.getMaxConnections(otherCellIndex)) {
+                    cells.addConnectionOneWay(cellIndex, otherCellIndex, 0);
+                    cells.addConnectionOneWay(otherCellIndex, cellIndex, 0);
+                }
+                break;
+            case StructuralOperationType::DelConnection:
+                cells.delConnectionOneWay(cellIndex, otherCellIndex);
+                cells.delConnectionOneWay(otherCellIndex, cellIndex);
+                break;
+            case StructuralOperationType::DelConnections:
+            case StructuralOperationType::DelCellAndConnections:
+                for (auto connectedCellIndex : cells.cells[cellIndex].connections) {
+                    cells.delConnectionOneWay(connectedCellIndex, cellIndex);
+                }
+                cells.delConnectionsOneWay(cellIndex);
+                if (StructuralOperationType::DelCellAndConnections == operation.type) {
+                    cellsToDelete.emplace_back(cellIndex);
+                }
+                break;
+            case StructuralOperationType::DelCell:
+                cellsToDelete.emplace_back(cellIndex);
+                break;
+            }
+        }
+        for (auto cellIndex : cellsToDelete) {
+            cells.delCell(cellIndex, 0);
+        }
+    }
+
+    std::set<int> getAffectedCells(TestCells const& cells, Operation const& operation) const
+    {
+        std::set<int> result{operation.cellIndex};
+        if (StructuralOperationType::AddConnections == operation.type || StructuralOperationType::DelConnection == operation.type) {
+            result.insert(operation.otherCellIndex);
+        }
+        if (StructuralOperationType::DelConnections == operation.type || StructuralOperationType::DelCellAndConnections == operation.type) {
+            auto const& connections = cells.cells[operation.cellIndex].connections;
+            result.insert(connections.begin(), connections.end());
+        }
+        return result;
+    }
+
+    void checkConsistency(TestCells const& cells) const
+    {
+        for (int cellIndex = 0; cellIndex < static_cast<int>(cells.cells.size()); ++cellIndex) {
+            auto const& cell = cells.cells[cellIndex];
+            EXPECT_LE(cell.connections.size(), cell.maxConnections);
+            EXPECT_EQ(cell.connections.size(), std::set<int>(cell.connections.begin(), cell.connections.end()).size());
+            for (auto connectedCellIndex : cell.connections) {
+                EXPECT_TRUE(cells.isConnected(connectedCellIndex, cellIndex));
+            }
+            if (cell.deleted) {
+                EXPECT_TRUE(cell.connections.empty());
+            }
+        }
+    }
+};
+
+TEST_F(StructuralOperationTests, independentOperationsMatchSequentialProcessing)
+{
+    std::mt19937 generator(0);
+    auto cells = createRandomCells(2000, generator);
+
+    std::vector<Operation> operations;
+    std::set<int> affectedCells;
+    for (int i = 0; i < 2000; ++i) {
+        auto operation = createRandomOperation(2000, generator);
+        auto operationCells = getAffectedCells(cells, operation);
+        auto isIndependent = std::none_of(operationCells.begin(), operationCells.end(), [&](int cellIndex) { return affectedCells.count(cellIndex) > 0; });
+        if (isIndependent) {
+            operations.emplace_back(operation);
+            affectedCells.insert(operationCells.begin(), operationCells.end());
+        }
+    }
+    ASSERT_GT(operations.size(), 100);
+
+    auto expectedCells = cells;
+    processSequentially(expectedCells, operations);
+    Processor().process(cells, operations);
+
+    for (int cellIndex = 0; cellIndex < 2000; ++cellIndex) {
+        auto const& expected = expectedCells.cells[cellIndex];
+        auto const& actual = cells.cells[cellIndex];
+        EXPECT_EQ(std::set<int>(expected.connections.begin(), expected.connections.end()), std::set<int>(actual.connections.begin(), actual.connections.end()));
+        EXPECT_EQ(expected.deleted, actual.deleted);
+    }
+}
+
+TEST_F(StructuralOperationTests, conflictingOperationsKeepConnectionsConsistent)
+{
+    std::mt19937 generator(1);
+    auto cells = createRandomCells(200, generator);
+
+    for (int step = 0; step < 20; ++step) {
+        std::vector<Operation> operations;
+        while (operations.size() < 1000) {
+            auto operation = createRandomOperation(200, generator);
+            if (!cells.cells[operation.cellIndex].deleted && !cells.cells[operation.otherCellIndex].deleted) {
+                operations.emplace_back(operation);
+            }
+        }
+        Processor().process(cells, operations);
+        checkConsistency(cells);
+    }
+}
+
+TEST_F(StructuralOperationTests, connectionsAreGrantedByFreeBondsOfBothCells)
+{
+    TestCells cells;
+    cells.cells.resize(6);
+    for (auto& cell : cells.cells) {
+        cell.maxConnections = 6;
+    }
+    cells.cells[0].maxConnections = 2;
+
+    Processor().process(
+        cells,
+        {{StructuralOperationType::AddConnections, 3, 0},
+         {StructuralOperationType::AddConnections, 0, 1},
+         {StructuralOperationType::AddConnections, 0, 2},
+         {StructuralOperationType::AddConnections, 4, 5},
+         {StructuralOperationType::AddConnections, 5, 4}});
+
+    EXPECT_EQ(std::vector<int>({1, 2}), cells.cells[0].connections);
+    EXPECT_TRUE(cells.cells[3].connections.empty());
+    EXPECT_EQ(std::vector<int>({5}), cells.cells[4].connections);
+    EXPECT_EQ(std::vector<int>({4}), cells.cells[5].connections);
+    checkConsistency(cells);
+}
+
+TEST_F(StructuralOperationTests, deletionsPrecedeConnectionsOfSameTimestep)
+{
+    TestCells cells;
+    cells.cells.resize(3);
+    for (auto& cell : cells.cells) {
+        cell.maxConnections = 1;
+    }
+    cells.addConnectionOneWay(0, 1, 0);
+    cells.addConnectionOneWay(1, 0, 0);
+
+    Processor().process(
+        cells,
+        {{StructuralOperationType::AddConnections, 0, 2},
+         {StructuralOperationType::DelCellAndConnections, 1, -1}});
+
+    EXPECT_EQ(std::vector<int>({2}), cells.cells[0].connections);
+    EXPECT_TRUE(cells.cells[1].deleted);
+    checkConsistency(cells);
+}
+
+//the same processing on the engine: cells below cellMinEnergy schedule the deletion of themselves and their connections
+class StructuralOperationEngineTests : public IntegrationTestFramework
+{
+public:
+    StructuralOperationEngineTests()
+        : IntegrationTestFramework({100, 100})
+    {}
+
+protected:
+    void SetUp() override
+    {
+        auto parameters = _simController->getSimulationParameters();
+        parameters.radiationProb = 0;
+        parameters.spotValues.tokenMutationRate = 0;
+        parameters.spotValues.cellMutationRate = 0;
+        _simController->setSimulationParameters_async(parameters);
+    }
+
+    void checkConsistency(DataDescription const& data) const
+    {
+        auto cellById = getCellById(data);
+        for (auto const& cell : data.cells) {
+            EXPECT_LE(cell.connections.size(), cell.maxConnections);
+            for (auto const& connection : cell.connections) {
+                ASSERT_TRUE(cellById.count(connection.cellId) > 0);
+                auto const& otherConnections = cellById.at(connection.cellId).connections;
+                EXPECT_TRUE(std::any_of(otherConnections.begin(), otherConnections.end(), [&](auto const& otherConnection) {
+                    return otherConnection.cellId == cell.id;
+                }));
+            }
+        }
+    }
+};
+
+TEST_F(StructuralOperationEngineTests, dyingCellsAreRemovedWithTheirConnections)
+{
+    auto data = DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(10).height(10).center({50, 50}));
+    std::set<uint64_t> dyingCellIds;
+    for (auto& cell : data.cells) {
+        if (cell.pos.x < 50) {
+            cell.energy = 1;
+            dyingCellIds.insert(cell.id);
+        }
+    }
+    _simController->setSimulationData(data);
+    _simController->calcSingleTimestep();
+    _simController->calcSingleTimestep();
+
+    auto result = _simController->getSimulationData();
+    EXPECT_EQ(data.cells.size() - dyingCellIds.size(), result.cells.size());
+    for (auto const& cell : result.cells) {
+        EXPECT_EQ(0, dyingCellIds.count(cell.id));
+    }
+    checkConsistency(result);
+    EXPECT_EQ(0, _simController->getStatistics().numDroppedStructuralOperations);
+}
+
+TEST_F(StructuralOperationEngineTests, droppedOperationsResizeQueue)
+{
+    _simController->setSimulationData(
+        DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(80).height(80).energy(1).center({50, 50})));
+
+    //dropped operations are scheduled again in the next time step since the cells are still below cellMinEnergy
+    for (int i = 0; i < 20; ++i) {
+        _simController->calcSingleTimestep();
+    }
+
+    auto result = _simController->getSimulationData();
+    EXPECT_TRUE(result.cells.empty());
+    auto statistics = _simController->getStatistics();
+    EXPECT_EQ(statistics.numDroppedStructuralOperations > 0, statistics.numStructuralOperationQueueResizes > 0);
+}
@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "Base/NumberGenerator.h"
+#include "Base/ParallelAlgorithms.h"
+#include "Base/ThreadPool.h"
+#include "EngineInterface/DescriptionHelper.h"
+
+class ThreadPoolTests : public ::testing::Test
+{
+protected:
+    void SetUp() override { ThreadPool::getInstance().setNumThreads(4); }
+    void TearDown() override { ThreadPool::getInstance().setNumThreads(0); }
+};
+
+TEST_F(ThreadPoolTests, parallelForVisitsEachIndexOnce)
+{
+    std::vector<std::atomic<int>> numVisits(100003);
+    ParallelAlgorithms::parallelFor(3, 100003, [&](int index) { ++numVisits[index]; });
+    for (int i = 0; i < 100003; ++i) {
+        EXPECT_EQ(i < 3 ? 0 : 1, numVisits[i].load()) << "index: " << i;
+    }
+}
+
+TEST_F(ThreadPoolTests, parallelReduceIsDeterministic)
+{
+    std::mt19937 randomEngine(42);
+    std::uniform_real_distribution<float> distribution(-1000.0f, 1000.0f);
+    std::vector<float> values(1000000);
+    for (auto& value : values) {
+        value = distribution(randomEngine);
+    }
+    auto sum = [&] {
+        return ParallelAlgorithms::parallelReduce(
+            0, toInt(values.size()), 0.0f, [&](int index) { return values[index]; }, std::plus<>());
+    };
+
+    auto expected = sum();
+    for (auto numThreads : {1, 3, 8}) {
+        ThreadPool::getInstance().setNumThreads(numThreads);
+        EXPECT_EQ(expected, sum());
+    }
+    EXPECT_NEAR(std::accumulate(values.begin(), values.end(), 0.0), expected, 1.0);
+
+    auto count = ParallelAlgorithms::parallelReduce(
+        0, 12345, int64_t(0), [](int index) { return int64_t(index); }, std::plus<>());
+    EXPECT_EQ(int64_t(12344) * 12345 / 2, count);
+}
+
+TEST_F(ThreadPoolTests, parallelSortMatchesSerialSort)
+{
+    std::mt19937 randomEngine(42);
+    for (auto size : {0, 10, 20000, 1000003}) {
+        std::vector<uint32_t> values(size);
+        for (auto& value : values) {
+            value = randomEngine() % 1000;
+        }
+        auto expected = values;
+        std::sort(expected.begin(), expected.end(), std::greater<>());
+        ParallelAlgorithms::parallelSort(values.begin(), values.end(), std::greater<>());
+        EXPECT_EQ(expected, values) << "size: " << size;
+    }
+}
+
+TEST_F(ThreadPoolTests, exceptionIsRethrown)
+{
+    std::atomic<int> numExecutedTasks = 0;
+    TaskGroup group;
+    for (int i = 0; i < 1000; ++i) {
+        group.run([&, i] {
+            ++numExecutedTasks;
+            if (i == 10) {
+                throw std::runtime_error("task failed");
+            }
+        });
+    }
+    EXPECT_THROW(group.wait(), std::runtime_error);
+    EXPECT_TRUE(group.isCanceled());
+
+    EXPECT_THROW(ParallelAlgorithms::parallelFor(0, 1000, [](int index) {
+        if (index == 500) {
+            throw std::runtime_error("index failed");
+        }
+    }), std::runtime_error);
+}
+
+TEST_F(ThreadPoolTests, canceledTasksAreSkipped)
+{
+    std::atomic<bool> release = false;
+    std::atomic<int> numExecutedTasks = 0;
+    TaskGroup group;
+    for (int i = 0; i < 1000; ++i) {
+        group.run([&] {
+            while (!release) {
+                std::this_thread::yield();
+            }
+            ++numExecutedTasks;
+        });
+    }
+    group.cancel();
+    release = true;
+    group.wait();
+
+    //only tasks already started before cancellation have been executed
+    EXPECT_LE(numExecutedTasks.load(), ThreadPool::getInstance().getNumThreads() + 1);
+}
+
+TEST_F(ThreadPoolTests, nestedParallelismDoesNotDeadlock)
+{
+    std::atomic<int> numVisits = 0;
+    ParallelAlgorithms::parallelFor(0, 64, [&](int) {
+        ParallelAlgorithms::parallelFor(0, 64, [&](int) {
+            ParallelAlgorithms::parallelFor(0, 64, [&](int) { ++numVisits; });
+        });
+    });
+    EXPECT_EQ(64 * 64 * 64, numVisits.load());
+}
+
+TEST_F(ThreadPoolTests, gridMultiplyIsIndependentOfNumberOfThreads)
+{
+    DataDescription input;
+    for (int i = 0; i < 50; ++i) {
+        input.addCell(CellDescription().setId(i + 1).setPos({toFloat(i % 10), toFloat(i / 10)}).setMaxConnections(2));
+    }
+    for (int i = 0; i + 1 < 50; ++i) {
+        input.cells.at(i).connections.emplace_back(ConnectionDescription{static_cast<uint64_t>(i + 2), 1.0f, 0});
+        input.cells.at(i + 1).connections.emplace_back(ConnectionDescription{static_cast<uint64_t>(i + 1), 1.0f, 0});
+    }
+    auto parameters = DescriptionHelper::GridMultiplyParameters().horizontalNumber(13).verticalNumber(7).horizontalAngleInc(10.0f);
+
+    auto multiply = [&](int numThreads) {
+        ThreadPool::getInstance().setNumThreads(numThreads);
+        NumberGenerator::getInstance().setSeed(1);
+        return DescriptionHelper::gridMultiply(input, parameters);
+    };
+    auto expected = multiply(1);
+    auto actual = multiply(8);
+
+    ASSERT_EQ(50 * 13 * 7, expected.cells.size());
+    ASSERT_EQ(expected.cells.size(), actual.cells.size());
+    std::unordered_set<uint64_t> ids;
+    for (size_t i = 0; i < expected.cells.size(); ++i) {
+        auto const& expectedCell = expected.cells[i];
+        auto const& actualCell = actual.cells[i];
+        EXPECT_EQ(expectedCell.id, actualCell.id);
+        EXPECT_EQ(expectedCell.pos, actualCell.pos);
+        ASSERT_EQ(expectedCell.connections.size(), actualCell.connections.size());
+        for (size_t j = 0; j < expectedCell.connections.size(); ++j) {
+            EXPECT_EQ(expectedCell.connections[j].cellId, actualCell.connections[j].cellId);
+        }
+        ids.insert(actualCell.id);
+    }
+    EXPECT_EQ(actual.cells.size(), ids.size());
+}
@@ -1,29 +1,97 @@
 #include "AutosaveController.h"
 
+#include <filesystem>
+
 #include <imgui.h>
 
+#include "Base/LoggingService.h"
 #include "Base/Resources.h"
+#include "Base/StringHelper.h"
 #include "EngineInterface/Serializer.h"
+#include "EngineInterface/SimulationDataSnapshot.h"
 #include "GlobalSettings.h"
 
+namespace
+{
+    //simulation file followed by the files for settings and symbols (same naming as in Serializer)
+    std::vector<std::filesystem::path> getFiles(std::filesystem::path const& simulationFile)
+    {
+        auto settingsFile = simulationFile;
+        settingsFile.replace_extension(".settings.json");
+        auto symbolsFile = simulationFile;
+        symbolsFile.replace_extension(".symbols.json");
+        return {simulationFile, settingsFile, symbolsFile};
+    }
+
+    //generation 0 is the newest one, e.g. "autosave.sim", "autosave.1.sim", "autosave.2.sim", ...
+    std::filesystem::path getGenerationFile(std::filesystem::path const& simulationFile, std::string const& generation)
+    {
+        auto result = simulationFile;
+        return result.replace_extension("." + generation + simulationFile.extension().string());
+    }
+
+    //the newest generation is replaced by renaming so that it is complete at any time, throws std::filesystem::filesystem_error
+    void rotateAndReplace(std::filesystem::path const& simulationFile, std::filesystem::path const& tempFile, int numGenerations)
+    {
+        for (int generation = numGenerations - 1; generation > 0; --generation) {
+            auto sourceFiles = getFiles(generation == 1 ? simulationFile : getGenerationFile(simulationFile, std::to_string(generation - 1)));
+            auto targetFiles = getFiles(getGenerationFile(simulationFile, std::to_string(generation)));
+            for (size_t i = 0; i < sourceFiles.size(); ++i) {
+                if (!std::filesystem::exists(sourceFiles[i])) {
+                    continue;
+                }
+                if (generation == 1) {
+                    std::filesystem::copy_file(sourceFiles[i], targetFiles[i], std::filesystem::copy_options::overwrite_existing);
+                } else {
+                    std::filesystem::rename(sourceFiles[i], targetFiles[i]);
+                }
+            }
+        }
+        auto sourceFiles = getFiles(tempFile);
+        auto targetFiles = getFiles(simulationFile);
+        for (size_t i = 0; i < sourceFiles.size(); ++i) {
+            std::filesystem::rename(sourceFiles[i], targetFiles[i]);
+        }
+    }
+
+    uint64_t getSizeInBytes(std::filesystem::path const& simulationFile)
+    {
+        uint64_t result = 0;
+        for (auto const& file : getFiles(simulationFile)) {
+            std::error_code error;
+            auto size = std::filesystem::file_size(file, error);
+            result += error ? 0 : size;
+        }
+        return result;
+    }
+}
+
 _AutosaveController::_AutosaveController(SimulationController const& simController)
     : _simController(simController)
 {
-    _startTimePoint = std::chrono::steady_clock::now();
-    _on = GlobalSettings::getInstance().getBoolState("controllers.auto save.active", true);
+    _lastSaveTimepoint = std::chrono::steady_clock::now();
+    auto& settings = GlobalSettings::getInstance();
+    _on = settings.getBoolState("controllers.auto save.active", true);
+    _interval = settings.getIntState("controllers.auto save.interval", 20);
+    _numGenerations = settings.getIntState("controllers.auto save.generations", 3);
 }
 
 _AutosaveController::~_AutosaveController()
 {
-    GlobalSettings::getInstance().setBoolState("controllers.auto save.active", _on);
+    auto& settings = GlobalSettings::getInstance();
+    settings.setBoolState("controllers.auto save.active", _on);
+    settings.setIntState("controllers.auto save.interval", _interval);
+    settings.setIntState("controllers.auto save.generations", _numGenerations);
 }
 
 void _AutosaveController::shutdown()
 {
+    processSaveResult(true);
     if (!_on) {
         return;
     }
     onSave();
+    processSaveResult(true);
 }
 
 bool _AutosaveController::isOn() const
@@ -36,28 +104,81 @@ void _AutosaveController::setOn(bool value)
     _on = value;
 }
 
+int _AutosaveController::getInterval() const
+{
+    return _interval;
+}
+
+void _AutosaveController::setInterval(int value)
+{
+    _interval = std::max(1, value);
+}
+
 void _AutosaveController::process()
 {
-    if (!_on) {
+    processSaveResult(false);
+    if (!_on || _saveResult.valid()) {
         return;
     }
 
-    auto durationSinceStart = std::chrono::duration_cast<std::chrono::minutes>(std::chrono::steady_clock::now() - *_startTimePoint).count();
-    if (durationSinceStart > 0 && durationSinceStart % 20 == 0 && !_alreadySaved) {
+    if (std::chrono::steady_clock::now() - _lastSaveTimepoint >= std::chrono::minutes(_interval)) {
         onSave();
-        _alreadySaved = true;
-    }
-    if (durationSinceStart > 0 && durationSinceStart % 20 == 1 && _alreadySaved) {
-        _alreadySaved = false;
     }
 }
 
 void _AutosaveController::onSave()
 {
-    DeserializedSimulation sim;
-    sim.timestep = _simController->getCurrentTimestep();
-    sim.settings = _simController->getSettings();
-    sim.symbolMap = _simController->getSymbolMap();
-    sim.content = _simController->getClusteredSimulationData();
-    Serializer::serializeSimulationToFiles(Const::AutosaveFile, sim);
+    _lastSaveTimepoint = std::chrono::steady_clock::now();
+
+    auto sim = std::make_shared<DeserializedSimulation>();
+    sim->timestep = _simController->getCurrentTimestep();
+    sim->settings = _simController->getSettings();
+    sim->symbolMap = _simController->getSymbolMap();
+    auto snapshot = _simController->getSimulationDataSnapshot();
+
+    auto blockingDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _lastSaveTimepoint);
+    log(Priority::Important,
+        "autosave: snapshot of " + StringHelper::format(snapshot->getSizeInBytes() / 1024) + " KB taken in "
+            + std::to_string(blockingDuration.count()) + " ms");
+
+    //conversion, serialization and compression do not block the simulation or the user interface
+    auto numGenerations = std::max(1, _numGenerations);
+    _saveResult = std::async(std::launch::async, [sim, snapshot, numGenerations] {
+        auto startTimepoint = std::chrono::steady_clock::now();
+        SaveResult result;
+
+        std::filesystem::path simulationFile(Const::AutosaveFile);
+        auto tempFile = getGenerationFile(simulationFile, "tmp");
+        try {
+            sim->content = snapshot->getClusteredData();
+            if (Serializer::serializeSimulationToFiles(tempFile.string(), *sim)) {
+                result.numBytes = getSizeInBytes(tempFile);
+                rotateAndReplace(simulationFile, tempFile, numGenerations);
+                result.succeeded = true;
+            }
+        } catch (std::exception const& e) {
+            result.errorMessage = e.what();
+        }
+        result.duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint);
+        return result;
+    });
+}
+
+void _AutosaveController::processSaveResult(bool wait)
+{
+    if (!_saveResult.valid()) {
+        return;
+    }
+    if (!wait && _saveResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return;
+    }
+    auto result = _saveResult.get();
+    if (!result.succeeded) {
+        log(Priority::Important,
+            "autosave: simulation could not be saved" + (result.errorMessage.empty() ? std::string() : ": " + result.errorMessage));
+        return;
+    }
+    log(Priority::Important,
+        "autosave: " + StringHelper::format(result.numBytes / 1024) + " KB written in "
+            + std::to_string(result.duration.count()) + " ms");
 }
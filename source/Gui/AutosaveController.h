@@ -1,6 +1,8 @@
 #pragma once
 
 #include <chrono>
+#include <future>
+#include <string>
 
 #include "EngineInterface/SimulationController.h"
 #include "Definitions.h"
@@ -16,14 +18,28 @@ public:
     bool isOn() const;
     void setOn(bool value);
 
+    int getInterval() const;  //in minutes
+    void setInterval(int value);
+
     void process();
 
 private:
     void onSave();
+    void processSaveResult(bool wait);
+
+    struct SaveResult
+    {
+        bool succeeded = false;
+        std::chrono::milliseconds duration;
+        uint64_t numBytes = 0;
+        std::string errorMessage;
+    };
 
     SimulationController _simController;
 
     bool _on = true;
-    std::optional<std::chrono::steady_clock::time_point> _startTimePoint;
-    bool _alreadySaved = false;
+    int _interval = 20;
+    int _numGenerations = 3;
+    std::chrono::steady_clock::time_point _lastSaveTimepoint;
+    std::future<SaveResult> _saveResult;
 };
\ No newline at end of file
@@ -5,14 +5,17 @@
 
 #include "Fonts/IconsFontAwesome5.h"
 
+#include "Base/LoggingService.h"
 #include "Base/StringHelper.h"
 #include "EngineInterface/Serializer.h"
 #include "EngineInterface/SimulationController.h"
+#include "Network/NetworkService.h"
+#include "Network/SimulationCatalog.h"
+#include "Network/SimulationDownload.h"
 
 #include "AlienImGui.h"
 #include "GlobalSettings.h"
 #include "StyleRepository.h"
-#include "RemoteSimulationDataParser.h"
 #include "NetworkController.h"
 #include "StatisticsWindow.h"
 #include "Viewport.h"
@@ -21,6 +24,24 @@
 #include "LoginDialog.h"
 #include "UploadSimulationDialog.h"
 
+namespace
+{
+    int compare(RemoteSimulationData const& left, RemoteSimulationData const& right, ImGuiTableSortSpecs const* specs)
+    {
+        for (int n = 0; n < specs->SpecsCount; n++) {
+            auto const& sortSpec = specs->Specs[n];
+            auto delta = RemoteSimulationData::compare(left, right, sortSpec.ColumnUserID);
+            if (delta > 0) {
+                return (sortSpec.SortDirection == ImGuiSortDirection_Ascending) ? +1 : -1;
+            }
+            if (delta < 0) {
+                return (sortSpec.SortDirection == ImGuiSortDirection_Ascending) ? -1 : +1;
+            }
+        }
+        return 0;
+    }
+}
+
 _BrowserWindow::_BrowserWindow(
     SimulationController const& simController,
     NetworkController const& networkController,
@@ -53,16 +74,24 @@ void _BrowserWindow::onRefresh()
     refreshIntern(false);
 }
 
+void _BrowserWindow::onUploadStarted(NetworkTask const& upload)
+{
+    _upload = upload;
+}
+
 void _BrowserWindow::refreshIntern(bool firstTimeStartup)
 {
+    //the locally stored catalog is shown even if the server is not reachable
     try {
-        if (!_networkController->getRemoteSimulationDataList(_remoteSimulationDatas, !firstTimeStartup)) {
-            if (!firstTimeStartup) {
-                MessageDialog::getInstance().show("Error", "Failed to retrieve browser data.");
-            }
+        _networkController->refreshSimulationCatalog(!firstTimeStartup);
+    } catch (std::exception const& e) {
+        if (!firstTimeStartup) {
+            MessageDialog::getInstance().show("Error", e.what());
         }
-        _filteredRemoteSimulationDatas = _remoteSimulationDatas;
+    }
+    updateSearchIndex();
 
+    try {
         if (_networkController->getLoggedInUserName()) {
             std::vector<std::string> likedIds;
             if (!_networkController->getLikedSimulationIdList(likedIds)) {
@@ -87,6 +116,8 @@ void _BrowserWindow::processIntern()
     processTable();
     processStatus();
     processFilter();
+    processDownload();
+    processUpload();
     if(_scheduleRefresh) {
         onRefresh();
         _scheduleRefresh = false;
@@ -122,7 +153,7 @@ void _BrowserWindow::processToolbar()
     AlienImGui::Tooltip("Logout");
 
     ImGui::SameLine();
-    ImGui::BeginDisabled(!_networkController->getLoggedInUserName());
+    ImGui::BeginDisabled(!_networkController->getLoggedInUserName() || _upload);
     if (AlienImGui::ToolbarButton(ICON_FA_UPLOAD)) {
         if (auto uploadSimulationDialog = _uploadSimulationDialog.lock()) {
             uploadSimulationDialog->show();
@@ -130,6 +161,19 @@ void _BrowserWindow::processToolbar()
     }
     ImGui::EndDisabled();
     AlienImGui::Tooltip("Upload simulation");
+
+    ImGui::SameLine();
+    ImGui::BeginDisabled(!_download && !_upload);
+    if (AlienImGui::ToolbarButton(ICON_FA_TIMES)) {
+        if (_download) {
+            _download->cancel();
+        }
+        if (_upload) {
+            _upload->cancel();
+        }
+    }
+    ImGui::EndDisabled();
+    AlienImGui::Tooltip("Cancel transfer");
     AlienImGui::Separator();
 }
 
@@ -175,20 +219,22 @@ void _BrowserWindow::processTable()
         //sort our data if sort specs have been changed!
         if (ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs()) {
             if (sortSpecs->SpecsDirty || _scheduleSort) {
-                if (_filteredRemoteSimulationDatas.size() > 1) {
-                    std::sort(_filteredRemoteSimulationDatas.begin(), _filteredRemoteSimulationDatas.end(), [&](auto const& left, auto const& right) {
-                        return RemoteSimulationData::compare(&left, &right, sortSpecs) < 0;
+                if (_filteredEntryIndices.size() > 1) {
+                    auto const& entries = _networkController->getSimulationCatalog()->getEntries();
+                    std::sort(_filteredEntryIndices.begin(), _filteredEntryIndices.end(), [&](int left, int right) {
+                        return compare(entries[left], entries[right], sortSpecs) < 0;
                     });
                 }
                 sortSpecs->SpecsDirty = false;
             }
         }
 
+        auto const& entries = _networkController->getSimulationCatalog()->getEntries();
         ImGuiListClipper clipper;
-        clipper.Begin(_filteredRemoteSimulationDatas.size());
+        clipper.Begin(_filteredEntryIndices.size());
         while (clipper.Step())
             for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
-                RemoteSimulationData* item = &_filteredRemoteSimulationDatas[row];
+                RemoteSimulationData const* item = &entries[_filteredEntryIndices[row]];
 
 //                auto isItemSelected = _selectionIds.find(item->id) != _selectionIds.end();
 
@@ -196,9 +242,11 @@ void _BrowserWindow::processTable()
                 ImGui::TableNextRow();
 
                 ImGui::TableNextColumn();
+                ImGui::BeginDisabled(_download != nullptr);
                 if (ImGui::Button(ICON_FA_DOWNLOAD)) {
-                    onOpenSimulation(item->id);
+                    onOpenSimulation(item->id, item->version);
                 }
+                ImGui::EndDisabled();
                 AlienImGui::Tooltip("Download");
 
                 ImGui::SameLine();
@@ -272,7 +320,7 @@ void _BrowserWindow::processStatus()
         ImGui::PushStyleColor(ImGuiCol_Text, (ImVec4)Const::LogMessageColor);
         std::string statusText;
         statusText += std::string(" " ICON_FA_INFO_CIRCLE " ");
-        statusText += std::to_string(_remoteSimulationDatas.size()) + " simulations found";
+        statusText += std::to_string(_networkController->getSimulationCatalog()->getEntries().size()) + " simulations found";
 
         statusText += std::string("  " ICON_FA_INFO_CIRCLE " ");
         if (auto userName = _networkController->getLoggedInUserName()) {
@@ -285,6 +333,14 @@ void _BrowserWindow::processStatus()
             statusText += std::string("   " ICON_FA_INFO_CIRCLE " ");
             statusText += "In order to upload and rate simulations you need to log in.";
         }
+        if (_download) {
+            statusText += std::string("   " ICON_FA_DOWNLOAD " ");
+            statusText += "Downloading simulation: " + std::to_string(toInt(_download->getProgress() * 100)) + "%";
+        }
+        if (_upload) {
+            statusText += std::string("   " ICON_FA_UPLOAD " ");
+            statusText += "Uploading simulation: " + StringHelper::format(_upload->getSentBytes() / 1024) + " KB";
+        }
         AlienImGui::Text(statusText);
         ImGui::PopStyleColor();
     }
@@ -294,12 +350,8 @@ void _BrowserWindow::processStatus()
 void _BrowserWindow::processFilter()
 {
     if (AlienImGui::InputText(AlienImGui::InputTextParameters().name("Filter"), _filter)) {
-        _filteredRemoteSimulationDatas.clear();
-        for (auto const& entry : _remoteSimulationDatas) {
-            if (entry.matchWithFilter(_filter)) {
-                _filteredRemoteSimulationDatas.emplace_back(entry);
-            }
-        }
+        _filteredEntryIndices = _searchIndex.find(_filter);
+        sortTable();
     }
 }
 
@@ -340,16 +392,27 @@ void _BrowserWindow::sortTable()
     _scheduleSort = true;
 }
 
-void _BrowserWindow::onOpenSimulation(std::string const& id)
+void _BrowserWindow::processDownload()
 {
-    std::string content, settings, symbolMap;
-    if (!_networkController->downloadSimulation(content, settings, symbolMap, id)) {
-        MessageDialog::getInstance().show("Error", "Failed to download simulation.");
+    if (!_download || !_download->isFinished()) {
         return;
     }
+    auto download = _download;
+    _download.reset();
+
+    if (!download->isSucceeded()) {
+        if (auto errorMessage = download->getErrorMessage(); !errorMessage.empty()) {
+            log(Priority::Important, "network: " + errorMessage);
+            MessageDialog::getInstance().show("Error", "Failed to download simulation.");
+        }
+        return;
+    }
+    if (download->isFromCache()) {
+        log(Priority::Important, "network: simulation loaded from cache");
+    }
 
     DeserializedSimulation deserializedSim;
-    if (!Serializer::deserializeSimulationFromStrings(deserializedSim, content, settings, symbolMap)) {
+    if (!Serializer::deserializeSimulationFromStrings(deserializedSim, download->getContent(), download->getSettings(), download->getSymbolMap())) {
         MessageDialog::getInstance().show("Error", "Failed to load simulation. Your program version may not match.");
         return;
     }
@@ -365,6 +428,28 @@ void _BrowserWindow::onOpenSimulation(std::string const& id)
     _temporalControlWindow->onSnapshot();
 }
 
+void _BrowserWindow::processUpload()
+{
+    if (!_upload || !_upload->isFinished()) {
+        return;
+    }
+    auto upload = _upload;
+    _upload.reset();
+
+    if (!_networkController->isPositiveResponse(upload)) {
+        if (!upload->isCanceled()) {
+            MessageDialog::getInstance().show("Error", "Failed to upload simulation.");
+        }
+        return;
+    }
+    _scheduleRefresh = true;
+}
+
+void _BrowserWindow::onOpenSimulation(std::string const& id, std::string const& version)
+{
+    _download = _networkController->downloadSimulation(id, version);
+}
+
 void _BrowserWindow::onDeleteSimulation(std::string const& id)
 {
     if (!_networkController->deleteSimulation(id)) {
@@ -374,17 +459,15 @@ void _BrowserWindow::onDeleteSimulation(std::string const& id)
     _scheduleRefresh = true;
 }
 
-void _BrowserWindow::onToggleLike(RemoteSimulationData& entry)
+void _BrowserWindow::onToggleLike(RemoteSimulationData const& entry)
 {
-    auto findResult = _likedIds.find(entry.id);
-    if (findResult != _likedIds.end()) {
-        _likedIds.erase(findResult);
-        --entry.likes;
-    } else {
+    auto like = !isLiked(entry.id);
+    if (like) {
         _likedIds.insert(entry.id);
-        ++entry.likes;
+    } else {
+        _likedIds.erase(entry.id);
     }
-    _userLikesByIdCache.erase(entry.id); //invalidate cache entry
+    _networkController->getSimulationCatalog()->setUserLike(entry.id, *_networkController->getLoggedInUserName(), like);
     _networkController->toggleLikeSimulation(entry.id);
     sortTable();
 }
@@ -396,15 +479,20 @@ bool _BrowserWindow::isLiked(std::string const& id)
 
 std::string _BrowserWindow::getUserLikes(std::string const& id)
 {
-    std::set<std::string> userLikes;
+    auto userLikes = _networkController->getSimulationCatalog()->getUserLikes(id);
+    return userLikes ? boost::algorithm::join(*userLikes, ", ") : "...";
+}
 
-    auto findResult = _userLikesByIdCache.find(id);
-    if (findResult != _userLikesByIdCache.end()) {
-        userLikes = findResult->second;
-    } else {
-        _networkController->getUserLikesForSimulation(userLikes, id);
-        _userLikesByIdCache.emplace(id, userLikes);
+void _BrowserWindow::updateSearchIndex()
+{
+    auto const& entries = _networkController->getSimulationCatalog()->getEntries();
+    std::vector<std::string> searchTexts;
+    searchTexts.reserve(entries.size());
+    for (auto const& entry : entries) {
+        searchTexts.emplace_back(entry.getSearchText());
     }
-
-    return boost::algorithm::join(userLikes, ", ");
+    _searchIndex.build(searchTexts);
+    _filteredEntryIndices = _searchIndex.find(_filter);
+    sortTable();
 }
+
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "EngineInterface/Definitions.h"
+#include "Network/Definitions.h"
+#include "Network/NgramIndex.h"
+#include "Network/RemoteSimulationData.h"
 
 #include "AlienWindow.h"
-#include "RemoteSimulationData.h"
 #include "Definitions.h"
 
 class _BrowserWindow : public _AlienWindow
@@ -20,6 +22,7 @@ public:
     void registerCyclicReferences(LoginDialogWeakPtr const& loginDialog, UploadSimulationDialogWeakPtr const& uploadSimulationDialog);
 
     void onRefresh();
+    void onUploadStarted(NetworkTask const& upload);
 
 private:
     void refreshIntern(bool firstTimeStartup);
@@ -32,26 +35,31 @@ private:
     void processToolbar();
     void processShortenedText(std::string const& text);
     bool processDetailButton();
+    void processDownload();
+    void processUpload();
 
     void processActivated() override;
 
     void sortTable();
 
-    void onOpenSimulation(std::string const& id);
+    void onOpenSimulation(std::string const& id, std::string const& version);
     void onDeleteSimulation(std::string const& id);
-    void onToggleLike(RemoteSimulationData& entry);
+    void onToggleLike(RemoteSimulationData const& entry);
 
     bool isLiked(std::string const& id);
     std::string getUserLikes(std::string const& id);
 
+    void updateSearchIndex();
+
     bool _scheduleRefresh = false;
     bool _scheduleSort = false;
     std::string _filter;
     std::unordered_set<std::string> _selectionIds;
     std::unordered_set<std::string> _likedIds;
-    std::unordered_map<std::string, std::set<std::string>> _userLikesByIdCache;
-    std::vector<RemoteSimulationData> _remoteSimulationDatas;
-    std::vector<RemoteSimulationData> _filteredRemoteSimulationDatas;
+    NgramIndex _searchIndex;
+    std::vector<int> _filteredEntryIndices;
+    SimulationDownload _download;
+    NetworkTask _upload;
 
     SimulationController _simController;
     NetworkController _networkController;
@@ -1,6 +1,5 @@
 #include "ExportStatisticsDialog.h"
 
-#include <fstream>
 #include <ImFileDialog.h>
 
 #include "Base/Definitions.h"
@@ -24,6 +23,8 @@ _ExportStatisticsDialog::~_ExportStatisticsDialog()
 
 void _ExportStatisticsDialog::process()
 {
+    processExportResult();
+
     if (!ifd::FileDialog::Instance().IsDone("ExportStatisticsDialog")) {
         return;
     }
@@ -32,40 +33,84 @@ void _ExportStatisticsDialog::process()
         auto firstFilenameCopy = firstFilename;
         _startingPath = firstFilenameCopy.remove_filename().string();
 
-        onSaveStatistics(firstFilename.string());
-
+        if (_mode == Mode::Export) {
+            onSaveStatistics(firstFilename.string());
+        } else {
+            onStartRecording(firstFilename.string());
+        }
     }
     ifd::FileDialog::Instance().Close();
 }
 
 void _ExportStatisticsDialog::show(LongtermStatistics const& longtermStatistics)
 {
-    _statistics = longtermStatistics;
-    ifd::FileDialog::Instance().Save("ExportStatisticsDialog", "Export statistics", "Comma-separated values (*.csv){.csv},.*", _startingPath);
+    _mode = Mode::Export;
+    _statistics = StatisticsTable::fromRollup(longtermStatistics.getBestRollup());
+    ifd::FileDialog::Instance().Save(
+        "ExportStatisticsDialog",
+        "Export statistics",
+        "Comma-separated values (*.csv){.csv},Columnar statistics (*" + StatisticsExporter::ColumnarFileExtension + "){"
+            + StatisticsExporter::ColumnarFileExtension + "},.*",
+        _startingPath);
 }
 
-void _ExportStatisticsDialog::onSaveStatistics(std::string const& filename)
+void _ExportStatisticsDialog::showForRecording()
 {
-    for (auto const& data : _statistics.datas) {
-        CHECK(_statistics.timestepHistory.size() == _statistics.datas[0].size());
+    _mode = Mode::Record;
+    ifd::FileDialog::Instance().Save("ExportStatisticsDialog", "Record statistics", "Comma-separated values (*.csv){.csv},.*", _startingPath);
+}
+
+bool _ExportStatisticsDialog::isRecording() const
+{
+    return _recorder != nullptr;
+}
+
+void _ExportStatisticsDialog::stopRecording()
+{
+    _recorder.reset();
+}
+
+void _ExportStatisticsDialog::addStatistics(MonitorData const& statistics)
+{
+    if (!_recorder) {
+        return;
+    }
+    _recorder->add(statistics);
+    if (!_recorder->isValid()) {
+        _recorder.reset();
+        MessageDialog::getInstance().show("Record statistics", "The statistics could not be written to the specified file.");
     }
+}
 
-    std::ofstream file;
-    file.open(filename, std::ios_base::out);
-    if (!file) {
-        MessageDialog::getInstance().show("Export statistics", "The statistics could not be saved to the specified file.");
+void _ExportStatisticsDialog::onSaveStatistics(std::string const& filename)
+{
+    if (_exportResult.valid()) {
+        MessageDialog::getInstance().show("Export statistics", "The previous export has not been finished yet.");
         return;
     }
 
-    file << "time step, cells, cells (color 0), cells (color 1), cells (color 2), cells (color 3), cells (color 4), cells (color 5), cells (color 6), "
-         << "cell connections, particles, tokens, created cells, successful attacks, failed attacks, muscle activities"
-         << std::endl;
-    for (int i = 0; i < _statistics.timestepHistory.size(); ++i) {
-        file << static_cast<uint64_t>(_statistics.timestepHistory.at(i));
-        for (int j = 0; j <= 14; ++j) {
-            file << ", " << static_cast<uint64_t>(_statistics.datas[j].at(i));
-        }
-        file << std::endl;
+    //formatting and writing do not block the user interface
+    _exportResult = std::async(std::launch::async, [filename, statistics = std::move(_statistics)] {
+        return StatisticsExporter::write(filename, statistics);
+    });
+    _statistics = StatisticsTable();
+}
+
+void _ExportStatisticsDialog::onStartRecording(std::string const& filename)
+{
+    _recorder = std::make_shared<_StatisticsRecorder>(filename);
+    if (!_recorder->isValid()) {
+        _recorder.reset();
+        MessageDialog::getInstance().show("Record statistics", "The statistics could not be written to the specified file.");
+    }
+}
+
+void _ExportStatisticsDialog::processExportResult()
+{
+    if (!_exportResult.valid() || _exportResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return;
+    }
+    if (!_exportResult.get()) {
+        MessageDialog::getInstance().show("Export statistics", "The statistics could not be saved to the specified file.");
     }
-    file.close();
 }
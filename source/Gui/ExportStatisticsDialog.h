@@ -1,8 +1,11 @@
 #pragma once
 
+#include <future>
+
 #include "EngineInterface/Definitions.h"
+#include "EngineInterface/StatisticsExporter.h"
+#include "EngineInterface/StatisticsHistory.h"
 
-#include "StatisticsHistory.h"
 #include "Definitions.h"
 
 class _ExportStatisticsDialog
@@ -15,9 +18,26 @@ public:
 
     void show(LongtermStatistics const& longtermStatistics);
 
+    //continuous export of all incoming samples to a csv file
+    void showForRecording();
+    bool isRecording() const;
+    void stopRecording();
+    void addStatistics(MonitorData const& statistics);
+
 private:
     void onSaveStatistics(std::string const& filename);
+    void onStartRecording(std::string const& filename);
+    void processExportResult();
+
+    enum class Mode
+    {
+        Export,
+        Record
+    };
+    Mode _mode = Mode::Export;
 
     std::string _startingPath;
-    LongtermStatistics _statistics;
+    StatisticsTable _statistics;
+    std::future<bool> _exportResult;
+    StatisticsRecorder _recorder;
 };
@@ -15,6 +15,7 @@ _FileLogger::_FileLogger()
 
 _FileLogger::~_FileLogger()
 {
+    LoggingService::getInstance().flush();
     LoggingService::getInstance().unregisterCallBack(this);
 }
 
@@ -22,3 +23,11 @@ void _FileLogger::newLogMessage(Priority priority, std::string const& message)
 {
     _outfile << message << std::endl;
 }
+
+void _FileLogger::newLogMessages(std::vector<LogMessage> const& messages)
+{
+    for (auto const& message : messages) {
+        _outfile << message.message << '\n';
+    }
+    _outfile.flush();
+}
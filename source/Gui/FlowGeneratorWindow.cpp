@@ -123,6 +123,16 @@ void _FlowGeneratorWindow::processIntern()
 
         ImGui::EndTabBar();
     }
+    AlienImGui::SliderInt(
+        AlienImGui::SliderIntParameters()
+            .name("Grid spacing")
+            .textWidth(MaxContentTextWidth)
+            .min(1)
+            .max(32)
+            .defaultValue(origFlowFieldSettings.gridSpacing)
+            .tooltip("Distance between the nodes of the precomputed velocity grid which is interpolated at the cell positions. "
+                     "Smaller values are more accurate but need more memory."),
+        flowFieldSettings.gridSpacing);
     ImGui::EndDisabled();
 
     if (flowFieldSettings != lastFlowFieldSettings) {
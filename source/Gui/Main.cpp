@@ -1,6 +1,7 @@
 #include <iostream>
 
 #include "Base/LoggingService.h"
+#include "Base/ThreadPool.h"
 #include "EngineInterface/Serializer.h"
 #include "EngineImpl/SimulationControllerImpl.h"
 #include "Base/Resources.h"
@@ -8,11 +9,15 @@
 #include "MainWindow.h"
 #include "SimpleLogger.h"
 #include "FileLogger.h"
+#include "GlobalSettings.h"
 
 #include <boost/optional.hpp>
 
 int main(int, char**)
 {
+    //the thread pool is configured before any of its users is created, 0 = hardware concurrency
+    ThreadPool::getInstance().setNumThreads(GlobalSettings::getInstance().getIntState("settings.cpu.num threads", 0));
+
     SimpleLogger logger = std::make_shared<_SimpleLogger>();
     FileLogger fileLogger = std::make_shared<_FileLogger>();
 
@@ -93,7 +93,7 @@ _MainWindow::_MainWindow(SimulationController const& simController, SimpleLogger
 {
     _logger = logger;
     _simController = simController;
-    
+
     auto glfwVersion = initGlfw();
 
     _windowController = std::make_shared<_WindowController>();
@@ -2,33 +2,39 @@
 
 #include <boost/property_tree/json_parser.hpp>
 
-#define CPPHTTPLIB_OPENSSL_SUPPORT
-#include <cpp-httplib/httplib.h>
-
 #include "Base/Resources.h"
 #include "Base/LoggingService.h"
+#include "Network/NetworkService.h"
+#include "Network/SimulationCache.h"
+#include "Network/SimulationCatalog.h"
+#include "Network/SimulationDownload.h"
 
 #include "GlobalSettings.h"
-#include "RemoteSimulationDataParser.h"
 
 _NetworkController::_NetworkController()
 {
-    _serverAddress = GlobalSettings::getInstance().getStringState("settings.server", "alien-project.org");
+    _networkService = std::make_shared<_NetworkService>(
+        GlobalSettings::getInstance().getStringState("settings.server", "alien-project.org"));
+    _simulationCache = std::make_shared<_SimulationCache>(Const::SimulationCacheDirectory, Const::SimulationCacheMaxBytes);
+    _simulationCatalog = std::make_shared<_SimulationCatalog>(_networkService->getServerAddress());
+    _simulationCatalog->load(Const::SimulationCatalogFilename);
 }
 
 _NetworkController::~_NetworkController()
 {
-    GlobalSettings::getInstance().setStringState("settings.server", _serverAddress);
+    GlobalSettings::getInstance().setStringState("settings.server", _networkService->getServerAddress());
 }
 
 std::string _NetworkController::getServerAddress() const
 {
-    return _serverAddress;
+    return _networkService->getServerAddress();
 }
 
 void _NetworkController::setServerAddress(std::string const& value)
 {
-    _serverAddress = value;
+    _networkService = std::make_shared<_NetworkService>(value);
+    _simulationCatalog = std::make_shared<_SimulationCatalog>(value);
+    _simulationCatalog->load(Const::SimulationCatalogFilename);
     logout();
 }
 
@@ -44,30 +50,6 @@ std::optional<std::string> _NetworkController::getPassword() const
 
 namespace
 {
-    void configureClient(httplib::SSLClient& client)
-    {
-        client.set_ca_cert_path("./resources/ca-bundle.crt");
-        client.enable_server_certificate_verification(true);
-        if (auto result = client.get_openssl_verify_result()) {
-            throw std::runtime_error("OpenSSL verify error: " + std::string(X509_verify_cert_error_string(result)));
-        }
-    }
-
-    httplib::Result executeRequest(std::function<httplib::Result()> const& func, bool withRetry = true)
-    {
-        auto attempt = 0;
-        while(true) {
-            auto result = func();
-            if (result) {
-                return result;
-            }
-            if (++attempt == 5 || !withRetry) {
-                throw std::runtime_error("Error connecting to the server.");
-            }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
-    }
-
     void logNetworkError(std::string const& serverResponse)
     {
         log(Priority::Important, "network: an error occurred while parsing the server response: " + serverResponse);
@@ -97,50 +79,47 @@ bool _NetworkController::createUser(std::string const& userName, std::string con
 {
     log(Priority::Important, "network: create user '" + userName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
-
-    httplib::Params params;
-    params.emplace("userName", userName);
-    params.emplace("password", password);
-    params.emplace("email", email);
+    NetworkRequest request;
+    request.method = NetworkRequest::Method::Post;
+    request.path = "/alien-server/createuser.php";
+    request.params.emplace_back("userName", userName);
+    request.params.emplace_back("password", password);
+    request.params.emplace_back("email", email);
 
-    auto result = executeRequest([&] { return client.Post("/alien-server/createuser.php", params); });
+    auto result = _networkService->execute(request);
 
-    return parseBoolResult(result->body);
+    return parseBoolResult(result);
 }
 
 bool _NetworkController::activateUser(std::string const& userName, std::string const& password, std::string const& confirmationCode)
 {
     log(Priority::Important, "network: activate user '" + userName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    NetworkRequest request;
+    request.method = NetworkRequest::Method::Post;
+    request.path = "/alien-server/activateuser.php";
+    request.params.emplace_back("userName", userName);
+    request.params.emplace_back("password", password);
+    request.params.emplace_back("activationCode", confirmationCode);
 
-    httplib::Params params;
-    params.emplace("userName", userName);
-    params.emplace("password", password);
-    params.emplace("activationCode", confirmationCode);
+    auto result = _networkService->execute(request);
 
-    auto result = executeRequest([&] { return client.Post("/alien-server/activateuser.php", params); });
-
-    return parseBoolResult(result->body);
+    return parseBoolResult(result);
 }
 
 bool _NetworkController::login(std::string const& userName, std::string const& password)
 {
     log(Priority::Important, "network: login user '" + userName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
-
-    httplib::Params params;
-    params.emplace("userName", userName);
-    params.emplace("password", password);
+    NetworkRequest request;
+    request.method = NetworkRequest::Method::Post;
+    request.path = "/alien-server/login.php";
+    request.params.emplace_back("userName", userName);
+    request.params.emplace_back("password", password);
 
-    auto result = executeRequest([&] { return client.Post("/alien-server/login.php", params); });
+    auto result = _networkService->execute(request);
 
-    auto boolResult = parseBoolResult(result->body);
+    auto boolResult = parseBoolResult(result);
     if (boolResult) {
         _loggedInUserName = userName;
         _password = password;
@@ -160,16 +139,15 @@ bool _NetworkController::deleteUser()
 {
     log(Priority::Important, "network: delete user '" + *_loggedInUserName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    NetworkRequest request;
+    request.method = NetworkRequest::Method::Post;
+    request.path = "/alien-server/deleteuser.php";
+    request.params.emplace_back("userName", *_loggedInUserName);
+    request.params.emplace_back("password", *_password);
 
-    httplib::Params params;
-    params.emplace("userName", *_loggedInUserName);
-    params.emplace("password", *_password);
+    auto postResult = _networkService->execute(request);
 
-    auto postResult = executeRequest([&] { return client.Post("/alien-server/deleteuser.php", params); });
-
-    auto result = parseBoolResult(postResult->body);
+    auto result = parseBoolResult(postResult);
     if (result) {
         logout();
     }
@@ -181,72 +159,60 @@ bool _NetworkController::resetPassword(std::string const& userName, std::string
 {
     log(Priority::Important, "network: reset password of user '" + userName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
-
-    httplib::Params params;
-    params.emplace("userName", userName);
-    params.emplace("email", email);
+    NetworkRequest request;
+    request.method = NetworkRequest::Method::Post;
+    request.path = "/alien-server/resetpw.php";
+    request.params.emplace_back("userName", userName);
+    request.params.emplace_back("email", email);
 
-    auto result = executeRequest([&] { return client.Post("/alien-server/resetpw.php", params); });
+    auto result = _networkService->execute(request);
 
-    return parseBoolResult(result->body);
+    return parseBoolResult(result);
 }
 
 bool _NetworkController::setNewPassword(std::string const& userName, std::string const& newPassword, std::string const& confirmationCode)
 {
     log(Priority::Important, "network: set new password for user '" + userName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    NetworkRequest request;
+    request.method = NetworkRequest::Method::Post;
+    request.path = "/alien-server/setnewpw.php";
+    request.params.emplace_back("userName", userName);
+    request.params.emplace_back("newPassword", newPassword);
+    request.params.emplace_back("activationCode", confirmationCode);
 
-    httplib::Params params;
-    params.emplace("userName", userName);
-    params.emplace("newPassword", newPassword);
-    params.emplace("activationCode", confirmationCode);
+    auto result = _networkService->execute(request);
 
-    auto result = executeRequest([&] { return client.Post("/alien-server/setnewpw.php", params); });
-
-    return parseBoolResult(result->body);
+    return parseBoolResult(result);
 }
 
-bool _NetworkController::getRemoteSimulationDataList(std::vector<RemoteSimulationData>& result, bool withRetry) const
+void _NetworkController::refreshSimulationCatalog(bool withRetry)
 {
-    log(Priority::Important, "network: get simulation list");
-
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    log(Priority::Important, "network: refresh simulation list since '" + _simulationCatalog->getLatestTimestamp() + "'");
 
-    auto postResult = executeRequest([&] { return client.Get("/alien-server/getsimulationinfo.php"); }, withRetry);
+    _simulationCatalog->refresh(_networkService, withRetry);
+    _simulationCatalog->save(Const::SimulationCatalogFilename);
+}
 
-    try {
-        std::stringstream stream(postResult->body);
-        boost::property_tree::ptree tree;
-        boost::property_tree::read_json(stream, tree);
-        result.clear();
-        result = RemoteSimulationDataParser::decode(tree);
-        return true;
-    } catch (...) {
-        logNetworkError(postResult->body);
-        return false;
-    }
+SimulationCatalog const& _NetworkController::getSimulationCatalog() const
+{
+    return _simulationCatalog;
 }
 
 bool _NetworkController::getLikedSimulationIdList(std::vector<std::string>& result) const
 {
     log(Priority::Important, "network: get liked simulations");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    NetworkRequest request;
+    request.method = NetworkRequest::Method::Post;
+    request.path = "/alien-server/getlikedsimulations.php";
+    request.params.emplace_back("userName", *_loggedInUserName);
+    request.params.emplace_back("password", *_password);
 
-    httplib::Params params;
-    params.emplace("userName", *_loggedInUserName);
-    params.emplace("password", *_password);
-
-    auto postResult = executeRequest([&] { return client.Post("/alien-server/getlikedsimulations.php", params); });
+    auto postResult = _networkService->execute(request);
 
     try {
-        std::stringstream stream(postResult->body);
+        std::stringstream stream(postResult);
         boost::property_tree::ptree tree;
         boost::property_tree::read_json(stream, tree);
 
@@ -256,35 +222,7 @@ bool _NetworkController::getLikedSimulationIdList(std::vector<std::string>& resu
         }
         return true;
     } catch (...) {
-        logNetworkError(postResult->body);
-        return false;
-    }
-}
-
-bool _NetworkController::getUserLikesForSimulation(std::set<std::string>& result, std::string const& simId)
-{
-    log(Priority::Important, "network: get user likes for simulation with id=" + simId);
-
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
-
-    httplib::Params params;
-    params.emplace("simId", simId);
-
-    auto postResult = executeRequest([&] { return client.Post("/alien-server/getuserlikes.php", params); });
-
-    try {
-        std::stringstream stream(postResult->body);
-        boost::property_tree::ptree tree;
-        boost::property_tree::read_json(stream, tree);
-
-        result.clear();
-        for (auto const& [key, subTree] : tree) {
-            result.insert(subTree.get<std::string>("userName"));
-        }
-        return true;
-    } catch (...) {
-        logNetworkError(postResult->body);
+        logNetworkError(postResult);
         return false;
     }
 }
@@ -293,95 +231,76 @@ bool _NetworkController::toggleLikeSimulation(std::string const& simId)
 {
     log(Priority::Important, "network: toggle like for simulation with id=" + simId);
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
-
-    httplib::Params params;
-    params.emplace("userName", *_loggedInUserName);
-    params.emplace("password", *_password);
-    params.emplace("simId", simId);
+    NetworkRequest request;
+    request.method = NetworkRequest::Method::Post;
+    request.path = "/alien-server/togglelikesimulation.php";
+    request.params.emplace_back("userName", *_loggedInUserName);
+    request.params.emplace_back("password", *_password);
+    request.params.emplace_back("simId", simId);
 
-    auto result = executeRequest([&] { return client.Post("/alien-server/togglelikesimulation.php", params); });
+    auto result = _networkService->execute(request);
 
-    return parseBoolResult(result->body);
+    return parseBoolResult(result);
 }
 
-bool _NetworkController::uploadSimulation(
+NetworkTask _NetworkController::uploadSimulation(
     std::string const& simulationName,
     std::string const& description,
     IntVector2D const& size,
     int particles,
-    std::string const& content,
+    std::function<void(std::ostream&)> const& contentWriter,
     std::string const& settings,
     std::string const& symbolMap)
 {
     log(Priority::Important, "network: upload simulation with name='" + simulationName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
-
-    httplib::MultipartFormDataItems items = {
-        {"userName", *_loggedInUserName, "", ""},
-        {"password", *_password, "", ""},
-        {"simName", simulationName, "", ""},
-        {"simDesc", description, "", ""},
-        {"width", std::to_string(size.x), "", ""},
-        {"height", std::to_string(size.y), "", ""},
-        {"particles", std::to_string(particles), "", ""},
-        {"version", Const::ProgramVersion, "", ""},
-        {"content", content, "", "application/octet-stream"},
-        {"settings", settings, "", ""},
-        {"symbolMap", symbolMap, "", ""},
+    NetworkRequest request;
+    request.method = NetworkRequest::Method::Post;
+    request.path = "/alien-server/uploadsimulation.php";
+    request.multipartItems = {
+        {"userName", *_loggedInUserName, ""},
+        {"password", *_password, ""},
+        {"simName", simulationName, ""},
+        {"simDesc", description, ""},
+        {"width", std::to_string(size.x), ""},
+        {"height", std::to_string(size.y), ""},
+        {"particles", std::to_string(particles), ""},
+        {"version", Const::ProgramVersion, ""},
+        {"content", "", "application/octet-stream", contentWriter},
+        {"settings", settings, ""},
+        {"symbolMap", symbolMap, ""},
     };
+    return _networkService->schedule(request);
+}
 
-    auto result = executeRequest([&] { return client.Post("/alien-server/uploadsimulation.php", items); });
-
-    return parseBoolResult(result->body);
+bool _NetworkController::isPositiveResponse(NetworkTask const& task) const
+{
+    if (_NetworkTask::State::Succeeded != task->getState()) {
+        log(Priority::Important, task->isCanceled() ? "network: transfer canceled" : "network: " + task->getErrorMessage());
+        return false;
+    }
+    return parseBoolResult(task->getResponse());
 }
 
-bool _NetworkController::downloadSimulation(std::string& content, std::string& settings, std::string& symbolMap, std::string const& simId)
+SimulationDownload _NetworkController::downloadSimulation(std::string const& simId, std::string const& version)
 {
     log(Priority::Important, "network: download simulation with id=" + simId);
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
-
-    httplib::Params params;
-    params.emplace("id", simId);
-
-    try {
-        {
-            auto result = executeRequest([&] { return client.Get("/alien-server/downloadcontent.php", params, {}); });
-            content = result->body;
-        }
-        {
-            auto result = executeRequest([&] { return client.Get("/alien-server/downloadsettings.php", params, {}); });
-            settings = result->body;
-        }
-        {
-            auto result = executeRequest([&] { return client.Get("/alien-server/downloadsymbolmap.php", params, {}); });
-            symbolMap = result->body;
-        }
-        return true;
-    } catch (...) {
-        log(Priority::Important, "network: an error occurred");
-        return false;
-    }
+    return std::make_shared<_SimulationDownload>(_networkService, _simulationCache, simId, version);
 }
 
 bool _NetworkController::deleteSimulation(std::string const& simId)
 {
     log(Priority::Important, "network: delete simulation with id=" + simId);
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
-
-    httplib::Params params;
-    params.emplace("userName", *_loggedInUserName);
-    params.emplace("password", *_password);
-    params.emplace("simId", simId);
+    NetworkRequest request;
+    request.method = NetworkRequest::Method::Post;
+    request.path = "/alien-server/deletesimulation.php";
+    request.params.emplace_back("userName", *_loggedInUserName);
+    request.params.emplace_back("password", *_password);
+    request.params.emplace_back("simId", simId);
 
-    auto result = executeRequest([&] { return client.Post("/alien-server/deletesimulation.php", params); });
+    auto result = _networkService->execute(request);
 
-    return parseBoolResult(result->body);
+    return parseBoolResult(result);
 }
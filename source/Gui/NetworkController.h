@@ -1,6 +1,10 @@
 #pragma once
 
-#include "RemoteSimulationData.h"
+#include <functional>
+#include <iosfwd>
+
+#include "Network/Definitions.h"
+
 #include "Definitions.h"
 
 class _NetworkController
@@ -22,24 +26,32 @@ public:
     bool resetPassword(std::string const& userName, std::string const& email);
     bool setNewPassword(std::string const& userName, std::string const& newPassword, std::string const& confirmationCode);
 
-    bool getRemoteSimulationDataList(std::vector<RemoteSimulationData>& result, bool withRetry) const;
+    //throws std::runtime_error if the server could not be reached
+    void refreshSimulationCatalog(bool withRetry);
+    SimulationCatalog const& getSimulationCatalog() const;
+
     bool getLikedSimulationIdList(std::vector<std::string>& result) const;
-    bool getUserLikesForSimulation(std::set<std::string>& result, std::string const& simId);
     bool toggleLikeSimulation(std::string const& simId);
 
-    bool uploadSimulation(
+    //non-blocking, the content is serialized while being sent
+    NetworkTask uploadSimulation(
         std::string const& simulationName,
         std::string const& description,
         IntVector2D const& size,
         int particles,
-        std::string const& content,
+        std::function<void(std::ostream&)> const& contentWriter,
         std::string const& settings,
         std::string const& symbolMap);
-    bool downloadSimulation(std::string& content, std::string& settings, std::string& symbolMap, std::string const& simId);
+    bool isPositiveResponse(NetworkTask const& task) const;  //for finished tasks
+
+    //non-blocking, the returned download is polled for progress and result
+    SimulationDownload downloadSimulation(std::string const& simId, std::string const& version);
     bool deleteSimulation(std::string const& simId);
 
 private:
-    std::string _serverAddress;
+    NetworkService _networkService;
+    SimulationCache _simulationCache;
+    SimulationCatalog _simulationCatalog;
     std::optional<std::string> _loggedInUserName;
     std::optional<std::string> _password;
 };
@@ -7,6 +7,7 @@
 
 #include <ImFileDialog.h>
 
+#include "EngineInterface/ClusterHasher.h"
 #include "EngineInterface/Descriptions.h"
 #include "EngineInterface/Serializer.h"
 #include "EngineInterface/SimulationController.h"
@@ -51,7 +52,7 @@ void _PatternAnalysisDialog::show()
 
 void _PatternAnalysisDialog::saveRepetitiveActiveClustersToFiles(std::string const& filename)
 {
-    auto const partitionClassDataByDescription = calcPartitionData();
+    auto const partitionClassData = calcPartitionData();
 
     std::ofstream file;
     file.open(filename, std::ios_base::out);
@@ -62,9 +63,9 @@ void _PatternAnalysisDialog::saveRepetitiveActiveClustersToFiles(std::string con
 
     int sum = 0;
     std::vector<PartitionClassData> partitionData;
-    for (auto const& [analysisDesc, partitionClassData] : partitionClassDataByDescription) {
-        if (partitionClassData.numberOfElements > 1 && analysisDesc.hasToken) {
-            partitionData.emplace_back(partitionClassData);
+    for (auto const& classData : partitionClassData) {
+        if (classData.numberOfElements > 1 && classData.hasToken) {
+            partitionData.emplace_back(classData);
         }
     }
     std::sort(partitionData.begin(), partitionData.end());
@@ -97,59 +98,31 @@ void _PatternAnalysisDialog::saveRepetitiveActiveClustersToFiles(std::string con
     MessageDialog::getInstance().show("Analysis result", messageStream.str());
 }
 
-auto _PatternAnalysisDialog::calcPartitionData() const -> std::map<ClusterAnalysisDescription, PartitionClassData>
+auto _PatternAnalysisDialog::calcPartitionData() const -> std::vector<PartitionClassData>
 {
     auto data = _simController->getClusteredSimulationData();
-
-    std::map<ClusterAnalysisDescription, PartitionClassData> result;
-
-    for (auto const& cluster : data.clusters) {
-        auto const clusterAnalysisData = getAnalysisDescription(cluster);
-        auto& partitionData = result[clusterAnalysisData];
-        if (1 == ++partitionData.numberOfElements) {
-            partitionData.representant = cluster;
-        }
-    }
-    return result;
-}
-
-auto _PatternAnalysisDialog::getAnalysisDescription(ClusterDescription const& cluster) const -> ClusterAnalysisDescription
-{
-    ClusterAnalysisDescription result;
-    result.hasToken = false;
-
-    std::map<uint64_t, CellAnalysisDescription> cellAnalysisDescById;
-    auto insertCellAnalysisDescription = [&cellAnalysisDescById](CellDescription const& cell) {
-        if (cellAnalysisDescById.find(cell.id) == cellAnalysisDescById.end()) {
-            CellAnalysisDescription result;
-            result.maxConnections = cell.maxConnections;
-            result.numConnections = cell.connections.size();
-            result.tokenBlocked = cell.tokenBlocked;
-            result.tokenBranchNumber = cell.tokenBranchNumber;
-            //            result.color = cell.metadata.color;
-
-            CellFeatureAnalysisDescription featureAnalysisData;
-            featureAnalysisData.cellFunction = cell.cellFeature.getType();
-            result.feature = featureAnalysisData;
-
-            cellAnalysisDescById.insert_or_assign(cell.id, result);
-        }
-    };
-
-    std::map<uint64_t, int> cellDescIndexById;
-    for (auto const& [index, cell] : cluster.cells | boost::adaptors::indexed(0)) {
-        cellDescIndexById.insert_or_assign(cell.id, toInt(index));
-    }
-
-    for (auto const& cell : cluster.cells) {
-        insertCellAnalysisDescription(cell);
-        for (auto const& connection : cell.connections) {
-            auto connectingCellId = connection.cellId;
-            insertCellAnalysisDescription(cluster.cells.at(cellDescIndexById.at(connectingCellId)));
-            result.connectedCells.insert(std::set<CellAnalysisDescription>{cellAnalysisDescById.at(cell.id), cellAnalysisDescById.at(connectingCellId)});
-        }
-        if (cell.tokens.size() > 0) {
-            result.hasToken = true;
+    auto structures = ClusterHasher::calcStructures(data.clusters);
+
+    //classes with the same hash are verified by an exact comparison to resolve collisions
+    std::vector<PartitionClassData> result;
+    std::vector<int> representantIndices;
+    std::unordered_map<uint64_t, std::vector<int>> classIndicesByHash;
+    for (auto const& [index, cluster] : data.clusters | boost::adaptors::indexed(0)) {
+        auto const& structure = structures.at(index);
+        auto& classIndices = classIndicesByHash[structure.hash];
+        auto findResult = std::find_if(classIndices.begin(), classIndices.end(), [&](int classIndex) {
+            return ClusterHasher::isEquivalent(structures.at(representantIndices.at(classIndex)), structure);
+        });
+        if (findResult != classIndices.end()) {
+            ++result.at(*findResult).numberOfElements;
+        } else {
+            classIndices.emplace_back(toInt(result.size()));
+            representantIndices.emplace_back(toInt(index));
+            PartitionClassData classData;
+            classData.numberOfElements = 1;
+            classData.hasToken = structure.hasToken;
+            classData.representant = cluster;
+            result.emplace_back(classData);
         }
     }
     return result;
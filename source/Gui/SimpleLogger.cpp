@@ -14,6 +14,18 @@ _SimpleLogger::~_SimpleLogger()
 
 std::vector<std::string> const& _SimpleLogger::getMessages(Priority minPriority) const
 {
+    std::vector<LogMessage> newLogMessages;
+    {
+        std::lock_guard lock(_mutex);
+        newLogMessages.swap(_newLogMessages);
+    }
+    for (auto& logMessage : newLogMessages) {
+        if (Priority::Important == logMessage.priority) {
+            _importantLogMessages.emplace_back(logMessage.message);
+        }
+        _allLogMessages.emplace_back(std::move(logMessage.message));
+    }
+
     if (Priority::Important == minPriority) {
         return _importantLogMessages;
     }
@@ -22,8 +34,6 @@ std::vector<std::string> const& _SimpleLogger::getMessages(Priority minPriority)
 
 void _SimpleLogger::newLogMessage(Priority priority, std::string const& message)
 {
-    _allLogMessages.emplace_back(message);
-    if (Priority::Important == priority) {
-        _importantLogMessages.emplace_back(message);
-    }
+    std::lock_guard lock(_mutex);
+    _newLogMessages.emplace_back(LogMessage{priority, message});
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <mutex>
+
 #include "Base/LoggingService.h"
 #include "Definitions.h"
 
@@ -9,12 +11,17 @@ public:
     _SimpleLogger();
     virtual ~_SimpleLogger();
 
+    //must be called from the GUI thread only
     std::vector<std::string> const& getMessages(Priority minPriority) const;
 
 private:
 
     void newLogMessage(Priority priority, std::string const& message) override;
 
-    std::vector<std::string> _allLogMessages;
-    std::vector<std::string> _importantLogMessages;
+    //messages from the logging thread are collected in _newLogMessages and moved to the lists below on request
+    mutable std::mutex _mutex;
+    mutable std::vector<LogMessage> _newLogMessages;
+
+    mutable std::vector<std::string> _allLogMessages;
+    mutable std::vector<std::string> _importantLogMessages;
 };
@@ -322,6 +322,16 @@ void _SimulationParametersWindow::processBase(
                 .max(6)
                 .tooltip(std::string("Maximum number of connections a cell can establish with others.")),
             simParameters.cellMaxBonds);
+        AlienImGui::SliderFloat(
+            AlienImGui::SliderFloatParameters()
+                .name("Particle merge distance")
+                .textWidth(MaxContentTextWidth)
+                .min(0)
+                .max(1.5f)
+                .defaultValue(origSimParameters.particleMergeDistance)
+                .tooltip(std::string("Energy particles in the same unit square are merged into the particle with the smallest id if they are closer "
+                                     "to it than this distance. Values above 1.42 merge all particles of a unit square.")),
+            simParameters.particleMergeDistance);
 
         /**
          * Cell color transition rules
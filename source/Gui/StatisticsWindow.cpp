@@ -14,34 +14,40 @@
 #include "AlienImGui.h"
 #include "ExportStatisticsDialog.h"
 
+namespace
+{
+    auto const HeadColWidth = 150.0f;
+
+    //the plots fill the available width
+    int getNumPlotPixels(float fractionOfVisibleRange = 1.0f)
+    {
+        return toInt(ImGui::GetContentRegionAvail().x / fractionOfVisibleRange);
+    }
+
+    size_t toMemoryCap(int megabytes)
+    {
+        return static_cast<size_t>(std::max(1, megabytes)) * 1024 * 1024;
+    }
+}
+
 _StatisticsWindow::_StatisticsWindow(SimulationController const& simController)
     : _AlienWindow("Statistics", "windows.statistics", false)
     , _simController(simController)
 {
     _exportStatisticsDialog = std::make_shared<_ExportStatisticsDialog>();
+    _longtermMemoryCap = GlobalSettings::getInstance().getIntState("windows.statistics.longterm memory cap", _longtermMemoryCap);
+    _longtermStatistics = LongtermStatistics(toMemoryCap(_longtermMemoryCap));
 }
 
-namespace
+_StatisticsWindow::~_StatisticsWindow()
 {
-    auto const HeadColWidth = 150.0f;
-
-    template<typename T>
-    T getMax(std::vector<T> const& range)
-    {
-        T result = static_cast<T>(0);
-        for (auto const& element : range) {
-            if (element > result) {
-                result = element;
-            }
-        }
-        return result;
-    }
+    GlobalSettings::getInstance().setIntState("windows.statistics.longterm memory cap", _longtermMemoryCap);
 }
 
 void _StatisticsWindow::reset()
 {
     _liveStatistics = LiveStatistics();
-    _longtermStatistics = LongtermStatistics();
+    _longtermStatistics = LongtermStatistics(toMemoryCap(_longtermMemoryCap));
 }
 
 void _StatisticsWindow::processIntern()
@@ -52,7 +58,7 @@ void _StatisticsWindow::processIntern()
 
     ImGui::SameLine();
     ImGui::BeginDisabled(!_live);
-    ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x - StyleRepository::getInstance().scaleContent(60));
+    ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x - StyleRepository::getInstance().scaleContent(160));
     ImGui::SliderFloat("", &_liveStatistics.history, 1, LiveStatistics::MaxLiveHistory, "%.1f s");
     ImGui::EndDisabled();
 
@@ -61,6 +67,15 @@ void _StatisticsWindow::processIntern()
         _exportStatisticsDialog->show(_longtermStatistics);
     }
 
+    ImGui::SameLine();
+    if (!_exportStatisticsDialog->isRecording()) {
+        if (AlienImGui::Button("Record")) {
+            _exportStatisticsDialog->showForRecording();
+        }
+    } else if (AlienImGui::Button("Stop recording")) {
+        _exportStatisticsDialog->stopRecording();
+    }
+
     if (_live) {
         processLiveStatistics();
     } else {
@@ -86,7 +101,7 @@ void _StatisticsWindow::processLiveStatistics()
         }
 
         ImGui::TableSetColumnIndex(1);
-        processLivePlot(0, _liveStatistics.datas[0]);
+        processLivePlot(0, 0);
         if (_showCellsByColor) {
             processLivePlotForCellsByColor(1);
         }
@@ -95,19 +110,19 @@ void _StatisticsWindow::processLiveStatistics()
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Cell connections");
         ImGui::TableSetColumnIndex(1);
-        processLivePlot(2, _liveStatistics.datas[8]);
+        processLivePlot(2, 8);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Energy particles");
         ImGui::TableSetColumnIndex(1);
-        processLivePlot(3, _liveStatistics.datas[9]);
+        processLivePlot(3, 9);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Tokens");
         ImGui::TableSetColumnIndex(1);
-        processLivePlot(4, _liveStatistics.datas[10]);
+        processLivePlot(4, 10);
 
         ImPlot::PopColormap();
 
@@ -125,25 +140,25 @@ void _StatisticsWindow::processLiveStatistics()
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Created cells");
         ImGui::TableSetColumnIndex(1);
-        processLivePlot(5, _liveStatistics.datas[11], 2);
+        processLivePlot(5, 11, 2);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Successful attacks");
         ImGui::TableSetColumnIndex(1);
-        processLivePlot(6, _liveStatistics.datas[12], 2);
+        processLivePlot(6, 12, 2);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Failed attacks");
         ImGui::TableSetColumnIndex(1);
-        processLivePlot(7, _liveStatistics.datas[13], 2);
+        processLivePlot(7, 13, 2);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Muscle activities");
         ImGui::TableSetColumnIndex(1);
-        processLivePlot(8, _liveStatistics.datas[14], 2);
+        processLivePlot(8, 14, 2);
 
         ImPlot::PopColormap();
         ImGui::EndTable();
@@ -152,6 +167,11 @@ void _StatisticsWindow::processLiveStatistics()
 
 void _StatisticsWindow::processLongtermStatistics()
 {
+    auto const& rollup = _longtermStatistics.getBestRollup();
+    if (rollup.timestepHistory.empty()) {
+        return;
+    }
+
     ImGui::Spacing();
     if (ImGui::BeginTable(
             "##",
@@ -172,28 +192,28 @@ void _StatisticsWindow::processLongtermStatistics()
         }
 
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(0, _longtermStatistics.datas[0]);
+        processLongtermPlot(0, 0);
         if (_showCellsByColor) {
-            processLongtermPlotForCellsByColor(1);
+            processLongtermPlotForCellsByColor(1, rollup);
         }
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Cell connections");
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(2, _longtermStatistics.datas[8]);
+        processLongtermPlot(2, 8);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Energy particles");
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(3, _longtermStatistics.datas[9]);
+        processLongtermPlot(3, 9);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Tokens");
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(4, _longtermStatistics.datas[10]);
+        processLongtermPlot(4, 10);
         ImPlot::PopColormap();
         ImGui::EndTable();
     }
@@ -213,35 +233,38 @@ void _StatisticsWindow::processLongtermStatistics()
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Created cells");
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(5, _longtermStatistics.datas[11], 2);
+        processLongtermPlot(5, 11, 2);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Successful attacks");
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(6, _longtermStatistics.datas[12], 2);
+        processLongtermPlot(6, 12, 2);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Failed attacks");
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(7, _longtermStatistics.datas[13], 2);
+        processLongtermPlot(7, 13, 2);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Muscle activities");
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(8, _longtermStatistics.datas[14], 2);
+        processLongtermPlot(8, 14, 2);
 
         ImPlot::PopColormap();
         ImGui::EndTable();
     }
 }
 
-void _StatisticsWindow::processLivePlot(int row, std::vector<float> const& valueHistory, int fracPartDecimals)
+void _StatisticsWindow::processLivePlot(int row, int seriesIndex, int fracPartDecimals)
 {
-    auto maxValue = getMax(valueHistory);
-    
+    auto const& valueHistory = _liveStatistics.datas[seriesIndex];
+    auto& plotSeries = _livePlotSeries[seriesIndex];
+    plotSeries.update(_liveStatistics.timepointsHistory, valueHistory, getNumPlotPixels(calcVisibleFractionOfLiveHistory()));
+    auto maxValue = std::max(0.0f, plotSeries.getMax());
+
     ImGui::PushID(row);
     ImPlot::PushStyleColor(ImPlotCol_FrameBg, (ImU32)ImColor(0.0f, 0.0f, 0.0f, ImGui::GetStyle().Alpha));
     ImPlot::PushStyleColor(ImPlotCol_PlotBg, (ImU32)ImColor(0.0f, 0.0f, 0.0f, ImGui::GetStyle().Alpha));
@@ -271,10 +294,10 @@ void _StatisticsWindow::processLivePlot(int row, std::vector<float> const& value
 
         ImPlot::PushStyleColor(ImPlotCol_Line, color);
 
-        ImPlot::PlotLine("##", _liveStatistics.timepointsHistory.data(), valueHistory.data(), toInt(valueHistory.size()));
+        ImPlot::PlotLine("##", plotSeries.getXs(), plotSeries.getYs(), plotSeries.getSize());
 
         ImPlot::PushStyleVar(ImPlotStyleVar_FillAlpha, 0.25f * ImGui::GetStyle().Alpha);
-        ImPlot::PlotShaded("##", _liveStatistics.timepointsHistory.data(), valueHistory.data(), toInt(valueHistory.size()));
+        ImPlot::PlotShaded("##", plotSeries.getXs(), plotSeries.getYs(), plotSeries.getSize());
         ImPlot::PopStyleVar();
 
         ImPlot::PopStyleColor();
@@ -289,8 +312,11 @@ void _StatisticsWindow::processLivePlot(int row, std::vector<float> const& value
 void _StatisticsWindow::processLivePlotForCellsByColor(int row)
 {
     auto maxValue = 0.0f;
+    auto numPixels = getNumPlotPixels(calcVisibleFractionOfLiveHistory());
     for (int i = 0; i < 7; ++i) {
-        maxValue = std::max(maxValue, getMax(_liveStatistics.datas[1 + i]));
+        auto& plotSeries = _livePlotSeries[1 + i];
+        plotSeries.update(_liveStatistics.timepointsHistory, _liveStatistics.datas[1 + i], numPixels);
+        maxValue = std::max(maxValue, plotSeries.getMax());
     }
 
     ImGui::PushID(row);
@@ -310,8 +336,8 @@ void _StatisticsWindow::processLivePlotForCellsByColor(int row)
 
             ImPlot::PushStyleColor(ImPlotCol_Line, (ImU32)color);
             auto s = std::to_string(toInt(_liveStatistics.datas[1 + i].back()));
-            ImPlot::PlotLine(
-                s.c_str(), _liveStatistics.timepointsHistory.data(), _liveStatistics.datas[1 + i].data(), toInt(_liveStatistics.datas[1 + i].size()));
+            auto const& plotSeries = _livePlotSeries[1 + i];
+            ImPlot::PlotLine(s.c_str(), plotSeries.getXs(), plotSeries.getYs(), plotSeries.getSize());
             ImPlot::PopStyleColor();
             ImGui::PopID();
         }
@@ -322,9 +348,14 @@ void _StatisticsWindow::processLivePlotForCellsByColor(int row)
     ImGui::PopID();
 }
 
-void _StatisticsWindow::processLongtermPlot(int row, std::vector<float> const& valueHistory, int fracPartDecimals)
+void _StatisticsWindow::processLongtermPlot(int row, int seriesIndex, int fracPartDecimals)
 {
-    auto maxValue = getMax(valueHistory);
+    auto const& rollup = _longtermStatistics.getBestRollup();
+    auto const& timestepHistory = rollup.timestepHistory;
+    auto const& valueHistory = rollup.means[seriesIndex];
+    auto& plotSeries = _longtermPlotSeries[seriesIndex];
+    plotSeries.update(timestepHistory, valueHistory, getNumPlotPixels());
+    auto maxValue = std::max(0.0f, plotSeries.getMax());
 
     ImGui::PushID(row);
     ImPlot::PushStyleColor(ImPlotCol_FrameBg, (ImU32)ImColor(0.0f, 0.0f, 0.0f, ImGui::GetStyle().Alpha));
@@ -332,8 +363,8 @@ void _StatisticsWindow::processLongtermPlot(int row, std::vector<float> const& v
     ImPlot::PushStyleColor(ImPlotCol_PlotBorder, (ImU32)ImColor(0.3f, 0.3f, 0.3f, ImGui::GetStyle().Alpha));
     ImPlot::PushStyleVar(ImPlotStyleVar_PlotPadding, ImVec2(0, 0));
     ImPlot::SetNextPlotLimits(
-        _longtermStatistics.timestepHistory.front(),
-        _longtermStatistics.timestepHistory.back(),
+        timestepHistory.front(),
+        timestepHistory.back(),
         0,
         maxValue * 1.5,
         ImGuiCond_Always);  
@@ -342,7 +373,7 @@ void _StatisticsWindow::processLongtermPlot(int row, std::vector<float> const& v
         auto color = ImPlot::GetColormapColor(row + 2);
         if (ImGui::GetStyle().Alpha == 1.0f) {
             ImPlot::AnnotateClamped(
-                _longtermStatistics.timestepHistory.back(),
+                timestepHistory.back(),
                 valueHistory.back(),
                 ImVec2(-10.0f, 10.0f),
                 ImPlot::GetLastItemColor(),
@@ -350,11 +381,9 @@ void _StatisticsWindow::processLongtermPlot(int row, std::vector<float> const& v
                 StringHelper::format(valueHistory.back(), fracPartDecimals).c_str());
         }
         ImPlot::PushStyleColor(ImPlotCol_Line, color);
-        ImPlot::PlotLine(
-            "##", _longtermStatistics.timestepHistory.data(), valueHistory.data(), toInt(valueHistory.size()));
+        ImPlot::PlotLine("##", plotSeries.getXs(), plotSeries.getYs(), plotSeries.getSize());
         ImPlot::PushStyleVar(ImPlotStyleVar_FillAlpha, 0.25f);
-        ImPlot::PlotShaded(
-            "##", _longtermStatistics.timestepHistory.data(), valueHistory.data(), toInt(valueHistory.size()));
+        ImPlot::PlotShaded("##", plotSeries.getXs(), plotSeries.getYs(), plotSeries.getSize());
         ImPlot::PopStyleVar();
         ImPlot::PopStyleColor();
         ImPlot::EndPlot();
@@ -364,11 +393,14 @@ void _StatisticsWindow::processLongtermPlot(int row, std::vector<float> const& v
     ImGui::PopID();
 }
 
-void _StatisticsWindow::processLongtermPlotForCellsByColor(int row)
+void _StatisticsWindow::processLongtermPlotForCellsByColor(int row, StatisticsRollup const& rollup)
 {
     auto maxValue = 0.0f;
+    auto numPixels = getNumPlotPixels();
     for (int i = 0; i < 7; ++i) {
-        maxValue = std::max(maxValue, getMax(_longtermStatistics.datas[1 + i]));
+        auto& plotSeries = _longtermPlotSeries[1 + i];
+        plotSeries.update(rollup.timestepHistory, rollup.means[1 + i], numPixels);
+        maxValue = std::max(maxValue, plotSeries.getMax());
     }
 
     ImGui::PushID(row);
@@ -376,7 +408,7 @@ void _StatisticsWindow::processLongtermPlotForCellsByColor(int row)
     ImPlot::PushStyleColor(ImPlotCol_PlotBg, (ImU32)ImColor(0.0f, 0.0f, 0.0f, ImGui::GetStyle().Alpha));
     ImPlot::PushStyleColor(ImPlotCol_PlotBorder, (ImU32)ImColor(0.3f, 0.3f, 0.3f, ImGui::GetStyle().Alpha));
     ImPlot::PushStyleVar(ImPlotStyleVar_PlotPadding, ImVec2(0, 0));
-    ImPlot::SetNextPlotLimits(_longtermStatistics.timestepHistory.front(), _longtermStatistics.timestepHistory.back(), 0, maxValue * 1.5, ImGuiCond_Always);
+    ImPlot::SetNextPlotLimits(rollup.timestepHistory.front(), rollup.timestepHistory.back(), 0, maxValue * 1.5, ImGuiCond_Always);
     if (ImPlot::BeginPlot(
             "##", 0, 0, ImVec2(-1, StyleRepository::getInstance().scaleContent(160.0f)), 0, ImPlotAxisFlags_NoTickLabels, ImPlotAxisFlags_NoTickLabels)) {
         for (int i = 0; i < 7; ++i) {
@@ -385,9 +417,9 @@ void _StatisticsWindow::processLongtermPlotForCellsByColor(int row)
             ImColor color(toInt((colorRaw >> 16) & 0xff), toInt((colorRaw >> 8) & 0xff), toInt(colorRaw & 0xff));
 
             ImPlot::PushStyleColor(ImPlotCol_Line, (ImU32)color);
-            auto s = std::to_string(toInt(_longtermStatistics.datas[1 + i].back()));
-            ImPlot::PlotLine(
-                s.c_str(), _longtermStatistics.timestepHistory.data(), _longtermStatistics.datas[1 + i].data(), toInt(_longtermStatistics.datas[1 + i].size()));
+            auto s = std::to_string(toInt(rollup.means[1 + i].back()));
+            auto const& plotSeries = _longtermPlotSeries[1 + i];
+            ImPlot::PlotLine(s.c_str(), plotSeries.getXs(), plotSeries.getYs(), plotSeries.getSize());
             ImPlot::PopStyleColor();
             ImGui::PopID();
         }
@@ -402,9 +434,17 @@ void _StatisticsWindow::processLongtermPlotForCellsByColor(int row)
 void _StatisticsWindow::processBackground()
 {
     auto newStatistics = _simController->getStatistics();
-    _liveStatistics.add(newStatistics);
+    _liveStatistics.add(newStatistics, ImGui::GetIO().DeltaTime);
 
     _longtermStatistics.add(newStatistics);
+    _exportStatisticsDialog->addStatistics(newStatistics);
+}
+
+float _StatisticsWindow::calcVisibleFractionOfLiveHistory() const
+{
+    auto const& timepoints = _liveStatistics.timepointsHistory;
+    auto timespan = timepoints.back() - timepoints.front();
+    return timespan > _liveStatistics.history ? _liveStatistics.history / timespan : 1.0f;
 }
 
 uint32_t _StatisticsWindow::getCellColor(int i) const
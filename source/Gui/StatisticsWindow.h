@@ -1,15 +1,17 @@
 #pragma once
 
+#include "EngineInterface/DecimatedPlotSeries.h"
 #include "EngineInterface/Definitions.h"
+#include "EngineInterface/StatisticsHistory.h"
 
 #include "Definitions.h"
 #include "AlienWindow.h"
-#include "StatisticsHistory.h"
 
 class _StatisticsWindow : public _AlienWindow
 {
 public:
     _StatisticsWindow(SimulationController const& simController);
+    ~_StatisticsWindow();
 
     void reset();
 
@@ -18,13 +20,14 @@ private:
     void processLiveStatistics();
     void processLongtermStatistics();
 
-    void processLivePlot(int row, std::vector<float> const& valueHistory, int fracPartDecimals = 0);
+    void processLivePlot(int row, int seriesIndex, int fracPartDecimals = 0);
     void processLivePlotForCellsByColor(int row);
-    void processLongtermPlot(int row, std::vector<float> const& valueHistory, int fracPartDecimals = 0);
-    void processLongtermPlotForCellsByColor(int row);
+    void processLongtermPlot(int row, int seriesIndex, int fracPartDecimals = 0);
+    void processLongtermPlotForCellsByColor(int row, StatisticsRollup const& rollup);
 
     void processBackground() override;
 
+    float calcVisibleFractionOfLiveHistory() const;
     uint32_t getCellColor(int i) const;
 
     SimulationController _simController;
@@ -33,6 +36,10 @@ private:
     bool _live = true;
     bool _showCellsByColor = false;
 
+    int _longtermMemoryCap = 16;  //in MB
+
     LiveStatistics _liveStatistics;
     LongtermStatistics _longtermStatistics;
+    std::array<DecimatedPlotSeries, NumStatisticsSeries> _livePlotSeries;
+    std::array<DecimatedPlotSeries, NumStatisticsSeries> _longtermPlotSeries;
 };
@@ -86,28 +86,26 @@ void _UploadSimulationDialog::show()
 
 void _UploadSimulationDialog::onUpload()
 {
-    DeserializedSimulation sim;
-    sim.timestep = static_cast<uint32_t>(_simController->getCurrentTimestep());
-    sim.settings = _simController->getSettings();
-    sim.symbolMap = _simController->getSymbolMap();
-    sim.content = _simController->getClusteredSimulationData();
-
-    std::string content, settings, symbolMap;
-    if (!Serializer::serializeSimulationToStrings(content, settings, symbolMap, sim)) {
+    auto sim = std::make_shared<DeserializedSimulation>();
+    sim->timestep = static_cast<uint32_t>(_simController->getCurrentTimestep());
+    sim->settings = _simController->getSettings();
+    sim->symbolMap = _simController->getSymbolMap();
+    sim->content = _simController->getClusteredSimulationData();
+
+    std::string settings, symbolMap;
+    if (!Serializer::serializeSettingsAndSymbolMapToStrings(settings, symbolMap, *sim)) {
         MessageDialog::getInstance().show("Save simulation", "The simulation could not be uploaded.");
         return;
     }
 
-    if (!_networkController->uploadSimulation(
+    //the snapshot is kept alive by the content writer until the upload is finished
+    auto upload = _networkController->uploadSimulation(
         _simName,
         _simDescription,
-        {sim.settings.generalSettings.worldSizeX, sim.settings.generalSettings.worldSizeY},
-        sim.content.getNumberOfCellAndParticles(),
-        content,
+        {sim->settings.generalSettings.worldSizeX, sim->settings.generalSettings.worldSizeY},
+        sim->content.getNumberOfCellAndParticles(),
+        [sim](std::ostream& stream) { Serializer::serializeContentToStream(stream, sim->content); },
         settings,
-        symbolMap)) {
-        MessageDialog::getInstance().show("Error", "Failed to upload simulation.");
-        return;
-    }
-    _browserWindow->onRefresh();
+        symbolMap);
+    _browserWindow->onUploadStarted(upload);
 }
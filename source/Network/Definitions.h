@@ -0,0 +1,18 @@
+#pragma once
+
+#include <memory>
+
+class _NetworkTask;
+using NetworkTask = std::shared_ptr<_NetworkTask>;
+
+class _NetworkService;
+using NetworkService = std::shared_ptr<_NetworkService>;
+
+class _SimulationCache;
+using SimulationCache = std::shared_ptr<_SimulationCache>;
+
+class _SimulationDownload;
+using SimulationDownload = std::shared_ptr<_SimulationDownload>;
+
+class _SimulationCatalog;
+using SimulationCatalog = std::shared_ptr<_SimulationCatalog>;
@@ -0,0 +1,335 @@
+#include "NetworkService.h"
+
+#include <ostream>
+
+#include <cpp-httplib/httplib.h>
+
+namespace
+{
+    bool isHttps(std::string const& serverAddress)
+    {
+        return serverAddress.find("://") == std::string::npos || serverAddress.rfind("https://", 0) == 0;
+    }
+
+    std::unique_ptr<httplib::Client> createClient(std::string const& serverAddress)
+    {
+        auto hasScheme = serverAddress.find("://") != std::string::npos;
+        auto result = std::make_unique<httplib::Client>(hasScheme ? serverAddress : "https://" + serverAddress);
+        result->set_keep_alive(true);
+        result->set_tcp_nodelay(true);
+        if (isHttps(serverAddress)) {
+            result->set_ca_cert_path("./resources/ca-bundle.crt");
+            result->enable_server_certificate_verification(true);
+        }
+        return result;
+    }
+
+    //forwards the written data in blocks of fixed size to the request body
+    class SinkBuffer : public std::streambuf
+    {
+    public:
+        SinkBuffer(httplib::DataSink& sink, std::function<bool(size_t)> const& onWrite)
+            : _sink(sink)
+            , _onWrite(onWrite)
+            , _buffer(BlockSize)
+        {
+            setp(_buffer.data(), _buffer.data() + _buffer.size());
+        }
+
+    protected:
+        int_type overflow(int_type ch) override
+        {
+            if (!writeBlock()) {
+                return traits_type::eof();
+            }
+            if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+                *pptr() = traits_type::to_char_type(ch);
+                pbump(1);
+            }
+            return traits_type::not_eof(ch);
+        }
+
+        int sync() override { return writeBlock() ? 0 : -1; }
+
+    private:
+        bool writeBlock()
+        {
+            auto size = static_cast<size_t>(pptr() - pbase());
+            if (size > 0 && (!_onWrite(size) || !_sink.write(pbase(), size))) {
+                return false;
+            }
+            setp(_buffer.data(), _buffer.data() + _buffer.size());
+            return true;
+        }
+
+        static auto constexpr BlockSize = 64 * 1024;
+
+        httplib::DataSink& _sink;
+        std::function<bool(size_t)> _onWrite;
+        std::vector<char> _buffer;
+    };
+
+    bool isStreamed(NetworkRequest const& request)
+    {
+        for (auto const& item : request.multipartItems) {
+            if (item.contentWriter) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //same layout as httplib's multipart serialization but without assembling the body in memory
+    bool writeMultipartBody(
+        httplib::DataSink& sink,
+        std::vector<MultipartItem> const& items,
+        std::string const& boundary,
+        std::function<bool(size_t)> const& onWrite)
+    {
+        SinkBuffer buffer(sink, onWrite);
+        std::ostream stream(&buffer);
+        try {
+            for (auto const& item : items) {
+                stream << "--" << boundary << "\r\n";
+                stream << "Content-Disposition: form-data; name=\"" << item.name << "\"\r\n";
+                if (!item.contentType.empty()) {
+                    stream << "Content-Type: " << item.contentType << "\r\n";
+                }
+                stream << "\r\n";
+                if (item.contentWriter) {
+                    item.contentWriter(stream);
+                } else {
+                    stream.write(item.content.data(), item.content.size());
+                }
+                stream << "\r\n";
+            }
+            stream << "--" << boundary << "--\r\n";
+            stream.flush();
+        } catch (...) {
+            return false;
+        }
+        if (!stream) {
+            return false;
+        }
+        sink.done();
+        return true;
+    }
+
+    httplib::Result send(
+        httplib::Client& client,
+        NetworkRequest const& request,
+        httplib::Progress const& progress,
+        std::function<bool(size_t)> const& onWrite)
+    {
+        httplib::Params params(request.params.begin(), request.params.end());
+        if (NetworkRequest::Method::Get == request.method) {
+            return client.Get(request.path.c_str(), params, {}, progress);
+        }
+        if (isStreamed(request)) {
+            auto boundary = httplib::detail::make_multipart_data_boundary();
+            return client.Post(
+                request.path.c_str(),
+                {},
+                [&](size_t, httplib::DataSink& sink) { return writeMultipartBody(sink, request.multipartItems, boundary, onWrite); },
+                ("multipart/form-data; boundary=" + boundary).c_str());
+        }
+        if (!request.multipartItems.empty()) {
+            httplib::MultipartFormDataItems items;
+            for (auto const& item : request.multipartItems) {
+                items.push_back({item.name, item.content, "", item.contentType});
+            }
+            return client.Post(request.path.c_str(), items);
+        }
+        return client.Post(request.path.c_str(), params);
+    }
+}
+
+auto _NetworkTask::getState() const -> State
+{
+    std::lock_guard lock(_mutex);
+    return _state;
+}
+
+bool _NetworkTask::isFinished() const
+{
+    auto state = getState();
+    return State::Succeeded == state || State::Failed == state || State::Canceled == state;
+}
+
+void _NetworkTask::wait() const
+{
+    std::unique_lock lock(_mutex);
+    _finishedCondition.wait(lock, [&] { return State::Pending != _state && State::Running != _state; });
+}
+
+void _NetworkTask::cancel()
+{
+    _canceled = true;
+}
+
+bool _NetworkTask::isCanceled() const
+{
+    return _canceled;
+}
+
+std::string const& _NetworkTask::getResponse() const
+{
+    return _response;
+}
+
+std::string const& _NetworkTask::getErrorMessage() const
+{
+    return _errorMessage;
+}
+
+uint64_t _NetworkTask::getReceivedBytes() const
+{
+    return _receivedBytes;
+}
+
+uint64_t _NetworkTask::getTotalBytes() const
+{
+    return _totalBytes;
+}
+
+uint64_t _NetworkTask::getSentBytes() const
+{
+    return _sentBytes;
+}
+
+bool _NetworkTask::tryStart()
+{
+    std::lock_guard lock(_mutex);
+    if (_canceled) {
+        return false;
+    }
+    _state = State::Running;
+    return true;
+}
+
+void _NetworkTask::finish(State state, std::string&& response, std::string const& errorMessage)
+{
+    {
+        std::lock_guard lock(_mutex);
+        _response = std::move(response);
+        _errorMessage = errorMessage;
+        _state = state;
+    }
+    _finishedCondition.notify_all();
+}
+
+_NetworkService::_NetworkService(std::string const& serverAddress, int numConnections)
+    : _serverAddress(serverAddress)
+{
+    for (int i = 0; i < numConnections; ++i) {
+        _workers.emplace_back([this] { runWorker(); });
+    }
+}
+
+_NetworkService::~_NetworkService()
+{
+    {
+        std::lock_guard lock(_mutex);
+        _shutdown = true;
+    }
+    _condition.notify_all();
+    _retryCondition.notify_all();
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+    for (auto const& task : _tasks) {
+        task->finish(_NetworkTask::State::Canceled, {});
+    }
+}
+
+std::string const& _NetworkService::getServerAddress() const
+{
+    return _serverAddress;
+}
+
+NetworkTask _NetworkService::schedule(NetworkRequest const& request)
+{
+    auto result = std::make_shared<_NetworkTask>();
+    result->_request = request;
+    {
+        std::lock_guard lock(_mutex);
+        _tasks.emplace_back(result);
+    }
+    _condition.notify_one();
+    return result;
+}
+
+std::string _NetworkService::execute(NetworkRequest const& request)
+{
+    auto task = schedule(request);
+    task->wait();
+    if (_NetworkTask::State::Succeeded != task->getState()) {
+        throw std::runtime_error(task->getErrorMessage());
+    }
+    return task->getResponse();
+}
+
+void _NetworkService::runWorker()
+{
+    auto client = createClient(_serverAddress);
+    while (true) {
+        NetworkTask task;
+        {
+            std::unique_lock lock(_mutex);
+            _condition.wait(lock, [&] { return _shutdown || !_tasks.empty(); });
+            if (_shutdown) {
+                return;
+            }
+            task = _tasks.front();
+            _tasks.pop_front();
+        }
+        executeTask(*client, *task);
+    }
+}
+
+void _NetworkService::executeTask(httplib::Client& client, _NetworkTask& task)
+{
+    if (!task.tryStart()) {
+        task.finish(_NetworkTask::State::Canceled, {});
+        return;
+    }
+    auto const& request = task._request;
+    auto progress = [&](uint64_t current, uint64_t total) {
+        task._receivedBytes = current;
+        task._totalBytes = total;
+        return !task.isCanceled() && !_shutdown;
+    };
+    auto onWrite = [&](size_t bytes) {
+        task._sentBytes += bytes;
+        return !task.isCanceled() && !_shutdown;
+    };
+
+    auto attempt = 0;
+    while (true) {
+        task._sentBytes = 0;
+        auto result = send(client, request, progress, onWrite);
+        if (result) {
+            if (request.onSuccess) {
+                request.onSuccess(result->body);
+            }
+            task.finish(_NetworkTask::State::Succeeded, std::move(result->body));
+            return;
+        }
+        if (task.isCanceled() || _shutdown) {
+            task.finish(_NetworkTask::State::Canceled, {});
+            return;
+        }
+        if (++attempt == MaxAttempts || !request.withRetry) {
+            std::string errorMessage = "Error connecting to the server.";
+            if (isHttps(_serverAddress)) {
+                if (auto verifyResult = client.get_openssl_verify_result()) {
+                    errorMessage = "OpenSSL verify error: " + std::string(X509_verify_cert_error_string(verifyResult));
+                }
+            }
+            task.finish(_NetworkTask::State::Failed, {}, errorMessage);
+            return;
+        }
+        std::unique_lock lock(_mutex);
+        _retryCondition.wait_for(lock, std::chrono::milliseconds(100), [&] { return _shutdown.load(); });
+    }
+}
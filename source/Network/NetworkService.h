@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Definitions.h"
+
+namespace httplib
+{
+    class Client;
+}
+
+struct MultipartItem
+{
+    std::string name;
+    std::string content;
+    std::string contentType;
+
+    //if set, the content is not taken from 'content' but written to the socket in fixed-size chunks while being produced;
+    //may be called again on retry and is aborted by an exception from the stream on cancellation
+    std::function<void(std::ostream&)> contentWriter = {};
+};
+
+struct NetworkRequest
+{
+    enum class Method
+    {
+        Get,
+        Post
+    };
+    Method method = Method::Get;
+    std::string path;
+    std::vector<std::pair<std::string, std::string>> params;
+    std::vector<MultipartItem> multipartItems;  //if not empty the request is posted as multipart form data
+    bool withRetry = true;
+
+    //called on the worker thread with the response body before the task is finished
+    std::function<void(std::string const&)> onSuccess;
+};
+
+class _NetworkTask
+{
+public:
+    enum class State
+    {
+        Pending,
+        Running,
+        Succeeded,
+        Failed,
+        Canceled
+    };
+
+    State getState() const;
+    bool isFinished() const;
+    void wait() const;
+
+    //a running transfer is aborted at the next sent or received chunk
+    void cancel();
+    bool isCanceled() const;
+
+    std::string const& getResponse() const;  //valid if succeeded
+    std::string const& getErrorMessage() const;  //valid if failed
+
+    uint64_t getReceivedBytes() const;
+    uint64_t getTotalBytes() const;  //0 if not known yet
+    uint64_t getSentBytes() const;  //request body bytes of the current attempt
+
+private:
+    friend class _NetworkService;
+
+    bool tryStart();
+    void finish(State state, std::string&& response, std::string const& errorMessage = "");
+
+    NetworkRequest _request;
+
+    mutable std::mutex _mutex;
+    mutable std::condition_variable _finishedCondition;
+    State _state = State::Pending;
+    std::string _response;
+    std::string _errorMessage;
+
+    std::atomic<bool> _canceled{false};
+    std::atomic<uint64_t> _receivedBytes{0};
+    std::atomic<uint64_t> _totalBytes{0};
+    std::atomic<uint64_t> _sentBytes{0};
+};
+
+//executes requests on worker threads each of which keeps its client (and thus its keep-alive connection and loaded CA bundle)
+//for the lifetime of the service
+class _NetworkService
+{
+public:
+    //serverAddress without scheme is connected via https
+    _NetworkService(std::string const& serverAddress, int numConnections = 3);
+    ~_NetworkService();
+
+    std::string const& getServerAddress() const;
+
+    NetworkTask schedule(NetworkRequest const& request);
+
+    //blocking, throws std::runtime_error if the server could not be reached
+    std::string execute(NetworkRequest const& request);
+
+private:
+    void runWorker();
+    void executeTask(httplib::Client& client, _NetworkTask& task);
+
+    static auto constexpr MaxAttempts = 5;
+
+    std::string _serverAddress;
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::condition_variable _retryCondition;
+    std::deque<NetworkTask> _tasks;
+    std::atomic<bool> _shutdown{false};
+    std::vector<std::thread> _workers;
+};
@@ -0,0 +1,87 @@
+#include "NgramIndex.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+
+void NgramIndex::build(std::vector<std::string> const& texts)
+{
+    _lowercaseTexts.clear();
+    _lowercaseTexts.reserve(texts.size());
+    _postingLists.clear();
+
+    std::vector<uint32_t> ngrams;
+    for (int index = 0; index < static_cast<int>(texts.size()); ++index) {
+        auto const& text = _lowercaseTexts.emplace_back(toLowercase(texts[index]));
+
+        ngrams.clear();
+        for (size_t pos = 0; pos + N <= text.size(); ++pos) {
+            ngrams.emplace_back(getNgram(text, pos));
+        }
+        std::sort(ngrams.begin(), ngrams.end());
+        ngrams.erase(std::unique(ngrams.begin(), ngrams.end()), ngrams.end());
+        for (auto const& ngram : ngrams) {
+            _postingLists[ngram].emplace_back(index);
+        }
+    }
+}
+
+std::vector<int> NgramIndex::find(std::string const& filter) const
+{
+    auto lowercaseFilter = toLowercase(filter);
+    auto matches = [&](int index) { return _lowercaseTexts[index].find(lowercaseFilter) != std::string::npos; };
+
+    std::vector<int> result;
+    if (lowercaseFilter.size() < N) {
+        for (int index = 0; index < static_cast<int>(_lowercaseTexts.size()); ++index) {
+            if (matches(index)) {
+                result.emplace_back(index);
+            }
+        }
+        return result;
+    }
+
+    std::vector<std::vector<int> const*> postingLists;
+    for (size_t pos = 0; pos + N <= lowercaseFilter.size(); ++pos) {
+        auto findResult = _postingLists.find(getNgram(lowercaseFilter, pos));
+        if (findResult == _postingLists.end()) {
+            return {};
+        }
+        postingLists.emplace_back(&findResult->second);
+    }
+    std::sort(postingLists.begin(), postingLists.end(), [](auto const& left, auto const& right) { return left->size() < right->size(); });
+    postingLists.erase(std::unique(postingLists.begin(), postingLists.end()), postingLists.end());
+
+    //intersect starting with the shortest list
+    std::vector<int> candidates = *postingLists.front();
+    std::vector<int> intersection;
+    for (size_t i = 1; i < postingLists.size() && !candidates.empty(); ++i) {
+        intersection.clear();
+        std::set_intersection(
+            candidates.begin(), candidates.end(), postingLists[i]->begin(), postingLists[i]->end(), std::back_inserter(intersection));
+        candidates.swap(intersection);
+    }
+
+    for (auto const& index : candidates) {
+        if (matches(index)) {
+            result.emplace_back(index);
+        }
+    }
+    return result;
+}
+
+std::string NgramIndex::toLowercase(std::string const& text)
+{
+    std::string result(text);
+    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return result;
+}
+
+uint32_t NgramIndex::getNgram(std::string const& text, size_t pos)
+{
+    uint32_t result = 0;
+    for (size_t i = 0; i < N; ++i) {
+        result = (result << 8) | static_cast<unsigned char>(text[pos + i]);
+    }
+    return result;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//case-insensitive substring search over a fixed set of texts:
+//candidates are obtained by intersecting the posting lists of the lowercase trigrams of the filter and verified afterwards
+class NgramIndex
+{
+public:
+    void build(std::vector<std::string> const& texts);
+
+    //indices of the texts containing the filter in ascending order
+    std::vector<int> find(std::string const& filter) const;
+
+private:
+    static std::string toLowercase(std::string const& text);
+    static uint32_t getNgram(std::string const& text, size_t pos);
+
+    static auto constexpr N = 3;
+
+    std::vector<std::string> _lowercaseTexts;
+    std::unordered_map<uint32_t, std::vector<int>> _postingLists;  //sorted indices
+};
@@ -0,0 +1,37 @@
+#include "RemoteSimulationData.h"
+
+int RemoteSimulationData::compare(RemoteSimulationData const& left, RemoteSimulationData const& right, int columnId)
+{
+    switch (columnId) {
+    case RemoteSimulationDataColumnId_Timestamp:
+        return left.timestamp.compare(right.timestamp);
+    case RemoteSimulationDataColumnId_UserName:
+        return left.userName.compare(right.userName);
+    case RemoteSimulationDataColumnId_SimulationName:
+        return left.simName.compare(right.simName);
+    case RemoteSimulationDataColumnId_Description:
+        return left.description.compare(right.description);
+    case RemoteSimulationDataColumnId_Likes:
+        return left.likes - right.likes;
+    case RemoteSimulationDataColumnId_NumDownloads:
+        return left.numDownloads - right.numDownloads;
+    case RemoteSimulationDataColumnId_Width:
+        return left.width - right.width;
+    case RemoteSimulationDataColumnId_Height:
+        return left.height - right.height;
+    case RemoteSimulationDataColumnId_Particles:
+        return left.particles - right.particles;
+    case RemoteSimulationDataColumnId_FileSize:
+        return static_cast<int>(left.contentSize / 1024) - static_cast<int>(right.contentSize / 1024);
+    case RemoteSimulationDataColumnId_Version:
+        return left.version.compare(right.version);
+    }
+    return 0;
+}
+
+std::string RemoteSimulationData::getSearchText() const
+{
+    return timestamp + "\n" + userName + "\n" + simName + "\n" + std::to_string(likes) + "\n" + std::to_string(numDownloads) + "\n"
+        + std::to_string(width) + "\n" + std::to_string(height) + "\n" + std::to_string(particles) + "\n" + std::to_string(contentSize)
+        + "\n" + description + "\n" + version;
+}
@@ -1,9 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
-class ImGuiTableSortSpecs;
-
 enum RemoteSimulationDataColumnId
 {
     RemoteSimulationDataColumnId_Timestamp,
@@ -36,6 +35,17 @@ public:
     std::string description;
     std::string version;
 
-    static int compare(void const* left, void const* right, ImGuiTableSortSpecs const* specs);
-    bool matchWithFilter(std::string const& filter) const;
+    //negative if left < right, 0 if equal, positive if left > right with respect to the column
+    static int compare(RemoteSimulationData const& left, RemoteSimulationData const& right, int columnId);
+
+    //values of all columns separated by line breaks
+    std::string getSearchText() const;
+};
+
+//counters which change without a new timestamp of the simulation
+struct RemoteSimulationStats
+{
+    std::string id;
+    int likes;
+    int numDownloads;
 };
@@ -21,3 +21,25 @@ std::vector<RemoteSimulationData> RemoteSimulationDataParser::decode(boost::prop
     }
     return result;
 }
+
+std::vector<RemoteSimulationStats> RemoteSimulationDataParser::decodeStats(boost::property_tree::ptree const& tree)
+{
+    std::vector<RemoteSimulationStats> result;
+    for (auto const& [key, subTree] : tree) {
+        RemoteSimulationStats entry;
+        entry.id = subTree.get<std::string>("id");
+        entry.likes = subTree.get<int>("likes");
+        entry.numDownloads = subTree.get<int>("numDownloads");
+        result.emplace_back(entry);
+    }
+    return result;
+}
+
+std::map<std::string, std::set<std::string>> RemoteSimulationDataParser::decodeUserLikes(boost::property_tree::ptree const& tree)
+{
+    std::map<std::string, std::set<std::string>> result;
+    for (auto const& [key, subTree] : tree) {
+        result[subTree.get<std::string>("simId")].insert(subTree.get<std::string>("userName"));
+    }
+    return result;
+}
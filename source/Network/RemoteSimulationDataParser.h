@@ -0,0 +1,16 @@
+#pragma once
+
+#include <map>
+#include <set>
+#include <vector>
+#include <boost/property_tree/json_parser.hpp>
+
+#include "RemoteSimulationData.h"
+
+class RemoteSimulationDataParser
+{
+public:
+    static std::vector<RemoteSimulationData> decode(boost::property_tree::ptree tree);
+    static std::vector<RemoteSimulationStats> decodeStats(boost::property_tree::ptree const& tree);
+    static std::map<std::string, std::set<std::string>> decodeUserLikes(boost::property_tree::ptree const& tree);
+};
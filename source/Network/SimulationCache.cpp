@@ -0,0 +1,119 @@
+#include "SimulationCache.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+_SimulationCache::_SimulationCache(std::filesystem::path const& directory, uint64_t maxBytes)
+    : _directory(directory)
+    , _maxBytes(maxBytes)
+{}
+
+std::optional<std::string> _SimulationCache::load(std::string const& simId, std::string const& version, std::string const& part)
+{
+    std::lock_guard lock(_mutex);
+
+    auto key = getKey(simId, version, part);
+    auto path = getPath(key);
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) {
+        return std::nullopt;
+    }
+    std::string storedKey;
+    std::getline(stream, storedKey);
+    if (storedKey != key) {
+        return std::nullopt;
+    }
+    std::stringstream result;
+    result << stream.rdbuf();
+
+    std::error_code error;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+    return result.str();
+}
+
+void _SimulationCache::store(std::string const& simId, std::string const& version, std::string const& part, std::string const& data)
+{
+    std::lock_guard lock(_mutex);
+
+    std::error_code error;
+    std::filesystem::create_directories(_directory, error);
+    if (error) {
+        return;
+    }
+    auto key = getKey(simId, version, part);
+    auto path = getPath(key);
+    auto tempPath = path;
+    tempPath += ".tmp";
+    {
+        std::ofstream stream(tempPath, std::ios::binary);
+        stream << key << '\n';
+        stream.write(data.data(), data.size());
+        if (!stream) {
+            stream.close();
+            std::filesystem::remove(tempPath, error);
+            return;
+        }
+    }
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        std::filesystem::remove(tempPath, error);
+        return;
+    }
+    evictIfNecessary();
+}
+
+std::string _SimulationCache::getKey(std::string const& simId, std::string const& version, std::string const& part)
+{
+    return simId + "/" + version + "/" + part;
+}
+
+std::filesystem::path _SimulationCache::getPath(std::string const& key) const
+{
+    //FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (auto const& c : key) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    std::stringstream stream;
+    stream << std::hex << hash;
+    return _directory / stream.str();
+}
+
+void _SimulationCache::evictIfNecessary()
+{
+    struct FileInfo
+    {
+        std::filesystem::path path;
+        uint64_t size;
+        std::filesystem::file_time_type lastWriteTime;
+    };
+    std::vector<FileInfo> files;
+    uint64_t totalBytes = 0;
+    std::error_code error;
+    for (auto const& entry : std::filesystem::directory_iterator(_directory, error)) {
+        if (!entry.is_regular_file(error)) {
+            continue;
+        }
+        auto size = entry.file_size(error);
+        if (error) {
+            continue;
+        }
+        files.push_back({entry.path(), size, entry.last_write_time(error)});
+        totalBytes += size;
+    }
+    if (totalBytes <= _maxBytes) {
+        return;
+    }
+    std::sort(files.begin(), files.end(), [](auto const& left, auto const& right) { return left.lastWriteTime < right.lastWriteTime; });
+    for (auto const& file : files) {
+        if (totalBytes <= _maxBytes) {
+            break;
+        }
+        if (std::filesystem::remove(file.path, error)) {
+            totalBytes -= file.size;
+        }
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "Definitions.h"
+
+//on-disk cache for downloaded simulation parts, the file of a part is named by the hash of simulation id, version and part name
+//and starts with these values in order to detect hash collisions
+//least recently used files are evicted if the total size exceeds the limit
+class _SimulationCache
+{
+public:
+    _SimulationCache(std::filesystem::path const& directory, uint64_t maxBytes);
+
+    std::optional<std::string> load(std::string const& simId, std::string const& version, std::string const& part);
+
+    //thread-safe, write errors are ignored
+    void store(std::string const& simId, std::string const& version, std::string const& part, std::string const& data);
+
+private:
+    static std::string getKey(std::string const& simId, std::string const& version, std::string const& part);
+    std::filesystem::path getPath(std::string const& key) const;
+    void evictIfNecessary();
+
+    std::filesystem::path _directory;
+    uint64_t _maxBytes;
+    std::mutex _mutex;
+};
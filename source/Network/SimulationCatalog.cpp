@@ -0,0 +1,276 @@
+#include "SimulationCatalog.h"
+
+#include <fstream>
+#include <sstream>
+
+#include <boost/algorithm/string/join.hpp>
+
+#include "NetworkService.h"
+#include "RemoteSimulationDataParser.h"
+
+namespace
+{
+    auto const FileHeader = std::string("alien simulation catalog 1");
+
+    boost::property_tree::ptree parseJson(std::string const& serverResponse)
+    {
+        std::stringstream stream(serverResponse);
+        boost::property_tree::ptree result;
+        boost::property_tree::read_json(stream, result);
+        return result;
+    }
+
+    void writeString(std::ostream& stream, std::string const& value)
+    {
+        auto size = static_cast<uint32_t>(value.size());
+        stream.write(reinterpret_cast<char const*>(&size), sizeof(size));
+        stream.write(value.data(), size);
+    }
+
+    void readString(std::istream& stream, std::string& value)
+    {
+        uint32_t size = 0;
+        stream.read(reinterpret_cast<char*>(&size), sizeof(size));
+        if (!stream) {
+            return;
+        }
+        value.resize(size);
+        stream.read(value.data(), size);
+    }
+
+    template <typename T>
+    void writeValue(std::ostream& stream, T const& value)
+    {
+        stream.write(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void readValue(std::istream& stream, T& value)
+    {
+        stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+    }
+}
+
+_SimulationCatalog::_SimulationCatalog(std::string const& serverAddress)
+    : _serverAddress(serverAddress)
+{}
+
+void _SimulationCatalog::load(std::filesystem::path const& path)
+{
+    std::ifstream stream(path, std::ios::binary);
+    std::string header, serverAddress;
+    readString(stream, header);
+    readString(stream, serverAddress);
+    if (!stream || header != FileHeader || serverAddress != _serverAddress) {
+        return;
+    }
+
+    std::vector<RemoteSimulationData> entries;
+    uint32_t numEntries = 0;
+    readValue(stream, numEntries);
+    for (uint32_t i = 0; i < numEntries && stream; ++i) {
+        RemoteSimulationData entry;
+        readString(stream, entry.id);
+        readString(stream, entry.timestamp);
+        readString(stream, entry.userName);
+        readString(stream, entry.simName);
+        readValue(stream, entry.likes);
+        readValue(stream, entry.numDownloads);
+        readValue(stream, entry.width);
+        readValue(stream, entry.height);
+        readValue(stream, entry.particles);
+        readValue(stream, entry.contentSize);
+        readString(stream, entry.description);
+        readString(stream, entry.version);
+        entries.emplace_back(entry);
+    }
+
+    std::map<std::string, std::set<std::string>> userLikesById;
+    uint32_t numUserLikes = 0;
+    readValue(stream, numUserLikes);
+    for (uint32_t i = 0; i < numUserLikes && stream; ++i) {
+        std::string simId;
+        readString(stream, simId);
+        uint32_t numUserNames = 0;
+        readValue(stream, numUserNames);
+        auto& userNames = userLikesById[simId];
+        for (uint32_t j = 0; j < numUserNames && stream; ++j) {
+            std::string userName;
+            readString(stream, userName);
+            userNames.insert(userName);
+        }
+    }
+    if (!stream) {
+        return;
+    }
+
+    _entries.clear();
+    _entryIndexById.clear();
+    updateEntries(entries);
+    _userLikesById = userLikesById;
+}
+
+void _SimulationCatalog::save(std::filesystem::path const& path) const
+{
+    std::ofstream stream(path, std::ios::binary);
+    writeString(stream, FileHeader);
+    writeString(stream, _serverAddress);
+
+    writeValue(stream, static_cast<uint32_t>(_entries.size()));
+    for (auto const& entry : _entries) {
+        writeString(stream, entry.id);
+        writeString(stream, entry.timestamp);
+        writeString(stream, entry.userName);
+        writeString(stream, entry.simName);
+        writeValue(stream, entry.likes);
+        writeValue(stream, entry.numDownloads);
+        writeValue(stream, entry.width);
+        writeValue(stream, entry.height);
+        writeValue(stream, entry.particles);
+        writeValue(stream, entry.contentSize);
+        writeString(stream, entry.description);
+        writeString(stream, entry.version);
+    }
+
+    writeValue(stream, static_cast<uint32_t>(_userLikesById.size()));
+    for (auto const& [simId, userNames] : _userLikesById) {
+        writeString(stream, simId);
+        writeValue(stream, static_cast<uint32_t>(userNames.size()));
+        for (auto const& userName : userNames) {
+            writeString(stream, userName);
+        }
+    }
+}
+
+void _SimulationCatalog::refresh(NetworkService const& networkService, bool withRetry)
+{
+    //timestamps have a resolution of seconds, hence simulations of the latest timestamp are requested again
+    auto since = getLatestTimestamp();
+    for (int offset = 0;; offset += PageSize) {
+        NetworkRequest request;
+        request.path = "/alien-server/getsimulationinfo.php";
+        request.params.emplace_back("since", since);
+        request.params.emplace_back("offset", std::to_string(offset));
+        request.params.emplace_back("limit", std::to_string(PageSize));
+        request.withRetry = withRetry;
+        auto page = RemoteSimulationDataParser::decode(parseJson(networkService->execute(request)));
+        updateEntries(page);
+        if (page.size() < PageSize) {
+            break;
+        }
+    }
+
+    NetworkRequest request;
+    request.path = "/alien-server/getsimulationstats.php";
+    request.withRetry = withRetry;
+    updateStats(RemoteSimulationDataParser::decodeStats(parseJson(networkService->execute(request))));
+
+    prefetchUserLikes(networkService, withRetry);
+}
+
+std::vector<RemoteSimulationData> const& _SimulationCatalog::getEntries() const
+{
+    return _entries;
+}
+
+std::string _SimulationCatalog::getLatestTimestamp() const
+{
+    std::string result;
+    for (auto const& entry : _entries) {
+        result = std::max(result, entry.timestamp);
+    }
+    return result;
+}
+
+std::optional<std::set<std::string>> _SimulationCatalog::getUserLikes(std::string const& simId) const
+{
+    auto findResult = _userLikesById.find(simId);
+    if (findResult == _userLikesById.end()) {
+        return std::nullopt;
+    }
+    return findResult->second;
+}
+
+void _SimulationCatalog::setUserLike(std::string const& simId, std::string const& userName, bool like)
+{
+    auto findResult = _entryIndexById.find(simId);
+    if (findResult == _entryIndexById.end()) {
+        return;
+    }
+    _entries[findResult->second].likes += like ? 1 : -1;
+
+    auto userLikesFindResult = _userLikesById.find(simId);
+    if (userLikesFindResult != _userLikesById.end()) {
+        if (like) {
+            userLikesFindResult->second.insert(userName);
+        } else {
+            userLikesFindResult->second.erase(userName);
+        }
+    }
+}
+
+void _SimulationCatalog::updateEntries(std::vector<RemoteSimulationData> const& entries)
+{
+    for (auto const& entry : entries) {
+        auto findResult = _entryIndexById.find(entry.id);
+        if (findResult != _entryIndexById.end()) {
+            _entries[findResult->second] = entry;
+        } else {
+            _entryIndexById.emplace(entry.id, _entries.size());
+            _entries.emplace_back(entry);
+        }
+    }
+}
+
+void _SimulationCatalog::updateStats(std::vector<RemoteSimulationStats> const& stats)
+{
+    std::unordered_map<std::string, RemoteSimulationStats const*> statsById;
+    for (auto const& entryStats : stats) {
+        statsById.emplace(entryStats.id, &entryStats);
+    }
+
+    std::vector<RemoteSimulationData> entries;
+    entries.reserve(_entries.size());
+    for (auto& entry : _entries) {
+        auto findResult = statsById.find(entry.id);
+        if (findResult == statsById.end()) {
+            _userLikesById.erase(entry.id);
+            continue;
+        }
+        entry.likes = findResult->second->likes;
+        entry.numDownloads = findResult->second->numDownloads;
+        entries.emplace_back(std::move(entry));
+    }
+    _entries.clear();
+    _entryIndexById.clear();
+    updateEntries(entries);
+}
+
+void _SimulationCatalog::prefetchUserLikes(NetworkService const& networkService, bool withRetry)
+{
+    std::vector<std::string> simIds;
+    for (auto const& entry : _entries) {
+        if (0 == entry.likes) {
+            _userLikesById.erase(entry.id);
+            continue;
+        }
+        auto findResult = _userLikesById.find(entry.id);
+        if (findResult == _userLikesById.end() || static_cast<int>(findResult->second.size()) != entry.likes) {
+            simIds.emplace_back(entry.id);
+        }
+    }
+
+    for (size_t batchStart = 0; batchStart < simIds.size(); batchStart += UserLikesBatchSize) {
+        std::vector<std::string> batch(simIds.begin() + batchStart, simIds.begin() + std::min(batchStart + UserLikesBatchSize, simIds.size()));
+
+        NetworkRequest request;
+        request.method = NetworkRequest::Method::Post;
+        request.path = "/alien-server/getuserlikesbatch.php";
+        request.params.emplace_back("simIds", boost::algorithm::join(batch, ","));
+        request.withRetry = withRetry;
+        auto userLikesById = RemoteSimulationDataParser::decodeUserLikes(parseJson(networkService->execute(request)));
+        for (auto const& simId : batch) {
+            _userLikesById[simId] = userLikesById[simId];
+        }
+    }
+}
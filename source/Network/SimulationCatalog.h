@@ -0,0 +1,48 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Definitions.h"
+#include "RemoteSimulationData.h"
+
+//local copy of the simulation list of a server which is updated incrementally:
+//only simulations with a timestamp not older than the latest known one are fetched (page by page), the counters of all
+//simulations are updated from a compact statistics list which also reveals deleted simulations,
+//like lists are prefetched in batches for simulations whose like count has changed
+class _SimulationCatalog
+{
+public:
+    _SimulationCatalog(std::string const& serverAddress);
+
+    //an incompatible file or a catalog of another server is ignored
+    void load(std::filesystem::path const& path);
+    void save(std::filesystem::path const& path) const;
+
+    //throws std::runtime_error if the server could not be reached
+    void refresh(NetworkService const& networkService, bool withRetry);
+
+    std::vector<RemoteSimulationData> const& getEntries() const;
+    std::string getLatestTimestamp() const;
+
+    std::optional<std::set<std::string>> getUserLikes(std::string const& simId) const;
+    void setUserLike(std::string const& simId, std::string const& userName, bool like);
+
+private:
+    void updateEntries(std::vector<RemoteSimulationData> const& entries);
+    void updateStats(std::vector<RemoteSimulationStats> const& stats);
+    void prefetchUserLikes(NetworkService const& networkService, bool withRetry);
+
+    static auto constexpr PageSize = 1000;
+    static auto constexpr UserLikesBatchSize = 500;
+
+    std::string _serverAddress;
+    std::vector<RemoteSimulationData> _entries;
+    std::unordered_map<std::string, size_t> _entryIndexById;
+    std::map<std::string, std::set<std::string>> _userLikesById;
+};
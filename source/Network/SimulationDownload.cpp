@@ -0,0 +1,136 @@
+#include "SimulationDownload.h"
+
+#include "NetworkService.h"
+#include "SimulationCache.h"
+
+namespace
+{
+    struct Part
+    {
+        std::string name;
+        std::string path;
+    };
+    std::vector<Part> const Parts = {
+        {"content", "/alien-server/downloadcontent.php"},
+        {"settings", "/alien-server/downloadsettings.php"},
+        {"symbolMap", "/alien-server/downloadsymbolmap.php"}};
+}
+
+_SimulationDownload::_SimulationDownload(
+    NetworkService const& networkService,
+    SimulationCache const& cache,
+    std::string const& simId,
+    std::string const& version)
+{
+    for (auto const& part : Parts) {
+        auto cachedPart = cache->load(simId, version, part.name);
+        if (!cachedPart) {
+            _cachedParts.clear();
+            break;
+        }
+        _cachedParts.emplace_back(std::move(*cachedPart));
+    }
+    if (!_cachedParts.empty()) {
+        return;
+    }
+
+    for (auto const& part : Parts) {
+        NetworkRequest request;
+        request.path = part.path;
+        request.params.emplace_back("id", simId);
+        request.onSuccess = [=](std::string const& data) { cache->store(simId, version, part.name, data); };
+        _tasks.emplace_back(networkService->schedule(request));
+    }
+}
+
+bool _SimulationDownload::isFinished() const
+{
+    for (auto const& task : _tasks) {
+        if (!task->isFinished()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool _SimulationDownload::isSucceeded() const
+{
+    for (auto const& task : _tasks) {
+        if (_NetworkTask::State::Succeeded != task->getState()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool _SimulationDownload::isFromCache() const
+{
+    return _tasks.empty();
+}
+
+std::string _SimulationDownload::getErrorMessage() const
+{
+    for (auto const& task : _tasks) {
+        if (_NetworkTask::State::Failed == task->getState()) {
+            return task->getErrorMessage();
+        }
+    }
+    return {};
+}
+
+float _SimulationDownload::getProgress() const
+{
+    if (_tasks.empty()) {
+        return 1.0f;
+    }
+
+    //weighted by size if all sizes are known
+    uint64_t receivedBytes = 0;
+    uint64_t totalBytes = 0;
+    int numFinishedTasks = 0;
+    bool allSizesKnown = true;
+    for (auto const& task : _tasks) {
+        if (task->isFinished()) {
+            ++numFinishedTasks;
+            receivedBytes += task->getResponse().size();
+            totalBytes += task->getResponse().size();
+            continue;
+        }
+        if (0 == task->getTotalBytes()) {
+            allSizesKnown = false;
+        }
+        receivedBytes += task->getReceivedBytes();
+        totalBytes += task->getTotalBytes();
+    }
+    if (allSizesKnown && totalBytes > 0) {
+        return static_cast<float>(static_cast<double>(receivedBytes) / static_cast<double>(totalBytes));
+    }
+    return static_cast<float>(numFinishedTasks) / static_cast<float>(_tasks.size());
+}
+
+void _SimulationDownload::cancel()
+{
+    for (auto const& task : _tasks) {
+        task->cancel();
+    }
+}
+
+std::string const& _SimulationDownload::getContent() const
+{
+    return getPart(0);
+}
+
+std::string const& _SimulationDownload::getSettings() const
+{
+    return getPart(1);
+}
+
+std::string const& _SimulationDownload::getSymbolMap() const
+{
+    return getPart(2);
+}
+
+std::string const& _SimulationDownload::getPart(int index) const
+{
+    return _tasks.empty() ? _cachedParts.at(index) : _tasks.at(index)->getResponse();
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Definitions.h"
+
+//fetches content, settings and symbol map of a simulation in parallel or takes them from the cache if available,
+//downloaded parts are stored in the cache on completion
+class _SimulationDownload
+{
+public:
+    _SimulationDownload(
+        NetworkService const& networkService,
+        SimulationCache const& cache,
+        std::string const& simId,
+        std::string const& version);
+
+    bool isFinished() const;
+    bool isSucceeded() const;
+    bool isFromCache() const;
+    std::string getErrorMessage() const;
+
+    float getProgress() const;  //between 0 and 1
+    void cancel();
+
+    //valid if succeeded
+    std::string const& getContent() const;
+    std::string const& getSettings() const;
+    std::string const& getSymbolMap() const;
+
+private:
+    std::string const& getPart(int index) const;
+
+    std::vector<std::string> _cachedParts;
+    std::vector<NetworkTask> _tasks;
+};
@@ -10,6 +10,15 @@
         $likesBySimulation[$obj->id] = (int)$obj->likes;
     }
 
+    // optional paging of the simulations with a timestamp not older than "since"
+    $filter = "";
+    if (isset($_GET["since"])) {
+        $since = $db->real_escape_string($_GET["since"]);
+        $offset = isset($_GET["offset"]) ? (int)$_GET["offset"] : 0;
+        $limit = isset($_GET["limit"]) ? (int)$_GET["limit"] : 1000;
+        $filter = "WHERE sim.TIMESTAMP >= '$since' ORDER BY sim.TIMESTAMP, sim.ID LIMIT $offset, $limit";
+    }
+
     $response = $db->query(
         "SELECT 
             sim.ID as id, 
@@ -28,6 +37,7 @@
             user u
         ON
             u.ID=sim.USER_ID
+        $filter
         ");
 
     $result = array();
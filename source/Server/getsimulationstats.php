@@ -0,0 +1,27 @@
+<?php
+    require './helpers.php';
+
+    $db = connectToDB();
+
+    $response = $db->query("SELECT SIMULATION_ID as id, count(1) as likes FROM userlike GROUP BY SIMULATION_ID");
+
+    $likesBySimulation = array();
+    while($obj = $response->fetch_object()){
+        $likesBySimulation[$obj->id] = (int)$obj->likes;
+    }
+
+    $response = $db->query("SELECT sim.ID as id, sim.NUM_DOWNLOADS as numDownloads FROM simulation sim");
+
+    $result = array();
+    while($obj = $response->fetch_object()){
+        $likes = is_null($likesBySimulation[$obj->id]) ? 0 : $likesBySimulation[$obj->id];
+        $result[] = [
+            "id" => (int)$obj->id,
+            "likes" => $likes,
+            "numDownloads" => (int)$obj->numDownloads
+        ];
+    }
+
+    echo json_encode($result);
+    $db->close();
+?>
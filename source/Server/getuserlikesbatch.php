@@ -0,0 +1,29 @@
+<?php
+    require './helpers.php';
+
+    $db = connectToDB();
+
+    $simIds = implode(",", array_map("intval", explode(",", $_POST["simIds"])));
+
+    $response= $db->query(
+        "SELECT 
+            ul.SIMULATION_ID as simId,
+            u.NAME as userName
+        FROM
+            userlike ul, user u
+        WHERE
+            ul.USER_ID = u.ID
+            AND ul.SIMULATION_ID IN ($simIds)
+        ");
+
+    $result = array();
+    while($obj = $response->fetch_object()){
+        $result[] = [
+            "simId" => (int)$obj->simId,
+            "userName" => $obj->userName
+        ];
+    }
+
+    echo json_encode($result);
+    $db->close();
+?>